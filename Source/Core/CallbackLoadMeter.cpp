@@ -0,0 +1,153 @@
+#include "CallbackLoadMeter.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Core {
+
+namespace {
+
+double calibrateTicksPerSecond() {
+#if defined(CORE_LOAD_METER_TSC)
+    // Invariant TSC: measure it against steady_clock over a few milliseconds
+    using Clock = std::chrono::steady_clock;
+    auto wallStart = Clock::now();
+    uint64_t tickStart = CallbackLoadMeter::now();
+    while (Clock::now() - wallStart < std::chrono::milliseconds(5)) {
+    }
+    uint64_t tickEnd = CallbackLoadMeter::now();
+    double seconds = std::chrono::duration<double>(Clock::now() - wallStart).count();
+    return (seconds > 0.0) ? static_cast<double>(tickEnd - tickStart) / seconds : 1.0e9;
+#elif defined(CORE_LOAD_METER_CNTVCT)
+    uint64_t frequency;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return static_cast<double>(frequency);
+#else
+    return 1.0e9;  // now() is in nanoseconds
+#endif
+}
+
+} // namespace
+
+CallbackLoadMeter::CallbackLoadMeter()
+    : sampleRate(44100.0)
+    , loadScale(0.0)
+{
+    for (auto& bin : histogram) {
+        bin.store(0, std::memory_order_relaxed);
+    }
+}
+
+double CallbackLoadMeter::getTicksPerSecond() {
+    static const double ticksPerSecond = calibrateTicksPerSecond();
+    return ticksPerSecond;
+}
+
+void CallbackLoadMeter::prepare(double newSampleRate) {
+    sampleRate = (newSampleRate > 0.0) ? newSampleRate : 44100.0;
+    loadScale = sampleRate / getTicksPerSecond();
+    applyReset();
+}
+
+bool CallbackLoadMeter::endBlock(uint64_t startTicks, int numSamples) {
+    uint64_t endTicks = now();
+    if (numSamples <= 0 || loadScale <= 0.0) {
+        return false;
+    }
+    
+    if (resetRequested.load(std::memory_order_relaxed)) {
+        applyReset();
+    }
+    
+    const float load = static_cast<float>(static_cast<double>(endTicks - startTicks) * loadScale / numSamples);
+    const int bin = std::min(NUM_BINS - 1, static_cast<int>(load * 100.0f));
+    bump(histogram[std::max(0, bin)]);
+    
+    const uint64_t block = blockCount.load(std::memory_order_relaxed);
+    blockCount.store(block + 1, std::memory_order_relaxed);
+    lastLoad.store(load, std::memory_order_relaxed);
+    if (load > maxLoad.load(std::memory_order_relaxed)) {
+        maxLoad.store(load, std::memory_order_relaxed);
+    }
+    lastBudgetMs.store(1000.0 * numSamples / sampleRate, std::memory_order_relaxed);
+    const uint64_t frames = frameCount.load(std::memory_order_relaxed);
+    frameCount.store(frames + static_cast<uint64_t>(numSamples), std::memory_order_relaxed);
+    
+    if (load < 1.0f) {
+        return false;
+    }
+    
+    bump(overrunCount);
+    int write = eventWrite.load(std::memory_order_relaxed);
+    int next = (write + 1) % OVERRUN_EVENTS;
+    if (next != eventRead.load(std::memory_order_acquire)) {
+        LoadOverrunEvent& event = events[write];
+        event.blockIndex = block;
+        event.frameCounter = frames;
+        event.load = load;
+        event.numSamples = numSamples;
+        eventWrite.store(next, std::memory_order_release);
+    }
+    return true;
+}
+
+CallbackLoadStats CallbackLoadMeter::getStats() const {
+    CallbackLoadStats stats;
+    stats.lastLoad = lastLoad.load(std::memory_order_relaxed);
+    stats.maxLoad = maxLoad.load(std::memory_order_relaxed);
+    stats.blocks = blockCount.load(std::memory_order_relaxed);
+    stats.overruns = overrunCount.load(std::memory_order_relaxed);
+    stats.budgetMs = lastBudgetMs.load(std::memory_order_relaxed);
+    
+    // Percentiles from a snapshot of the bins (the audio thread may be mid-update;
+    // one block either way does not matter at this resolution)
+    uint32_t counts[NUM_BINS];
+    uint64_t total = 0;
+    for (int i = 0; i < NUM_BINS; ++i) {
+        counts[i] = histogram[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return stats;
+    }
+    
+    auto percentile = [&](double fraction) {
+        const uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < NUM_BINS; ++i) {
+            seen += counts[i];
+            if (seen >= target) {
+                return static_cast<float>(i + 1) / 100.0f;  // Upper edge of the bin
+            }
+        }
+        return static_cast<float>(NUM_BINS) / 100.0f;
+    };
+    stats.p50 = std::min(percentile(0.50), std::max(stats.maxLoad, 0.01f));
+    stats.p99 = std::min(percentile(0.99), std::max(stats.maxLoad, 0.01f));
+    return stats;
+}
+
+int CallbackLoadMeter::readOverruns(LoadOverrunEvent* out, int maxCount) {
+    int count = 0;
+    int read = eventRead.load(std::memory_order_relaxed);
+    const int write = eventWrite.load(std::memory_order_acquire);
+    while (count < maxCount && read != write) {
+        out[count++] = events[read];
+        read = (read + 1) % OVERRUN_EVENTS;
+    }
+    eventRead.store(read, std::memory_order_release);
+    return count;
+}
+
+void CallbackLoadMeter::applyReset() {
+    for (auto& bin : histogram) {
+        bin.store(0, std::memory_order_relaxed);
+    }
+    blockCount.store(0, std::memory_order_relaxed);
+    overrunCount.store(0, std::memory_order_relaxed);
+    frameCount.store(0, std::memory_order_relaxed);
+    lastLoad.store(0.0f, std::memory_order_relaxed);
+    maxLoad.store(0.0f, std::memory_order_relaxed);
+    resetRequested.store(false, std::memory_order_relaxed);
+}
+
+} // namespace Core
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define CORE_LOAD_METER_TSC 1
+#elif defined(__aarch64__)
+#define CORE_LOAD_METER_CNTVCT 1
+#else
+#include <chrono>
+#endif
+
+namespace Core {
+
+/**
+ * Snapshot of callback load (fractions of the block's real-time budget, 1.0 = deadline)
+ */
+struct CallbackLoadStats {
+    float lastLoad = 0.0f;
+    float p50 = 0.0f;         // Histogram percentiles (1% resolution)
+    float p99 = 0.0f;
+    float maxLoad = 0.0f;     // Exact worst block since the last reset
+    uint64_t blocks = 0;      // Blocks measured since the last reset
+    uint64_t overruns = 0;    // Blocks that took longer than their budget
+    double budgetMs = 0.0;    // Budget of the last block (numSamples / sampleRate)
+};
+
+/**
+ * One deadline miss, as recorded for the UI
+ */
+struct LoadOverrunEvent {
+    uint64_t blockIndex = 0;     // Block number since the last reset
+    uint64_t frameCounter = 0;   // Frames processed before this block
+    float load = 0.0f;
+    int numSamples = 0;
+};
+
+/**
+ * Audio-callback CPU load meter and deadline-miss detector
+ * Portable C++ - no JUCE dependencies
+ *
+ * beginBlock()/endBlock() bracket a callback with the CPU's monotonic counter
+ * (TSC on x86, CNTVCT on AArch64, steady_clock elsewhere). Each block's load is its
+ * elapsed time over numSamples / sampleRate, binned into a 1%-wide histogram (0..200%,
+ * last bin open-ended). A block that takes longer than its budget counts as an overrun
+ * and is pushed to a small event ring for the UI.
+ *
+ * Audio thread: beginBlock/endBlock only - two counter reads, a few relaxed stores,
+ * no allocation. Any thread: getStats, readOverruns, requestReset
+ */
+class CallbackLoadMeter {
+public:
+    static constexpr int NUM_BINS = 201;         // 0..199% in 1% steps, then >= 200%
+    static constexpr int OVERRUN_EVENTS = 32;
+    
+    CallbackLoadMeter();
+    
+    /**
+     * Set the rate used for block budgets and calibrate the counter (message thread;
+     * the first call spins for a few milliseconds on x86)
+     */
+    void prepare(double sampleRate);
+    
+    // Monotonic counter value (ticks) for beginBlock/endBlock
+    static uint64_t now() {
+#if defined(CORE_LOAD_METER_TSC)
+        return __rdtsc();
+#elif defined(CORE_LOAD_METER_CNTVCT)
+        uint64_t ticks;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+    
+    // Counter ticks per second (calibrated once per process)
+    static double getTicksPerSecond();
+    
+    uint64_t beginBlock() const { return now(); }
+    
+    /**
+     * Record a block that started at startTicks; returns true if it missed its deadline
+     */
+    bool endBlock(uint64_t startTicks, int numSamples);
+    
+    /**
+     * Percentiles, max and counters since the last reset
+     */
+    CallbackLoadStats getStats() const;
+    
+    // Last block, max and overruns since the last reset (cheap reads for per-block publishing)
+    float getLastLoad() const { return lastLoad.load(std::memory_order_relaxed); }
+    float getMaxLoad() const { return maxLoad.load(std::memory_order_relaxed); }
+    uint64_t getOverrunCount() const { return overrunCount.load(std::memory_order_relaxed); }
+    
+    /**
+     * Drain recorded overruns (oldest first); returns the number copied
+     */
+    int readOverruns(LoadOverrunEvent* out, int maxCount);
+    
+    /**
+     * Clear the histogram and counters; applied by the audio thread at its next block
+     */
+    void requestReset() { resetRequested.store(true, std::memory_order_release); }
+
+private:
+    double sampleRate;
+    double loadScale;       // sampleRate / ticks per second: load = ticks * loadScale / numSamples
+    
+    // Written only by the audio thread (relaxed load + store, no read-modify-write)
+    std::atomic<uint32_t> histogram[NUM_BINS];
+    std::atomic<uint64_t> blockCount{0};
+    std::atomic<uint64_t> overrunCount{0};
+    std::atomic<uint64_t> frameCount{0};
+    std::atomic<float> lastLoad{0.0f};
+    std::atomic<float> maxLoad{0.0f};
+    std::atomic<double> lastBudgetMs{0.0};
+    std::atomic<bool> resetRequested{false};
+    
+    // Overrun events (single producer: audio thread, single consumer: UI; full = drop)
+    LoadOverrunEvent events[OVERRUN_EVENTS];
+    std::atomic<int> eventWrite{0};
+    std::atomic<int> eventRead{0};
+    
+    void applyReset();
+    
+    template <typename T>
+    static void bump(std::atomic<T>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+} // namespace Core
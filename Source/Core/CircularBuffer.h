@@ -1,5 +1,7 @@
 #pragma once
 
+#include "DSP/PlanarRingBuffer.h"
+
 namespace Core {
 
 /**
@@ -48,16 +50,10 @@ public:
     /**
      * Get maximum size
      */
-    int getSize() const { return bufferSize; }
+    int getSize() const { return ring.getCapacity(); }
 
 private:
-    float* buffer;
-    int bufferSize;
-    int writePos;
-    int readPos;
-    int numAvailable;
-    
-    int wrapIndex(int index) const;
+    PlanarRingBuffer<float> ring;  // One channel, exactly size frames
 };
 
 } // namespace Core
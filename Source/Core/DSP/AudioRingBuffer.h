@@ -1,170 +1,80 @@
 #pragma once
 
-#include <cstdint>
-#include <cstring>
+#include "PlanarRingBuffer.h"
 #include <algorithm>
 
 namespace Core {
 
 /**
  * Portable ring buffer for planar float audio (no allocations in process)
- * Supports multi-channel audio with power-of-two capacity for efficient wrapping
+ * Supports multi-channel audio with power-of-two capacity; blocks move with one
+ * memcpy per channel (PlanarRingBuffer). Reads that run short zero-fill the rest
+ * of the output
  */
 class AudioRingBuffer {
 public:
-    AudioRingBuffer() 
-        : storage(nullptr)
-        , capacity(0)
-        , channels(0)
-        , readPos(0)
-        , writePos(0)
-        , available(0)
-    {}
-    
-    ~AudioRingBuffer() {
-        deallocate();
-    }
-    
     // Allocate storage (call from prepare/constructor, not audio thread)
-    void allocate(int numChannels, int maxFrames) {
-        deallocate();
-        channels = numChannels;
-        capacity = nextPowerOfTwo(maxFrames);
-        storage = new float[static_cast<size_t>(capacity * channels)];
-        std::fill(storage, storage + capacity * channels, 0.0f);
-        readPos = 0;
-        writePos = 0;
-        available = 0;
+    // mirrored: double-map the storage so readPointer()/writePointer() spans never wrap
+    void allocate(int numChannels, int maxFrames, bool mirrored = false) {
+        ring.allocate(numChannels, nextPowerOfTwo(maxFrames), mirrored);
     }
     
     void deallocate() {
-        delete[] storage;
-        storage = nullptr;
-        capacity = 0;
-        channels = 0;
-        readPos = 0;
-        writePos = 0;
-        available = 0;
+        ring.deallocate();
     }
     
     void reset() {
-        readPos = 0;
-        writePos = 0;
-        available = 0;
-        if (storage && capacity > 0 && channels > 0) {
-            std::fill(storage, storage + capacity * channels, 0.0f);
-        }
+        ring.clear();
     }
     
     // Push frames into ring (planar: in[channels][frames])
     int push(const float* const* in, int frames) {
-        if (!storage || capacity == 0 || channels == 0 || frames <= 0) {
-            return 0;
-        }
-        
-        int toPush = std::min(frames, capacity - available);
-        if (toPush <= 0) {
-            return 0; // Ring full
-        }
-        
-        for (int f = 0; f < toPush; ++f) {
-            int writeIdx = (writePos + f) & (capacity - 1);
-            for (int ch = 0; ch < channels; ++ch) {
-                storage[writeIdx * channels + ch] = in[ch][f];
-            }
-        }
-        
-        writePos = (writePos + toPush) & (capacity - 1);
-        available += toPush;
-        
-        return toPush;
+        return ring.write(in, frames);
     }
     
     // Pop frames from ring (planar: out[channels][frames])
     int pop(float* const* out, int frames) {
-        if (!storage || capacity == 0 || channels == 0 || frames <= 0) {
-            return 0;
-        }
-        
-        int toPop = std::min(frames, available);
-        if (toPop <= 0) {
-            // Ring empty - zero-fill output
-            for (int ch = 0; ch < channels; ++ch) {
-                std::fill(out[ch], out[ch] + frames, 0.0f);
-            }
-            return 0;
-        }
-        
-        for (int f = 0; f < toPop; ++f) {
-            int readIdx = (readPos + f) & (capacity - 1);
-            for (int ch = 0; ch < channels; ++ch) {
-                out[ch][f] = storage[readIdx * channels + ch];
-            }
-        }
-        
-        readPos = (readPos + toPop) & (capacity - 1);
-        available -= toPop;
-        
-        // Zero-fill remaining if requested more than available
-        if (toPop < frames) {
-            for (int ch = 0; ch < channels; ++ch) {
-                std::fill(out[ch] + toPop, out[ch] + frames, 0.0f);
-            }
-        }
-        
-        return toPop;
+        int popped = ring.read(out, frames);
+        zeroFill(out, popped, frames);
+        return popped;
     }
     
     // Peek frames without consuming (planar: out[channels][frames])
     int peek(float* const* out, int frames) const {
-        if (!storage || capacity == 0 || channels == 0 || frames <= 0) {
-            return 0;
-        }
-        
-        int toPeek = std::min(frames, available);
-        if (toPeek <= 0) {
-            for (int ch = 0; ch < channels; ++ch) {
-                std::fill(out[ch], out[ch] + frames, 0.0f);
-            }
-            return 0;
-        }
-        
-        for (int f = 0; f < toPeek; ++f) {
-            int readIdx = (readPos + f) & (capacity - 1);
-            for (int ch = 0; ch < channels; ++ch) {
-                out[ch][f] = storage[readIdx * channels + ch];
-            }
-        }
-        
-        // Zero-fill remaining
-        if (toPeek < frames) {
-            for (int ch = 0; ch < channels; ++ch) {
-                std::fill(out[ch] + toPeek, out[ch] + frames, 0.0f);
-            }
-        }
-        
-        return toPeek;
+        int peeked = ring.peek(out, frames);
+        zeroFill(out, peeked, frames);
+        return peeked;
     }
     
     // Discard frames without reading
     void discard(int frames) {
-        int toDiscard = std::min(frames, available);
-        readPos = (readPos + toDiscard) & (capacity - 1);
-        available -= toDiscard;
+        ring.discard(frames);
     }
     
-    int availableToRead() const { return available; }
-    int availableToWrite() const { return capacity - available; }
-    int getCapacity() const { return capacity; }
-    int getChannels() const { return channels; }
+    // In-place access (see PlanarRingBuffer); spans are full length when mirrored
+    const float* readPointer(int channel) const { return ring.readPointer(channel); }
+    int contiguousReadable() const { return ring.contiguousReadable(); }
+    float* writePointer(int channel) { return ring.writePointer(channel); }
+    int contiguousWritable() const { return ring.contiguousWritable(); }
+    void commitWrite(int frames) { ring.commitWrite(frames); }
     
+    int availableToRead() const { return ring.availableToRead(); }
+    int availableToWrite() const { return ring.availableToWrite(); }
+    int getCapacity() const { return ring.getCapacity(); }
+    int getChannels() const { return ring.getChannels(); }
+    bool isMirrored() const { return ring.isMirrored(); }
+
 private:
-    float* storage;
-    int capacity;
-    int channels;
-    int readPos;
-    int writePos;
-    int available;
+    PlanarRingBuffer<float> ring;
+    
+    void zeroFill(float* const* out, int from, int frames) const {
+        if (out == nullptr || from >= frames) {
+            return;
+        }
+        for (int ch = 0; ch < ring.getChannels(); ++ch) {
+            std::fill(out[ch] + std::max(0, from), out[ch] + frames, 0.0f);
+        }
+    }
     
     static int nextPowerOfTwo(int n) {
         if (n <= 0) return 1;
@@ -175,7 +85,3 @@ private:
 };
 
 } // namespace Core
-
-
-
-
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "WarpSampleView.h"
+
 namespace Core {
 
 /**
@@ -47,6 +49,28 @@ public:
     virtual int process(const float* const* in, int inFrames,
                        float* const* out, int outFrames) = 0;
     
+    /**
+     * Process audio reading input directly from sample memory (pull mode)
+     * Consumes outFrames * (view.sampleRate / host rate) / timeRatio input frames from
+     * view.position and advances it; the source/host rate difference is compensated in
+     * pitch. Nothing is buffered between calls, so exactly outFrames are produced
+     * @param view Sample memory, loop points and read position
+     * @param out Planar output buffers [channels][frames]
+     * @param outFrames Number of output frames to produce
+     * @return Number of output frames produced
+     */
+    virtual int processPull(WarpSampleView& view, float* const* out, int outFrames) = 0;
+    
+    /**
+     * Pre-roll the input lookahead from sample memory before the first processPull of a note
+     * The frames ahead of view.position are handed to the processor without producing output
+     * and view.position advances past them, so the note's first frame comes out exactly
+     * getLatencyFrames() after the next processPull starts instead of lookahead + latency later
+     * @param view Sample memory, loop points and read position
+     * @return Input frames consumed (the processor's lookahead, in source frames)
+     */
+    virtual int prerollPull(WarpSampleView& view) = 0;
+    
     /**
      * Get output latency in frames
      * @return Latency in frames
@@ -68,6 +92,7 @@ public:
     
     /**
      * Get current output ring buffer fill level (for debugging)
+     * In pull mode nothing is buffered; this reports frames produced since reset
      */
     virtual int getOutputRingFill() const = 0;
 };
@@ -0,0 +1,129 @@
+#include "MirroredMemory.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define CORE_MIRROR_POSIX 1
+#endif
+
+namespace Core {
+
+namespace {
+
+#if defined(CORE_MIRROR_POSIX)
+// Anonymous shared-memory object of the given size; the name (if any) is already unlinked
+int createSharedMemory(size_t bytes) {
+    int fd = -1;
+#if defined(__linux__)
+    fd = memfd_create("op1clone-ring", MFD_CLOEXEC);
+#endif
+    if (fd < 0) {
+        // Unique per process and allocation; shm names are limited to ~30 chars on macOS
+        static std::atomic<unsigned int> counter{0};
+        char name[32];
+        std::snprintf(name, sizeof(name), "/op1r-%d-%u", static_cast<int>(getpid()),
+                      counter.fetch_add(1, std::memory_order_relaxed));
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            shm_unlink(name);
+        }
+    }
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+#endif
+
+} // namespace
+
+MirroredMemory::~MirroredMemory() {
+    release();
+}
+
+size_t MirroredMemory::getGranularity() {
+#if defined(CORE_MIRROR_POSIX)
+    long pageSize = sysconf(_SC_PAGESIZE);
+    return (pageSize > 0) ? static_cast<size_t>(pageSize) : 4096;
+#else
+    return 0;
+#endif
+}
+
+bool MirroredMemory::allocate(size_t bytesPerRegion, int regions) {
+    release();
+    size_t granularity = getGranularity();
+    if (granularity == 0 || bytesPerRegion == 0 || bytesPerRegion % granularity != 0 || regions <= 0) {
+        return false;
+    }
+
+#if defined(CORE_MIRROR_POSIX)
+    const size_t totalBytes = bytesPerRegion * static_cast<size_t>(regions);
+    int fd = createSharedMemory(totalBytes);
+    if (fd < 0) {
+        return false;
+    }
+    
+    // Reserve the whole address range first so the two copies are guaranteed adjacent
+    void* reserved = mmap(nullptr, 2 * totalBytes, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (reserved == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    
+    bool mapped = true;
+    uint8_t* bytes = static_cast<uint8_t*>(reserved);
+    for (int r = 0; r < regions && mapped; ++r) {
+        off_t offset = static_cast<off_t>(bytesPerRegion * static_cast<size_t>(r));
+        uint8_t* region = bytes + 2 * bytesPerRegion * static_cast<size_t>(r);
+        for (int copy = 0; copy < 2; ++copy) {
+            void* target = region + bytesPerRegion * static_cast<size_t>(copy);
+            void* view = mmap(target, bytesPerRegion, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, offset);
+            if (view != target) {
+                mapped = false;
+                break;
+            }
+        }
+    }
+    
+    // The mappings keep the pages alive
+    close(fd);
+    
+    if (!mapped) {
+        munmap(reserved, 2 * totalBytes);
+        return false;
+    }
+    
+    base = reserved;
+    regionBytes = bytesPerRegion;
+    numRegions = regions;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MirroredMemory::release() {
+#if defined(CORE_MIRROR_POSIX)
+    if (base != nullptr) {
+        munmap(base, 2 * regionBytes * static_cast<size_t>(numRegions));
+    }
+#endif
+    base = nullptr;
+    regionBytes = 0;
+    numRegions = 0;
+}
+
+void* MirroredMemory::getRegion(int index) const {
+    if (base == nullptr || index < 0 || index >= numRegions) {
+        return nullptr;
+    }
+    return static_cast<uint8_t*>(base) + 2 * regionBytes * static_cast<size_t>(index);
+}
+
+} // namespace Core
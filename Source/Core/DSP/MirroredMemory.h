@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Core {
+
+/**
+ * Double-mapped memory regions for ring buffers
+ * Portable C++ - no JUCE dependencies
+ *
+ * Each region of regionBytes is mapped twice, back to back, onto the same physical
+ * pages: writing byte i of a region also writes byte i + regionBytes. A reader that
+ * starts anywhere inside the first copy can therefore walk up to regionBytes forward
+ * without ever wrapping. Regions are laid out one after another, each followed by its
+ * mirror, from a single shared-memory object.
+ *
+ * Linux uses memfd_create, other POSIX systems an unlinked shm_open object. Platforms
+ * without either (Windows) report failure and callers fall back to plain storage.
+ * allocate() and release() make system calls - never call them on the audio thread
+ */
+class MirroredMemory {
+public:
+    MirroredMemory() = default;
+    ~MirroredMemory();
+    
+    MirroredMemory(const MirroredMemory&) = delete;
+    MirroredMemory& operator=(const MirroredMemory&) = delete;
+    
+    /**
+     * Size every region must be a multiple of (the system page size), or 0 if this
+     * platform cannot mirror
+     */
+    static size_t getGranularity();
+    
+    /**
+     * Map numRegions mirrored regions of regionBytes each (a multiple of getGranularity()).
+     * Returns false, leaving nothing mapped, if the system refuses
+     */
+    bool allocate(size_t regionBytes, int numRegions);
+    
+    void release();
+    
+    bool isValid() const { return base != nullptr; }
+    
+    /**
+     * Start of region index; its mirror begins regionBytes later
+     */
+    void* getRegion(int index) const;
+    
+    size_t getRegionBytes() const { return regionBytes; }
+
+private:
+    void* base = nullptr;
+    size_t regionBytes = 0;
+    int numRegions = 0;
+};
+
+} // namespace Core
@@ -10,6 +10,7 @@ OrbitBlender::OrbitBlender()
     , activeSlotsMask(0x0F)  // All 4 slots active by default
     , phase(0.0f)
     , smoothedWeights{0.25f, 0.25f, 0.25f, 0.25f}  // Equal weights initially
+    , rampWeights{0.25f, 0.25f, 0.25f, 0.25f}
     , smoothingCoeff(0.05f)  // Smooth transition (~20 samples at 44.1k for dt=1/44100)
     , randomPhase(0.0f)
     , randomTarget(0.0f)
@@ -59,6 +60,7 @@ void OrbitBlender::reset()
     } else {
         smoothedWeights.fill(0.0f);
     }
+    rampWeights = smoothedWeights;
     randomPhase = 0.0f;
     randomTarget = randomFloat();
 }
@@ -88,6 +90,29 @@ std::array<float, 4> OrbitBlender::update(float dtSeconds)
     return smoothedWeights;
 }
 
+std::array<float, 4> OrbitBlender::renderWeightRamps(float dtSeconds, int numSamples, float* const* rampOut)
+{
+    std::array<float, 4> startWeights = rampWeights;
+    std::array<float, 4> endWeights = update(dtSeconds);
+    
+    if (numSamples > 0) {
+        float invSamples = 1.0f / static_cast<float>(numSamples);
+        for (int slot = 0; slot < 4; ++slot) {
+            float* ramp = rampOut[slot];
+            if (ramp == nullptr) {
+                continue;
+            }
+            float step = (endWeights[slot] - startWeights[slot]) * invSamples;
+            for (int i = 0; i < numSamples; ++i) {
+                ramp[i] = startWeights[slot] + step * static_cast<float>(i + 1);
+            }
+        }
+    }
+    
+    rampWeights = endWeights;
+    return endWeights;
+}
+
 std::array<float, 4> OrbitBlender::computeRawWeights(float currentPhase)
 {
     std::array<float, 4> weights = {0.0f, 0.0f, 0.0f, 0.0f};
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 
 namespace Core {
 namespace DSP {
@@ -47,6 +48,12 @@ public:
     // Returns: array of 4 weights, normalized so sum = 1.0
     std::array<float, 4> update(float dtSeconds);
     
+    // Update orbit over one audio block and write per-sample weight ramps [A, B, C, D]
+    // Each ramp moves linearly from the previous block's weights to this block's, so
+    // blended voices never step in gain at block boundaries (no zipper noise)
+    // rampOut[i] must hold numSamples floats; returns the weights at the end of the block
+    std::array<float, 4> renderWeightRamps(float dtSeconds, int numSamples, float* const* rampOut);
+    
     // Get current phase (0.0 to 1.0)
     float getPhase() const { return phase; }
     
@@ -59,6 +66,7 @@ private:
     
     // Smoothing per weight (one-pole lowpass for click-free transitions)
     std::array<float, 4> smoothedWeights;
+    std::array<float, 4> rampWeights;  // Weights at the end of the last rendered ramp
     float smoothingCoeff;  // One-pole coefficient (0.0 to 1.0)
     
     // Random state for RandomSmooth shape
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "MirroredMemory.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace Core {
+
+/**
+ * Planar multi-channel ring buffer moved in bulk
+ * Portable C++ - no JUCE dependencies
+ *
+ * Each channel is its own contiguous array, so a block moves with one memcpy per
+ * channel, or two when it crosses the end of the array. Storage is either owned
+ * (allocate) or supplied by the caller (attach).
+ *
+ * Owned storage can be mirrored: every channel is double-mapped (see MirroredMemory),
+ * so the frames after any read or write position are contiguous in memory. peek/read/
+ * write are then always a single memcpy, and readPointer()/writePointer() hand out
+ * spans that callers can process in place. Mirroring rounds the capacity up to whole
+ * pages and quietly falls back to plain storage where the platform cannot map it.
+ *
+ * allocate/attach/deallocate are setup calls; everything else is allocation-free and
+ * safe on the audio thread. Not thread-safe - one reader and one writer on one thread
+ */
+template <typename T>
+class PlanarRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "PlanarRingBuffer moves samples with memcpy");
+
+public:
+    static constexpr int MAX_CHANNELS = 8;
+    
+    PlanarRingBuffer() = default;
+    
+    ~PlanarRingBuffer() {
+        deallocate();
+    }
+    
+    PlanarRingBuffer(const PlanarRingBuffer&) = delete;
+    PlanarRingBuffer& operator=(const PlanarRingBuffer&) = delete;
+    
+    /**
+     * Own numChannels x at least minFrames of zeroed storage (exactly minFrames unless
+     * mirrored). Call from prepare, not the audio thread
+     */
+    void allocate(int numChannels, int minFrames, bool mirror = false) {
+        deallocate();
+        numChannels = std::max(0, std::min(MAX_CHANNELS, numChannels));
+        if (numChannels == 0 || minFrames <= 0) {
+            return;
+        }
+        
+        if (mirror && allocateMirrored(numChannels, minFrames)) {
+            return;
+        }
+        
+        capacity = minFrames;
+        channels = numChannels;
+        ownedStorage = new T[static_cast<size_t>(capacity) * static_cast<size_t>(channels)];
+        for (int ch = 0; ch < channels; ++ch) {
+            channelData[ch] = ownedStorage + static_cast<size_t>(ch) * static_cast<size_t>(capacity);
+        }
+        clear();
+    }
+    
+    /**
+     * Use caller-owned storage: one array of capacityFrames per channel, which must
+     * outlive the buffer. Never mirrored; contents are left as they are
+     */
+    void attach(T* const* channelStorage, int numChannels, int capacityFrames) {
+        deallocate();
+        if (channelStorage == nullptr || numChannels <= 0 || capacityFrames <= 0) {
+            return;
+        }
+        channels = std::min(MAX_CHANNELS, numChannels);
+        capacity = capacityFrames;
+        for (int ch = 0; ch < channels; ++ch) {
+            channelData[ch] = channelStorage[ch];
+        }
+    }
+    
+    void deallocate() {
+        delete[] ownedStorage;
+        ownedStorage = nullptr;
+        mirrorMemory.release();
+        mirrored = false;
+        std::fill(channelData, channelData + MAX_CHANNELS, nullptr);
+        capacity = 0;
+        channels = 0;
+        reset();
+    }
+    
+    /**
+     * Forget the contents (storage is not touched)
+     */
+    void reset() {
+        readPos = 0;
+        writePos = 0;
+        available = 0;
+    }
+    
+    /**
+     * Forget the contents and zero the storage
+     */
+    void clear() {
+        reset();
+        for (int ch = 0; ch < channels; ++ch) {
+            std::memset(channelData[ch], 0, sizeof(T) * static_cast<size_t>(capacity));
+        }
+    }
+    
+    /**
+     * Append up to frames frames (in[channels][frames]); returns the number written,
+     * limited by availableToWrite()
+     */
+    int write(const T* const* in, int frames) {
+        int toWrite = std::min(frames, capacity - available);
+        if (in == nullptr || toWrite <= 0) {
+            return 0;
+        }
+        for (int ch = 0; ch < channels; ++ch) {
+            copyIn(channelData[ch], writePos, in[ch], toWrite);
+        }
+        commitWrite(toWrite);
+        return toWrite;
+    }
+    
+    /**
+     * Append all frames, dropping the oldest contents to make room. If frames exceeds
+     * the capacity only the newest capacity frames are kept
+     */
+    void writeOverwriting(const T* const* in, int frames) {
+        if (in == nullptr || frames <= 0 || capacity == 0) {
+            return;
+        }
+        if (frames >= capacity) {
+            reset();
+            const int skip = frames - capacity;
+            for (int ch = 0; ch < channels; ++ch) {
+                std::memcpy(channelData[ch], in[ch] + skip, sizeof(T) * static_cast<size_t>(capacity));
+            }
+            commitWrite(capacity);
+            return;
+        }
+        discard(frames - (capacity - available));
+        write(in, frames);
+    }
+    
+    /**
+     * Copy up to frames frames starting offset frames after the read position without
+     * consuming them; returns the number copied (the rest of out is left untouched)
+     */
+    int peek(T* const* out, int frames, int offset = 0) const {
+        int toCopy = std::min(frames, available - offset);
+        if (out == nullptr || offset < 0 || toCopy <= 0) {
+            return 0;
+        }
+        const int start = wrap(readPos + offset);
+        for (int ch = 0; ch < channels; ++ch) {
+            copyOut(out[ch], channelData[ch], start, toCopy);
+        }
+        return toCopy;
+    }
+    
+    /**
+     * peek() then consume what was copied
+     */
+    int read(T* const* out, int frames) {
+        int copied = peek(out, frames);
+        discard(copied);
+        return copied;
+    }
+    
+    /**
+     * Consume up to frames frames without copying them
+     */
+    void discard(int frames) {
+        int toDiscard = std::min(frames, available);
+        if (toDiscard <= 0) {
+            return;
+        }
+        readPos = wrap(readPos + toDiscard);
+        available -= toDiscard;
+    }
+    
+    /**
+     * In-place view of channel starting offset frames after the read position; valid
+     * for contiguousReadable(offset) frames until the next write
+     */
+    const T* readPointer(int channel, int offset = 0) const {
+        return channelData[channel] + wrap(readPos + std::max(0, offset));
+    }
+    
+    int contiguousReadable(int offset = 0) const {
+        int frames = available - offset;
+        if (offset < 0 || frames <= 0) {
+            return 0;
+        }
+        return mirrored ? frames : std::min(frames, capacity - wrap(readPos + offset));
+    }
+    
+    /**
+     * In-place span at the write position for contiguousWritable() frames; fill it and
+     * call commitWrite() to append what was written
+     */
+    T* writePointer(int channel) {
+        return channelData[channel] + writePos;
+    }
+    
+    int contiguousWritable() const {
+        int frames = capacity - available;
+        return mirrored ? frames : std::min(frames, capacity - writePos);
+    }
+    
+    void commitWrite(int frames) {
+        frames = std::min(frames, capacity - available);
+        if (frames <= 0) {
+            return;
+        }
+        writePos = wrap(writePos + frames);
+        available += frames;
+    }
+    
+    int availableToRead() const { return available; }
+    int availableToWrite() const { return capacity - available; }
+    int getCapacity() const { return capacity; }
+    int getChannels() const { return channels; }
+    bool isMirrored() const { return mirrored; }
+
+private:
+    T* channelData[MAX_CHANNELS] = {};
+    T* ownedStorage = nullptr;
+    MirroredMemory mirrorMemory;
+    bool mirrored = false;
+    int capacity = 0;
+    int channels = 0;
+    int readPos = 0;
+    int writePos = 0;
+    int available = 0;
+    
+    // Positions never run more than one capacity past the end
+    int wrap(int position) const {
+        return (position >= capacity) ? position - capacity : position;
+    }
+    
+    bool allocateMirrored(int numChannels, int minFrames) {
+        const size_t granularity = MirroredMemory::getGranularity();
+        if (granularity == 0) {
+            return false;
+        }
+        size_t bytes = sizeof(T) * static_cast<size_t>(minFrames);
+        bytes = ((bytes + granularity - 1) / granularity) * granularity;
+        if (bytes % sizeof(T) != 0 || !mirrorMemory.allocate(bytes, numChannels)) {
+            return false;
+        }
+        capacity = static_cast<int>(bytes / sizeof(T));
+        channels = numChannels;
+        mirrored = true;
+        for (int ch = 0; ch < channels; ++ch) {
+            channelData[ch] = static_cast<T*>(mirrorMemory.getRegion(ch));
+        }
+        clear();
+        return true;
+    }
+    
+    void copyIn(T* data, int start, const T* src, int frames) {
+        int first = mirrored ? frames : std::min(frames, capacity - start);
+        std::memcpy(data + start, src, sizeof(T) * static_cast<size_t>(first));
+        if (first < frames) {
+            std::memcpy(data, src + first, sizeof(T) * static_cast<size_t>(frames - first));
+        }
+    }
+    
+    void copyOut(T* dest, const T* data, int start, int frames) const {
+        int first = mirrored ? frames : std::min(frames, capacity - start);
+        std::memcpy(dest, data + start, sizeof(T) * static_cast<size_t>(first));
+        if (first < frames) {
+            std::memcpy(dest + first, data, sizeof(T) * static_cast<size_t>(frames - first));
+        }
+    }
+};
+
+} // namespace Core
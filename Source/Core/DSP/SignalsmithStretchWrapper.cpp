@@ -16,6 +16,27 @@ public:
     ~Impl() = default;
 };
 
+namespace {
+
+// Signalsmith Stretch reads input as inputs[channel][frame]; these adapt a
+// WarpSampleView to that shape so processPull reads sample memory in place
+struct ViewChannel {
+    const WarpSampleView* view;
+    int channel;
+    int base;
+    
+    float operator[](int frame) const { return view->read(channel, base + frame); }
+};
+
+struct ViewInputs {
+    const WarpSampleView* view;
+    int base;
+    
+    ViewChannel operator[](int channel) const { return ViewChannel{ view, channel > 0 ? 1 : 0, base }; }
+};
+
+} // namespace
+
 SignalsmithStretchWrapper::SignalsmithStretchWrapper()
     : impl(std::make_unique<Impl>())
     , prepared_(false)
@@ -27,6 +48,9 @@ SignalsmithStretchWrapper::SignalsmithStretchWrapper()
     , inputLatency_(0)
     , outputLatency_(0)
     , primed_(false)
+    , appliedTranspose_(0.0f)
+    , pullMode_(false)
+    , pullFramesProduced_(0)
     , tempIn_(nullptr)
     , tempOut_(nullptr)
     , tempInMaxFrames_(0)
@@ -39,6 +63,16 @@ SignalsmithStretchWrapper::~SignalsmithStretchWrapper() {
     deallocateBuffers();
 }
 
+const char* SignalsmithStretchWrapper::getBackendName() {
+#if defined(SIGNALSMITH_USE_ACCELERATE)
+    return "accelerate";
+#elif defined(SIGNALSMITH_USE_IPP)
+    return "ipp";
+#else
+    return "scalar";
+#endif
+}
+
 void SignalsmithStretchWrapper::prepare(double sampleRate, int channels, int maxBlockFrames) {
     sampleRate_ = sampleRate;
     channels_ = channels;
@@ -78,7 +112,8 @@ void SignalsmithStretchWrapper::reset() {
     impl->stretch.reset();
     
     // Re-apply current settings
-    impl->stretch.setTransposeSemitones(std::max(-24.0f, std::min(24.0f, pitchSemitones_)));
+    appliedTranspose_ = std::max(-24.0f, std::min(24.0f, pitchSemitones_));
+    impl->stretch.setTransposeSemitones(appliedTranspose_);
     
     // Clear ring buffers
     inputRing_.reset();
@@ -86,6 +121,8 @@ void SignalsmithStretchWrapper::reset() {
     
     // Reset priming state
     primed_ = false;
+    pullMode_ = false;
+    pullFramesProduced_ = 0;
     
     // Reset debug metrics
     warpPeak.store(0.0f, std::memory_order_relaxed);
@@ -104,7 +141,14 @@ void SignalsmithStretchWrapper::setTimeRatio(double ratio) {
 void SignalsmithStretchWrapper::setPitchSemitones(float semitones) {
     pitchSemitones_ = std::max(-24.0f, std::min(24.0f, semitones));
     if (prepared_) {
-        impl->stretch.setTransposeSemitones(pitchSemitones_);
+        applyTranspose(pitchSemitones_);
+    }
+}
+
+void SignalsmithStretchWrapper::applyTranspose(float semitones) {
+    if (semitones != appliedTranspose_) {
+        impl->stretch.setTransposeSemitones(semitones);
+        appliedTranspose_ = semitones;
     }
 }
 
@@ -118,6 +162,10 @@ int SignalsmithStretchWrapper::process(const float* const* in, int inFrames,
     warpPeak.store(0.0f, std::memory_order_relaxed);
     warpMaxDelta.store(0.0f, std::memory_order_relaxed);
     
+    // Drop any source-rate compensation left by processPull
+    pullMode_ = false;
+    applyTranspose(pitchSemitones_);
+    
     // (1) Push input frames into inputRing
     if (in != nullptr && inFrames > 0) {
         inputRing_.push(in, inFrames);
@@ -141,44 +189,66 @@ int SignalsmithStretchWrapper::process(const float* const* in, int inFrames,
         int inChunk = static_cast<int>(std::round(static_cast<double>(outChunk) / timeRatio_));
         inChunk = std::max(32, std::min(inChunk, tempInMaxFrames_));
         
-        // Pop input chunk from inputRing
-        int actualInChunk = inputRing_.pop(tempIn_, inChunk);
-        
-        // Track starvation: if we got less than requested
-        if (actualInChunk < inChunk) {
-            // Pad remaining with zeros
-            for (int ch = 0; ch < channels_; ++ch) {
-                std::fill(tempIn_[ch] + actualInChunk, tempIn_[ch] + inChunk, 0.0f);
-            }
-            if (actualInChunk == 0) {
-                inputStarveCount.fetch_add(1, std::memory_order_relaxed);
+        // Read the chunk in place when it is contiguous in the input ring (always, once
+        // the ring is mirrored); otherwise pop it into tempIn_
+        const float* inPtrs[2];
+        int actualInChunk = inChunk;
+        const bool inPlaceIn = inputRing_.contiguousReadable() >= inChunk;
+        if (inPlaceIn) {
+            inPtrs[0] = inputRing_.readPointer(0);
+            inPtrs[1] = inputRing_.readPointer((channels_ > 1) ? 1 : 0);
+        } else {
+            actualInChunk = inputRing_.pop(tempIn_, inChunk);
+            
+            // Track starvation: if we got less than requested
+            if (actualInChunk < inChunk) {
+                // Pad remaining with zeros
+                for (int ch = 0; ch < channels_; ++ch) {
+                    std::fill(tempIn_[ch] + actualInChunk, tempIn_[ch] + inChunk, 0.0f);
+                }
+                if (actualInChunk == 0) {
+                    inputStarveCount.fetch_add(1, std::memory_order_relaxed);
+                }
             }
+            inPtrs[0] = tempIn_[0];
+            inPtrs[1] = (channels_ > 1) ? tempIn_[1] : tempIn_[0];
         }
         
+        // Likewise render straight into free space in the output ring when possible
+        const bool inPlaceOut = outputRing_.contiguousWritable() >= outChunk;
+        auto chunkChannel = [&](int ch) { return inPlaceOut ? outputRing_.writePointer(ch) : tempOut_[ch]; };
+        
         // Clear output buffer
         for (int ch = 0; ch < channels_; ++ch) {
-            std::fill(tempOut_[ch], tempOut_[ch] + outChunk, 0.0f);
+            std::fill(chunkChannel(ch), chunkChannel(ch) + outChunk, 0.0f);
         }
         
-        // Prepare planar pointers for Signalsmith
-        const float* inPtrs[2] = {tempIn_[0], (channels_ > 1) ? tempIn_[1] : tempIn_[0]};
-        float* outPtrs[2] = {tempOut_[0], (channels_ > 1) ? tempOut_[1] : tempOut_[0]};
-        
         // Process with Signalsmith Stretch
         // Time ratio is inferred from inChunk/outChunk ratio
+        float* outPtrs[2] = {chunkChannel(0), chunkChannel((channels_ > 1) ? 1 : 0)};
         impl->stretch.process(inPtrs, inChunk, outPtrs, outChunk);
         
         // Check for non-finite values
         for (int ch = 0; ch < channels_; ++ch) {
+            float* chunk = chunkChannel(ch);
             for (int f = 0; f < outChunk; ++f) {
-                if (!std::isfinite(tempOut_[ch][f])) {
-                    tempOut_[ch][f] = 0.0f;
+                if (!std::isfinite(chunk[f])) {
+                    chunk[f] = 0.0f;
                 }
             }
         }
         
+        // Consume the input span only now that the stretcher has read it
+        if (inPlaceIn) {
+            inputRing_.discard(inChunk);
+        }
+        
         // Push to output ring
-        outputRing_.push(tempOut_, outChunk);
+        if (inPlaceOut) {
+            outputRing_.commitWrite(outChunk);
+        } else {
+            outputRing_.push(tempOut_, outChunk);
+        }
         
         // If we got no input and no more output available, break
         if (actualInChunk == 0) {
@@ -196,39 +266,116 @@ int SignalsmithStretchWrapper::process(const float* const* in, int inFrames,
     int popped = outputRing_.pop(out, outFrames);
     
     // Track discontinuities and peak for debug metrics
-    if (popped > 0) {
-        float blockMaxDelta = 0.0f;
-        float blockPeak = 0.0f;
-        float lastSample[2] = {0.0f, 0.0f};
-        
+    updateOutputMetrics(out, popped);
+    
+    // Update priming state
+    if (!primed_ && outputRing_.availableToRead() >= outputLatency_) {
+        primed_ = true;
+    }
+    
+    return popped;
+}
+
+int SignalsmithStretchWrapper::processPull(WarpSampleView& view, float* const* out, int outFrames) {
+    if (!prepared_ || out == nullptr || outFrames <= 0) {
+        return 0;
+    }
+    
+    warpPeak.store(0.0f, std::memory_order_relaxed);
+    warpMaxDelta.store(0.0f, std::memory_order_relaxed);
+    pullMode_ = true;
+    
+    float* outPtrs[2] = {out[0], (channels_ > 1) ? out[1] : out[0]};
+    
+    if (!view.isValid() || view.sampleRate <= 0.0) {
         for (int ch = 0; ch < channels_; ++ch) {
-            for (int f = 0; f < popped; ++f) {
-                float sample = out[ch][f];
-                float absSample = std::abs(sample);
-                if (absSample > blockPeak) {
-                    blockPeak = absSample;
-                }
-                
-                if (f > 0) {
-                    float delta = std::abs(sample - lastSample[ch]);
-                    if (delta > blockMaxDelta) {
-                        blockMaxDelta = delta;
-                    }
-                }
-                lastSample[ch] = sample;
+            std::fill(outPtrs[ch], outPtrs[ch] + outFrames, 0.0f);
+        }
+        inputStarveCount.fetch_add(1, std::memory_order_relaxed);
+        return outFrames;
+    }
+    
+    // The stretcher treats input frames as host-rate audio, so a sample recorded at
+    // another rate is read faster/slower and pitched back by the same ratio
+    const double rateRatio = view.sampleRate / sampleRate_;
+    applyTranspose(pitchSemitones_ + static_cast<float>(12.0 * std::log2(rateRatio)));
+    
+    // Input consumed this block; the fractional part stays in view.position
+    const double target = view.position + static_cast<double>(outFrames) * rateRatio / timeRatio_;
+    const int base = static_cast<int>(std::floor(view.position));
+    const int inFrames = std::max(0, static_cast<int>(std::floor(target)) - base);
+    
+    // Time ratio is inferred from inFrames/outFrames; input is read in place
+    impl->stretch.process(ViewInputs{ &view, base }, inFrames, outPtrs, outFrames);
+    
+    view.position = target;
+    view.wrapPosition();
+    
+    for (int ch = 0; ch < channels_; ++ch) {
+        for (int f = 0; f < outFrames; ++f) {
+            if (!std::isfinite(outPtrs[ch][f])) {
+                outPtrs[ch][f] = 0.0f;
             }
         }
-        
-        warpMaxDelta.store(blockMaxDelta, std::memory_order_relaxed);
-        warpPeak.store(blockPeak, std::memory_order_relaxed);
     }
     
-    // Update priming state
-    if (!primed_ && outputRing_.availableToRead() >= outputLatency_) {
+    updateOutputMetrics(out, outFrames);
+    
+    pullFramesProduced_ = (pullFramesProduced_ > INT_MAX - outFrames) ? INT_MAX : pullFramesProduced_ + outFrames;
+    if (!primed_ && pullFramesProduced_ >= outputLatency_) {
         primed_ = true;
     }
     
-    return popped;
+    return outFrames;
+}
+
+int SignalsmithStretchWrapper::prerollPull(WarpSampleView& view) {
+    if (!prepared_ || !view.isValid() || view.sampleRate <= 0.0) {
+        return 0;
+    }
+    
+    pullMode_ = true;
+    const double rateRatio = view.sampleRate / sampleRate_;
+    applyTranspose(pitchSemitones_ + static_cast<float>(12.0 * std::log2(rateRatio)));
+    
+    // seek() only fills the analysis input - no output is produced, so this is cheap
+    const int base = static_cast<int>(std::floor(view.position));
+    impl->stretch.seek(ViewInputs{ &view, base }, inputLatency_, rateRatio / timeRatio_);
+    
+    view.position += static_cast<double>(inputLatency_);
+    view.wrapPosition();
+    return inputLatency_;
+}
+
+void SignalsmithStretchWrapper::updateOutputMetrics(float* const* out, int frames) {
+    if (frames <= 0) {
+        return;
+    }
+    
+    float blockMaxDelta = 0.0f;
+    float blockPeak = 0.0f;
+    float lastSample[2] = {0.0f, 0.0f};
+    
+    for (int ch = 0; ch < channels_; ++ch) {
+        for (int f = 0; f < frames; ++f) {
+            float sample = out[ch][f];
+            float absSample = std::abs(sample);
+            if (absSample > blockPeak) {
+                blockPeak = absSample;
+            }
+            
+            if (f > 0) {
+                float delta = std::abs(sample - lastSample[ch]);
+                if (delta > blockMaxDelta) {
+                    blockMaxDelta = delta;
+                }
+            }
+            lastSample[ch] = sample;
+        }
+    }
+    
+    warpMaxDelta.store(blockMaxDelta, std::memory_order_relaxed);
+    warpPeak.store(blockPeak, std::memory_order_relaxed);
 }
 
 int SignalsmithStretchWrapper::flush(float* const* out, int outFrames) {
@@ -303,16 +450,17 @@ bool SignalsmithStretchWrapper::isPrepared() const {
 }
 
 int SignalsmithStretchWrapper::getOutputRingFill() const {
-    return outputRing_.availableToRead();
+    return pullMode_ ? pullFramesProduced_ : outputRing_.availableToRead();
 }
 
 void SignalsmithStretchWrapper::allocateBuffers() {
     deallocateBuffers();
     
-    // Allocate ring buffers (enough for 4x max block size)
+    // Allocate ring buffers (enough for 4x max block size), mirrored so that
+    // process() can hand the stretcher ring spans instead of copying chunks
     int ringCapacity = maxBlockFrames_ * 4;
-    inputRing_.allocate(channels_, ringCapacity);
-    outputRing_.allocate(channels_, ringCapacity);
+    inputRing_.allocate(channels_, ringCapacity, true);
+    outputRing_.allocate(channels_, ringCapacity, true);
     
     // Allocate temporary buffers for processing chunks
     tempInMaxFrames_ = chunkOutFrames_ * 4; // Enough for time ratio up to 4x
@@ -11,6 +11,9 @@ namespace Core {
 /**
  * Wrapper for Signalsmith Stretch with proper buffering and latency handling
  * Portable C++ - no JUCE dependencies
+ *
+ * process() buffers copied input/output through ring buffers in fixed chunks;
+ * processPull() reads a WarpSampleView in place and writes straight to the caller
  */
 class SignalsmithStretchWrapper : public IWarpProcessor {
 public:
@@ -24,6 +27,8 @@ public:
     void setPitchSemitones(float semitones) override;
     int process(const float* const* in, int inFrames,
                 float* const* out, int outFrames) override;
+    int processPull(WarpSampleView& view, float* const* out, int outFrames) override;
+    int prerollPull(WarpSampleView& view) override;
     int getLatencyFrames() const override;
     bool isPrepared() const override;
     int flush(float* const* out, int outFrames) override;
@@ -36,6 +41,9 @@ public:
     int getOutputUnderrunCount() const { return outputUnderrunCount.load(std::memory_order_acquire); }
     float getGainMatch() const { return gainMatch.load(std::memory_order_acquire); }
     float getLimiterGain() const { return limiterGain.load(std::memory_order_acquire); }
+    
+    // signalsmith-linear backend compiled in (OP1_STRETCH_BACKEND): "accelerate", "ipp" or "scalar"
+    static const char* getBackendName();
 
 private:
     // PIMPL to hide Signalsmith implementation
@@ -52,6 +60,9 @@ private:
     int inputLatency_;
     int outputLatency_;
     bool primed_;
+    float appliedTranspose_;   // Transpose currently set on the stretcher (pitch + rate compensation)
+    bool pullMode_;            // Last process call was processPull (rings unused)
+    int pullFramesProduced_;   // Frames produced by processPull since reset (saturating)
     
     // Ring buffers
     AudioRingBuffer inputRing_;
@@ -74,6 +85,8 @@ private:
     
     void allocateBuffers();
     void deallocateBuffers();
+    void applyTranspose(float semitones);
+    void updateOutputMetrics(float* const* out, int frames);
 };
 
 } // namespace Core
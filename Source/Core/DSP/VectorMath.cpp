@@ -0,0 +1,213 @@
+#include "VectorMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CORE_VECTORMATH_SSE2 1
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define CORE_VECTORMATH_NEON 1
+#endif
+
+namespace Core {
+namespace DSP {
+namespace VectorMath {
+
+#if defined(CORE_VECTORMATH_SSE2)
+
+namespace {
+
+inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 atan2x4(__m128 y, __m128 x) {
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    __m128 ax = _mm_andnot_ps(signBit, x);
+    __m128 ay = _mm_andnot_ps(signBit, y);
+    __m128 mx = _mm_max_ps(ax, ay);
+    __m128 mn = _mm_min_ps(ax, ay);
+    __m128 a = _mm_div_ps(mn, _mm_add_ps(mx, _mm_set1_ps(1.0e-30f)));
+    __m128 s = _mm_mul_ps(a, a);
+    __m128 r = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(-0.01172120f)), _mm_set1_ps(0.05265332f));
+    r = _mm_add_ps(_mm_mul_ps(s, r), _mm_set1_ps(-0.11643287f));
+    r = _mm_add_ps(_mm_mul_ps(s, r), _mm_set1_ps(0.19354346f));
+    r = _mm_add_ps(_mm_mul_ps(s, r), _mm_set1_ps(-0.33262347f));
+    r = _mm_add_ps(_mm_mul_ps(s, r), _mm_set1_ps(0.99997726f));
+    r = _mm_mul_ps(a, r);
+    r = select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(HALF_PI), r), r);
+    r = select(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(PI), r), r);
+    return _mm_or_ps(r, _mm_and_ps(y, signBit));  // r >= 0 here, so copy y's sign
+}
+
+inline void sincos4(__m128 x, __m128& sinOut, __m128& cosOut) {
+    __m128i q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(2.0f / PI)));  // Round to nearest
+    __m128 qf = _mm_cvtepi32_ps(q);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(qf, _mm_set1_ps(1.5707963705062866f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(qf, _mm_set1_ps(-4.371139000186243e-08f)));
+    __m128 r2 = _mm_mul_ps(r, r);
+    
+    __m128 sp = _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(-1.9515295891e-4f)), _mm_set1_ps(8.3321608736e-3f));
+    sp = _mm_add_ps(_mm_mul_ps(r2, sp), _mm_set1_ps(-1.6666654611e-1f));
+    __m128 s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), sp));
+    
+    __m128 cp = _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(2.443315711809948e-5f)), _mm_set1_ps(-1.388731625493765e-3f));
+    cp = _mm_add_ps(_mm_mul_ps(r2, cp), _mm_set1_ps(4.166664568298827e-2f));
+    __m128 c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)),
+                          _mm_mul_ps(_mm_mul_ps(r2, r2), cp));
+    
+    // Odd quadrants swap sin/cos; bit 1 of q (of q + 1 for cos) flips the sign
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+    __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+    sinOut = _mm_xor_ps(select(swap, c, s), sinSign);
+    cosOut = _mm_xor_ps(select(swap, s, c), cosSign);
+}
+
+} // namespace
+
+void cartesianToPolar(const float* spectrum, float* magnitude, float* phase, int numBins) {
+    int k = 0;
+    for (; k + 4 <= numBins; k += 4) {
+        // De-interleave re/im of four bins
+        __m128 a = _mm_loadu_ps(spectrum + k * 2);
+        __m128 b = _mm_loadu_ps(spectrum + k * 2 + 4);
+        __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(magnitude + k, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im))));
+        _mm_storeu_ps(phase + k, atan2x4(im, re));
+    }
+    for (; k < numBins; ++k) {
+        float re = spectrum[k * 2];
+        float im = spectrum[k * 2 + 1];
+        magnitude[k] = std::sqrt(re * re + im * im);
+        phase[k] = fastAtan2(im, re);
+    }
+}
+
+void polarToCartesian(const float* magnitude, const float* phase, float* spectrum, int numBins) {
+    int k = 0;
+    for (; k + 4 <= numBins; k += 4) {
+        __m128 s, c;
+        sincos4(_mm_loadu_ps(phase + k), s, c);
+        __m128 m = _mm_loadu_ps(magnitude + k);
+        __m128 re = _mm_mul_ps(m, c);
+        __m128 im = _mm_mul_ps(m, s);
+        _mm_storeu_ps(spectrum + k * 2, _mm_unpacklo_ps(re, im));
+        _mm_storeu_ps(spectrum + k * 2 + 4, _mm_unpackhi_ps(re, im));
+    }
+    for (; k < numBins; ++k) {
+        float s, c;
+        fastSinCos(phase[k], s, c);
+        spectrum[k * 2] = magnitude[k] * c;
+        spectrum[k * 2 + 1] = magnitude[k] * s;
+    }
+}
+
+#elif defined(CORE_VECTORMATH_NEON)
+
+namespace {
+
+inline float32x4_t atan2x4(float32x4_t y, float32x4_t x) {
+    float32x4_t ax = vabsq_f32(x);
+    float32x4_t ay = vabsq_f32(y);
+    float32x4_t mx = vmaxq_f32(ax, ay);
+    float32x4_t mn = vminq_f32(ax, ay);
+    float32x4_t a = vdivq_f32(mn, vaddq_f32(mx, vdupq_n_f32(1.0e-30f)));
+    float32x4_t s = vmulq_f32(a, a);
+    float32x4_t r = vfmaq_f32(vdupq_n_f32(0.05265332f), s, vdupq_n_f32(-0.01172120f));
+    r = vfmaq_f32(vdupq_n_f32(-0.11643287f), s, r);
+    r = vfmaq_f32(vdupq_n_f32(0.19354346f), s, r);
+    r = vfmaq_f32(vdupq_n_f32(-0.33262347f), s, r);
+    r = vfmaq_f32(vdupq_n_f32(0.99997726f), s, r);
+    r = vmulq_f32(a, r);
+    r = vbslq_f32(vcgtq_f32(ay, ax), vsubq_f32(vdupq_n_f32(HALF_PI), r), r);
+    r = vbslq_f32(vcltq_f32(x, vdupq_n_f32(0.0f)), vsubq_f32(vdupq_n_f32(PI), r), r);
+    uint32x4_t signBit = vandq_u32(vreinterpretq_u32_f32(y), vdupq_n_u32(0x80000000u));
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(r), signBit));
+}
+
+inline void sincos4(float32x4_t x, float32x4_t& sinOut, float32x4_t& cosOut) {
+    int32x4_t q = vcvtnq_s32_f32(vmulq_f32(x, vdupq_n_f32(2.0f / PI)));
+    float32x4_t qf = vcvtq_f32_s32(q);
+    float32x4_t r = vfmsq_f32(x, qf, vdupq_n_f32(1.5707963705062866f));
+    r = vfmsq_f32(r, qf, vdupq_n_f32(-4.371139000186243e-08f));
+    float32x4_t r2 = vmulq_f32(r, r);
+    
+    float32x4_t sp = vfmaq_f32(vdupq_n_f32(8.3321608736e-3f), r2, vdupq_n_f32(-1.9515295891e-4f));
+    sp = vfmaq_f32(vdupq_n_f32(-1.6666654611e-1f), r2, sp);
+    float32x4_t s = vfmaq_f32(r, vmulq_f32(r, r2), sp);
+    
+    float32x4_t cp = vfmaq_f32(vdupq_n_f32(-1.388731625493765e-3f), r2, vdupq_n_f32(2.443315711809948e-5f));
+    cp = vfmaq_f32(vdupq_n_f32(4.166664568298827e-2f), r2, cp);
+    float32x4_t c = vfmaq_f32(vfmsq_f32(vdupq_n_f32(1.0f), vdupq_n_f32(0.5f), r2), vmulq_f32(r2, r2), cp);
+    
+    uint32x4_t swap = vtstq_s32(q, vdupq_n_s32(1));
+    uint32x4_t sinSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(q, vdupq_n_s32(2))), 30);
+    uint32x4_t cosSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(vaddq_s32(q, vdupq_n_s32(1)), vdupq_n_s32(2))), 30);
+    sinOut = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, c, s)), sinSign));
+    cosOut = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, s, c)), cosSign));
+}
+
+} // namespace
+
+void cartesianToPolar(const float* spectrum, float* magnitude, float* phase, int numBins) {
+    int k = 0;
+    for (; k + 4 <= numBins; k += 4) {
+        float32x4x2_t reim = vld2q_f32(spectrum + k * 2);  // De-interleaving load
+        float32x4_t re = reim.val[0];
+        float32x4_t im = reim.val[1];
+        vst1q_f32(magnitude + k, vsqrtq_f32(vfmaq_f32(vmulq_f32(re, re), im, im)));
+        vst1q_f32(phase + k, atan2x4(im, re));
+    }
+    for (; k < numBins; ++k) {
+        float re = spectrum[k * 2];
+        float im = spectrum[k * 2 + 1];
+        magnitude[k] = std::sqrt(re * re + im * im);
+        phase[k] = fastAtan2(im, re);
+    }
+}
+
+void polarToCartesian(const float* magnitude, const float* phase, float* spectrum, int numBins) {
+    int k = 0;
+    for (; k + 4 <= numBins; k += 4) {
+        float32x4_t s, c;
+        sincos4(vld1q_f32(phase + k), s, c);
+        float32x4_t m = vld1q_f32(magnitude + k);
+        float32x4x2_t reim;
+        reim.val[0] = vmulq_f32(m, c);
+        reim.val[1] = vmulq_f32(m, s);
+        vst2q_f32(spectrum + k * 2, reim);  // Interleaving store
+    }
+    for (; k < numBins; ++k) {
+        float s, c;
+        fastSinCos(phase[k], s, c);
+        spectrum[k * 2] = magnitude[k] * c;
+        spectrum[k * 2 + 1] = magnitude[k] * s;
+    }
+}
+
+#else
+
+void cartesianToPolar(const float* spectrum, float* magnitude, float* phase, int numBins) {
+    for (int k = 0; k < numBins; ++k) {
+        float re = spectrum[k * 2];
+        float im = spectrum[k * 2 + 1];
+        magnitude[k] = std::sqrt(re * re + im * im);
+        phase[k] = fastAtan2(im, re);
+    }
+}
+
+void polarToCartesian(const float* magnitude, const float* phase, float* spectrum, int numBins) {
+    for (int k = 0; k < numBins; ++k) {
+        float s, c;
+        fastSinCos(phase[k], s, c);
+        spectrum[k * 2] = magnitude[k] * c;
+        spectrum[k * 2 + 1] = magnitude[k] * s;
+    }
+}
+
+#endif
+
+} // namespace VectorMath
+} // namespace DSP
+} // namespace Core
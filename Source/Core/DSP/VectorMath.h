@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cmath>
+
+namespace Core {
+namespace DSP {
+
+/**
+ * Approximate polar/cartesian kernels for spectral processing
+ * Portable C++ - no JUCE dependencies
+ *
+ * Four bins per instruction with SSE2 (x86) or NEON (AArch64); other targets use the
+ * scalar versions below, which evaluate the same polynomials so results match
+ * across platforms to rounding.
+ * atan2: max error ~2e-6 rad. sin/cos: max error ~4e-6 for |x| < 100 (wrap phases first)
+ */
+namespace VectorMath {
+
+constexpr float PI = 3.14159265358979323846f;
+constexpr float TWO_PI = 6.28318530717958647692f;
+constexpr float HALF_PI = 1.57079632679489661923f;
+
+/**
+ * Approximate atan2(y, x) in [-pi, pi]; atan2(0, 0) = 0
+ */
+inline float fastAtan2(float y, float x) {
+    float ax = std::fabs(x);
+    float ay = std::fabs(y);
+    float mx = std::fmax(ax, ay);
+    float mn = std::fmin(ax, ay);
+    float a = mn / (mx + 1.0e-30f);
+    float s = a * a;
+    float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+    if (ay > ax) r = HALF_PI - r;
+    if (x < 0.0f) r = PI - r;
+    if (y < 0.0f) r = -r;
+    return r;
+}
+
+/**
+ * Approximate sin and cos of x (quadrant reduction + minimax polynomials)
+ */
+inline void fastSinCos(float x, float& sinOut, float& cosOut) {
+    float q = std::nearbyint(x * (2.0f / PI));
+    float r = (x - q * 1.5707963705062866f) - q * -4.371139000186243e-08f;
+    float r2 = r * r;
+    float s = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+    float c = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+    int quadrant = static_cast<int>(q) & 3;
+    float sv = (quadrant & 1) ? c : s;
+    float cv = (quadrant & 1) ? s : c;
+    sinOut = (quadrant & 2) ? -sv : sv;
+    cosOut = ((quadrant + 1) & 2) ? -cv : cv;
+}
+
+/**
+ * Wrap a phase to [-pi, pi]
+ */
+inline float wrapPhase(float phase) {
+    return phase - TWO_PI * std::nearbyint(phase * (1.0f / TWO_PI));
+}
+
+/**
+ * Interleaved complex spectrum [re0, im0, re1, im1, ...] -> magnitude and phase
+ */
+void cartesianToPolar(const float* spectrum, float* magnitude, float* phase, int numBins);
+
+/**
+ * Magnitude and phase -> interleaved complex spectrum
+ */
+void polarToCartesian(const float* magnitude, const float* phase, float* spectrum, int numBins);
+
+} // namespace VectorMath
+
+} // namespace DSP
+} // namespace Core
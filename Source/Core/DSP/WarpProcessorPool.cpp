@@ -0,0 +1,78 @@
+#include "WarpProcessorPool.h"
+#include "SignalsmithStretchWrapper.h"
+#include <algorithm>
+
+namespace Core {
+
+WarpProcessorPool::WarpProcessorPool()
+    : sampleRate(44100.0)
+    , numInUse(0)
+{
+}
+
+WarpProcessorPool::~WarpProcessorPool() = default;
+
+void WarpProcessorPool::prepare(double newSampleRate, int maxBlockSize, int capacity) {
+    sampleRate = newSampleRate;
+    maxBlockSize = std::max(1, maxBlockSize);
+    capacity = std::max(0, capacity);
+    
+    leases.clear();
+    leases.resize(static_cast<size_t>(capacity));
+    bufferStorage.assign(static_cast<size_t>(capacity) * 4 * static_cast<size_t>(maxBlockSize), 0.0f);
+    
+    for (int i = 0; i < capacity; ++i) {
+        Lease& lease = leases[static_cast<size_t>(i)];
+        lease.processor = std::make_unique<SignalsmithStretchWrapper>();
+        lease.processor->prepare(sampleRate, 2, maxBlockSize);
+        float* base = bufferStorage.data() + static_cast<size_t>(i) * 4 * static_cast<size_t>(maxBlockSize);
+        lease.input[0] = base;
+        lease.input[1] = base + maxBlockSize;
+        lease.output[0] = base + 2 * maxBlockSize;
+        lease.output[1] = base + 3 * maxBlockSize;
+        lease.bufferSize = maxBlockSize;
+    }
+    numInUse = 0;
+}
+
+WarpProcessorPool::Lease* WarpProcessorPool::acquire() {
+    // Only processors maintain() has already reset are handed out; resetting here would put
+    // the full reset cost on the note-on
+    for (auto& lease : leases) {
+        if (!lease.inUse && !lease.needsReset) {
+            lease.inUse = true;
+            ++numInUse;
+            return &lease;
+        }
+    }
+    exhaustedCount.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void WarpProcessorPool::release(Lease* lease) {
+    if (lease == nullptr || !lease->inUse) {
+        return;
+    }
+    lease->inUse = false;
+    lease->needsReset = true;
+    --numInUse;
+}
+
+void WarpProcessorPool::maintain() {
+    for (auto& lease : leases) {
+        if (!lease.inUse && lease.needsReset) {
+            lease.processor->reset();
+            lease.needsReset = false;
+            return;
+        }
+    }
+}
+
+int WarpProcessorPool::getLatencyFrames() const {
+    if (leases.empty() || !leases.front().processor) {
+        return 0;
+    }
+    return leases.front().processor->getLatencyFrames();
+}
+
+} // namespace Core
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "IWarpProcessor.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Core {
+
+/**
+ * Preallocated pool of time-stretch processors shared by all voices of an engine
+ * Portable C++ - no JUCE dependencies
+ *
+ * prepare() builds every processor and its planar I/O buffers up front, so warped
+ * note-ons never allocate. Voices check a processor out on note-on and hand it back
+ * once their tail has finished; memory scales with the number of concurrently
+ * warped voices rather than the size of the voice pool.
+ * Returned processors are reset lazily (one per maintain() call) so the reset cost
+ * is spread over blocks instead of landing on the next note-on; until then they
+ * count as unavailable.
+ * acquire/release/maintain are audio-thread only.
+ */
+class WarpProcessorPool {
+public:
+    // One checked-out processor with its stereo planar buffers (bufferSize frames each)
+    struct Lease {
+        std::unique_ptr<IWarpProcessor> processor;
+        float* input[2];
+        float* output[2];
+        int bufferSize;
+        bool inUse;
+        bool needsReset;
+        
+        Lease() : input{ nullptr, nullptr }, output{ nullptr, nullptr }, bufferSize(0), inUse(false), needsReset(false) {}
+    };
+    
+    WarpProcessorPool();
+    ~WarpProcessorPool();
+    
+    WarpProcessorPool(const WarpProcessorPool&) = delete;
+    WarpProcessorPool& operator=(const WarpProcessorPool&) = delete;
+    
+    /**
+     * Allocate and prepare capacity processors. Not real-time safe
+     * Invalidates every outstanding lease - holders must drop them first
+     */
+    void prepare(double sampleRate, int maxBlockSize, int capacity);
+    
+    /**
+     * Check out a reset processor; nullptr when none is ready (audio thread)
+     */
+    Lease* acquire();
+    
+    /**
+     * Return a processor; it is reset before it is handed out again (audio thread)
+     */
+    void release(Lease* lease);
+    
+    /**
+     * Reset at most one returned processor (audio thread, once per block)
+     */
+    void maintain();
+    
+    int getCapacity() const { return static_cast<int>(leases.size()); }
+    int getNumInUse() const { return numInUse; }
+    double getSampleRate() const { return sampleRate; }
+    
+    /**
+     * Output latency of the pooled processors (all are prepared identically; 0 when empty)
+     */
+    int getLatencyFrames() const;
+    
+    /**
+     * Number of acquire() calls that found no reset processor (thread-safe)
+     */
+    uint64_t getExhaustedCount() const { return exhaustedCount.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<Lease> leases;
+    std::vector<float> bufferStorage;  // 4 planar buffers per lease
+    double sampleRate;
+    int numInUse;
+    std::atomic<uint64_t> exhaustedCount{0};
+};
+
+} // namespace Core
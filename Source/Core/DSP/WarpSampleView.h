@@ -0,0 +1,54 @@
+#pragma once
+
+namespace Core {
+
+/**
+ * Read-only view of immutable sample memory for pull-mode warp input
+ * Portable C++ - no JUCE dependencies
+ *
+ * A warp processor reads frames straight out of the sample at the view's position
+ * instead of from a block the voice copied for it. Reads wrap inside
+ * [loopStart, loopEnd) while looping and return silence outside
+ * [startFrame, endFrame), so the processor never needs to know about loop points
+ * or the end of the sample. The processor advances position by the input it consumed
+ */
+struct WarpSampleView {
+    const float* channels[2] = { nullptr, nullptr };  // Same pointer twice for mono
+    int startFrame = 0;
+    int endFrame = 0;           // One past the last playable frame
+    int loopStart = 0;
+    int loopEnd = 0;
+    bool looping = false;
+    float gain = 1.0f;
+    double sampleRate = 44100.0;  // Rate of the sample memory (not the host)
+    double position = 0.0;        // Read position in frames; fraction carried between blocks
+    
+    bool isValid() const { return channels[0] != nullptr && endFrame > startFrame; }
+    
+    bool isLooping() const { return looping && loopEnd > loopStart; }
+    
+    // Fold a frame index back into the loop once it has run past loopEnd
+    int wrap(int frame) const {
+        if (isLooping() && frame >= loopEnd) {
+            frame = loopStart + (frame - loopStart) % (loopEnd - loopStart);
+        }
+        return frame;
+    }
+    
+    void wrapPosition() {
+        if (isLooping() && position >= static_cast<double>(loopEnd)) {
+            int whole = static_cast<int>(position);
+            position = static_cast<double>(wrap(whole)) + (position - static_cast<double>(whole));
+        }
+    }
+    
+    float read(int channel, int frame) const {
+        frame = wrap(frame);
+        if (frame < startFrame || frame >= endFrame) {
+            return 0.0f;
+        }
+        return channels[channel][frame] * gain;
+    }
+};
+
+} // namespace Core
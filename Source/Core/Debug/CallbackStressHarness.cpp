@@ -0,0 +1,480 @@
+#include "CallbackStressHarness.h"
+#include "../SamplerEngine.h"
+#include "../LockFreeMidiQueue.h"
+#include "../CallbackLoadMeter.h"
+#include "../RenderWorkerPool.h"
+#include "../RealtimeSanitizer.h"
+#include "../DSP/OrbitBlender.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int MAX_SLOTS = 5;
+constexpr int MAX_CALLBACK_BLOCK = 2048;
+constexpr int MAX_BLOCK_EVENTS = 256;  // Adapter-side event buffer per callback
+
+// Host buffer sizes seen in the wild: powers of two, odd sizes, and sizes above the prepared 512
+constexpr int blockSizes[] = { 16, 32, 64, 100, 128, 192, 256, 441, 480, 512, 600, 1000, 1024, 2048 };
+
+struct TimedEvent {
+    uint64_t frame;
+    MidiEvent event;
+};
+
+// Two seconds of a bright, hard-edged tone per slot (full level at frame 0) at 44.1kHz,
+// so every voice resamples and note starts and steals exercise the click suppression
+SampleDataPtr makeSlotSample(int slot) {
+    auto data = std::make_shared<SampleData>();
+    const double sourceRate = 44100.0;
+    int length = static_cast<int>(sourceRate * 2.0);
+    double freq = 110.0 * (1.0 + 0.5 * slot);
+    data->mono.resize(static_cast<size_t>(length));
+    data->right.resize(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i) {
+        double phase = freq * static_cast<double>(i) / sourceRate;
+        float saw = static_cast<float>(phase - std::floor(phase)) * 2.0f - 1.0f;
+        data->mono[i] = 0.5f * saw;
+        data->right[i] = 0.5f * saw * (1.0f - 0.1f * slot);
+    }
+    data->length = length;
+    data->sourceSampleRate = sourceRate;
+    return data;
+}
+
+// Poisson note-on groups (chords) plus periodic floods; note-offs after a random hold
+std::vector<TimedEvent> makeSchedule(const CallbackStressHarness::Scenario& scenario, uint64_t totalFrames, std::mt19937& rng) {
+    std::vector<TimedEvent> events;
+    std::uniform_int_distribution<int> noteDist(36, 96);
+    std::uniform_real_distribution<float> velocityDist(0.2f, 1.0f);
+    std::uniform_real_distribution<double> holdDist(0.5, 1.5);
+    const double framesPerMs = scenario.sampleRate / 1000.0;
+    
+    auto addNote = [&](uint64_t frame) {
+        int note = noteDist(rng);
+        uint64_t hold = static_cast<uint64_t>(scenario.noteLengthMs * holdDist(rng) * framesPerMs);
+        events.push_back({ frame, { MidiEvent::NoteOn, note, velocityDist(rng), 0 } });
+        events.push_back({ frame + std::max<uint64_t>(1, hold), { MidiEvent::NoteOff, note, 0.0f, 0 } });
+    };
+    
+    if (scenario.notesPerSecond > 0.0) {
+        std::exponential_distribution<double> gapDist(scenario.notesPerSecond);
+        std::uniform_int_distribution<int> chordDist(1, std::max(1, scenario.maxChord));
+        for (double t = gapDist(rng); t < scenario.seconds; t += gapDist(rng)) {
+            uint64_t frame = static_cast<uint64_t>(t * scenario.sampleRate);
+            for (int n = chordDist(rng); n > 0; --n) {
+                addNote(frame);
+            }
+        }
+    }
+    if (scenario.floodEverySeconds > 0.0 && scenario.floodSize > 0) {
+        for (double t = scenario.floodEverySeconds * 0.5; t < scenario.seconds; t += scenario.floodEverySeconds) {
+            uint64_t frame = static_cast<uint64_t>(t * scenario.sampleRate);
+            for (int n = 0; n < scenario.floodSize; ++n) {
+                addNote(frame);
+            }
+        }
+    }
+    
+    std::stable_sort(events.begin(), events.end(), [](const TimedEvent& a, const TimedEvent& b) {
+        return a.frame < b.frame;
+    });
+    while (!events.empty() && events.back().frame >= totalFrames) {
+        events.pop_back();
+    }
+    return events;
+}
+
+/**
+ * Everything one scenario run shares between the audio, MIDI and UI threads
+ */
+struct Rig {
+    const CallbackStressHarness::Scenario& scenario;
+    std::unique_ptr<SamplerEngine> engine;
+    std::array<SampleDataPtr, MAX_SLOTS> slotSamples;
+    int numSlots = 1;
+    
+    // Adapter emulation (audio thread only, except the queue)
+    LockFreeMidiQueue adapterQueue;
+    std::array<MidiEvent, MAX_BLOCK_EVENTS> blockEvents;
+    std::array<uint8_t, 128> orbitNoteSlots {};
+    DSP::OrbitBlender orbitBlender;
+    std::vector<std::vector<float>> weightRamps;
+    
+    std::vector<TimedEvent> schedule;
+    size_t nextEvent = 0;
+    std::atomic<uint64_t> framesRendered { 0 };
+    std::atomic<bool> running { true };
+    std::atomic<int> adapterDropped { 0 };
+    std::atomic<uint64_t> noteOnsSent { 0 };
+    
+    explicit Rig(const CallbackStressHarness::Scenario& s) : scenario(s) {}
+    
+    // MIDI thread (or the audio thread between callbacks when unpaced)
+    void deliverUpTo(uint64_t frame) {
+        while (nextEvent < schedule.size() && schedule[nextEvent].frame < frame) {
+            const MidiEvent& event = schedule[nextEvent++].event;
+            bool isNoteOn = (event.type == MidiEvent::NoteOn);
+            if (isNoteOn) {
+                noteOnsSent.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (scenario.mode == CallbackStressHarness::Mode::Direct) {
+                engine->pushMidiEvent(event);  // Engine counts its own queue drops
+            } else if (!adapterQueue.push(event) && isNoteOn) {
+                adapterDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool triggerSlot(const MidiEvent& event, int note, int slot, bool loop, int blendGroup) {
+        // Every note of a slot shares the slot's SampleData, as in the adapter
+        const SampleDataPtr& sample = slotSamples[slot];
+        return engine->triggerNoteOnWithSample(note, event.velocity, sample, 0.0f, 0, sample->length, 1.0f,
+                                               5.0f, 100.0f, 0.8f, 150.0f, loop, 0, sample->length,
+                                               slot, blendGroup);
+    }
+    
+    void dispatchStacked(const MidiEvent& event) {
+        if (event.type == MidiEvent::NoteOn) {
+            for (int slot = 0; slot < numSlots; ++slot) {
+                triggerSlot(event, (event.note + slot) % 128, slot, false, -1);
+            }
+        } else {
+            MidiEvent noteOffs[MAX_SLOTS];
+            for (int slot = 0; slot < numSlots; ++slot) {
+                noteOffs[slot] = event;
+                noteOffs[slot].note = (event.note + slot) % 128;
+            }
+            engine->handleMidi(noteOffs, numSlots);
+        }
+    }
+    
+    void dispatchOrbit(const MidiEvent& event) {
+        uint8_t& slots = orbitNoteSlots[event.note & 0x7F];
+        if (event.type == MidiEvent::NoteOn) {
+            for (int slot = 0; slot < numSlots; ++slot) {
+                if (triggerSlot(event, event.note, slot, true, slot)) {
+                    slots |= static_cast<uint8_t>(1 << slot);
+                }
+            }
+        } else {
+            MidiEvent noteOffs[4];
+            int count = 0;
+            for (int slot = 0; slot < 4; ++slot) {
+                if (slots & (1 << slot)) {
+                    noteOffs[count++] = event;
+                }
+            }
+            slots = 0;
+            if (count > 0) {
+                engine->handleMidi(noteOffs, count);
+            }
+        }
+    }
+    
+    // The simulated host callback
+    void callback(float** output, int numSamples) {
+        using Mode = CallbackStressHarness::Mode;
+        if (scenario.mode == Mode::Direct) {
+            engine->process(output, 2, numSamples);
+            return;
+        }
+        
+        // Collect this block's events first, as the adapter converts the host MIDI buffer
+        int numEvents = 0;
+        MidiEvent event;
+        while (numEvents < MAX_BLOCK_EVENTS && adapterQueue.pop(event)) {
+            blockEvents[static_cast<size_t>(numEvents++)] = event;
+        }
+        for (int i = 0; i < numEvents; ++i) {
+            if (scenario.mode == Mode::Stacked) {
+                dispatchStacked(blockEvents[static_cast<size_t>(i)]);
+            } else {
+                dispatchOrbit(blockEvents[static_cast<size_t>(i)]);
+            }
+        }
+        
+        if (scenario.mode == Mode::Stacked) {
+            engine->process(output, 2, numSamples);
+            return;
+        }
+        
+        // Orbit: weight ramps are sized for the prepared block, so longer callbacks render in chunks
+        int rampCapacity = static_cast<int>(weightRamps[0].size());
+        for (int offset = 0; offset < numSamples; ) {
+            int chunk = std::min(rampCapacity, numSamples - offset);
+            float* ramps[4];
+            const float* weights[4];
+            for (int i = 0; i < 4; ++i) {
+                ramps[i] = weightRamps[static_cast<size_t>(i)].data();
+                weights[i] = ramps[i];
+            }
+            orbitBlender.renderWeightRamps(static_cast<float>(chunk / scenario.sampleRate), chunk, ramps);
+            engine->setBlendWeights(weights);
+            float* chunkOutput[2] = { output[0] + offset, output[1] + offset };
+            engine->process(chunkOutput, 2, chunk);
+            offset += chunk;
+        }
+    }
+};
+
+// UI thread: sweep the parameters the editor's encoders drive, every millisecond
+void sweepParameters(Rig& rig) {
+    SamplerEngine& engine = *rig.engine;
+    double t = 0.0;
+    while (rig.running.load(std::memory_order_acquire)) {
+        float slow = static_cast<float>(0.5 + 0.5 * std::sin(t * 1.3));
+        float fast = static_cast<float>(0.5 + 0.5 * std::sin(t * 9.7));
+        engine.setLPFilterCutoff(200.0f * std::pow(60.0f, slow));  // 200Hz..12kHz
+        engine.setLPFilterResonance(3.5f * fast);
+        engine.setLPFilterDrive(18.0f * slow);
+        engine.setRepitch(12.0f * (2.0f * fast - 1.0f));
+        engine.setADSR(1.0f + 50.0f * fast, 20.0f + 200.0f * slow, slow, 10.0f + 300.0f * fast);
+        t += 0.001;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// MIDI thread (paced runs): deliver events as the rendered position passes them
+void deliverMidi(Rig& rig) {
+    while (rig.running.load(std::memory_order_acquire) && rig.nextEvent < rig.schedule.size()) {
+        rig.deliverUpTo(rig.framesRendered.load(std::memory_order_acquire) + 1);
+        std::this_thread::sleep_for(std::chrono::microseconds(250));
+    }
+}
+
+} // namespace
+
+CallbackStressHarness::Report CallbackStressHarness::runScenario(const Scenario& scenario) {
+    Rig rig(scenario);
+    std::mt19937 rng(scenario.seed);
+    const uint64_t totalFrames = static_cast<uint64_t>(scenario.seconds * scenario.sampleRate);
+    const int maxSlots = (scenario.mode == Mode::Orbit) ? 4 : MAX_SLOTS;
+    rig.numSlots = std::max(1, std::min(scenario.slots, maxSlots));
+    for (int s = 0; s < MAX_SLOTS; ++s) {
+        rig.slotSamples[static_cast<size_t>(s)] = makeSlotSample(s);
+    }
+    rig.schedule = makeSchedule(scenario, totalFrames, rng);
+    
+    RenderWorkerPool pool;
+    rig.engine = std::make_unique<SamplerEngine>();
+    SamplerEngine& engine = *rig.engine;
+    if (scenario.renderWorkers > 0) {
+        pool.start(scenario.renderWorkers);
+        engine.setRenderPool(&pool);
+    }
+    engine.setWarpEnabled(scenario.warp);
+    engine.prepare(scenario.sampleRate, scenario.preparedBlockSize, 2);
+    engine.setSampleData(rig.slotSamples[0]);
+    engine.setADSR(5.0f, 100.0f, 0.8f, 150.0f);
+    
+    rig.weightRamps.assign(4, std::vector<float>(static_cast<size_t>(scenario.preparedBlockSize), 0.0f));
+    rig.orbitBlender.setRateHz(scenario.orbitRateHz);
+    rig.orbitBlender.setActiveSlotsMask(static_cast<uint8_t>((1 << rig.numSlots) - 1));
+    
+    RealtimeSanitizer::reset();
+    
+    // Harness-side meter covers the whole callback, adapter dispatch included
+    CallbackLoadMeter meter;
+    meter.prepare(scenario.sampleRate);
+    
+    std::vector<float> left(MAX_CALLBACK_BLOCK), right(MAX_CALLBACK_BLOCK);
+    float* output[2] = { left.data(), right.data() };
+    std::array<PopEvent, PopEventRingBuffer::BUFFER_SIZE> pops;
+    
+    Report report;
+    report.minBlock = MAX_CALLBACK_BLOCK;
+    float lastL = 0.0f;
+    float lastR = 0.0f;
+    
+    std::thread uiThread;
+    std::thread midiThread;
+    if (scenario.parameterSweeps) {
+        uiThread = std::thread(sweepParameters, std::ref(rig));
+    }
+    if (scenario.paced) {
+        midiThread = std::thread(deliverMidi, std::ref(rig));
+    }
+    
+    std::uniform_int_distribution<int> blockDist(0, static_cast<int>(sizeof(blockSizes) / sizeof(blockSizes[0])) - 1);
+    std::uniform_real_distribution<double> jitterDist(0.0, std::max(0.0, scenario.jitterMs));
+    Clock::time_point periodStart = Clock::now();
+    
+    for (uint64_t frame = 0; frame < totalFrames; ) {
+        int numSamples = blockSizes[blockDist(rng)];
+        auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(numSamples / scenario.sampleRate));
+        
+        if (scenario.paced) {
+            // Device clock: the callback is due at the start of its period, woken up late by jitter
+            auto wake = periodStart + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(jitterDist(rng)));
+            std::this_thread::sleep_until(wake);
+        } else {
+            rig.deliverUpTo(frame + static_cast<uint64_t>(numSamples));
+        }
+        
+        std::fill(left.begin(), left.begin() + numSamples, 0.0f);
+        std::fill(right.begin(), right.begin() + numSamples, 0.0f);
+        uint64_t start = meter.beginBlock();
+        {
+            OP1_REALTIME_SCOPE(realtimeScope);
+            rig.callback(output, numSamples);
+        }
+        meter.endBlock(start, numSamples);
+        
+        if (scenario.paced) {
+            periodStart += period;
+            Clock::time_point now = Clock::now();
+            if (now > periodStart) {
+                ++report.lateCallbacks;
+                if (now - periodStart > period) {
+                    periodStart = now;  // Device would have dropped the buffer; resync like an xrun
+                }
+            }
+        }
+        
+        frame += static_cast<uint64_t>(numSamples);
+        rig.framesRendered.store(frame, std::memory_order_release);
+        ++report.blocks;
+        report.minBlock = std::min(report.minBlock, numSamples);
+        report.maxBlock = std::max(report.maxBlock, numSamples);
+        
+        for (int i = 0; i < numSamples; ++i) {
+            float l = left[static_cast<size_t>(i)];
+            float r = right[static_cast<size_t>(i)];
+            if (!std::isfinite(l) || !std::isfinite(r)) {
+                ++report.nonFiniteSamples;
+                continue;
+            }
+            report.maxOutputStep = std::max(report.maxOutputStep, std::max(std::abs(l - lastL), std::abs(r - lastR)));
+            lastL = l;
+            lastR = r;
+        }
+        int numPops = engine.getPopEvents(pops.data(), static_cast<int>(pops.size()));
+        for (int i = 0; i < numPops; ++i) {
+            report.maxPopDelta = std::max(report.maxPopDelta, pops[static_cast<size_t>(i)].mixDelta);
+        }
+        report.popEvents += numPops;
+    }
+    
+    rig.running.store(false, std::memory_order_release);
+    if (uiThread.joinable()) {
+        uiThread.join();
+    }
+    if (midiThread.joinable()) {
+        midiThread.join();
+    }
+    pool.stop();
+    
+    CallbackLoadStats stats = meter.getStats();
+    report.frames = totalFrames;
+    report.overrunBlocks = stats.overruns;
+    report.p99Load = stats.p99;
+    report.maxLoad = stats.maxLoad;
+    report.noteOnsSent = rig.noteOnsSent.load();
+    report.voicesStolen = engine.getTotalVoicesStolen();
+    report.droppedNotes = engine.getDroppedNotes() + rig.adapterDropped.load();
+    report.realtimeViolations = RealtimeSanitizer::getViolationCount();
+    return report;
+}
+
+std::vector<CallbackStressHarness::Scenario> CallbackStressHarness::defaultScenarios() {
+    std::vector<Scenario> scenarios;
+    
+    Scenario repeated;
+    repeated.name = "repeated-notes";
+    repeated.notesPerSecond = 40.0;
+    repeated.noteLengthMs = 60.0;
+    repeated.jitterMs = 1.0;
+    scenarios.push_back(repeated);
+    
+    Scenario stacked;
+    stacked.name = "stacked-5-slots";
+    stacked.mode = Mode::Stacked;
+    stacked.slots = 5;
+    stacked.maxChord = 4;
+    stacked.jitterMs = 2.0;
+    scenarios.push_back(stacked);
+    
+    Scenario orbit;
+    orbit.name = "orbit-fast";
+    orbit.mode = Mode::Orbit;
+    orbit.slots = 4;
+    orbit.orbitRateHz = 8.0f;
+    orbit.maxChord = 3;
+    orbit.noteLengthMs = 600.0;
+    orbit.jitterMs = 1.0;
+    scenarios.push_back(orbit);
+    
+    Scenario flood;
+    flood.name = "midi-flood";
+    flood.mode = Mode::Stacked;
+    flood.slots = 2;
+    flood.floodEverySeconds = 0.5;
+    flood.floodSize = 96;  // Beyond both 64-event queues
+    flood.noteLengthMs = 100.0;
+    scenarios.push_back(flood);
+    
+    Scenario sweeps;
+    sweeps.name = "param-sweeps";
+    sweeps.parameterSweeps = true;
+    sweeps.maxChord = 3;
+    sweeps.noteLengthMs = 400.0;
+    sweeps.jitterMs = 2.0;
+    scenarios.push_back(sweeps);
+    
+    Scenario warp;
+    warp.name = "warp-chords";
+    warp.warp = true;
+    warp.maxChord = 6;
+    warp.noteLengthMs = 500.0;
+    warp.renderWorkers = 2;
+    scenarios.push_back(warp);
+    
+    return scenarios;
+}
+
+bool CallbackStressHarness::runAll() {
+    printf("Callback stress harness (random blocks 16-2048, prepared 512, RT sanitizer %s)\n",
+           RealtimeSanitizer::isEnabled() ? "on" : "off");
+    printf("%-16s %7s %6s %6s %6s %6s %8s %7s %7s %6s %8s %8s %5s %6s\n",
+           "scenario", "blocks", "late", "overr", "p99%", "max%", "noteOns", "stolen",
+           "dropped", "pops", "popDelta", "maxStep", "nan", "rtViol");
+    bool passed = true;
+    for (const Scenario& scenario : defaultScenarios()) {
+        Report r = runScenario(scenario);
+        printf("%-16s %7llu %6llu %6llu %6.1f %6.1f %8llu %7d %7d %6d %8.3f %8.3f %5llu %6llu\n",
+               scenario.name,
+               static_cast<unsigned long long>(r.blocks),
+               static_cast<unsigned long long>(r.lateCallbacks),
+               static_cast<unsigned long long>(r.overrunBlocks),
+               r.p99Load * 100.0f, r.maxLoad * 100.0f,
+               static_cast<unsigned long long>(r.noteOnsSent),
+               r.voicesStolen, r.droppedNotes, r.popEvents, r.maxPopDelta, r.maxOutputStep,
+               static_cast<unsigned long long>(r.nonFiniteSamples),
+               static_cast<unsigned long long>(r.realtimeViolations));
+        if (r.realtimeViolations > 0) {
+            fflush(stdout);
+            RealtimeSanitizer::printViolations(4);
+            passed = false;
+        }
+    }
+    printf("%s\n", passed ? "PASS" : "FAIL: real-time violations in the audio callback");
+    return passed;
+}
+
+} // namespace Debug
+} // namespace Core
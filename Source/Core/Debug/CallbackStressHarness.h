@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Headless real-time stress harness for SamplerEngine
+ * A simulated audio thread calls the engine with randomised block sizes (non powers of two
+ * and blocks larger than the prepared size included), optionally paced to wall time with
+ * wake-up jitter. A MIDI thread delivers a random note schedule with chords and bursts well
+ * past the 64-event queues, and a UI thread sweeps parameters the way the editor does.
+ * Stacked and Orbit modes reproduce JuceEngineAdapter's per-block dispatch (one voice per
+ * slot, blend-tagged orbit voices, weight ramps in prepared-size chunks) without JUCE.
+ * In OP1_RT_SANITIZER builds every callback runs in a real-time scope
+ */
+class CallbackStressHarness {
+public:
+    enum class Mode {
+        Direct,   // MIDI straight into SamplerEngine::pushMidiEvent
+        Stacked,  // Adapter stacked mode: every loaded slot per note, offset note numbers
+        Orbit     // Adapter orbit mode: slots A-D per note, mixed through weight ramps
+    };
+    
+    struct Scenario {
+        const char* name = "default";
+        Mode mode = Mode::Direct;
+        double sampleRate = 48000.0;
+        int preparedBlockSize = 512;     // Size passed to prepare; callbacks go up to 2048
+        double seconds = 4.0;            // Audio rendered
+        bool paced = true;               // Sleep to wall time (false = render as fast as possible)
+        double jitterMs = 0.0;           // Random wake-up delay per callback (paced only)
+        int slots = 1;                   // Loaded slots (Stacked: up to 5, Orbit: up to 4)
+        float orbitRateHz = 1.0f;
+        double notesPerSecond = 8.0;     // Mean rate of note-on groups (Poisson)
+        int maxChord = 1;                // Notes per group, 1..maxChord
+        double noteLengthMs = 250.0;     // Mean held time
+        double floodEverySeconds = 0.0;  // 0 = no floods
+        int floodSize = 0;               // Note-ons delivered at once per flood
+        bool parameterSweeps = false;    // UI thread sweeps filter, ADSR and repitch
+        bool warp = false;
+        int renderWorkers = 0;           // RenderWorkerPool threads (0 = serial voices)
+        uint32_t seed = 1;
+    };
+    
+    struct Report {
+        uint64_t blocks = 0;
+        uint64_t frames = 0;
+        int minBlock = 0;
+        int maxBlock = 0;
+        uint64_t overrunBlocks = 0;   // Callbacks that took longer than their block's duration
+        uint64_t lateCallbacks = 0;   // Paced callbacks that finished after their deadline (jitter included)
+        float p99Load = 0.0f;         // Callback load, fraction of the block duration
+        float maxLoad = 0.0f;
+        uint64_t noteOnsSent = 0;
+        int voicesStolen = 0;
+        int droppedNotes = 0;         // Engine drops plus note-ons lost to a full adapter queue
+        int popEvents = 0;            // PopDetector events (mix-level steps above threshold)
+        float maxPopDelta = 0.0f;
+        float maxOutputStep = 0.0f;   // Largest sample-to-sample step in the output, block edges included
+        uint64_t nonFiniteSamples = 0;
+        uint64_t realtimeViolations = 0;  // Allocations/locks/file I/O in the callback (OP1_RT_SANITIZER builds)
+    };
+    
+    // Run one scenario on its own engine and threads
+    static Report runScenario(const Scenario& scenario);
+    
+    // Built-in scenarios: repeated notes, stacked slots, fast orbit, MIDI flood, parameter sweeps, warp chords
+    static std::vector<Scenario> defaultScenarios();
+    
+    // Run the default scenarios and print one line per scenario
+    // Returns false if any callback broke real-time rules (stacks are printed to stderr)
+    static bool runAll();
+};
+
+} // namespace Debug
+} // namespace Core
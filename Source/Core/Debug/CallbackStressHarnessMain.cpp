@@ -0,0 +1,18 @@
+#include "CallbackStressHarness.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneStressHarness target
+//   Op1CloneStressHarness
+// Runs the default callback stress scenarios with the real-time sanitizer hooks; exit code 1
+// when any callback allocated, locked or touched a file
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneStressHarness\n"
+               "  Drives SamplerEngine from simulated audio, MIDI and UI threads (repeated notes,\n"
+               "  stacked slots, fast orbit, MIDI flood, parameter sweeps, warp chords).\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    return Core::Debug::CallbackStressHarness::runAll() ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include "CoreDspBench.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Entry point for the Op1CloneCoreBench target
+//   Op1CloneCoreBench [--json <file>] [--filter <class>] [--repeats <n>] [--repeat-ms <ms>] [--quick]
+// Compare two JSON runs with compare_core_bench.py
+
+namespace {
+
+void printUsage() {
+    printf("Usage: Op1CloneCoreBench [--json <file>] [--filter <class>] [--repeats <n>] [--repeat-ms <ms>] [--quick]\n"
+           "  --json       write results as JSON to <file> ('-' for stdout, table is then skipped)\n"
+           "  --filter     only benchmark classes whose name contains <class>\n"
+           "  --repeats    timed repeats per case, median reported (default 5)\n"
+           "  --repeat-ms  minimum wall time per repeat (default 20)\n"
+           "  --quick      shorthand for --repeats 3 --repeat-ms 5\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Core::Debug::CoreDspBench::Options options;
+    std::string jsonPath;
+    
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(arg, "--repeats") == 0 && hasValue) {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--repeat-ms") == 0 && hasValue) {
+            options.minRepeatMs = std::max(0.1, std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--quick") == 0) {
+            options.repeats = 3;
+            options.minRepeatMs = 5.0;
+        } else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+    }
+    
+    auto results = Core::Debug::CoreDspBench::run(options);
+    if (results.empty()) {
+        fprintf(stderr, "No benchmark matches filter '%s'\n", options.filter.c_str());
+        return 1;
+    }
+    
+    if (jsonPath != "-") {
+        Core::Debug::CoreDspBench::print(results);
+    }
+    if (!jsonPath.empty()) {
+        std::string json = Core::Debug::CoreDspBench::toJson(results, options);
+        if (jsonPath == "-") {
+            fputs(json.c_str(), stdout);
+        } else {
+            FILE* file = fopen(jsonPath.c_str(), "w");
+            if (file == nullptr) {
+                fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+                return 1;
+            }
+            fputs(json.c_str(), file);
+            fclose(file);
+            printf("Wrote %s\n", jsonPath.c_str());
+        }
+    }
+    return 0;
+}
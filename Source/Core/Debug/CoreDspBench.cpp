@@ -0,0 +1,387 @@
+#include "CoreDspBench.h"
+#include "../MoogLadderFilter.h"
+#include "../BiquadFilter.h"
+#include "../DriveEffect.h"
+#include "../LofiEffect.h"
+#include "../EnvelopeGenerator.h"
+#include "../SimpleFFT.h"
+#include "../STFT.h"
+#include "../Resampler.h"
+#include "../DSP/AmpEnvelopeADSR.h"
+#include "../DSP/OrbitBlender.h"
+#include "../DSP/AudioRingBuffer.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+using Options = CoreDspBench::Options;
+
+const int blockSizes[] = { 32, 64, 128, 256, 512, 1024 };
+const int frameSizes[] = { 512, 1024, 2048 };
+const double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+
+constexpr int SIGNAL_LENGTH = 1 << 16;
+constexpr int SIGNAL_HEADROOM = 4096;  // Longest read past a block's start (2048-frame FFT, 1.5x resampler)
+
+// Deterministic test material: a slow sine sweep plus low-level noise
+const std::vector<float>& testSignal() {
+    static const std::vector<float> signal = [] {
+        std::vector<float> s(static_cast<size_t>(SIGNAL_LENGTH));
+        uint32_t seed = 12345u;
+        double phase = 0.0;
+        for (int i = 0; i < SIGNAL_LENGTH; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            float noise = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+            phase += 0.002 + 0.05 * i / SIGNAL_LENGTH;
+            s[static_cast<size_t>(i)] = 0.6f * static_cast<float>(std::sin(phase)) + 0.05f * noise;
+        }
+        return s;
+    }();
+    return signal;
+}
+
+// Input for the given block; consecutive blocks walk through the signal
+const float* blockInput(int block, int hop) {
+    const int span = SIGNAL_LENGTH - SIGNAL_HEADROOM;
+    int64_t offset = (static_cast<int64_t>(block) * hop) % span;
+    return testSignal().data() + offset;
+}
+
+// Cutoff sweep (80 Hz - 8 kHz) so filters recompute coefficients every block
+float sweepCutoff(int block) {
+    static const std::vector<float> table = [] {
+        std::vector<float> t(256);
+        for (int i = 0; i < 256; ++i) {
+            double position = 0.5 + 0.5 * std::sin(2.0 * 3.14159265358979 * i / 256.0);
+            t[static_cast<size_t>(i)] = static_cast<float>(80.0 * std::pow(100.0, position));
+        }
+        return t;
+    }();
+    return table[static_cast<size_t>(block & 255)];
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Timing {
+    double median;
+    double min;
+};
+
+/**
+ * Time per sample of render(block) over the repeats, where each call produces
+ * samplesPerBlock samples. An untimed warm-up counts how many blocks fill options.minRepeatMs
+ */
+template <typename Render>
+Timing timeNsPerSample(int samplesPerBlock, const Options& options, Render&& render) {
+    int block = 0;
+    auto warmUp = std::chrono::steady_clock::now();
+    while (elapsedMs(warmUp) < options.minRepeatMs) {
+        render(block++);
+    }
+    const int numBlocks = std::max(1, block);
+    
+    const int repeats = std::max(1, options.repeats);
+    std::vector<double> times;
+    times.reserve(static_cast<size_t>(repeats));
+    for (int repeat = 0; repeat < repeats; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < numBlocks; ++b) {
+            render(block++);
+        }
+        times.push_back(elapsedMs(start) * 1e6 / (static_cast<double>(numBlocks) * samplesPerBlock));
+    }
+    std::sort(times.begin(), times.end());
+    return { times[static_cast<size_t>(repeats / 2)], times.front() };
+}
+
+// --- Block processors (blockSize samples per call) ---
+
+Timing benchMoogLadder(int blockSize, double sampleRate, const Options& options, double& checksum) {
+    MoogLadderFilter filter;
+    filter.prepare(sampleRate);
+    filter.setResonance(2.0f);
+    filter.setDrive(0.5f);
+    std::vector<float> out(static_cast<size_t>(blockSize));
+    return timeNsPerSample(blockSize, options, [&](int block) {
+        filter.setCutoff(sweepCutoff(block));
+        filter.processBlock(blockInput(block, blockSize), out.data(), blockSize);
+        checksum += out[static_cast<size_t>(blockSize - 1)];
+    });
+}
+
+Timing benchBiquad(int blockSize, double sampleRate, const Options& options, double& checksum) {
+    BiquadFilter filter;
+    filter.prepare(sampleRate);
+    filter.setResonance(1.0f);
+    std::vector<float> out(static_cast<size_t>(blockSize));
+    return timeNsPerSample(blockSize, options, [&](int block) {
+        filter.setCutoff(sweepCutoff(block));
+        filter.processBlock(blockInput(block, blockSize), out.data(), blockSize);
+        checksum += out[static_cast<size_t>(blockSize - 1)];
+    });
+}
+
+Timing benchDrive(int blockSize, double /*sampleRate*/, const Options& options, double& checksum) {
+    DriveEffect drive;
+    drive.setDrive(2.5f);
+    std::vector<float> out(static_cast<size_t>(blockSize));
+    return timeNsPerSample(blockSize, options, [&](int block) {
+        drive.processBlock(blockInput(block, blockSize), out.data(), blockSize);
+        checksum += out[static_cast<size_t>(blockSize - 1)];
+    });
+}
+
+Timing benchLofi(int blockSize, double sampleRate, const Options& options, double& checksum) {
+    LofiEffect lofi;
+    lofi.prepare(sampleRate);
+    lofi.setBitDepth(8.0f);
+    lofi.setSampleRateReduction(0.25f);
+    std::vector<float> out(static_cast<size_t>(blockSize));
+    return timeNsPerSample(blockSize, options, [&](int block) {
+        lofi.processBlock(blockInput(block, blockSize), out.data(), blockSize);
+        checksum += out[static_cast<size_t>(blockSize - 1)];
+    });
+}
+
+Timing benchEnvelopeGenerator(int blockSize, double sampleRate, const Options& options, double& checksum) {
+    EnvelopeGenerator envelope;
+    envelope.prepare(sampleRate);
+    envelope.setAttack(5.0f);
+    envelope.setRelease(50.0f);
+    std::vector<float> out(static_cast<size_t>(blockSize));
+    return timeNsPerSample(blockSize, options, [&](int block) {
+        // Retrigger and release regularly so every stage is exercised
+        if (block % 32 == 0) {
+            envelope.trigger();
+        } else if (block % 32 == 16) {
+            envelope.release();
+        }
+        envelope.processBlock(out.data(), blockSize);
+        checksum += out[static_cast<size_t>(blockSize - 1)];
+    });
+}
+
+Timing benchAmpEnvelope(int blockSize, double sampleRate, const Options& options, double& checksum) {
+    DSP::AmpEnvelopeADSR envelope;
+    envelope.prepare(sampleRate);
+    envelope.setParams(0.005f, 0.1f, 0.7f, 0.05f);
+    std::vector<float> out(static_cast<size_t>(blockSize));
+    return timeNsPerSample(blockSize, options, [&](int block) {
+        if (block % 32 == 0) {
+            envelope.noteOn(0.8f);
+        } else if (block % 32 == 16) {
+            envelope.noteOff();
+        }
+        for (int i = 0; i < blockSize; ++i) {
+            out[static_cast<size_t>(i)] = envelope.processSample();
+        }
+        checksum += out[static_cast<size_t>(blockSize - 1)];
+    });
+}
+
+Timing benchResampler(int blockSize, double sampleRate, const Options& options, double& checksum) {
+    Resampler resampler;
+    resampler.prepare(sampleRate);
+    resampler.setRatio(1.5f);  // A fifth up
+    const int inCount = static_cast<int>(blockSize * 1.5f) + 2;
+    std::vector<float> out(static_cast<size_t>(blockSize));
+    return timeNsPerSample(blockSize, options, [&](int block) {
+        int produced = resampler.process(blockInput(block, inCount), inCount, out.data(), blockSize);
+        checksum += out[static_cast<size_t>(std::max(0, produced - 1))];
+    });
+}
+
+Timing benchOrbitBlender(int blockSize, double sampleRate, const Options& options, double& checksum) {
+    DSP::OrbitBlender blender;
+    blender.setRateHz(1.0f);
+    blender.setShape(DSP::OrbitBlender::Shape::Figure8);
+    blender.setActiveSlotsMask(0x0F);
+    std::vector<float> ramps[4];
+    float* rampPointers[4];
+    for (int i = 0; i < 4; ++i) {
+        ramps[i].assign(static_cast<size_t>(blockSize), 0.0f);
+        rampPointers[i] = ramps[i].data();
+    }
+    const float dt = static_cast<float>(blockSize / sampleRate);
+    return timeNsPerSample(blockSize, options, [&](int) {
+        std::array<float, 4> weights = blender.renderWeightRamps(dt, blockSize, rampPointers);
+        checksum += weights[0] + ramps[3][static_cast<size_t>(blockSize / 2)];
+    });
+}
+
+Timing benchAudioRingBuffer(int blockSize, double /*sampleRate*/, const Options& options, double& checksum) {
+    AudioRingBuffer ring;
+    ring.allocate(2, 4096);
+    std::vector<float> out[2] = { std::vector<float>(static_cast<size_t>(blockSize)),
+                                  std::vector<float>(static_cast<size_t>(blockSize)) };
+    float* outPointers[2] = { out[0].data(), out[1].data() };
+    return timeNsPerSample(blockSize, options, [&](int block) {
+        const float* in = blockInput(block, blockSize);
+        const float* inPointers[2] = { in, in + 1 };
+        ring.push(inPointers, blockSize);
+        ring.pop(outPointers, blockSize);
+        checksum += out[1][static_cast<size_t>(blockSize - 1)];
+    });
+}
+
+// --- Frame processors (one frame per hop of frameSize / 4) ---
+
+Timing benchSimpleFFT(int frameSize, double /*sampleRate*/, const Options& options, double& checksum) {
+    SimpleFFT fft;
+    fft.prepare(frameSize);
+    const int hop = frameSize / 4;
+    std::vector<float> spectrum(static_cast<size_t>(frameSize + 2));
+    std::vector<float> out(static_cast<size_t>(frameSize));
+    return timeNsPerSample(hop, options, [&](int block) {
+        fft.forward(blockInput(block, hop), spectrum.data());
+        fft.inverse(spectrum.data(), out.data());
+        checksum += out[0];
+    });
+}
+
+Timing benchSTFT(int frameSize, double sampleRate, const Options& options, double& checksum) {
+    STFT stft;
+    const int hop = frameSize / 4;
+    stft.prepare(frameSize, hop, sampleRate);
+    std::vector<float> spectrum(static_cast<size_t>(frameSize + 2));
+    std::vector<float> out(static_cast<size_t>(frameSize));
+    return timeNsPerSample(hop, options, [&](int block) {
+        stft.analyze(blockInput(block, hop), spectrum.data());
+        stft.synthesize(spectrum.data(), out.data());
+        checksum += out[static_cast<size_t>(hop)];
+    });
+}
+
+struct Case {
+    const char* name;
+    bool frameBased;
+    Timing (*bench)(int size, double sampleRate, const Options& options, double& checksum);
+};
+
+const Case cases[] = {
+    { "MoogLadderFilter", false, &benchMoogLadder },
+    { "BiquadFilter", false, &benchBiquad },
+    { "DriveEffect", false, &benchDrive },
+    { "LofiEffect", false, &benchLofi },
+    { "EnvelopeGenerator", false, &benchEnvelopeGenerator },
+    { "AmpEnvelopeADSR", false, &benchAmpEnvelope },
+    { "Resampler", false, &benchResampler },
+    { "OrbitBlender", false, &benchOrbitBlender },
+    { "AudioRingBuffer", false, &benchAudioRingBuffer },
+    { "SimpleFFT", true, &benchSimpleFFT },
+    { "STFT", true, &benchSTFT },
+};
+
+// JSON numbers cannot be NaN or infinite
+std::string jsonNumber(double value, const char* format) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    char text[64];
+    snprintf(text, sizeof(text), format, value);
+    return text;
+}
+
+std::string jsonString(const std::string& value) {
+    std::string escaped = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+    }
+    return escaped + "\"";
+}
+
+std::string compilerName() {
+#if defined(__clang__)
+    return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+std::vector<CoreDspBench::Result> CoreDspBench::run(const Options& options) {
+    std::vector<Result> results;
+    for (const Case& benchCase : cases) {
+        if (!options.filter.empty() && std::string(benchCase.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        const int* sizes = benchCase.frameBased ? frameSizes : blockSizes;
+        const int numSizes = benchCase.frameBased ? static_cast<int>(sizeof(frameSizes) / sizeof(int))
+                                                  : static_cast<int>(sizeof(blockSizes) / sizeof(int));
+        for (double sampleRate : sampleRates) {
+            for (int s = 0; s < numSizes; ++s) {
+                Result result;
+                result.name = benchCase.name;
+                result.blockSize = sizes[s];
+                result.sampleRate = sampleRate;
+                result.checksum = 0.0;
+                Timing timing = benchCase.bench(sizes[s], sampleRate, options, result.checksum);
+                result.nsPerSample = timing.median;
+                result.nsPerSampleMin = timing.min;
+                result.realtimePercent = result.nsPerSample * sampleRate * 1e-7;
+                results.push_back(result);
+            }
+        }
+    }
+    return results;
+}
+
+std::string CoreDspBench::toJson(const std::vector<Result>& results, const Options& options) {
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"suite\": \"Op1CloneCoreBench\",\n";
+    json << "  \"schema\": 1,\n";
+#if defined(NDEBUG)
+    json << "  \"build\": \"release\",\n";
+#else
+    json << "  \"build\": \"debug\",\n";
+#endif
+    json << "  \"compiler\": " << jsonString(compilerName()) << ",\n";
+    json << "  \"minRepeatMs\": " << jsonNumber(options.minRepeatMs, "%g") << ",\n";
+    json << "  \"repeats\": " << options.repeats << ",\n";
+    json << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        json << (i == 0 ? "\n" : ",\n");
+        json << "    {\"name\": " << jsonString(r.name)
+             << ", \"blockSize\": " << r.blockSize
+             << ", \"sampleRate\": " << jsonNumber(r.sampleRate, "%.0f")
+             << ", \"nsPerSample\": " << jsonNumber(r.nsPerSample, "%.4f")
+             << ", \"nsPerSampleMin\": " << jsonNumber(r.nsPerSampleMin, "%.4f")
+             << ", \"realtimePercent\": " << jsonNumber(r.realtimePercent, "%.5f")
+             << ", \"checksum\": " << jsonNumber(r.checksum, "%.9g") << "}";
+    }
+    json << "\n  ]\n}\n";
+    return json.str();
+}
+
+void CoreDspBench::print(const std::vector<Result>& results) {
+    printf("=== Op1CloneCoreBench ===\n");
+    printf("  %-18s %6s %7s %12s %12s\n", "class", "block", "rate", "ns/sample", "% realtime");
+    for (const Result& r : results) {
+        printf("  %-18s %6d %7.0f %12.3f %12.4f\n", r.name.c_str(), r.blockSize, r.sampleRate,
+               r.nsPerSample, r.realtimePercent);
+    }
+}
+
+} // namespace Debug
+} // namespace Core
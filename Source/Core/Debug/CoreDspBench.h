@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Micro-benchmarks for every Core DSP building block (Op1CloneCoreBench target)
+ * Each class is driven the way the engine drives it - block processing with parameter
+ * changes between blocks - over a grid of block sizes and sample rates. The frame-based
+ * classes (SimpleFFT, STFT) run one frame per hop at 75% overlap, with the frame size in
+ * place of the block size. A warm-up sizes each repeat to a minimum wall time; results
+ * are the median repeat, per sample of audio produced, so they compare across block
+ * sizes and against the real-time budget
+ */
+class CoreDspBench {
+public:
+    struct Result {
+        std::string name;        // Class under test
+        int blockSize;           // Block size (frame size for SimpleFFT/STFT)
+        double sampleRate;
+        double nsPerSample;      // Median time per sample of audio
+        double nsPerSampleMin;   // Fastest repeat (steadier on a busy machine)
+        double realtimePercent;  // Share of one core needed to keep up in real time
+        double checksum;         // Output digest; keeps the optimiser from skipping work
+    };
+    
+    struct Options {
+        double minRepeatMs = 20.0;  // Wall time of each timed repeat (at least)
+        int repeats = 5;            // Timed repeats per case (median reported)
+        std::string filter;         // Only run classes whose name contains this
+    };
+    
+    // Run every case that passes the filter
+    static std::vector<Result> run(const Options& options);
+    
+    // Machine-readable report (see compare_core_bench.py)
+    static std::string toJson(const std::vector<Result>& results, const Options& options);
+    
+    // Human-readable table on stdout
+    static void print(const std::vector<Result>& results);
+};
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,463 @@
+#include "GoldenRender.h"
+#include "../SamplerEngine.h"
+#include "../SimpleFFT.h"
+#include "../WindowFunctions.h"
+#include "../DSP/OrbitBlender.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+namespace Core {
+namespace Debug {
+
+struct GoldenScript {
+    SamplerEngine* engine = nullptr;
+    const std::vector<SampleDataPtr>* samples = nullptr;
+    DSP::OrbitBlender* orbit = nullptr;
+    double time = 0.0;           // Start of the coming block (seconds)
+    double blockSeconds = 0.0;
+    float* const* weightRamps = nullptr;  // BLOCK_SIZE floats per blend group 0-3
+    bool useBlendWeights = false;         // Set by the script to mix through weightRamps this block
+    
+    // True for the one block whose span contains t
+    bool at(double t) const { return t >= time && t < time + blockSeconds; }
+    
+    const SampleDataPtr& sample(int slot) const { return (*samples)[static_cast<size_t>(slot)]; }
+    
+    void noteOn(int note, int slot, bool loop = false, int loopStart = 0, int loopEnd = 0, int blendGroup = -1) {
+        const SampleDataPtr& data = sample(slot);
+        engine->triggerNoteOnWithSample(note, 0.8f, data, 0.0f, 0, data->length, 1.0f,
+                                        5.0f, 100.0f, 0.8f, 150.0f, loop, loopStart, loopEnd,
+                                        slot, blendGroup);
+    }
+    
+    void noteOff(int note, int count = 1) {
+        MidiEvent offs[4];
+        count = std::min(count, 4);
+        for (int i = 0; i < count; ++i) {
+            offs[i] = MidiEvent(MidiEvent::NoteOff, note, 0.0f, 0);
+        }
+        engine->handleMidi(offs, count);
+    }
+};
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double SOURCE_RATE = 44100.0;  // Source samples resample to SAMPLE_RATE on every note
+constexpr int NUM_SLOTS = 4;
+constexpr int SPECTRUM_SIZE = 2048;
+constexpr int SPECTRUM_HOP = 512;
+constexpr double AUDIBLE_FLOOR_DB = -90.0;  // Bins below this in both renders are ignored
+constexpr double SPECTRUM_MIN_DB = -120.0;
+
+int sourceFrames(double seconds) {
+    return static_cast<int>(seconds * SOURCE_RATE);
+}
+
+// Two seconds of band-limited-ish saw with a decaying noise transient (fixed LCG), one pitch
+// and stereo tilt per slot. Identical on every platform that rounds float maths the same way
+SampleDataPtr makeSlotSample(int slot) {
+    auto data = std::make_shared<SampleData>();
+    const int length = sourceFrames(2.0);
+    const double freq = 110.0 * (1.0 + 0.5 * slot);
+    const int harmonics = 24;
+    data->mono.resize(static_cast<size_t>(length));
+    data->right.resize(static_cast<size_t>(length));
+    uint32_t noise = 0x1234567u + static_cast<uint32_t>(slot);
+    for (int i = 0; i < length; ++i) {
+        const double t = static_cast<double>(i) / SOURCE_RATE;
+        double saw = 0.0;
+        for (int h = 1; h <= harmonics; ++h) {
+            saw += std::sin(2.0 * PI * freq * h * t) / h;
+        }
+        noise = noise * 1664525u + 1013904223u;
+        const double white = static_cast<double>(noise >> 8) / 8388608.0 - 1.0;
+        const double transient = white * std::exp(-t * 40.0);
+        const float left = static_cast<float>(0.3 * saw + 0.2 * transient);
+        data->mono[static_cast<size_t>(i)] = left;
+        data->right[static_cast<size_t>(i)] = left * (1.0f - 0.15f * slot);
+    }
+    data->length = length;
+    data->sourceSampleRate = SOURCE_RATE;
+    return data;
+}
+
+// Every slot per chord note at offset note numbers, as the adapter's stacked mode
+void stackedChords(GoldenScript& s) {
+    const int roots[] = { 48, 53, 55, 50 };
+    for (int chord = 0; chord < 4; ++chord) {
+        const double start = 0.75 * chord;
+        for (int interval : { 0, 4, 7 }) {
+            const int note = roots[chord] + interval;
+            for (int slot = 0; slot < 3; ++slot) {
+                if (s.at(start)) {
+                    s.noteOn(note + slot, slot);
+                }
+                if (s.at(start + 0.6)) {
+                    s.noteOff(note + slot);
+                }
+            }
+        }
+    }
+}
+
+// Forward loops shorter than the hold, so the 150 ms loop crossfade runs several times
+void loopCrossfade(GoldenScript& s) {
+    if (s.at(0.0)) {
+        s.noteOn(48, 0, true, sourceFrames(0.4), sourceFrames(0.9));
+    }
+    if (s.at(0.5)) {
+        s.noteOn(55, 1, true, sourceFrames(0.2), sourceFrames(0.55));
+    }
+    if (s.at(3.0)) {
+        s.noteOff(48);
+        s.noteOff(55);
+    }
+}
+
+// loopStart > loopEnd: the voice plays the loop region backwards
+void reverseLoop(GoldenScript& s) {
+    if (s.at(0.0)) {
+        s.noteOn(52, 0, true, sourceFrames(1.2), sourceFrames(0.4));
+    }
+    if (s.at(0.3)) {
+        s.noteOn(59, 2, true, sourceFrames(0.9), sourceFrames(0.5));
+    }
+    if (s.at(3.0)) {
+        s.noteOff(52);
+        s.noteOff(59);
+    }
+}
+
+// Slots A-D per note, blend-tagged, mixed through orbit ramps whose rate sweeps 0.25-16 Hz
+void orbitSweep(GoldenScript& s) {
+    for (int note : { 48, 55, 60 }) {
+        if (s.at(0.0)) {
+            for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+                s.noteOn(note, slot, true, sourceFrames(0.3), sourceFrames(1.6), slot);
+            }
+        }
+        if (s.at(3.5)) {
+            s.noteOff(note, NUM_SLOTS);
+        }
+    }
+    s.orbit->setRateHz(static_cast<float>(0.25 * std::pow(64.0, std::min(1.0, s.time / 3.5))));
+    s.orbit->renderWeightRamps(static_cast<float>(s.blockSeconds), GoldenRender::BLOCK_SIZE, s.weightRamps);
+    s.useBlendWeights = true;
+}
+
+// Time-stretched notes across the keyboard (live stretchers; the render cache is off)
+void warpNotes(GoldenScript& s) {
+    const int notes[] = { 48, 60, 67, 72 };
+    for (int i = 0; i < 4; ++i) {
+        const double start = 0.4 * i;
+        if (s.at(start)) {
+            s.noteOn(notes[i], i % 2);
+        }
+        if (s.at(start + 1.2)) {
+            s.noteOff(notes[i]);
+        }
+    }
+}
+
+// Held looped chord through the ladder filter, cutoff swept up and back down with resonance and drive
+void filterSweep(GoldenScript& s) {
+    if (s.at(0.0)) {
+        s.engine->setLPFilterResonance(3.0f);
+        s.engine->setLPFilterDrive(6.0f);
+        for (int note : { 45, 52, 57 }) {
+            s.noteOn(note, 0, true, sourceFrames(0.3), sourceFrames(1.5));
+        }
+    }
+    const double phase = std::min(1.0, s.time / 3.0);
+    const double sweep = 1.0 - std::abs(2.0 * phase - 1.0);  // 0 -> 1 -> 0
+    s.engine->setLPFilterCutoff(static_cast<float>(200.0 * std::pow(60.0, sweep)));  // 200 Hz..12 kHz
+    if (s.at(3.0)) {
+        for (int note : { 45, 52, 57 }) {
+            s.noteOff(note);
+        }
+    }
+}
+
+double toDb(double ratio) {
+    return ratio > 0.0 ? 20.0 * std::log10(ratio) : -INFINITY;
+}
+
+// Worst frame's mean |dB difference| over bins audible in either render (one channel)
+double spectralDifference(const std::vector<float>& reference, const std::vector<float>& test, size_t frames) {
+    if (frames < static_cast<size_t>(SPECTRUM_SIZE)) {
+        return 0.0;
+    }
+    SimpleFFT fft;
+    fft.prepare(SPECTRUM_SIZE);
+    std::vector<float> window(SPECTRUM_SIZE);
+    WindowFunctions::generateHann(window.data(), SPECTRUM_SIZE);
+    double windowSum = 0.0;
+    for (float w : window) {
+        windowSum += w;
+    }
+    const double fullScale = 0.5 * windowSum;  // Bin magnitude of a full-scale sine
+    
+    std::vector<float> frameIn(SPECTRUM_SIZE);
+    std::vector<float> refSpectrum(SPECTRUM_SIZE + 2);
+    std::vector<float> testSpectrum(SPECTRUM_SIZE + 2);
+    auto binDb = [fullScale](const std::vector<float>& spectrum, int bin) {
+        const double re = spectrum[static_cast<size_t>(2 * bin)];
+        const double im = spectrum[static_cast<size_t>(2 * bin + 1)];
+        return std::max(SPECTRUM_MIN_DB, toDb(std::sqrt(re * re + im * im) / fullScale));
+    };
+    
+    double worst = 0.0;
+    for (size_t start = 0; start + SPECTRUM_SIZE <= frames; start += SPECTRUM_HOP) {
+        for (int i = 0; i < SPECTRUM_SIZE; ++i) {
+            frameIn[static_cast<size_t>(i)] = reference[start + static_cast<size_t>(i)] * window[static_cast<size_t>(i)];
+        }
+        fft.forward(frameIn.data(), refSpectrum.data());
+        for (int i = 0; i < SPECTRUM_SIZE; ++i) {
+            frameIn[static_cast<size_t>(i)] = test[start + static_cast<size_t>(i)] * window[static_cast<size_t>(i)];
+        }
+        fft.forward(frameIn.data(), testSpectrum.data());
+        
+        double sum = 0.0;
+        int bins = 0;
+        for (int bin = 0; bin <= SPECTRUM_SIZE / 2; ++bin) {
+            const double refDb = binDb(refSpectrum, bin);
+            const double testDb = binDb(testSpectrum, bin);
+            if (std::max(refDb, testDb) > AUDIBLE_FLOOR_DB) {
+                sum += std::abs(refDb - testDb);
+                ++bins;
+            }
+        }
+        if (bins > 0) {
+            worst = std::max(worst, sum / bins);
+        }
+    }
+    return worst;
+}
+
+void putU16(FILE* file, uint16_t value) {
+    const unsigned char bytes[2] = { static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8) };
+    fwrite(bytes, 1, 2, file);
+}
+
+void putU32(FILE* file, uint32_t value) {
+    const unsigned char bytes[4] = { static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+                                     static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24) };
+    fwrite(bytes, 1, 4, file);
+}
+
+uint32_t getU32(const unsigned char* bytes) {
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+        | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+uint16_t getU16(const unsigned char* bytes) {
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 3;
+
+} // namespace
+
+const std::vector<GoldenRender::Scenario>& GoldenRender::scenarios() {
+    static const std::vector<Scenario> list = {
+        { "stacked-chords", "triads on 3 stacked slots, overlapping releases", 3.2, false, stackedChords },
+        { "loop-crossfade", "two held forward loops through repeated loop crossfades", 3.5, false, loopCrossfade },
+        { "reverse-loop", "two held reverse loops (loop start after loop end)", 3.5, false, reverseLoop },
+        { "orbit-sweep", "4-slot orbit chord, rate swept 0.25-16 Hz", 4.0, false, orbitSweep },
+        { "warp-notes", "time-stretched notes over two octaves", 3.0, true, warpNotes },
+        { "filter-sweep", "looped chord through a resonant, driven ladder filter sweep", 3.5, false, filterSweep },
+    };
+    return list;
+}
+
+GoldenRender::Render GoldenRender::render(const Scenario& scenario) {
+    std::vector<SampleDataPtr> samples;
+    for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+        samples.push_back(makeSlotSample(slot));
+    }
+    
+    // Everything that could make two renders differ is off: load-driven quality changes,
+    // background stretch renders and worker-thread voice rendering
+    auto engine = std::make_unique<SamplerEngine>();
+    engine->setQualityGovernorEnabled(false);
+    engine->setStretchCacheEnabled(false);
+    engine->setWarpEnabled(scenario.warp);
+    engine->prepare(SAMPLE_RATE, BLOCK_SIZE, 2);
+    engine->setSampleData(samples[0]);
+    engine->setADSR(5.0f, 100.0f, 0.8f, 150.0f);
+    
+    DSP::OrbitBlender orbit;
+    orbit.setShape(DSP::OrbitBlender::Shape::Circle);
+    orbit.setActiveSlotsMask(static_cast<uint8_t>((1 << NUM_SLOTS) - 1));
+    std::array<std::vector<float>, NUM_SLOTS> ramps;
+    float* rampPointers[NUM_SLOTS];
+    const float* weightPointers[NUM_SLOTS];
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        ramps[static_cast<size_t>(i)].assign(BLOCK_SIZE, 0.0f);
+        rampPointers[i] = ramps[static_cast<size_t>(i)].data();
+        weightPointers[i] = rampPointers[i];
+    }
+    
+    GoldenScript script;
+    script.engine = engine.get();
+    script.samples = &samples;
+    script.orbit = &orbit;
+    script.blockSeconds = BLOCK_SIZE / SAMPLE_RATE;
+    script.weightRamps = rampPointers;
+    
+    Render result;
+    result.sampleRate = SAMPLE_RATE;
+    const int blocks = static_cast<int>(std::ceil(scenario.seconds * SAMPLE_RATE / BLOCK_SIZE));
+    result.left.assign(static_cast<size_t>(blocks) * BLOCK_SIZE, 0.0f);
+    result.right.assign(static_cast<size_t>(blocks) * BLOCK_SIZE, 0.0f);
+    for (int block = 0; block < blocks; ++block) {
+        const size_t offset = static_cast<size_t>(block) * BLOCK_SIZE;
+        script.time = static_cast<double>(offset) / SAMPLE_RATE;
+        script.useBlendWeights = false;
+        scenario.script(script);
+        if (script.useBlendWeights) {
+            engine->setBlendWeights(weightPointers);
+        }
+        float* output[2] = { result.left.data() + offset, result.right.data() + offset };
+        engine->process(output, 2, BLOCK_SIZE);
+    }
+    return result;
+}
+
+GoldenRender::Comparison GoldenRender::compare(const Render& reference, const Render& test) {
+    Comparison result;
+    const size_t frames = std::min(std::min(reference.left.size(), reference.right.size()),
+                                   std::min(test.left.size(), test.right.size()));
+    result.frames = frames;
+    result.lengthMatches = reference.sampleRate == test.sampleRate
+        && reference.left.size() == test.left.size() && reference.right.size() == test.right.size();
+    
+    double errorEnergy = 0.0;
+    double referenceEnergy = 0.0;
+    const std::vector<float>* channels[2][2] = { { &reference.left, &test.left }, { &reference.right, &test.right } };
+    for (auto& channel : channels) {
+        const std::vector<float>& ref = *channel[0];
+        const std::vector<float>& out = *channel[1];
+        for (size_t i = 0; i < frames; ++i) {
+            if (std::memcmp(&ref[i], &out[i], sizeof(float)) != 0) {
+                ++result.differingSamples;
+            }
+            const double error = static_cast<double>(ref[i]) - static_cast<double>(out[i]);
+            const float absError = static_cast<float>(std::abs(error));
+            if (absError > result.maxAbsError || std::isnan(absError)) {
+                result.maxAbsError = std::isnan(absError) ? INFINITY : absError;
+                result.maxErrorFrame = i;
+            }
+            errorEnergy += error * error;
+            referenceEnergy += static_cast<double>(ref[i]) * ref[i];
+        }
+        result.spectralDb = std::max(result.spectralDb, spectralDifference(ref, out, frames));
+    }
+    if (errorEnergy == 0.0) {
+        result.residualDb = -INFINITY;
+    } else {
+        result.residualDb = toDb(std::sqrt(errorEnergy / std::max(referenceEnergy, 1.0e-30)));
+    }
+    return result;
+}
+
+bool GoldenRender::passes(const Comparison& comparison, const Tolerance& tolerance) {
+    if (!comparison.lengthMatches) {
+        return false;
+    }
+    if (tolerance.bitExact) {
+        return comparison.differingSamples == 0;
+    }
+    return comparison.maxAbsError <= tolerance.maxAbsError
+        && comparison.residualDb <= tolerance.maxResidualDb
+        && comparison.spectralDb <= tolerance.maxSpectralDb;
+}
+
+bool GoldenRender::writeWav(const std::string& path, const Render& render) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    const uint32_t frames = static_cast<uint32_t>(std::min(render.left.size(), render.right.size()));
+    const uint32_t dataBytes = frames * 2 * 4;
+    const uint32_t rate = static_cast<uint32_t>(std::lround(render.sampleRate));
+    fwrite("RIFF", 1, 4, file);
+    putU32(file, 36 + dataBytes);
+    fwrite("WAVEfmt ", 1, 8, file);
+    putU32(file, 16);
+    putU16(file, WAVE_FORMAT_IEEE_FLOAT);
+    putU16(file, 2);
+    putU32(file, rate);
+    putU32(file, rate * 2 * 4);
+    putU16(file, 2 * 4);
+    putU16(file, 32);
+    fwrite("data", 1, 4, file);
+    putU32(file, dataBytes);
+    for (uint32_t i = 0; i < frames; ++i) {
+        for (float sample : { render.left[i], render.right[i] }) {
+            uint32_t bits;
+            std::memcpy(&bits, &sample, sizeof(bits));
+            putU32(file, bits);
+        }
+    }
+    const bool ok = (ferror(file) == 0);
+    return (fclose(file) == 0) && ok;
+}
+
+bool GoldenRender::readWav(const std::string& path, Render& render, std::string& error) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::vector<unsigned char> bytes;
+    unsigned char buffer[65536];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + got);
+    }
+    fclose(file);
+    
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        error = path + " is not a WAV file";
+        return false;
+    }
+    bool haveFormat = false;
+    for (size_t pos = 12; pos + 8 <= bytes.size(); ) {
+        const unsigned char* chunk = bytes.data() + pos;
+        const size_t size = getU32(chunk + 4);
+        if (pos + 8 + size > bytes.size()) {
+            break;
+        }
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            if (getU16(chunk + 8) != WAVE_FORMAT_IEEE_FLOAT || getU16(chunk + 10) != 2 || getU16(chunk + 22) != 32) {
+                error = path + " is not 32-bit float stereo";
+                return false;
+            }
+            render.sampleRate = static_cast<double>(getU32(chunk + 12));
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0 && haveFormat) {
+            const size_t frames = size / 8;
+            render.left.resize(frames);
+            render.right.resize(frames);
+            for (size_t i = 0; i < frames; ++i) {
+                uint32_t left = getU32(chunk + 8 + i * 8);
+                uint32_t right = getU32(chunk + 12 + i * 8);
+                std::memcpy(&render.left[i], &left, sizeof(float));
+                std::memcpy(&render.right[i], &right, sizeof(float));
+            }
+            return true;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    error = path + " has no float audio data";
+    return false;
+}
+
+} // namespace Debug
+} // namespace Core
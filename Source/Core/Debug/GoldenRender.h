@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+struct GoldenScript;  // Engine, source samples and block timing handed to a scenario script
+
+/**
+ * Deterministic golden-render regression corpus for SamplerEngine
+ * Each scenario scripts note-ons, note-offs, loop points, orbit weights and parameter moves
+ * at fixed block boundaries against synthetic source samples, and renders the engine
+ * offline: serial voices, quality governor off, stretch cache off, fixed block size. Two
+ * renders of a scenario are bit-identical, so a corpus written before a change can be
+ * compared against renders after it (bit-exact for refactors, within tolerance for SIMD or
+ * fast-math paths). Renders are stored as 32-bit float stereo WAV files
+ */
+class GoldenRender {
+public:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int BLOCK_SIZE = 256;
+    
+    struct Scenario {
+        const char* name;
+        const char* description;
+        double seconds;
+        bool warp;                       // Engine warp (time-stretch) enabled
+        void (*script)(GoldenScript& context);  // Called before every block
+    };
+    
+    struct Render {
+        double sampleRate = 0.0;
+        std::vector<float> left;
+        std::vector<float> right;
+    };
+    
+    struct Comparison {
+        bool lengthMatches = false;      // Same frame count and sample rate
+        uint64_t frames = 0;             // Frames compared (the shorter render)
+        uint64_t differingSamples = 0;   // Samples whose bits differ (both channels)
+        float maxAbsError = 0.0f;        // Largest |reference - test|
+        uint64_t maxErrorFrame = 0;
+        double residualDb = 0.0;         // Null test: RMS(reference - test) / RMS(reference), dB (-inf = identical)
+        double spectralDb = 0.0;         // Worst STFT frame's mean |dB difference| over audible bins
+    };
+    
+    struct Tolerance {
+        bool bitExact = false;           // Every sample bit-identical (the other limits are ignored)
+        float maxAbsError = 1.0e-4f;     // -80 dBFS
+        double maxResidualDb = -80.0;
+        double maxSpectralDb = 0.1;
+    };
+    
+    // Built-in scenarios: stacked chords, loop crossfades, reverse loops, orbit sweep, warp notes, filter sweep
+    static const std::vector<Scenario>& scenarios();
+    
+    // Render one scenario on a fresh engine
+    static Render render(const Scenario& scenario);
+    
+    static Comparison compare(const Render& reference, const Render& test);
+    static bool passes(const Comparison& comparison, const Tolerance& tolerance);
+    
+    // 32-bit float stereo WAV; readWav fills error on failure
+    static bool writeWav(const std::string& path, const Render& render);
+    static bool readWav(const std::string& path, Render& render, std::string& error);
+};
+
+} // namespace Debug
+} // namespace Core
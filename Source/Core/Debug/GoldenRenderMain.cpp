@@ -0,0 +1,212 @@
+#include "GoldenRender.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+// Entry point for the Op1CloneGolden target
+//   Op1CloneGolden --render <dir> [--filter <name>]
+//   Op1CloneGolden --compare <dir> [--exact | tolerance options] [--filter <name>] [--save <dir>]
+//   Op1CloneGolden --diff <reference.wav> <test.wav> [--exact | tolerance options]
+// Render the corpus before a change, compare after it; exit code 1 on any failure
+
+namespace {
+
+using Core::Debug::GoldenRender;
+
+void printUsage() {
+    printf("Usage: Op1CloneGolden --list\n"
+           "       Op1CloneGolden --render <dir> [--filter <name>]\n"
+           "       Op1CloneGolden --compare <dir> [options] [--filter <name>] [--save <dir>]\n"
+           "       Op1CloneGolden --diff <reference.wav> <test.wav> [options]\n"
+           "  --render           write <scenario>.wav reference renders to <dir>\n"
+           "  --compare          render every scenario and compare it to <dir>/<scenario>.wav\n"
+           "  --diff             compare two 32-bit float stereo WAV files\n"
+           "  --filter           only scenarios whose name contains <name>\n"
+           "  --save             write renders that fail the comparison to <dir>\n"
+           "  --exact            require bit-identical output (refactors)\n"
+           "  --max-error        tolerance: largest sample difference (default 1e-4)\n"
+           "  --max-residual-db  tolerance: null-test residual vs reference RMS (default -80)\n"
+           "  --max-spectral-db  tolerance: worst frame mean spectral difference (default 0.1)\n");
+}
+
+std::string formatDb(double db) {
+    if (std::isinf(db)) {
+        return db < 0.0 ? "-inf" : "inf";
+    }
+    char text[32];
+    snprintf(text, sizeof(text), "%.1f", db);
+    return text;
+}
+
+void printHeader() {
+    printf("%-16s %8s %10s %10s %9s %11s %9s  %s\n",
+           "scenario", "frames", "differing", "maxErr dB", "at s", "residual dB", "spec dB", "result");
+}
+
+void printComparison(const char* name, const GoldenRender::Comparison& c, bool pass, double sampleRate) {
+    const double atSeconds = sampleRate > 0.0 ? static_cast<double>(c.maxErrorFrame) / sampleRate : 0.0;
+    printf("%-16s %8llu %10llu %10s %9.3f %11s %9.3f  %s\n", name,
+           static_cast<unsigned long long>(c.frames), static_cast<unsigned long long>(c.differingSamples),
+           formatDb(c.maxAbsError > 0.0f ? 20.0 * std::log10(c.maxAbsError) : -INFINITY).c_str(), atSeconds,
+           formatDb(c.residualDb).c_str(), c.spectralDb,
+           pass ? "ok" : (c.lengthMatches ? "FAIL" : "FAIL (length/rate)"));
+}
+
+std::string scenarioPath(const std::string& dir, const char* name) {
+    return (std::filesystem::path(dir) / (std::string(name) + ".wav")).string();
+}
+
+bool ensureDirectory(const std::string& dir) {
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
+    if (!std::filesystem::is_directory(dir)) {
+        fprintf(stderr, "Cannot create %s\n", dir.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Renders each scenario twice and refuses to write one whose renders differ
+int renderCorpus(const std::string& dir, const std::string& filter) {
+    if (!ensureDirectory(dir)) {
+        return 1;
+    }
+    int failures = 0;
+    for (const auto& scenario : GoldenRender::scenarios()) {
+        if (std::strstr(scenario.name, filter.c_str()) == nullptr) {
+            continue;
+        }
+        const auto first = GoldenRender::render(scenario);
+        const auto second = GoldenRender::render(scenario);
+        GoldenRender::Tolerance exact;
+        exact.bitExact = true;
+        if (!GoldenRender::passes(GoldenRender::compare(first, second), exact)) {
+            fprintf(stderr, "%s: two renders differ - scenario is not deterministic, not written\n", scenario.name);
+            ++failures;
+            continue;
+        }
+        const std::string path = scenarioPath(dir, scenario.name);
+        if (!GoldenRender::writeWav(path, first)) {
+            fprintf(stderr, "Cannot write %s\n", path.c_str());
+            ++failures;
+            continue;
+        }
+        printf("Wrote %s (%.2f s)\n", path.c_str(), static_cast<double>(first.left.size()) / first.sampleRate);
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+int compareCorpus(const std::string& dir, const std::string& filter, const GoldenRender::Tolerance& tolerance,
+                  const std::string& saveDir) {
+    if (!saveDir.empty() && !ensureDirectory(saveDir)) {
+        return 1;
+    }
+    printHeader();
+    int compared = 0;
+    int failures = 0;
+    for (const auto& scenario : GoldenRender::scenarios()) {
+        if (std::strstr(scenario.name, filter.c_str()) == nullptr) {
+            continue;
+        }
+        GoldenRender::Render reference;
+        std::string error;
+        if (!GoldenRender::readWav(scenarioPath(dir, scenario.name), reference, error)) {
+            printf("%-16s %s\n", scenario.name, error.c_str());
+            ++failures;
+            continue;
+        }
+        const auto render = GoldenRender::render(scenario);
+        const auto comparison = GoldenRender::compare(reference, render);
+        const bool pass = GoldenRender::passes(comparison, tolerance);
+        printComparison(scenario.name, comparison, pass, reference.sampleRate);
+        ++compared;
+        if (!pass) {
+            ++failures;
+            if (!saveDir.empty()) {
+                GoldenRender::writeWav(scenarioPath(saveDir, scenario.name), render);
+            }
+        }
+    }
+    printf("%d compared, %d failed (%s)\n", compared, failures, tolerance.bitExact ? "bit-exact" : "tolerance");
+    return failures == 0 && compared > 0 ? 0 : 1;
+}
+
+int diffFiles(const std::string& referencePath, const std::string& testPath, const GoldenRender::Tolerance& tolerance) {
+    GoldenRender::Render reference;
+    GoldenRender::Render test;
+    std::string error;
+    if (!GoldenRender::readWav(referencePath, reference, error) || !GoldenRender::readWav(testPath, test, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    const auto comparison = GoldenRender::compare(reference, test);
+    const bool pass = GoldenRender::passes(comparison, tolerance);
+    printHeader();
+    printComparison(std::filesystem::path(testPath).stem().string().c_str(), comparison, pass, reference.sampleRate);
+    return pass ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    enum class Command { None, List, Render, Compare, Diff } command = Command::None;
+    std::string dir;
+    std::string testPath;
+    std::string filter;
+    std::string saveDir;
+    GoldenRender::Tolerance tolerance;
+    
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(arg, "--list") == 0) {
+            command = Command::List;
+        } else if (std::strcmp(arg, "--render") == 0 && hasValue) {
+            command = Command::Render;
+            dir = argv[++i];
+        } else if (std::strcmp(arg, "--compare") == 0 && hasValue) {
+            command = Command::Compare;
+            dir = argv[++i];
+        } else if (std::strcmp(arg, "--diff") == 0 && i + 2 < argc) {
+            command = Command::Diff;
+            dir = argv[++i];
+            testPath = argv[++i];
+        } else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            filter = argv[++i];
+        } else if (std::strcmp(arg, "--save") == 0 && hasValue) {
+            saveDir = argv[++i];
+        } else if (std::strcmp(arg, "--exact") == 0) {
+            tolerance.bitExact = true;
+        } else if (std::strcmp(arg, "--max-error") == 0 && hasValue) {
+            tolerance.maxAbsError = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--max-residual-db") == 0 && hasValue) {
+            tolerance.maxResidualDb = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--max-spectral-db") == 0 && hasValue) {
+            tolerance.maxSpectralDb = std::atof(argv[++i]);
+        } else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+    }
+    
+    switch (command) {
+        case Command::List:
+            for (const auto& scenario : GoldenRender::scenarios()) {
+                printf("%-16s %4.1f s  %s\n", scenario.name, scenario.seconds, scenario.description);
+            }
+            return 0;
+        case Command::Render:
+            return renderCorpus(dir, filter);
+        case Command::Compare:
+            return compareCorpus(dir, filter, tolerance, saveDir);
+        case Command::Diff:
+            return diffFiles(dir, testPath, tolerance);
+        case Command::None:
+            break;
+    }
+    printUsage();
+    return 2;
+}
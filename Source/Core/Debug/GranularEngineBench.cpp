@@ -0,0 +1,127 @@
+#include "GranularEngineBench.h"
+#include "../GranularEngine.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+
+SampleDataPtr makeSource(bool stereo) {
+    // Two seconds of a detuned harmonic tone
+    auto data = std::make_shared<SampleData>();
+    data->length = static_cast<int>(SAMPLE_RATE * 2.0);
+    data->sourceSampleRate = SAMPLE_RATE;
+    data->mono.resize(static_cast<size_t>(data->length));
+    if (stereo) {
+        data->right.resize(static_cast<size_t>(data->length));
+    }
+    for (int i = 0; i < data->length; ++i) {
+        double t = i / SAMPLE_RATE;
+        data->mono[static_cast<size_t>(i)] = static_cast<float>(0.3 * std::sin(2.0 * M_PI * 220.0 * t) + 0.1 * std::sin(2.0 * M_PI * 661.0 * t));
+        if (stereo) {
+            data->right[static_cast<size_t>(i)] = static_cast<float>(0.3 * std::sin(2.0 * M_PI * 221.0 * t) + 0.1 * std::sin(2.0 * M_PI * 659.0 * t));
+        }
+    }
+    return data;
+}
+
+} // namespace
+
+GranularEngineBench::Result GranularEngineBench::benchGrains(int targetGrains, float grainSizeMs, int blockSize, bool stereoSource, double seconds) {
+    std::unique_ptr<GranularEngine> engine(new GranularEngine());
+    engine->prepare(SAMPLE_RATE, blockSize);
+    engine->setCpuBudget(0.0f);  // Measure the raw cost
+    
+    GranularEngine::Parameters params;
+    params.grainSizeMs = grainSizeMs;
+    params.density = static_cast<float>(targetGrains) / (grainSizeMs * 0.001f);
+    params.position = 0.3f;
+    params.positionJitter = 0.25f;
+    params.pitchSpread = 0.5f;
+    engine->noteOn(60, 1.0f, makeSource(stereoSource), params);
+    
+    std::vector<float> left(static_cast<size_t>(blockSize)), right(static_cast<size_t>(blockSize));
+    float* output[2] = { left.data(), right.data() };
+    
+    // Let the cloud fill before measuring
+    int warmupBlocks = static_cast<int>(2.0 * grainSizeMs * 0.001 * SAMPLE_RATE / blockSize) + 1;
+    for (int b = 0; b < warmupBlocks; ++b) {
+        engine->process(output, 2, blockSize);
+    }
+    
+    int numBlocks = static_cast<int>(seconds * SAMPLE_RATE / blockSize);
+    double totalNs = 0.0;
+    double grainSum = 0.0;
+    for (int b = 0; b < numBlocks; ++b) {
+        std::fill(left.begin(), left.end(), 0.0f);
+        std::fill(right.begin(), right.end(), 0.0f);
+        auto start = std::chrono::steady_clock::now();
+        engine->process(output, 2, blockSize);
+        totalNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        grainSum += engine->getActiveGrainCount();
+    }
+    
+    Result result;
+    result.meanGrains = (numBlocks > 0) ? grainSum / numBlocks : 0.0;
+    double grainSamples = result.meanGrains * numBlocks * blockSize;
+    result.nsPerGrainSample = (grainSamples > 0.0) ? totalNs / grainSamples : 0.0;
+    result.grainsPerCore = (result.nsPerGrainSample > 0.0) ? 1.0e9 / (result.nsPerGrainSample * SAMPLE_RATE) : 0.0;
+    return result;
+}
+
+GranularEngineBench::GuardResult GranularEngineBench::benchGuard(float cpuBudget, int blockSize, double seconds) {
+    std::unique_ptr<GranularEngine> engine(new GranularEngine());
+    engine->prepare(SAMPLE_RATE, blockSize);
+    engine->setCpuBudget(cpuBudget);
+    
+    GranularEngine::Parameters params;
+    params.grainSizeMs = 100.0f;
+    params.density = 20000.0f;  // Would need ~2000 concurrent grains
+    params.positionJitter = 0.5f;
+    engine->noteOn(60, 1.0f, makeSource(true), params);
+    
+    std::vector<float> left(static_cast<size_t>(blockSize)), right(static_cast<size_t>(blockSize));
+    float* output[2] = { left.data(), right.data() };
+    int numBlocks = static_cast<int>(seconds * SAMPLE_RATE / blockSize);
+    for (int b = 0; b < numBlocks; ++b) {
+        engine->process(output, 2, blockSize);
+    }
+    
+    GuardResult result;
+    result.densityScale = engine->getDensityScale();
+    result.cpuLoad = engine->getCpuLoad();
+    result.activeGrains = engine->getActiveGrainCount();
+    return result;
+}
+
+void GranularEngineBench::runAll() {
+    const int blockSize = 256;
+    printf("=== GranularEngineBench (48 kHz, block %d, stereo out) ===\n", blockSize);
+    printf("  grains  size ms  source   ns/grain-sample  mean grains  grains per core\n");
+    const int grainCounts[] = { 16, 64, 256, 512 };
+    for (int stereo = 0; stereo < 2; ++stereo) {
+        for (int grains : grainCounts) {
+            Result r = benchGrains(grains, 80.0f, blockSize, stereo != 0, 2.0);
+            printf("  %6d  %7.0f  %-6s   %15.2f  %11.1f  %15.0f\n",
+                   grains, 80.0, stereo ? "stereo" : "mono", r.nsPerGrainSample, r.meanGrains, r.grainsPerCore);
+        }
+    }
+    
+    printf("  CPU guard (density for ~2000 grains, 3 s):\n");
+    const float budgets[] = { 0.05f, 0.2f };
+    for (float budget : budgets) {
+        GuardResult g = benchGuard(budget, blockSize, 3.0);
+        printf("    budget %.2f: density scale %.3f, load %.3f, %d grains\n",
+               budget, g.densityScale, g.cpuLoad, g.activeGrains);
+    }
+}
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline benchmark for GranularEngine
+ * Holds one note with density set so a fixed number of grains overlap, and reports the
+ * per-grain cost and how many concurrent grains one core sustains in real time.
+ * Also checks the CPU guard: with an unreachable density the density scale should
+ * settle and the measured load should hold near the budget
+ */
+class GranularEngineBench {
+public:
+    struct Result {
+        double nsPerGrainSample;  // process() time per grain per output sample (nanoseconds)
+        double meanGrains;        // Average concurrent grains while measuring
+        double grainsPerCore;     // Concurrent grains at 100% of one core
+    };
+    
+    struct GuardResult {
+        float densityScale;       // Settled density scale
+        float cpuLoad;            // Smoothed load reported by the engine
+        int activeGrains;         // Grains sounding at the end of the run
+    };
+    
+    // Render seconds of stereo output with ~targetGrains overlapping grainSizeMs grains
+    static Result benchGrains(int targetGrains, float grainSizeMs, int blockSize, bool stereoSource, double seconds);
+    
+    // Run with a deliberately excessive density under cpuBudget
+    static GuardResult benchGuard(float cpuBudget, int blockSize, double seconds);
+    
+    // Print grain-count scaling and the guard check at 48 kHz
+    static void runAll();
+};
+
+} // namespace Debug
+} // namespace Core
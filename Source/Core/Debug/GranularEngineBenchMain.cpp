@@ -0,0 +1,19 @@
+#include "GranularEngineBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneGranularBench target
+//   Op1CloneGranularBench
+// Prints the per-grain cost and grains per core for a held granular note at several grain
+// counts, then the CPU guard's settled density scale and load at a few budgets
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneGranularBench\n"
+               "  Holds one GranularEngine note at 48 kHz with a fixed number of overlapping grains,\n"
+               "  then checks that the CPU guard holds an excessive density near its budget.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    Core::Debug::GranularEngineBench::runAll();
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "OrbitModeBench.h"
+#include "../SamplerEngine.h"
+#include "../DSP/OrbitBlender.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+constexpr double benchSampleRate = 48000.0;
+constexpr float benchRateHz = 2.0f;  // Fast orbit so weights change noticeably every block
+
+// Ten seconds of a sine per slot (different frequency each) so voices never reach the end
+SampleDataPtr makeSlotSample(int slot) {
+    auto data = std::make_shared<SampleData>();
+    int length = static_cast<int>(benchSampleRate * 10.0);
+    double freq = 220.0 * (1.0 + 0.25 * slot);
+    data->mono.resize(static_cast<size_t>(length));
+    data->right.resize(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i) {
+        float s = static_cast<float>(0.3 * std::sin(2.0 * M_PI * freq * static_cast<double>(i) / benchSampleRate));
+        data->mono[i] = s;
+        data->right[i] = s;
+    }
+    data->length = length;
+    data->sourceSampleRate = benchSampleRate;
+    return data;
+}
+
+void triggerSlot(SamplerEngine& engine, int note, const SampleDataPtr& sample, int blendGroup) {
+    engine.triggerNoteOnWithSample(note, 0.8f, sample, 0.0f, 0, sample->length, 1.0f,
+                                   0.0f, 0.0f, 1.0f, 100.0f, true, 0, sample->length, 0, blendGroup);
+}
+
+} // namespace
+
+OrbitModeBench::Result OrbitModeBench::benchOrbit(int numNotes, int blockSize, int numBlocks) {
+    std::array<SampleDataPtr, 4> samples;
+    for (int s = 0; s < 4; ++s) {
+        samples[s] = makeSlotSample(s);
+    }
+    float dt = static_cast<float>(blockSize) / static_cast<float>(benchSampleRate);
+    Result result;
+    
+    std::vector<float> left(static_cast<size_t>(blockSize)), right(static_cast<size_t>(blockSize));
+    float* output[2] = { left.data(), right.data() };
+    
+    // Before: one engine per slot, mixed with one weight per block
+    {
+        std::array<std::unique_ptr<SamplerEngine>, 4> engines;
+        std::vector<float> tempL(static_cast<size_t>(blockSize)), tempR(static_cast<size_t>(blockSize));
+        float* temp[2] = { tempL.data(), tempR.data() };
+        for (int s = 0; s < 4; ++s) {
+            engines[s] = std::make_unique<SamplerEngine>();
+            engines[s]->prepare(benchSampleRate, blockSize, 2);
+            for (int n = 0; n < numNotes; ++n) {
+                triggerSlot(*engines[s], 48 + n * 3, samples[s], -1);
+            }
+        }
+        DSP::OrbitBlender blender;
+        blender.setRateHz(benchRateHz);
+        
+        double totalUs = 0.0;
+        for (int b = 0; b < numBlocks; ++b) {
+            auto start = std::chrono::steady_clock::now();
+            std::array<float, 4> weights = blender.update(dt);
+            std::fill(left.begin(), left.end(), 0.0f);
+            std::fill(right.begin(), right.end(), 0.0f);
+            for (int s = 0; s < 4; ++s) {
+                std::fill(tempL.begin(), tempL.end(), 0.0f);
+                std::fill(tempR.begin(), tempR.end(), 0.0f);
+                engines[s]->process(temp, 2, blockSize);
+                for (int i = 0; i < blockSize; ++i) {
+                    left[i] += tempL[i] * weights[s];
+                    right[i] += tempR[i] * weights[s];
+                }
+            }
+            totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+        result.usPerBlockSeparate = totalUs / static_cast<double>(numBlocks);
+    }
+    
+    // After: one engine, each voice tagged with its slot and mixed through the weight ramps
+    {
+        auto engine = std::make_unique<SamplerEngine>();
+        engine->prepare(benchSampleRate, blockSize, 2);
+        for (int n = 0; n < numNotes; ++n) {
+            for (int s = 0; s < 4; ++s) {
+                triggerSlot(*engine, 48 + n * 3, samples[s], s);
+            }
+        }
+        DSP::OrbitBlender blender;
+        blender.setRateHz(benchRateHz);
+        std::array<std::vector<float>, 4> ramps;
+        float* rampPtrs[4];
+        const float* weights[4];
+        for (int s = 0; s < 4; ++s) {
+            ramps[s].resize(static_cast<size_t>(blockSize));
+            rampPtrs[s] = ramps[s].data();
+            weights[s] = rampPtrs[s];
+        }
+        
+        double totalUs = 0.0;
+        std::array<float, 4> lastWeights = { 0.25f, 0.25f, 0.25f, 0.25f };
+        result.maxBlockStep = 0.0f;
+        for (int b = 0; b < numBlocks; ++b) {
+            auto start = std::chrono::steady_clock::now();
+            blender.renderWeightRamps(dt, blockSize, rampPtrs);
+            std::fill(left.begin(), left.end(), 0.0f);
+            std::fill(right.begin(), right.end(), 0.0f);
+            engine->setBlendWeights(weights);
+            engine->process(output, 2, blockSize);
+            totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            
+            // Gain continuity across the block edge (the old layout stepped here)
+            for (int s = 0; s < 4; ++s) {
+                result.maxBlockStep = std::max(result.maxBlockStep, std::abs(ramps[s][0] - lastWeights[s]));
+                lastWeights[s] = ramps[s][static_cast<size_t>(blockSize - 1)];
+            }
+        }
+        result.usPerBlockSingle = totalUs / static_cast<double>(numBlocks);
+    }
+    return result;
+}
+
+void OrbitModeBench::runAll() {
+    const int blockSize = 256;
+    const int numBlocks = 400;
+    
+    printf("=== OrbitModeBench (4 slots, %d-sample blocks) ===\n", blockSize);
+    for (int notes : { 1, 3, 6 }) {
+        Result r = benchOrbit(notes, blockSize, numBlocks);
+        printf("  %d notes: separate engines %8.1f us/block  single engine %8.1f us/block  (%.2fx)  max edge step %.5f\n",
+               notes, r.usPerBlockSeparate, r.usPerBlockSingle,
+               (r.usPerBlockSingle > 0.0) ? r.usPerBlockSeparate / r.usPerBlockSingle : 0.0, r.maxBlockStep);
+    }
+}
+
+} // namespace Debug
+} // namespace Core
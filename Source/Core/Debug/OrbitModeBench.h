@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline benchmark for orbit mode rendering
+ * Compares the old layout (one SamplerEngine per slot A-D, mixed with block-constant
+ * weights) against one engine with blend-tagged voices and per-sample weight ramps
+ */
+class OrbitModeBench {
+public:
+    struct Result {
+        double usPerBlockSeparate;  // Four engines + block-constant weights (microseconds)
+        double usPerBlockSingle;    // One engine, weighted voice mix (microseconds)
+        float maxBlockStep;         // Largest sample-to-sample gain step at a block edge (single engine)
+    };
+    
+    // Hold numNotes notes on all four slots for numBlocks blocks of blockSize
+    static Result benchOrbit(int numNotes, int blockSize, int numBlocks);
+    
+    // Print results for 1, 3 and 6 held notes
+    static void runAll();
+};
+
+} // namespace Debug
+} // namespace Core
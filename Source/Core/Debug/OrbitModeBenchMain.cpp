@@ -0,0 +1,19 @@
+#include "OrbitModeBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneOrbitBench target
+//   Op1CloneOrbitBench
+// Prints the per-block cost of four per-slot engines mixed with block-constant weights against
+// one engine with blend-tagged voices, and the largest gain step at a block edge
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneOrbitBench\n"
+               "  Holds 1, 3 and 6 notes on slots A-D in orbit mode and times both render layouts;\n"
+               "  'max edge step' is the largest weight jump between blocks in the single engine.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    Core::Debug::OrbitModeBench::runAll();
+    return 0;
+}
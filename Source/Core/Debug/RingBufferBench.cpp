@@ -0,0 +1,266 @@
+#include "RingBufferBench.h"
+#include "../DSP/PlanarRingBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+// AudioRingBuffer before the port: interleaved storage, one frame and channel at a time
+class LegacyStereoRing {
+public:
+    explicit LegacyStereoRing(int frames) : capacity(frames), storage(static_cast<size_t>(frames) * 2, 0.0f) {}
+    
+    int push(const float* const* in, int frames) {
+        int toPush = std::min(frames, capacity - available);
+        for (int f = 0; f < toPush; ++f) {
+            int writeIdx = (writePos + f) & (capacity - 1);
+            for (int ch = 0; ch < 2; ++ch) {
+                storage[static_cast<size_t>(writeIdx * 2 + ch)] = in[ch][f];
+            }
+        }
+        writePos = (writePos + toPush) & (capacity - 1);
+        available += toPush;
+        return toPush;
+    }
+    
+    int pop(float* const* out, int frames) {
+        int toPop = std::min(frames, available);
+        for (int f = 0; f < toPop; ++f) {
+            int readIdx = (readPos + f) & (capacity - 1);
+            for (int ch = 0; ch < 2; ++ch) {
+                out[ch][f] = storage[static_cast<size_t>(readIdx * 2 + ch)];
+            }
+        }
+        readPos = (readPos + toPop) & (capacity - 1);
+        available -= toPop;
+        return toPop;
+    }
+
+private:
+    int capacity;
+    std::vector<float> storage;
+    int readPos = 0;
+    int writePos = 0;
+    int available = 0;
+};
+
+// RingBufferF before the port: modulo on every sample
+class LegacyMonoRing {
+public:
+    explicit LegacyMonoRing(int frames) : cap(frames), buf(static_cast<size_t>(frames), 0.0f) {}
+    
+    int push(const float* in, int n) {
+        int can = std::min(n, cap - size);
+        for (int i = 0; i < can; ++i) {
+            buf[static_cast<size_t>(w)] = in[i];
+            w = (w + 1) % cap;
+        }
+        size += can;
+        return can;
+    }
+    
+    int peek(float* out, int n, int offset) const {
+        int can = std::min(n, size - offset);
+        int idx = (r + offset) % cap;
+        for (int i = 0; i < can; ++i) {
+            out[i] = buf[static_cast<size_t>(idx)];
+            idx = (idx + 1) % cap;
+        }
+        return can;
+    }
+    
+    void discard(int n) {
+        int can = std::min(n, size);
+        r = (r + can) % cap;
+        size -= can;
+    }
+
+private:
+    int cap;
+    std::vector<float> buf;
+    int r = 0;
+    int w = 0;
+    int size = 0;
+};
+
+// Source material that changes every frame so misordered copies show up in the checksum
+std::vector<float> makeSource(int frames, int channel) {
+    std::vector<float> source(static_cast<size_t>(frames));
+    for (int i = 0; i < frames; ++i) {
+        source[static_cast<size_t>(i)] = static_cast<float>(std::sin(0.001 * i + channel) + 1e-6 * i);
+    }
+    return source;
+}
+
+double checksum(const std::vector<float>& data) {
+    double sum = 0.0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        sum += data[i] * static_cast<double>((i % 977) + 1);
+    }
+    return sum;
+}
+
+RingBufferBench::Result finish(double totalNs, int frames, int channels, double sum, double reference) {
+    RingBufferBench::Result result;
+    result.nsPerFrame = (frames > 0) ? totalNs / frames : 0.0;
+    result.gbPerSec = (totalNs > 0.0) ? 2.0 * sizeof(float) * channels * static_cast<double>(frames) / totalNs : 0.0;
+    result.matches = (sum == reference);
+    return result;
+}
+
+const char* pathName(RingBufferBench::Path path) {
+    switch (path) {
+        case RingBufferBench::Path::Legacy: return "legacy loop";
+        case RingBufferBench::Path::Plain: return "memcpy";
+        case RingBufferBench::Path::Mirrored: return "memcpy, mirrored";
+        case RingBufferBench::Path::InPlace: return "in-place span";
+    }
+    return "";
+}
+
+} // namespace
+
+RingBufferBench::Result RingBufferBench::benchStereo(Path path, int capacity, int blockSize, int totalFrames) {
+    const int numBlocks = totalFrames / blockSize;
+    const int frames = numBlocks * blockSize;
+    std::vector<float> source[2] = { makeSource(frames, 0), makeSource(frames, 1) };
+    std::vector<float> sink[2] = { std::vector<float>(static_cast<size_t>(frames)),
+                                   std::vector<float>(static_cast<size_t>(frames)) };
+    
+    LegacyStereoRing legacy(capacity);
+    PlanarRingBuffer<float> ring;
+    ring.allocate(2, capacity, path == Path::Mirrored || path == Path::InPlace);
+    
+    // Keep the ring part-full so reads and writes land at different offsets
+    const int prefill = blockSize / 2;
+    std::vector<float> zeros(static_cast<size_t>(prefill), 0.0f);
+    const float* zeroPtrs[2] = { zeros.data(), zeros.data() };
+    legacy.push(zeroPtrs, prefill);
+    ring.write(zeroPtrs, prefill);
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < numBlocks; ++b) {
+        const size_t at = static_cast<size_t>(b) * static_cast<size_t>(blockSize);
+        const float* in[2] = { source[0].data() + at, source[1].data() + at };
+        // Output lags input by the prefill; the first prefill frames read are zeros
+        float* out[2] = { sink[0].data() + at, sink[1].data() + at };
+        switch (path) {
+            case Path::Legacy:
+                legacy.push(in, blockSize);
+                legacy.pop(out, blockSize);
+                break;
+            case Path::Plain:
+            case Path::Mirrored:
+                ring.write(in, blockSize);
+                ring.read(out, blockSize);
+                break;
+            case Path::InPlace:
+                ring.write(in, blockSize);
+                // Stand-in for a consumer that reads the span directly (the stretcher)
+                for (int ch = 0; ch < 2; ++ch) {
+                    const float* span = ring.readPointer(ch);
+                    std::copy(span, span + blockSize, out[ch]);
+                }
+                ring.discard(blockSize);
+                break;
+        }
+    }
+    double totalNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    
+    // Reference: the source delayed by prefill frames
+    double sum = 0.0;
+    double reference = 0.0;
+    for (int ch = 0; ch < 2; ++ch) {
+        std::vector<float> expected(static_cast<size_t>(frames), 0.0f);
+        std::copy(source[ch].begin(), source[ch].end() - prefill, expected.begin() + prefill);
+        sum += checksum(sink[ch]) * (ch + 1);
+        reference += checksum(expected) * (ch + 1);
+    }
+    return finish(totalNs, frames, 2, sum, reference);
+}
+
+RingBufferBench::Result RingBufferBench::benchMono(Path path, int capacity, int blockSize, int totalFrames) {
+    const int numBlocks = totalFrames / blockSize;
+    const int frames = numBlocks * blockSize;
+    const int lookahead = blockSize;  // WSOLA peeks a frame ahead of what it discards
+    const int offset = blockSize / 3;
+    std::vector<float> source = makeSource(frames + lookahead, 0);
+    std::vector<float> sink(static_cast<size_t>(frames), 0.0f);
+    
+    LegacyMonoRing legacy(capacity);
+    std::vector<float> storage(static_cast<size_t>(capacity), 0.0f);
+    PlanarRingBuffer<float> ring;
+    if (path == Path::Legacy || path == Path::Plain) {
+        float* channel = storage.data();
+        ring.attach(&channel, 1, capacity);
+    } else {
+        ring.allocate(1, capacity, true);
+    }
+    
+    const float* first = source.data();
+    legacy.push(first, lookahead);
+    ring.write(&first, lookahead);
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < numBlocks; ++b) {
+        const size_t at = static_cast<size_t>(b) * static_cast<size_t>(blockSize);
+        const float* in = source.data() + lookahead + at;
+        float* out = sink.data() + at;
+        switch (path) {
+            case Path::Legacy:
+                legacy.push(in, blockSize);
+                legacy.peek(out, blockSize, offset);
+                legacy.discard(blockSize);
+                break;
+            case Path::Plain:
+            case Path::Mirrored:
+                ring.write(&in, blockSize);
+                ring.peek(&out, blockSize, offset);
+                ring.discard(blockSize);
+                break;
+            case Path::InPlace: {
+                ring.write(&in, blockSize);
+                const float* span = ring.readPointer(0, offset);
+                std::copy(span, span + blockSize, out);
+                ring.discard(blockSize);
+                break;
+            }
+        }
+    }
+    double totalNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    
+    std::vector<float> expected(source.begin() + offset, source.begin() + offset + frames);
+    return finish(totalNs, frames, 1, checksum(sink), checksum(expected));
+}
+
+void RingBufferBench::runAll() {
+    const int capacity = 4096;
+    const int totalFrames = 1 << 22;
+    const int blockSizes[] = { 64, 256, 1000 };
+    const Path paths[] = { Path::Legacy, Path::Plain, Path::Mirrored, Path::InPlace };
+    
+    PlanarRingBuffer<float> probe;
+    probe.allocate(2, capacity, true);
+    printf("=== RingBufferBench (capacity %d, mirrored storage %s) ===\n", capacity,
+           probe.isMirrored() ? "available" : "UNAVAILABLE - mirrored rows use plain storage");
+    
+    for (int blockSize : blockSizes) {
+        printf("  block %4d\n", blockSize);
+        for (Path path : paths) {
+            Result stereo = benchStereo(path, capacity, blockSize, totalFrames);
+            Result mono = benchMono(path, capacity, blockSize, totalFrames);
+            printf("    %-17s stereo push/pop %6.2f ns/frame %6.2f GB/s %s | mono push/peek %6.2f ns/frame %6.2f GB/s %s\n",
+                   pathName(path), stereo.nsPerFrame, stereo.gbPerSec, stereo.matches ? "ok" : "MISMATCH",
+                   mono.nsPerFrame, mono.gbPerSec, mono.matches ? "ok" : "MISMATCH");
+        }
+    }
+}
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,40 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline throughput benchmark for the ring buffers
+ * Compares the per-frame loops AudioRingBuffer and RingBufferF used before
+ * PlanarRingBuffer (interleaved storage with index masking, and modulo per sample)
+ * against bulk memcpy on plain and mirrored storage, plus the in-place span read
+ * SignalsmithStretchWrapper now uses. Block sizes are chosen so most blocks wrap.
+ * Every path's output is checksummed against the reference to catch ordering bugs
+ */
+class RingBufferBench {
+public:
+    struct Result {
+        double nsPerFrame;  // Write + read of one frame (all channels)
+        double gbPerSec;    // Sample bytes moved through the ring (written + read)
+        bool matches;       // Output identical to the legacy loop
+    };
+    
+    enum class Path {
+        Legacy,    // The loop the class used before the port
+        Plain,     // PlanarRingBuffer::write/read, two memcpys on wrap
+        Mirrored,  // PlanarRingBuffer on double-mapped storage, one memcpy
+        InPlace    // Mirrored, reader consumes readPointer() spans without copying
+    };
+    
+    // Stereo push/pop in blockSize frames through a capacity-frame ring (AudioRingBuffer)
+    static Result benchStereo(Path path, int capacity, int blockSize, int totalFrames);
+    
+    // Mono push, peek at an offset, then discard (RingBufferF as WSOLA drives it)
+    static Result benchMono(Path path, int capacity, int blockSize, int totalFrames);
+    
+    // Print every path for a few block sizes
+    static void runAll();
+};
+
+} // namespace Debug
+} // namespace Core
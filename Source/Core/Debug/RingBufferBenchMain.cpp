@@ -0,0 +1,19 @@
+#include "RingBufferBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneRingBufferBench target
+//   Op1CloneRingBufferBench
+// Prints legacy, plain, mirrored and in-place ring buffer throughput for stereo push/pop
+// and mono push/peek at a few block sizes
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneRingBufferBench\n"
+               "  Streams blocks through AudioRingBuffer/RingBufferF loops and PlanarRingBuffer\n"
+               "  (plain, mirrored and in-place reads); 'ok' marks output identical to the legacy loop.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    Core::Debug::RingBufferBench::runAll();
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "SlotParameterBench.h"
+#include "../SlotParameterBlock.h"
+#include "../TripleBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+// Sink so the compiler cannot drop the reads
+volatile float benchSink = 0.0f;
+
+// Fold every field a NoteOn passes to triggerNoteOnWithSample
+inline float consumeBlock(const SlotParameterBlock& p) {
+    return p.repitchSemitones + static_cast<float>(p.startPoint + p.endPoint) + p.sampleGain
+         + p.attackMs + p.decayMs + p.sustain + p.releaseMs
+         + static_cast<float>(p.loopStartPoint + p.loopEndPoint) + (p.loopEnabled ? 1.0f : 0.0f);
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+double SlotParameterBench::benchPlainReads(int numNoteOns) {
+    SlotParameterSet plain;
+    float acc = 0.0f;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numNoteOns; ++i) {
+        acc += consumeBlock(plain.slots[i % SlotParameterSet::NUM_SLOTS]);
+    }
+    double ns = elapsedNs(start);
+    
+    benchSink = acc;
+    return ns / static_cast<double>(numNoteOns);
+}
+
+double SlotParameterBench::benchSnapshotReads(int numNoteOns, int noteOnsPerBlock) {
+    TripleBuffer<SlotParameterSet> buffer;
+    float acc = 0.0f;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numNoteOns; i += noteOnsPerBlock) {
+        const SlotParameterSet& snapshot = buffer.read();
+        for (int n = 0; n < noteOnsPerBlock; ++n) {
+            acc += consumeBlock(snapshot.slots[(i + n) % SlotParameterSet::NUM_SLOTS]);
+        }
+    }
+    double ns = elapsedNs(start);
+    
+    benchSink = acc;
+    return ns / static_cast<double>(numNoteOns);
+}
+
+double SlotParameterBench::benchSnapshotReadsWithWriter(int numNoteOns, int noteOnsPerBlock) {
+    TripleBuffer<SlotParameterSet> buffer;
+    std::atomic<bool> running{true};
+    
+    // Writer publishes a self-consistent set: every field of a slot carries the same value,
+    // so a torn read shows up as mismatched fields
+    std::thread writer([&buffer, &running]() {
+        SlotParameterSet set;
+        int counter = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            for (auto& slot : set.slots) {
+                slot.startPoint = counter;
+                slot.endPoint = counter;
+                slot.loopStartPoint = counter;
+                slot.loopEndPoint = counter;
+            }
+            buffer.write(set);
+            ++counter;
+        }
+    });
+    
+    float acc = 0.0f;
+    int tornReads = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numNoteOns; i += noteOnsPerBlock) {
+        const SlotParameterSet& snapshot = buffer.read();
+        for (int n = 0; n < noteOnsPerBlock; ++n) {
+            const SlotParameterBlock& p = snapshot.slots[(i + n) % SlotParameterSet::NUM_SLOTS];
+            if (p.startPoint != p.endPoint || p.startPoint != p.loopStartPoint || p.startPoint != p.loopEndPoint
+                || p.startPoint != snapshot.slots[0].startPoint) {
+                ++tornReads;
+            }
+            acc += consumeBlock(p);
+        }
+    }
+    double ns = elapsedNs(start);
+    
+    running.store(false, std::memory_order_relaxed);
+    writer.join();
+    
+    if (tornReads > 0) {
+        printf("FAIL: %d torn snapshot reads\n", tornReads);
+    }
+    benchSink = acc;
+    return ns / static_cast<double>(numNoteOns);
+}
+
+void SlotParameterBench::runAll() {
+    const int numNoteOns = 10000000;
+    const int noteOnsPerBlock = 8;  // Busy block: chord across stacked slots
+    
+    printf("Running SlotParameter read benchmarks (%d NoteOns)...\n\n", numNoteOns);
+    printf("Plain struct reads:            %.2f ns/NoteOn\n", benchPlainReads(numNoteOns));
+    printf("Snapshot reads:                %.2f ns/NoteOn\n", benchSnapshotReads(numNoteOns, noteOnsPerBlock));
+    printf("Snapshot reads (1 NoteOn/blk): %.2f ns/NoteOn\n", benchSnapshotReads(numNoteOns, 1));
+    printf("Snapshot reads + live writer:  %.2f ns/NoteOn\n", benchSnapshotReadsWithWriter(numNoteOns, noteOnsPerBlock));
+}
+
+} // namespace Debug
+} // namespace Core
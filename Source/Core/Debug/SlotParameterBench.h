@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline benchmark for per-slot parameter snapshot reads
+ * Measures the audio-thread cost of reading slot parameters per NoteOn
+ */
+class SlotParameterBench {
+public:
+    // Baseline: field-by-field reads from a plain struct array (previous adapter behaviour)
+    // Returns nanoseconds per NoteOn
+    static double benchPlainReads(int numNoteOns);
+    
+    // TripleBuffer: one read() per block, then per-NoteOn field reads from the snapshot
+    // Returns nanoseconds per NoteOn
+    static double benchSnapshotReads(int numNoteOns, int noteOnsPerBlock);
+    
+    // Same as benchSnapshotReads, with a writer thread publishing continuously
+    // (worst case: knob sweep while playing). Returns nanoseconds per NoteOn
+    static double benchSnapshotReadsWithWriter(int numNoteOns, int noteOnsPerBlock);
+    
+    // Run all benchmarks and print results
+    static void runAll();
+};
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,19 @@
+#include "SlotParameterBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneSlotParamBench target
+//   Op1CloneSlotParamBench
+// Prints the audio-thread cost per NoteOn of reading slot parameters from a plain struct array
+// and from a TripleBuffer snapshot, with and without a writer publishing continuously
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneSlotParamBench\n"
+               "  Times per-NoteOn slot parameter reads: plain struct fields against one TripleBuffer\n"
+               "  snapshot per block, including a writer thread publishing throughout.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    Core::Debug::SlotParameterBench::runAll();
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "StretchBackendBench.h"
+#include "../DSP/SignalsmithStretchWrapper.h"
+#include "../PitchShiftTSM.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+StretchBackendBench::Result StretchBackendBench::benchVoice(double sampleRate, int blockSize, double seconds) {
+    SignalsmithStretchWrapper stretch;
+    stretch.prepare(sampleRate, 2, blockSize);
+    stretch.setTimeRatio(1.0);
+    stretch.setPitchSemitones(7.0f);  // Typical warp voice: constant duration, shifted pitch
+    
+    std::vector<float> inL(static_cast<size_t>(blockSize)), inR(static_cast<size_t>(blockSize));
+    std::vector<float> outL(static_cast<size_t>(blockSize)), outR(static_cast<size_t>(blockSize));
+    const float* input[2] = { inL.data(), inR.data() };
+    float* output[2] = { outL.data(), outR.data() };
+    
+    int numBlocks = static_cast<int>(seconds * sampleRate / blockSize);
+    double phase = 0.0;
+    double totalUs = 0.0;
+    for (int b = 0; b < numBlocks; ++b) {
+        // Harmonic-rich input so every spectral bin does real work
+        for (int i = 0; i < blockSize; ++i) {
+            float s = static_cast<float>(0.3 * std::sin(phase) + 0.1 * std::sin(3.0 * phase) + 0.05 * std::sin(7.1 * phase));
+            inL[static_cast<size_t>(i)] = s;
+            inR[static_cast<size_t>(i)] = s;
+            phase += 2.0 * M_PI * 220.0 / sampleRate;
+        }
+        auto start = std::chrono::steady_clock::now();
+        stretch.process(input, blockSize, output, blockSize);
+        totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    Result result;
+    result.usPerBlock = (numBlocks > 0) ? totalUs / numBlocks : 0.0;
+    double audioUs = 1.0e6 * blockSize / sampleRate;
+    result.realtimeLoad = (audioUs > 0.0) ? result.usPerBlock / audioUs : 0.0;
+    result.latencySamples = stretch.getLatencyFrames();
+    return result;
+}
+
+StretchBackendBench::Result StretchBackendBench::benchPitchShiftTSM(double sampleRate, int blockSize, double seconds) {
+    PitchShiftTSM shifter;
+    shifter.prepare(TimePitchConfig{ 2, sampleRate, blockSize });
+    shifter.setTimeRatio(1.0f);
+    shifter.setPitchSemitones(7.0f);
+    
+    std::vector<float> input(static_cast<size_t>(blockSize) * 2);
+    std::vector<float> output(static_cast<size_t>(blockSize) * 2);
+    
+    int numBlocks = static_cast<int>(seconds * sampleRate / blockSize);
+    double phase = 0.0;
+    double totalUs = 0.0;
+    for (int b = 0; b < numBlocks; ++b) {
+        for (int i = 0; i < blockSize; ++i) {
+            float s = static_cast<float>(0.3 * std::sin(phase) + 0.1 * std::sin(3.0 * phase) + 0.05 * std::sin(7.1 * phase));
+            input[static_cast<size_t>(i) * 2] = s;
+            input[static_cast<size_t>(i) * 2 + 1] = s;
+            phase += 2.0 * M_PI * 220.0 / sampleRate;
+        }
+        auto start = std::chrono::steady_clock::now();
+        shifter.process(input.data(), blockSize, output.data(), blockSize);
+        totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    Result result;
+    result.usPerBlock = (numBlocks > 0) ? totalUs / numBlocks : 0.0;
+    double audioUs = 1.0e6 * blockSize / sampleRate;
+    result.realtimeLoad = (audioUs > 0.0) ? result.usPerBlock / audioUs : 0.0;
+    result.latencySamples = shifter.getInputLatency() + shifter.getOutputLatency();
+    return result;
+}
+
+void StretchBackendBench::runAll() {
+    const int blockSize = 512;
+    const double seconds = 10.0;
+    const double rates[] = { 44100.0, 48000.0, 96000.0 };
+    
+    printf("=== StretchBackendBench (%d-sample blocks, stereo, +7 semitones) ===\n", blockSize);
+    for (int backend = 0; backend < 2; ++backend) {
+        if (backend == 0) {
+            printf("  Signalsmith Stretch (FFT backend: %s)\n", SignalsmithStretchWrapper::getBackendName());
+        } else {
+            printf("  PitchShiftTSM (phase-locked vocoder)\n");
+        }
+        for (double rate : rates) {
+            Result r = (backend == 0) ? benchVoice(rate, blockSize, seconds)
+                                      : benchPitchShiftTSM(rate, blockSize, seconds);
+            printf("    %6.1f kHz: %8.1f us/block  %5.1f%% of one core per voice  (~%d voices per core)  latency %d (%.1f ms)\n",
+                   rate / 1000.0, r.usPerBlock, r.realtimeLoad * 100.0,
+                   (r.realtimeLoad > 0.0) ? static_cast<int>(1.0 / r.realtimeLoad) : 0,
+                   r.latencySamples, 1000.0 * r.latencySamples / rate);
+        }
+    }
+}
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline benchmark for the pitch-shift backends
+ * Measures per-voice cost and latency of SignalsmithStretchWrapper::process (Signalsmith
+ * Stretch on signalsmith-linear) and of PitchShiftTSM (phase-locked vocoder) at common
+ * host rates. Build once per OP1_STRETCH_BACKEND setting to compare FFT backends
+ */
+class StretchBackendBench {
+public:
+    struct Result {
+        double usPerBlock;       // Average process() time per block (microseconds)
+        double realtimeLoad;     // Processing time / audio time for one voice (1.0 = one full core)
+        int latencySamples;      // Reported processing latency
+    };
+    
+    // Pitch-shift seconds of audio through one stereo stretcher in blocks of blockSize
+    static Result benchVoice(double sampleRate, int blockSize, double seconds);
+    
+    // Same workload through PitchShiftTSM (stereo, interleaved)
+    static Result benchPitchShiftTSM(double sampleRate, int blockSize, double seconds);
+    
+    // Print results at 44.1, 48 and 96 kHz for both backends
+    static void runAll();
+};
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,19 @@
+#include "StretchBackendBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneStretchBench target
+//   Op1CloneStretchBench
+// Per-voice pitch-shift cost at 44.1/48/96 kHz for the configured OP1_STRETCH_BACKEND and
+// PitchShiftTSM; build once per backend to compare them
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneStretchBench\n"
+               "  Times one stereo voice (+7 semitones, 512-sample blocks) through Signalsmith Stretch\n"
+               "  and PitchShiftTSM at 44.1, 48 and 96 kHz.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    Core::Debug::StretchBackendBench::runAll();
+    return 0;
+}
@@ -0,0 +1,240 @@
+#include "../TelemetrySegment.h"
+#include "../QualityGovernor.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Entry point for the Op1CloneTelemetry target
+//   Op1CloneTelemetry [--list] [<segment>] [--tail [<ms>]]
+// Reads the shared-memory segment a running engine publishes (SamplerEngine::enableTelemetry):
+// a snapshot by default, or one line per interval with --tail. Runs without the editor,
+// the host or JUCE
+
+namespace {
+
+using Core::TelemetryLayout;
+using Core::TelemetryPop;
+using Core::TelemetryReader;
+using Core::TelemetryStatus;
+
+constexpr int RECENT_POPS = 8;
+
+const char* qualityName(int32_t level) {
+    return Core::QualityGovernor::getLevelName(static_cast<Core::QualityLevel>(level));
+}
+
+void printUsage() {
+    printf("Usage: Op1CloneTelemetry [--list] [<segment>] [--tail [<ms>]]\n"
+           "  --list     list telemetry segments (Linux: /dev/shm/op1clone-*)\n"
+           "  <segment>  segment to read, e.g. /op1clone-4242-0 (default: the only live one)\n"
+           "  --tail     print load, voices, steals and pops every <ms> (default 500) until the\n"
+           "             writer stops; exit code 1 when it exits\n");
+}
+
+// Upper edge of the bin holding the given fraction of blocks (as CallbackLoadMeter::getStats)
+float percentile(const uint64_t* counts, double fraction) {
+    uint64_t total = 0;
+    for (int i = 0; i < TelemetryLayout::LOAD_BINS; ++i) {
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0.0f;
+    }
+    const uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < TelemetryLayout::LOAD_BINS; ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return static_cast<float>(i + 1) / 100.0f;
+        }
+    }
+    return static_cast<float>(TelemetryLayout::LOAD_BINS) / 100.0f;
+}
+
+float toDb(float peak) {
+    return peak > 0.0f ? 20.0f * std::log10(peak) : -INFINITY;
+}
+
+void printPop(const TelemetryPop& pop, double sampleRate) {
+    const double seconds = sampleRate > 0.0 ? static_cast<double>(pop.frame) / sampleRate : 0.0;
+    printf("  pop #%llu at %.3f s (frame %llu): step %.3f, peak %.3f\n",
+           static_cast<unsigned long long>(pop.index), seconds, static_cast<unsigned long long>(pop.frame),
+           pop.mixDelta, pop.mixPeak);
+}
+
+// The named segment, or the only segment whose writer is still running (name is set to it)
+bool openSegment(TelemetryReader& reader, std::string& name) {
+    if (!name.empty()) {
+        if (!reader.open(name)) {
+            fprintf(stderr, "%s\n", reader.getError().c_str());
+            return false;
+        }
+        return true;
+    }
+    std::string found;
+    int live = 0;
+    for (const auto& candidate : TelemetryReader::listSegments()) {
+        TelemetryReader probe;
+        if (probe.open(candidate) && probe.isWriterAlive()) {
+            found = candidate;
+            ++live;
+        }
+    }
+    if (live != 1) {
+        fprintf(stderr, live == 0 ? "No running engine publishes telemetry\n"
+                                  : "Several engines publish telemetry - name one (see --list)\n");
+        return false;
+    }
+    name = found;
+    return reader.open(name);
+}
+
+int listSegments() {
+    auto names = TelemetryReader::listSegments();
+    if (names.empty()) {
+        printf("No telemetry segments\n");
+    }
+    for (const auto& name : names) {
+        TelemetryReader reader;
+        if (!reader.open(name)) {
+            printf("%-28s %s\n", name.c_str(), reader.getError().c_str());
+            continue;
+        }
+        TelemetryStatus status;
+        reader.readStatus(status);
+        printf("%-28s pid %-7d %-8s %llu blocks\n", name.c_str(), reader.getWriterPid(),
+               reader.isWriterAlive() ? "running" : "exited", static_cast<unsigned long long>(status.blocks));
+    }
+    return 0;
+}
+
+int printSnapshot(const TelemetryReader& reader, const std::string& name) {
+    TelemetryStatus status;
+    if (!reader.readStatus(status)) {
+        fprintf(stderr, "Status record is stuck mid-update (writer died while publishing?)\n");
+        return 1;
+    }
+    std::vector<uint64_t> histogram(TelemetryLayout::LOAD_BINS);
+    reader.readLoadHistogram(histogram.data());
+    std::vector<TelemetryPop> pops;
+    const uint64_t popCount = reader.readPops(0, pops);
+    
+    const double seconds = status.sampleRate > 0.0 ? static_cast<double>(status.frames) / status.sampleRate : 0.0;
+    printf("%s  pid %d (%s)\n", name.c_str(), reader.getWriterPid(), reader.isWriterAlive() ? "running" : "exited");
+    printf("  blocks      %llu (%.1f s of audio), block %d @ %.0f Hz\n",
+           static_cast<unsigned long long>(status.blocks), seconds, status.blockSize, status.sampleRate);
+    printf("  voices      %d active, %d stolen, %d dropped note-ons\n",
+           status.activeVoices, status.voicesStolen, status.droppedNotes);
+    printf("  output      peak %.1f dBFS, %d clipped samples last block, %llu total\n",
+           toDb(status.blockPeak), status.clippedSamples, static_cast<unsigned long long>(status.clippedTotal));
+    printf("  load        last %.0f%%, p50 %.0f%%, p99 %.0f%%, max %.0f%%, %llu overruns\n",
+           100.0f * status.load, 100.0f * percentile(histogram.data(), 0.50),
+           100.0f * percentile(histogram.data(), 0.99), 100.0f * status.maxLoad,
+           static_cast<unsigned long long>(status.overruns));
+    printf("  quality     %s\n", qualityName(status.qualityLevel));
+    printf("  pops        %llu\n", static_cast<unsigned long long>(popCount));
+    const size_t first = pops.size() > RECENT_POPS ? pops.size() - RECENT_POPS : 0;
+    for (size_t i = first; i < pops.size(); ++i) {
+        printPop(pops[i], status.sampleRate);
+    }
+    return 0;
+}
+
+int tail(const TelemetryReader& reader, int intervalMs) {
+    TelemetryStatus previous;
+    reader.readStatus(previous);
+    std::vector<uint64_t> previousHistogram(TelemetryLayout::LOAD_BINS);
+    std::vector<uint64_t> histogram(TelemetryLayout::LOAD_BINS);
+    std::vector<uint64_t> intervalHistogram(TelemetryLayout::LOAD_BINS);
+    reader.readLoadHistogram(previousHistogram.data());
+    std::vector<TelemetryPop> pops;
+    uint64_t popCount = reader.readPops(0, pops);
+    pops.clear();
+    
+    printf("%8s %7s %6s %6s %6s %6s %8s %7s %7s %5s %8s\n",
+           "time s", "blocks", "p50%", "p99%", "max%", "voices", "peak dB", "clipped", "stolen", "pops", "quality");
+    const auto start = std::chrono::steady_clock::now();
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        TelemetryStatus status;
+        if (!reader.readStatus(status)) {
+            fprintf(stderr, "Status record is stuck mid-update\n");
+            return 1;
+        }
+        reader.readLoadHistogram(histogram.data());
+        for (int i = 0; i < TelemetryLayout::LOAD_BINS; ++i) {
+            intervalHistogram[i] = histogram[i] - previousHistogram[i];
+        }
+        const uint64_t newPopCount = reader.readPops(popCount, pops);
+        
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const uint64_t blocks = status.blocks - previous.blocks;
+        if (blocks == 0) {
+            if (!reader.isWriterAlive()) {
+                printf("%8.1f writer (pid %d) exited\n", elapsed, reader.getWriterPid());
+                return 1;
+            }
+            printf("%8.1f %7s  (audio stopped)\n", elapsed, "0");
+        } else {
+            printf("%8.1f %7llu %6.0f %6.0f %6.0f %6d %8.1f %7llu %7d %5llu %8s\n", elapsed,
+                   static_cast<unsigned long long>(blocks),
+                   100.0f * percentile(intervalHistogram.data(), 0.50),
+                   100.0f * percentile(intervalHistogram.data(), 0.99),
+                   100.0f * status.maxLoad, status.activeVoices, toDb(status.blockPeak),
+                   static_cast<unsigned long long>(status.clippedTotal - previous.clippedTotal),
+                   status.voicesStolen - previous.voicesStolen,
+                   static_cast<unsigned long long>(newPopCount - popCount), qualityName(status.qualityLevel));
+        }
+        for (const auto& pop : pops) {
+            printPop(pop, status.sampleRate);
+        }
+        fflush(stdout);
+        
+        pops.clear();
+        popCount = newPopCount;
+        previous = status;
+        previousHistogram.swap(histogram);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string name;
+    bool list = false;
+    int tailMs = 0;
+    
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--list") == 0) {
+            list = true;
+        } else if (std::strcmp(arg, "--tail") == 0) {
+            tailMs = 500;
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                tailMs = std::atoi(argv[++i]);
+            }
+        } else if (arg[0] != '-' && name.empty()) {
+            name = arg;
+        } else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+    }
+    
+    if (list) {
+        return listSegments();
+    }
+    TelemetryReader reader;
+    if (!openSegment(reader, name)) {
+        return 1;
+    }
+    if (tailMs > 0) {
+        return tail(reader, tailMs);
+    }
+    return printSnapshot(reader, name);
+}
@@ -0,0 +1,336 @@
+#include "TimePitchMatrixBench.h"
+#include "../WSOLA.h"
+#include "../PitchShiftTSM.h"
+#include "../TimePitchProcessor.h"
+#include "../SignalsmithTimePitch.h"
+#include "../SimpleFFT.h"
+#include "../RealtimeSanitizer.h"
+#include "../DSP/SignalsmithStretchWrapper.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+constexpr int ANALYSIS_SIZE = 8192;   // Settled output analysed for quality (power of 2)
+constexpr double FUNDAMENTAL = 220.0;
+constexpr int NUM_PARTIALS = 3;
+constexpr double PARTIAL_GAINS[NUM_PARTIALS] = { 0.3, 0.15, 0.1 };
+
+// WSOLA is push-driven (it emits whatever its input allows); a small FIFO turns it
+// into the pull-style adapter the other backends already match
+class WsolaBackend : public TimePitchMatrixBench::Backend {
+public:
+    const char* getName() const override { return "WSOLA"; }
+    bool supportsPitch() const override { return false; }
+    bool supportsStretch() const override { return true; }
+    
+    void prepare(double sampleRate, int maxBlockSize) override {
+        wsola.prepare(sampleRate);
+        // Worst case per call: 4x input at stretch 2 plus one frame already in flight
+        scratch.assign(static_cast<size_t>(maxBlockSize) * 4 + WSOLA::DEFAULT_FRAME_SIZE * 4, 0.0f);
+        pending.assign(scratch.size() * 2, 0.0f);
+        pendingCount = 0;
+    }
+    
+    void reset() override {
+        wsola.reset();
+        pendingCount = 0;
+    }
+    
+    void setParameters(float, float stretch) override {
+        wsola.setTimeScale(stretch);
+    }
+    
+    int process(const float* in, int inN, float* out, int outN) override {
+        int produced = wsola.process(in, inN, scratch.data(), static_cast<int>(scratch.size()));
+        int room = static_cast<int>(pending.size()) - pendingCount;
+        produced = std::min(produced, room);
+        std::memcpy(pending.data() + pendingCount, scratch.data(), static_cast<size_t>(produced) * sizeof(float));
+        pendingCount += produced;
+        
+        int toCopy = std::min(outN, pendingCount);
+        std::memcpy(out, pending.data(), static_cast<size_t>(toCopy) * sizeof(float));
+        std::memmove(pending.data(), pending.data() + toCopy, static_cast<size_t>(pendingCount - toCopy) * sizeof(float));
+        pendingCount -= toCopy;
+        return toCopy;
+    }
+    
+    int getLatency() const override {
+        // First frame needs hop + seek + frame samples of input
+        return (wsola.getFrameSize() - wsola.getOverlap()) + wsola.getSeekRange() + wsola.getFrameSize();
+    }
+
+private:
+    WSOLA wsola;
+    std::vector<float> scratch;
+    std::vector<float> pending;
+    int pendingCount = 0;
+};
+
+// Any ITimePitch (interleaved, one channel here)
+class TimePitchBackend : public TimePitchMatrixBench::Backend {
+public:
+    TimePitchBackend(const char* name, ITimePitch* processor, bool canStretch)
+        : name(name)
+        , processor(processor)
+        , canStretch(canStretch) {}
+    
+    const char* getName() const override { return name; }
+    bool supportsPitch() const override { return true; }
+    bool supportsStretch() const override { return canStretch; }
+    
+    void prepare(double sampleRate, int maxBlockSize) override {
+        // Stretch 0.5 feeds two input samples per output sample
+        processor->prepare(TimePitchConfig{ 1, sampleRate, maxBlockSize * 2 });
+    }
+    
+    void reset() override { processor->reset(); }
+    
+    void setParameters(float semitones, float stretch) override {
+        processor->setPitchSemitones(semitones);
+        processor->setTimeRatio(stretch);
+    }
+    
+    int process(const float* in, int inN, float* out, int outN) override {
+        return processor->process(in, inN, out, outN);
+    }
+    
+    int getLatency() const override {
+        return processor->getInputLatency() + processor->getOutputLatency();
+    }
+
+private:
+    const char* name;
+    std::unique_ptr<ITimePitch> processor;
+    bool canStretch;
+};
+
+// TimePitchProcessor over GranularTimeWarp. The granular core restarts its read position
+// per call ("per-block granular OLA"), so it is reset before every block as it would be
+// used; blocks shorter than one grain produce nothing
+class GranularBackend : public TimePitchMatrixBench::Backend {
+public:
+    const char* getName() const override { return "Granular"; }
+    bool supportsPitch() const override { return true; }
+    bool supportsStretch() const override { return false; }
+    
+    void prepare(double sampleRate, int maxBlockSize) override {
+        processor.prepare(sampleRate, maxBlockSize);
+        processor.setEnabled(true);
+    }
+    
+    void reset() override { processor.reset(); }
+    
+    void setParameters(float semitones, float) override {
+        processor.setPitchRatio(std::pow(2.0f, semitones / 12.0f));
+    }
+    
+    int process(const float* in, int inN, float* out, int outN) override {
+        processor.reset();
+        return processor.process(in, inN, out, outN);
+    }
+    
+    int getLatency() const override { return 0; }
+
+private:
+    TimePitchProcessor processor;
+};
+
+// SignalsmithStretchWrapper (IWarpProcessor, planar); its ratio is playback speed
+class StretchWrapperBackend : public TimePitchMatrixBench::Backend {
+public:
+    const char* getName() const override { return "SignalsmithWrapper"; }
+    bool supportsPitch() const override { return true; }
+    bool supportsStretch() const override { return true; }
+    
+    void prepare(double sampleRate, int maxBlockSize) override {
+        stretch.prepare(sampleRate, 1, maxBlockSize * 2);
+    }
+    
+    void reset() override { stretch.reset(); }
+    
+    void setParameters(float semitones, float stretchRatio) override {
+        stretch.setPitchSemitones(semitones);
+        stretch.setTimeRatio(1.0 / stretchRatio);
+    }
+    
+    int process(const float* in, int inN, float* out, int outN) override {
+        const float* input[1] = { in };
+        float* output[1] = { out };
+        return stretch.process(input, inN, output, outN);
+    }
+    
+    int getLatency() const override { return stretch.getLatencyFrames(); }
+
+private:
+    SignalsmithStretchWrapper stretch;
+};
+
+void renderTone(float* out, int numSamples, double sampleRate, double frequencyScale) {
+    for (int i = 0; i < numSamples; ++i) {
+        double t = static_cast<double>(i) / sampleRate;
+        double s = 0.0;
+        for (int p = 0; p < NUM_PARTIALS; ++p) {
+            s += PARTIAL_GAINS[p] * std::sin(2.0 * M_PI * FUNDAMENTAL * frequencyScale * (p + 1) * t);
+        }
+        out[i] = static_cast<float>(s);
+    }
+}
+
+// Hann-windowed magnitude spectrum normalised to unit energy
+void unitMagnitudeSpectrum(SimpleFFT& fft, const float* signal, std::vector<float>& magnitude) {
+    std::vector<float> frame(ANALYSIS_SIZE);
+    std::vector<float> spectrum(ANALYSIS_SIZE + 2);
+    for (int i = 0; i < ANALYSIS_SIZE; ++i) {
+        float w = 0.5f - 0.5f * static_cast<float>(std::cos(2.0 * M_PI * i / ANALYSIS_SIZE));
+        frame[static_cast<size_t>(i)] = signal[i] * w;
+    }
+    fft.forward(frame.data(), spectrum.data());
+    
+    int numBins = ANALYSIS_SIZE / 2 + 1;
+    magnitude.assign(static_cast<size_t>(numBins), 0.0f);
+    double energy = 0.0;
+    for (int k = 0; k < numBins; ++k) {
+        float re = spectrum[static_cast<size_t>(k) * 2];
+        float im = spectrum[static_cast<size_t>(k) * 2 + 1];
+        magnitude[static_cast<size_t>(k)] = std::sqrt(re * re + im * im);
+        energy += static_cast<double>(magnitude[static_cast<size_t>(k)]) * magnitude[static_cast<size_t>(k)];
+    }
+    float scale = (energy > 1.0e-20) ? static_cast<float>(1.0 / std::sqrt(energy)) : 0.0f;
+    for (float& m : magnitude) {
+        m *= scale;
+    }
+}
+
+} // namespace
+
+TimePitchMatrixBench::Cell TimePitchMatrixBench::runCell(Backend& backend, double sampleRate, int blockSize,
+                                                         float semitones, float stretch, double seconds) {
+    Cell cell{};
+    cell.skipped = (semitones != 0.0f && !backend.supportsPitch()) ||
+                   (stretch != 1.0f && !backend.supportsStretch());
+    if (cell.skipped) {
+        return cell;
+    }
+    
+    backend.reset();
+    backend.setParameters(semitones, stretch);
+    cell.latencySamples = backend.getLatency();
+    
+    int numBlocks = std::max(1, static_cast<int>(seconds * sampleRate / blockSize));
+    numBlocks = std::max(numBlocks, (cell.latencySamples + 2 * ANALYSIS_SIZE) / blockSize + 1);
+    int outputLength = numBlocks * blockSize;
+    int inputLength = static_cast<int>(std::ceil(outputLength / stretch)) + blockSize * 2;
+    
+    std::vector<float> input(static_cast<size_t>(inputLength));
+    std::vector<float> output(static_cast<size_t>(outputLength), 0.0f);
+    renderTone(input.data(), inputLength, sampleRate, 1.0);
+    
+    // Output blocks are fixed; input per block follows the stretch with a fractional carry
+    double inputCarry = 0.0;
+    int inputPos = 0;
+    double totalNs = 0.0;
+    RealtimeSanitizer::reset();
+    for (int b = 0; b < numBlocks; ++b) {
+        inputCarry += blockSize / static_cast<double>(stretch);
+        int inN = static_cast<int>(inputCarry);
+        inputCarry -= inN;
+        inN = std::min(inN, inputLength - inputPos);
+        
+        float* out = output.data() + static_cast<size_t>(b) * blockSize;
+        {
+            OP1_REALTIME_SCOPE(realtimeScope);
+            auto start = std::chrono::steady_clock::now();
+            backend.process(input.data() + inputPos, inN, out, blockSize);
+            totalNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+        inputPos += inN;
+    }
+    cell.allocations = RealtimeSanitizer::isEnabled()
+        ? static_cast<long>(RealtimeSanitizer::getViolationCount(RealtimeViolationKind::Allocation))
+        : -1;
+    cell.nsPerSample = totalNs / outputLength;
+    
+    // Quality: last ANALYSIS_SIZE samples (well past latency) against the ideal shifted tone
+    SimpleFFT fft;
+    fft.prepare(ANALYSIS_SIZE);
+    std::vector<float> reference(ANALYSIS_SIZE);
+    renderTone(reference.data(), ANALYSIS_SIZE, sampleRate, std::pow(2.0, semitones / 12.0));
+    std::vector<float> referenceMagnitude, outputMagnitude;
+    unitMagnitudeSpectrum(fft, reference.data(), referenceMagnitude);
+    unitMagnitudeSpectrum(fft, output.data() + (outputLength - ANALYSIS_SIZE), outputMagnitude);
+    
+    double error = 0.0;
+    for (size_t k = 0; k < referenceMagnitude.size(); ++k) {
+        double d = static_cast<double>(outputMagnitude[k]) - referenceMagnitude[k];
+        error += d * d;
+    }
+    // Reference has unit energy, so this is 10*log10(signal / error); silence scores 0 dB
+    cell.qualityDb = -10.0 * std::log10(std::max(error, 1.0e-12));
+    return cell;
+}
+
+bool TimePitchMatrixBench::runAll() {
+    const double sampleRate = 48000.0;
+    const double seconds = 1.0;
+    const float pitches[] = { -24.0f, -12.0f, -7.0f, 0.0f, 7.0f, 12.0f, 24.0f };
+    const float stretches[] = { 0.5f, 0.75f, 1.0f, 1.5f, 2.0f };
+    const int blockSizes[] = { 32, 128, 512, 2048 };
+    const int maxBlockSize = 2048;
+    
+    std::vector<std::unique_ptr<Backend>> backends;
+    backends.emplace_back(new WsolaBackend());
+    backends.emplace_back(new TimePitchBackend("PitchShiftTSM", new PitchShiftTSM(), false));
+    backends.emplace_back(new GranularBackend());
+    backends.emplace_back(new TimePitchBackend("SignalsmithTimePitch", new SignalsmithTimePitch(), true));
+    backends.emplace_back(new StretchWrapperBackend());
+    
+    printf("=== TimePitchMatrixBench (%.0f Hz, mono, %.1f s per cell, allocations %s) ===\n", sampleRate, seconds,
+           RealtimeSanitizer::isEnabled() ? "counted" : "not counted (build with OP1_RT_SANITIZER=1)");
+    printf("  %-20s %6s %7s %6s %10s %8s %7s %10s\n",
+           "backend", "pitch", "stretch", "block", "ns/sample", "latency", "allocs", "SNR dB");
+    long allAllocations = 0;
+    for (auto& backend : backends) {
+        backend->prepare(sampleRate, maxBlockSize);
+        
+        double sumNs = 0.0, sumQuality = 0.0, minQuality = 1.0e9;
+        long totalAllocations = 0;
+        int numCells = 0;
+        for (float pitch : pitches) {
+            for (float stretch : stretches) {
+                for (int blockSize : blockSizes) {
+                    Cell c = runCell(*backend, sampleRate, blockSize, pitch, stretch, seconds);
+                    if (c.skipped) {
+                        continue;
+                    }
+                    printf("  %-20s %+6.0f %7.2f %6d %10.1f %8d %7ld %10.1f\n",
+                           backend->getName(), pitch, stretch, blockSize,
+                           c.nsPerSample, c.latencySamples, c.allocations, c.qualityDb);
+                    sumNs += c.nsPerSample;
+                    sumQuality += c.qualityDb;
+                    minQuality = std::min(minQuality, c.qualityDb);
+                    totalAllocations += std::max(0L, c.allocations);
+                    ++numCells;
+                }
+            }
+        }
+        if (numCells > 0) {
+            printf("  %-20s summary: %d cells, mean %.1f ns/sample, SNR mean %.1f dB / min %.1f dB, %ld allocations\n",
+                   backend->getName(), numCells, sumNs / numCells, sumQuality / numCells, minQuality, totalAllocations);
+        }
+        allAllocations += totalAllocations;
+    }
+    return allAllocations == 0;
+}
+
+} // namespace Debug
+} // namespace Core
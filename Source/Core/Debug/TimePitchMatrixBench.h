@@ -0,0 +1,65 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline benchmark and quality matrix for every time/pitch processor in Core
+ * WSOLA, PitchShiftTSM, TimePitchProcessor (GranularTimeWarp), SignalsmithTimePitch and
+ * SignalsmithStretchWrapper are driven mono through one Backend adapter, so cost and
+ * quality are compared on the same material, block sizes and I/O pattern.
+ *
+ * Each cell renders a harmonic tone at a pitch shift (semitones) and stretch (output
+ * duration / input duration) in fixed output blocks and reports:
+ * - ns per output sample spent inside process()
+ * - reported latency
+ * - heap allocations made during process(), counted by the real-time sanitizer hooks
+ *   (-1 unless built with OP1_RT_SANITIZER=1, as the Op1CloneMatrixBench target is)
+ * - spectral SNR (dB) of the settled output against an ideal render of the shifted
+ *   partials; magnitudes only and energy-normalised, so latency and gain do not count
+ * Cells a backend cannot do (WSOLA has no pitch, the pitch shifters keep duration
+ * constant) are skipped
+ */
+class TimePitchMatrixBench {
+public:
+    /**
+     * Common adapter: mono, pull-style (outN samples wanted per call)
+     */
+    class Backend {
+    public:
+        virtual ~Backend() = default;
+        
+        virtual const char* getName() const = 0;
+        virtual bool supportsPitch() const = 0;
+        virtual bool supportsStretch() const = 0;
+        
+        virtual void prepare(double sampleRate, int maxBlockSize) = 0;
+        virtual void reset() = 0;
+        
+        // semitones: +/- pitch shift; stretch: output duration / input duration
+        virtual void setParameters(float semitones, float stretch) = 0;
+        
+        // Consume inN samples, write up to outN samples; returns samples produced
+        virtual int process(const float* in, int inN, float* out, int outN) = 0;
+        virtual int getLatency() const = 0;
+    };
+    
+    struct Cell {
+        bool skipped;           // Backend cannot do this pitch/stretch combination
+        double nsPerSample;     // process() time per output sample (nanoseconds)
+        int latencySamples;     // Reported latency
+        long allocations;       // Heap allocations during process() (-1: sanitizer off)
+        double qualityDb;       // Spectral SNR against the reference render (higher is better)
+    };
+    
+    // Render seconds of output through backend at one matrix point
+    static Cell runCell(Backend& backend, double sampleRate, int blockSize,
+                        float semitones, float stretch, double seconds);
+    
+    // Print the full matrix (pitch +/-24 st, stretch 0.5-2.0, blocks 32-2048) for every backend;
+    // false if any backend allocated inside process()
+    static bool runAll();
+};
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,18 @@
+#include "TimePitchMatrixBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneMatrixBench target
+//   Op1CloneMatrixBench
+// Prints cost, latency, allocations and SNR for every time/pitch backend over the pitch,
+// stretch and block-size matrix; exit code 1 when a backend allocates inside process()
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneMatrixBench\n"
+               "  Runs WSOLA, PitchShiftTSM, TimePitchProcessor, SignalsmithTimePitch and\n"
+               "  SignalsmithStretchWrapper over pitch +/-24 st, stretch 0.5-2.0 and blocks 32-2048.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    return Core::Debug::TimePitchMatrixBench::runAll() ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "VoiceRenderBench.h"
+#include "../VoiceManager.h"
+#include "../RenderWorkerPool.h"
+#include "../DSP/WarpProcessorPool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+constexpr double benchSampleRate = 48000.0;
+
+// Ten seconds of a detuned saw-ish mix so voices never reach the end of the sample
+SampleDataPtr makeBenchSample() {
+    auto data = std::make_shared<SampleData>();
+    int length = static_cast<int>(benchSampleRate * 10.0);
+    data->mono.resize(static_cast<size_t>(length));
+    data->right.resize(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i) {
+        double t = static_cast<double>(i) / benchSampleRate;
+        data->mono[i] = static_cast<float>(0.3 * std::sin(2.0 * M_PI * 220.0 * t) + 0.1 * std::sin(2.0 * M_PI * 663.0 * t));
+        data->right[i] = static_cast<float>(0.3 * std::sin(2.0 * M_PI * 221.0 * t) + 0.1 * std::sin(2.0 * M_PI * 659.0 * t));
+    }
+    data->length = length;
+    data->sourceSampleRate = benchSampleRate;
+    return data;
+}
+
+// Render with the given pool and return the concatenated stereo output
+std::vector<float> renderBlocks(RenderWorkerPool* pool, const SampleDataPtr& sample, int numVoices, bool warp,
+                                int blockSize, int numBlocks, double& usPerBlock) {
+    auto manager = std::make_unique<VoiceManager>();
+    manager->prepare(blockSize, 2);
+    manager->setRenderPool(pool);
+    WarpProcessorPool warpPool;
+    warpPool.prepare(benchSampleRate, blockSize, warp ? numVoices : 0);
+    manager->setWarpProcessorPool(&warpPool);
+    manager->setWarpEnabled(warp);
+    manager->setEndPoint(sample->length);
+    
+    for (int v = 0; v < numVoices; ++v) {
+        bool wasStolen = false;
+        manager->noteOn(48 + v * 3, 0.8f, sample, wasStolen);
+    }
+    
+    std::vector<float> left(static_cast<size_t>(blockSize)), right(static_cast<size_t>(blockSize));
+    float* output[2] = { left.data(), right.data() };
+    std::vector<float> rendered;
+    rendered.reserve(static_cast<size_t>(blockSize) * 2 * numBlocks);
+    
+    double totalUs = 0.0;
+    for (int b = 0; b < numBlocks; ++b) {
+        std::fill(left.begin(), left.end(), 0.0f);
+        std::fill(right.begin(), right.end(), 0.0f);
+        auto start = std::chrono::steady_clock::now();
+        manager->process(output, 2, blockSize, benchSampleRate);
+        totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        rendered.insert(rendered.end(), left.begin(), left.end());
+        rendered.insert(rendered.end(), right.begin(), right.end());
+    }
+    usPerBlock = totalUs / static_cast<double>(numBlocks);
+    return rendered;
+}
+
+} // namespace
+
+VoiceRenderBench::Result VoiceRenderBench::benchVoices(int numWorkers, int numVoices, bool warp, int blockSize, int numBlocks) {
+    SampleDataPtr sample = makeBenchSample();
+    
+    double serialUs = 0.0;
+    std::vector<float> reference = renderBlocks(nullptr, sample, numVoices, warp, blockSize, numBlocks, serialUs);
+    
+    RenderWorkerPool pool;
+    pool.start(numWorkers);
+    Result result;
+    result.workersStarted = pool.getNumWorkers();
+    std::vector<float> parallel = renderBlocks(&pool, sample, numVoices, warp, blockSize, numBlocks, result.usPerBlock);
+    pool.stop();
+    
+    result.matchesSerial = (reference.size() == parallel.size())
+        && std::memcmp(reference.data(), parallel.data(), reference.size() * sizeof(float)) == 0;
+    if (numWorkers == 0) {
+        result.usPerBlock = serialUs;
+    }
+    return result;
+}
+
+bool VoiceRenderBench::runAll() {
+    const int blockSize = 256;
+    const int numBlocks = 400;
+    const int numVoices = VoiceManager::MAX_VOICES;
+    
+    printf("=== VoiceRenderBench (%d voices, %d-sample blocks, %u hardware threads) ===\n",
+           numVoices, blockSize, std::thread::hardware_concurrency());
+    bool allMatch = true;
+    for (int warp = 0; warp <= 1; ++warp) {
+        printf("%s voices:\n", warp ? "Warp" : "Resampled");
+        double baseline = 0.0;
+        for (int workers = 0; workers <= RenderWorkerPool::MAX_WORKERS; ++workers) {
+            Result r = benchVoices(workers, numVoices, warp != 0, blockSize, numBlocks);
+            if (workers == 0) {
+                baseline = r.usPerBlock;
+            }
+            printf("  workers=%d (started %d)  %8.1f us/block  speedup %.2fx  %s%s\n", workers, r.workersStarted, r.usPerBlock,
+                   (r.usPerBlock > 0.0) ? baseline / r.usPerBlock : 0.0,
+                   r.matchesSerial ? "bit-identical" : "MISMATCH",
+                   (r.workersStarted < workers) ? "  (clamped to spare cores)" : "");
+            allMatch = allMatch && r.matchesSerial;
+        }
+    }
+    return allMatch;
+}
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline benchmark for parallel voice rendering (RenderWorkerPool)
+ * Renders a full voice pool and reports block cost and speedup for 1-8 workers,
+ * and checks the parallel output is bit-identical to serial rendering
+ */
+class VoiceRenderBench {
+public:
+    struct Result {
+        double usPerBlock;     // Average render time per block (microseconds)
+        bool matchesSerial;    // Output bit-identical to 0-worker rendering
+        int workersStarted;    // Workers actually started (the pool clamps to spare cores)
+    };
+    
+    // Render numBlocks blocks of blockSize with numVoices held notes
+    // warp: enable time-warp on every voice (the expensive path the pool targets)
+    static Result benchVoices(int numWorkers, int numVoices, bool warp, int blockSize, int numBlocks);
+    
+    // Print scaling curves (0 = serial baseline, then 1-8 workers) for plain and warp voices
+    // Returns false if any parallel render differed from serial rendering
+    static bool runAll();
+};
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,18 @@
+#include "VoiceRenderBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneVoiceBench target
+//   Op1CloneVoiceBench
+// Prints serial and 1-8 worker block costs for resampled and warp voices; exit code 1 when
+// a parallel render is not bit-identical to serial rendering
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneVoiceBench\n"
+               "  Renders a full voice pool serially and through RenderWorkerPool with 1-8 workers.\n"
+               "  The pool starts at most (hardware threads - 1) workers; 'started' shows how many ran.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    return Core::Debug::VoiceRenderBench::runAll() ? 0 : 1;
+}
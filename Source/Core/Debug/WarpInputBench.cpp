@@ -0,0 +1,166 @@
+#include "WarpInputBench.h"
+#include "../DSP/SignalsmithStretchWrapper.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+// Distinct harmonic material per voice so no two voices share cache lines
+std::vector<float> makeSample(double sourceRate, double seconds, int voice) {
+    std::vector<float> sample(static_cast<size_t>(sourceRate * seconds));
+    double f0 = 110.0 * std::pow(2.0, voice / 12.0);
+    for (size_t i = 0; i < sample.size(); ++i) {
+        double t = static_cast<double>(i) / sourceRate;
+        sample[i] = static_cast<float>(0.3 * std::sin(2.0 * M_PI * f0 * t) + 0.1 * std::sin(2.0 * M_PI * 3.0 * f0 * t)
+                                       + 0.05 * std::sin(2.0 * M_PI * 5.0 * f0 * t));
+    }
+    return sample;
+}
+
+int chunkFramesFor(int blockSize) {
+    return std::max(512, std::min(1024, blockSize));  // SignalsmithStretchWrapper::prepare
+}
+
+struct Voice {
+    std::vector<float> sample;
+    std::unique_ptr<SignalsmithStretchWrapper> stretch;
+    std::vector<float> input[2];
+    std::vector<float> output[2];
+    double playhead = 0.0;
+    WarpSampleView view;
+};
+
+WarpInputBench::Result runVoices(bool pull, double hostRate, double sourceRate, int blockSize,
+                                 int numVoices, double seconds) {
+    std::vector<Voice> voices(static_cast<size_t>(numVoices));
+    for (int v = 0; v < numVoices; ++v) {
+        Voice& voice = voices[static_cast<size_t>(v)];
+        voice.sample = makeSample(sourceRate, seconds + 1.0, v);
+        voice.stretch = std::make_unique<SignalsmithStretchWrapper>();
+        voice.stretch->prepare(hostRate, 2, blockSize);
+        voice.stretch->setTimeRatio(1.0);
+        voice.stretch->setPitchSemitones(7.0f);
+        for (int ch = 0; ch < 2; ++ch) {
+            voice.input[ch].assign(static_cast<size_t>(blockSize), 0.0f);
+            voice.output[ch].assign(static_cast<size_t>(blockSize), 0.0f);
+        }
+        voice.view.channels[0] = voice.sample.data();
+        voice.view.channels[1] = voice.sample.data();
+        voice.view.startFrame = 0;
+        voice.view.endFrame = static_cast<int>(voice.sample.size());
+        voice.view.sampleRate = sourceRate;
+    }
+    
+    const double speed = sourceRate / hostRate;
+    const int numBlocks = static_cast<int>(seconds * hostRate / blockSize);
+    const int settleBlocks = numBlocks / 4;
+    double totalNs = 0.0;
+    double sumSquares = 0.0;
+    long rmsFrames = 0;
+    
+    for (int b = 0; b < numBlocks; ++b) {
+        auto start = std::chrono::steady_clock::now();
+        for (Voice& voice : voices) {
+            float* out[2] = { voice.output[0].data(), voice.output[1].data() };
+            if (pull) {
+                voice.stretch->processPull(voice.view, out, blockSize);
+            } else {
+                // SamplerVoice's former warp input: interpolate at source speed, duplicate mono
+                const float* data = voice.sample.data();
+                const int last = static_cast<int>(voice.sample.size()) - 1;
+                for (int i = 0; i < blockSize; ++i) {
+                    int index0 = std::min(last, static_cast<int>(voice.playhead));
+                    int index1 = std::min(last, index0 + 1);
+                    float fraction = static_cast<float>(voice.playhead - static_cast<double>(index0));
+                    float s = data[index0] * (1.0f - fraction) + data[index1] * fraction;
+                    voice.input[0][static_cast<size_t>(i)] = s;
+                    voice.input[1][static_cast<size_t>(i)] = s;
+                    voice.playhead += speed;
+                }
+                const float* in[2] = { voice.input[0].data(), voice.input[1].data() };
+                voice.stretch->process(in, blockSize, out, blockSize);
+            }
+        }
+        totalNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        
+        if (b >= settleBlocks) {
+            const Voice& voice = voices[0];
+            for (int i = 0; i < blockSize; ++i) {
+                float s = voice.output[0][static_cast<size_t>(i)];
+                sumSquares += static_cast<double>(s) * s;
+            }
+            rmsFrames += blockSize;
+        }
+    }
+    
+    WarpInputBench::Result result;
+    double frames = static_cast<double>(numBlocks) * blockSize * numVoices;
+    result.nsPerSample = (frames > 0.0) ? totalNs / frames : 0.0;
+    result.outputRms = (rmsFrames > 0) ? std::sqrt(sumSquares / static_cast<double>(rmsFrames)) : 0.0;
+    
+    // Stereo float frames are 8 bytes; both paths scan their output once for non-finite values
+    const double frameBytes = 8.0;
+    if (pull) {
+        result.copyBytesPerSample = frameBytes;  // Output scan only
+        result.scratchBytesPerVoice = 0.0;
+    } else {
+        // Interpolate (read mono source, write planar), ring push, ring pop to chunk,
+        // clear chunk output, output scan, output ring push, output ring pop
+        result.copyBytesPerSample = 4.0 * speed + frameBytes                // Voice interpolation
+                                    + 2.0 * frameBytes                      // Input ring push
+                                    + 2.0 * frameBytes                      // Input ring pop
+                                    + frameBytes                            // Chunk output clear
+                                    + frameBytes                            // Output scan
+                                    + 2.0 * frameBytes                      // Output ring push
+                                    + 2.0 * frameBytes;                     // Output ring pop
+        const int chunk = chunkFramesFor(blockSize);
+        result.scratchBytesPerVoice = 4.0 * 2.0 * (blockSize              // Voice planar input
+                                                   + 2 * 4 * blockSize     // Input + output rings
+                                                   + 4 * chunk             // Chunk input
+                                                   + chunk);               // Chunk output
+    }
+    return result;
+}
+
+} // namespace
+
+WarpInputBench::Result WarpInputBench::benchLegacy(double hostRate, double sourceRate, int blockSize,
+                                                   int numVoices, double seconds) {
+    return runVoices(false, hostRate, sourceRate, blockSize, numVoices, seconds);
+}
+
+WarpInputBench::Result WarpInputBench::benchPull(double hostRate, double sourceRate, int blockSize,
+                                                 int numVoices, double seconds) {
+    return runVoices(true, hostRate, sourceRate, blockSize, numVoices, seconds);
+}
+
+void WarpInputBench::runAll() {
+    const int numVoices = 6;
+    const double seconds = 4.0;
+    const int blockSizes[] = { 128, 512 };
+    const double sourceRates[] = { 48000.0, 44100.0 };
+    const double hostRate = 48000.0;
+    
+    printf("=== WarpInputBench (%d voices, 48 kHz host, +7 semitones, constant duration) ===\n", numVoices);
+    for (double sourceRate : sourceRates) {
+        for (int blockSize : blockSizes) {
+            Result legacy = benchLegacy(hostRate, sourceRate, blockSize, numVoices, seconds);
+            Result pull = benchPull(hostRate, sourceRate, blockSize, numVoices, seconds);
+            printf("  source %.1f kHz, block %4d\n", sourceRate / 1000.0, blockSize);
+            printf("    copied blocks: %6.1f ns/sample  %5.1f B copied/sample  %7.0f B scratch/voice  rms %.4f\n",
+                   legacy.nsPerSample, legacy.copyBytesPerSample, legacy.scratchBytesPerVoice, legacy.outputRms);
+            printf("    sample view:   %6.1f ns/sample  %5.1f B copied/sample  %7.0f B scratch/voice  rms %.4f\n",
+                   pull.nsPerSample, pull.copyBytesPerSample, pull.scratchBytesPerVoice, pull.outputRms);
+        }
+    }
+}
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline benchmark for warp voice input: copied blocks vs reading sample memory in place
+ * Legacy path: the voice interpolates numSamples frames into planar buffers, then
+ * SignalsmithStretchWrapper::process copies them through its input ring, a chunk buffer
+ * and its output ring. Pull path: processPull reads a WarpSampleView of the sample and
+ * writes straight to the voice's output buffers.
+ *
+ * Several voices with long, distinct samples run interleaved so the sample memory and
+ * per-voice buffers compete for cache the way a full warped chord does. Copy traffic is
+ * counted from the data movement each path performs outside the stretcher itself.
+ */
+class WarpInputBench {
+public:
+    struct Result {
+        double nsPerSample;          // Wall time per output frame per voice (copies + stretch)
+        double copyBytesPerSample;   // Bytes read + written by copies per output frame
+        double scratchBytesPerVoice; // Intermediate buffers touched per voice (not sample memory)
+        double outputRms;            // Settled output level (both paths should agree)
+    };
+    
+    static Result benchLegacy(double hostRate, double sourceRate, int blockSize, int numVoices, double seconds);
+    static Result benchPull(double hostRate, double sourceRate, int blockSize, int numVoices, double seconds);
+    
+    // Print both paths at matching and mismatched source/host rates
+    static void runAll();
+};
+
+} // namespace Debug
+} // namespace Core
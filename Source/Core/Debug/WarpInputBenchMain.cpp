@@ -0,0 +1,19 @@
+#include "WarpInputBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneWarpBench target
+//   Op1CloneWarpBench
+// Prints copied-block and sample-view warp input cost, copy traffic and scratch per voice
+// for several interleaved voices at matching and mismatched source rates
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneWarpBench\n"
+               "  Runs several warp voices through SignalsmithStretchWrapper with copied input blocks\n"
+               "  and with processPull reading the sample in place; compare the rms of the two paths.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    Core::Debug::WarpInputBench::runAll();
+    return 0;
+}
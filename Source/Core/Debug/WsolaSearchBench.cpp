@@ -0,0 +1,158 @@
+#include "WsolaSearchBench.h"
+#include "../SimilaritySearch.h"
+#include "../WSOLA.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace Core {
+namespace Debug {
+
+namespace {
+
+// Tonal test material: a few detuned harmonic partials plus a little noise
+std::vector<float> makeTonalSignal(int length, double sampleRate) {
+    std::vector<float> signal(static_cast<size_t>(length));
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+    for (int i = 0; i < length; ++i) {
+        double t = i / sampleRate;
+        double s = 0.4 * std::sin(2.0 * M_PI * 110.0 * t)
+                 + 0.2 * std::sin(2.0 * M_PI * 220.7 * t)
+                 + 0.1 * std::sin(2.0 * M_PI * 331.1 * t)
+                 + 0.05 * std::sin(2.0 * M_PI * 1450.0 * t);
+        signal[static_cast<size_t>(i)] = static_cast<float>(s) + noise(rng);
+    }
+    return signal;
+}
+
+// The search WSOLA used before SimilaritySearch: copy each candidate, scalar double NCC
+float referenceCorrelation(const float* a, const float* b, int n) {
+    double dot = 0.0;
+    double ea = 0.0;
+    double eb = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double x = a[i];
+        double y = b[i];
+        dot += x * y;
+        ea += x * x;
+        eb += y * y;
+    }
+    return static_cast<float>(dot / (std::sqrt(ea * eb) + 1e-12));
+}
+
+int referenceSearch(const float* tmpl, const float* region, int overlap, int numOffsets,
+                    std::vector<float>& candidate, float& bestScore) {
+    int bestOffset = 0;
+    bestScore = -1.0f;
+    for (int k = 0; k < numOffsets; ++k) {
+        std::copy(region + k, region + k + overlap, candidate.begin());
+        float score = referenceCorrelation(tmpl, candidate.data(), overlap);
+        if (score > bestScore) {
+            bestScore = score;
+            bestOffset = k;
+        }
+    }
+    return bestOffset;
+}
+
+} // namespace
+
+WsolaSearchBench::Result WsolaSearchBench::benchSearch(int overlap, int seekRange, int numFrames) {
+    const double sampleRate = 44100.0;
+    const int hop = 384;
+    const int numOffsets = 2 * seekRange + 1;
+    const int regionLength = numOffsets + overlap - 1;
+    
+    std::vector<float> signal = makeTonalSignal(numFrames * hop + regionLength + overlap + 2 * seekRange, sampleRate);
+    std::vector<float> candidate(static_cast<size_t>(overlap));
+    
+    SimilaritySearch search;
+    search.prepare(overlap, numOffsets);
+    
+    double exhaustiveUs = 0.0;
+    double searchUs = 0.0;
+    int matches = 0;
+    double scoreLoss = 0.0;
+    volatile int sink = 0;
+    
+    for (int f = 0; f < numFrames; ++f) {
+        // Template: overlap samples at the frame's nominal end; region: +/- seekRange around the next hop
+        const float* tmpl = signal.data() + f * hop + seekRange;
+        const float* region = tmpl + hop - seekRange;
+        
+        float exhaustiveScore = 0.0f;
+        auto t0 = std::chrono::steady_clock::now();
+        int exhaustiveOffset = referenceSearch(tmpl, region, overlap, numOffsets, candidate, exhaustiveScore);
+        auto t1 = std::chrono::steady_clock::now();
+        float searchScore = 0.0f;
+        int searchOffset = search.findBestOffset(tmpl, region, numOffsets, &searchScore);
+        auto t2 = std::chrono::steady_clock::now();
+        
+        exhaustiveUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        searchUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        sink = sink + exhaustiveOffset + searchOffset;
+        
+        float loss = exhaustiveScore - searchScore;
+        if (loss <= 0.01f) {
+            ++matches;
+        }
+        scoreLoss += std::max(0.0f, loss);
+    }
+    
+    Result result;
+    result.usPerFrameExhaustive = exhaustiveUs / numFrames;
+    result.usPerFrameSearch = searchUs / numFrames;
+    result.matchRate = static_cast<double>(matches) / numFrames;
+    result.meanScoreLoss = scoreLoss / numFrames;
+    return result;
+}
+
+double WsolaSearchBench::benchProcess(int frameSize, int overlap, int seekRange) {
+    const double sampleRate = 44100.0;
+    const int blockSize = 256;
+    const double seconds = 10.0;
+    const int numBlocks = static_cast<int>(seconds * sampleRate / blockSize);
+    
+    std::vector<float> signal = makeTonalSignal(numBlocks * blockSize, sampleRate);
+    std::vector<float> output(static_cast<size_t>(blockSize * 8));
+    
+    WSOLA wsola;
+    wsola.prepare(sampleRate, frameSize, overlap, seekRange);
+    wsola.setTimeScale(1.25f);
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < numBlocks; ++b) {
+        wsola.process(signal.data() + b * blockSize, blockSize, output.data(), static_cast<int>(output.size()));
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return us / seconds;
+}
+
+void WsolaSearchBench::runAll() {
+    const int numFrames = 2000;
+    const int configs[][2] = { { 128, 128 }, { 128, 512 }, { 128, 1024 }, { 512, 512 }, { 1024, 1024 } };
+    
+    printf("=== WsolaSearchBench (tonal input, %d frames) ===\n", numFrames);
+    printf("  overlap  seek   exhaustive us  search us  speedup  match   mean loss\n");
+    for (const auto& config : configs) {
+        Result r = benchSearch(config[0], config[1], numFrames);
+        printf("  %7d %5d   %13.2f %10.2f %7.1fx  %5.1f%%  %.5f\n",
+               config[0], config[1], r.usPerFrameExhaustive, r.usPerFrameSearch,
+               (r.usPerFrameSearch > 0.0) ? r.usPerFrameExhaustive / r.usPerFrameSearch : 0.0,
+               r.matchRate * 100.0, r.meanScoreLoss);
+    }
+    
+    printf("  WSOLA::process (1.25x stretch), us per second of audio:\n");
+    const int processConfigs[][3] = { { 512, 128, 128 }, { 512, 128, 512 }, { 2048, 512, 1024 } };
+    for (const auto& config : processConfigs) {
+        printf("    frame %4d overlap %4d seek %4d: %8.1f us/s\n",
+               config[0], config[1], config[2], benchProcess(config[0], config[1], config[2]));
+    }
+}
+
+} // namespace Debug
+} // namespace Core
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Core {
+namespace Debug {
+
+/**
+ * Offline benchmark for the WSOLA overlap search
+ * Compares the previous exhaustive scalar search (one normalised dot product per
+ * candidate) against SimilaritySearch on tonal material, and reports how often the
+ * faster search finds an equally good match
+ */
+class WsolaSearchBench {
+public:
+    struct Result {
+        double usPerFrameExhaustive;  // Scalar search over every offset (microseconds)
+        double usPerFrameSearch;      // SimilaritySearch::findBestOffset (microseconds)
+        double matchRate;             // Frames where the search scored within 0.01 of the exhaustive best
+        double meanScoreLoss;         // Mean (exhaustive best - search score)
+    };
+    
+    // Search numFrames frames with the given overlap and +/- seekRange
+    static Result benchSearch(int overlap, int seekRange, int numFrames);
+    
+    // Whole WSOLA::process cost (microseconds per second of audio) at a 1.25x stretch
+    static double benchProcess(int frameSize, int overlap, int seekRange);
+    
+    // Print results for default and raised seek ranges
+    static void runAll();
+};
+
+} // namespace Debug
+} // namespace Core
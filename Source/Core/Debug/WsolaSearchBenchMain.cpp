@@ -0,0 +1,19 @@
+#include "WsolaSearchBench.h"
+#include <cstdio>
+#include <cstring>
+
+// Entry point for the Op1CloneWsolaBench target
+//   Op1CloneWsolaBench
+// Prints the exhaustive scalar overlap search against SimilaritySearch for several overlap
+// and seek ranges, then the whole WSOLA::process cost at a 1.25x stretch
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        printf("Usage: Op1CloneWsolaBench\n"
+               "  Times the WSOLA overlap search (exhaustive vs SimilaritySearch) on tonal input;\n"
+               "  'match' is the share of frames scoring within 0.01 of the exhaustive best.\n");
+        return std::strcmp(argv[1], "--help") == 0 ? 0 : 2;
+    }
+    Core::Debug::WsolaSearchBench::runAll();
+    return 0;
+}
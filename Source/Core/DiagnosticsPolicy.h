@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+
+// Render-loop diagnostics are chosen at compile time: OP1_DIAGNOSTICS=0 (Release), 1
+// (Diagnostics) or 2 (Paranoid); CMake option OP1_DIAGNOSTICS. Defaults to Diagnostics in
+// debug builds and Release otherwise
+#ifndef OP1_DIAGNOSTICS
+#if defined(NDEBUG)
+#define OP1_DIAGNOSTICS 0
+#else
+#define OP1_DIAGNOSTICS 1
+#endif
+#endif
+
+namespace Core {
+
+/**
+ * Production: no diagnostic branches or atomics in the render loops
+ * The audible safety stages (voice NaN zeroing, voice and mix slew limiters, clamps,
+ * limiter) and the master output NaN guard are not diagnostics and run under every policy
+ */
+struct ReleaseDiagnostics {
+    static constexpr const char* name = "release";
+    static constexpr bool popForensics = false;   // Engine PopDetector and pop telemetry
+    static constexpr bool voiceMeters = false;    // Per-voice peak/clip/out-of-bounds atomics
+    static constexpr bool mixNanScrub = false;    // Scrub and count non-finite mix samples
+};
+
+/**
+ * Debug builds: full pop forensics and per-voice guards (the engine's historical behaviour)
+ */
+struct FullDiagnostics {
+    static constexpr const char* name = "diagnostics";
+    static constexpr bool popForensics = true;
+    static constexpr bool voiceMeters = true;
+    static constexpr bool mixNanScrub = false;
+};
+
+/**
+ * FullDiagnostics plus a scrub of the voice mix before the mix slew limiter, so a
+ * non-finite voice sample is counted (SamplerEngine::getNonFiniteSampleCount) instead of
+ * latching the limiter state
+ */
+struct ParanoidDiagnostics {
+    static constexpr const char* name = "paranoid";
+    static constexpr bool popForensics = true;
+    static constexpr bool voiceMeters = true;
+    static constexpr bool mixNanScrub = true;
+};
+
+#if OP1_DIAGNOSTICS >= 2
+using ActiveDiagnostics = ParanoidDiagnostics;
+#elif OP1_DIAGNOSTICS == 1
+using ActiveDiagnostics = FullDiagnostics;
+#else
+using ActiveDiagnostics = ReleaseDiagnostics;
+#endif
+
+// Zero a non-finite voice sample under every policy: the clamps that follow it would turn a
+// NaN into full-scale DC (std::min(1.0f, NaN) is 1.0f), which no later guard can tell apart
+inline float guardVoiceSample(float sample) {
+    return std::isfinite(sample) ? sample : 0.0f;
+}
+
+// Raise a relaxed peak meter when the policy keeps voice meters; no-op otherwise
+template <typename Policy>
+inline void trackVoicePeak(std::atomic<float>& meter, float absSample) {
+    if constexpr (Policy::voiceMeters) {
+        if (absSample > meter.load(std::memory_order_relaxed)) {
+            meter.store(absSample, std::memory_order_relaxed);
+        }
+    } else {
+        (void) meter;
+        (void) absSample;
+    }
+}
+
+} // namespace Core
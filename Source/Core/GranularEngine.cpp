@@ -0,0 +1,482 @@
+#include "GranularEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CORE_GRANULAR_SSE2 1
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define CORE_GRANULAR_NEON 1
+#endif
+
+namespace Core {
+
+namespace {
+
+constexpr int MIN_GRAIN_SAMPLES = 16;
+constexpr float PI = 3.14159265358979323846f;
+
+} // namespace
+
+GranularEngine::GranularEngine()
+    : sampleRate(44100.0)
+    , maxBlockSize(512)
+    , cpuBudget(DEFAULT_CPU_BUDGET)
+    , maxGrains(MAX_GRAINS)
+    , latencyCompensation(0)
+    , numStreams(0)
+    , numActiveGrains(0)
+    , densityScale(1.0f)
+    , cpuLoad(0.0f)
+    , randomState(0x9E3779B9u)
+{
+    buildWindowTables();
+}
+
+GranularEngine::~GranularEngine() = default;
+
+void GranularEngine::prepare(double rate, int blockSize) {
+    sampleRate = (rate > 0.0) ? rate : 44100.0;
+    maxBlockSize = std::max(32, blockSize);
+    reset();
+}
+
+void GranularEngine::reset() {
+    for (auto& stream : streams) {
+        stream.sample.reset();
+        stream.note = -1;
+        stream.held = false;
+        stream.liveGrains = 0;
+        stream.noteOffCountdown = -1;
+    }
+    numStreams = 0;
+    numActiveGrains = 0;
+    densityScale = 1.0f;
+    cpuLoad = 0.0f;
+    activeGrainsPublished.store(0, std::memory_order_relaxed);
+    densityScalePublished.store(1.0f, std::memory_order_relaxed);
+    cpuLoadPublished.store(0.0f, std::memory_order_relaxed);
+}
+
+void GranularEngine::setCpuBudget(float fractionOfBlock) {
+    cpuBudget = std::max(0.0f, fractionOfBlock);
+    if (cpuBudget == 0.0f) {
+        densityScale = 1.0f;
+    }
+}
+
+void GranularEngine::setMaxGrains(int grains) {
+    maxGrains = std::max(1, std::min(MAX_GRAINS, grains));
+}
+
+void GranularEngine::setLatencyCompensation(int latencyFrames) {
+    latencyCompensation = std::max(0, latencyFrames);
+}
+
+void GranularEngine::buildWindowTables() {
+    float* hann = windowTables[static_cast<int>(WindowShape::Hann)];
+    float* tukey = windowTables[static_cast<int>(WindowShape::Tukey)];
+    float* triangle = windowTables[static_cast<int>(WindowShape::Triangle)];
+    const int taper = WINDOW_TABLE_SIZE / 4;
+    for (int i = 0; i <= WINDOW_TABLE_SIZE; ++i) {
+        float x = static_cast<float>(i) / static_cast<float>(WINDOW_TABLE_SIZE);
+        hann[i] = 0.5f - 0.5f * std::cos(2.0f * PI * x);
+        
+        int edge = std::min(i, WINDOW_TABLE_SIZE - i);
+        tukey[i] = (edge >= taper) ? 1.0f
+                                   : 0.5f - 0.5f * std::cos(PI * static_cast<float>(edge) / static_cast<float>(taper));
+        
+        triangle[i] = 1.0f - std::fabs(2.0f * x - 1.0f);
+    }
+    for (auto& table : windowTables) {
+        table[WINDOW_TABLE_SIZE + 1] = 0.0f;
+    }
+}
+
+float GranularEngine::nextRandom() {
+    // xorshift32
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return static_cast<float>(randomState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+bool GranularEngine::noteOn(int note, float velocity, SampleDataPtr sample, const Parameters& params, int sampleOffset) {
+    if (!sample || sample->length < MIN_GRAIN_SAMPLES || sample->mono.empty()) {
+        return false;
+    }
+    
+    int free = -1;
+    for (int s = 0; s < MAX_STREAMS; ++s) {
+        if (!streams[s].sample) {
+            free = s;
+            break;
+        }
+    }
+    if (free < 0) {
+        return false;
+    }
+    
+    Stream& stream = streams[free];
+    stream.sample = std::move(sample);
+    stream.params = params;
+    stream.note = note;
+    stream.held = true;
+    stream.liveGrains = 0;
+    stream.compensation = latencyCompensation;
+    stream.noteOffCountdown = -1;
+    stream.samplesToNextGrain = std::max(0, sampleOffset) + stream.compensation;
+    
+    float semitones = static_cast<float>(note - params.rootNote) + params.repitchSemitones;
+    stream.baseIncrement = std::exp2(semitones / 12.0f) *
+                           static_cast<float>(stream.sample->sourceSampleRate / sampleRate);
+    
+    // Keep loudness roughly constant as grains pile up (uncorrelated grains add in power)
+    float overlap = params.density * params.grainSizeMs * 0.001f;
+    stream.amplitude = velocity * params.sampleGain / std::sqrt(std::max(1.0f, overlap));
+    ++numStreams;
+    return true;
+}
+
+void GranularEngine::noteOff(int note) {
+    for (auto& stream : streams) {
+        if (stream.sample && stream.held && stream.note == note) {
+            if (stream.compensation > 0) {
+                if (stream.noteOffCountdown < 0) {
+                    stream.noteOffCountdown = stream.compensation;
+                }
+            } else {
+                stopStream(stream);
+            }
+        }
+    }
+}
+
+void GranularEngine::stopStream(Stream& stream) {
+    stream.held = false;
+    stream.noteOffCountdown = -1;
+    if (stream.liveGrains == 0) {
+        stream.sample.reset();
+        --numStreams;
+    }
+}
+
+void GranularEngine::process(float** output, int numChannels, int numSamples) {
+    if (output == nullptr || numChannels <= 0 || numSamples <= 0 || !isActive()) {
+        activeGrainsPublished.store(numActiveGrains, std::memory_order_relaxed);
+        return;
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    float* chunkOutput[2];
+    int channels = std::min(numChannels, 2);
+    for (int offset = 0; offset < numSamples; offset += maxBlockSize) {
+        int chunk = std::min(maxBlockSize, numSamples - offset);
+        for (int ch = 0; ch < channels; ++ch) {
+            chunkOutput[ch] = (output[ch] != nullptr) ? output[ch] + offset : nullptr;
+        }
+        processChunk(chunkOutput, channels, chunk);
+    }
+    
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    updateCpuGuard(elapsed, numSamples);
+    activeGrainsPublished.store(numActiveGrains, std::memory_order_relaxed);
+}
+
+void GranularEngine::processChunk(float** output, int numChannels, int numSamples) {
+    // Spawn: a grain due at fractional time t starts at sample ceil(t), its window and
+    // read position advanced by ceil(t) - t so onsets are exact to the sub-sample
+    for (int s = 0; s < MAX_STREAMS; ++s) {
+        Stream& stream = streams[s];
+        if (!stream.sample) {
+            continue;
+        }
+        if (stream.held) {
+            // A deferred noteOff stops spawning part way through the chunk
+            int spawnLimit = (stream.noteOffCountdown >= 0) ? std::min(numSamples, stream.noteOffCountdown) : numSamples;
+            float density = stream.params.density * densityScale;
+            if (density > 0.0f) {
+                double interval = sampleRate / static_cast<double>(density);
+                while (true) {
+                    double due = stream.samplesToNextGrain;
+                    int startSample = static_cast<int>(std::ceil(due));
+                    if (startSample >= spawnLimit) {
+                        break;
+                    }
+                    spawnGrain(s, startSample, static_cast<float>(startSample - due));
+                    stream.samplesToNextGrain += interval;
+                }
+            }
+        }
+        stream.samplesToNextGrain -= numSamples;
+        if (stream.noteOffCountdown >= 0) {
+            stream.noteOffCountdown -= numSamples;
+            if (stream.noteOffCountdown <= 0) {
+                stopStream(stream);
+            }
+        }
+    }
+    
+    float* outLeft = output[0];
+    float* outRight = (numChannels > 1) ? output[1] : nullptr;
+    int g = 0;
+    while (g < numActiveGrains) {
+        if (outLeft != nullptr) {
+            renderGrain(g, outLeft, outRight, numSamples);
+        }
+        int rendered = numSamples - grainStartOffset[g];
+        grainRemaining[g] -= rendered;
+        grainStartOffset[g] = 0;
+        if (grainRemaining[g] <= 0) {
+            retireGrain(g);  // Moves the last grain into g
+        } else {
+            ++g;
+        }
+    }
+}
+
+void GranularEngine::spawnGrain(int streamIndex, int startOffset, float startFraction) {
+    Stream& stream = streams[streamIndex];
+    const Parameters& params = stream.params;
+    const int length = stream.sample->length;
+    
+    if (numActiveGrains >= maxGrains) {
+        droppedGrains.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    int regionStart = std::max(0, std::min(params.startPoint, length - 1));
+    int regionEnd = (params.endPoint > 0) ? std::min(params.endPoint, length) : length;
+    if (regionEnd - regionStart < MIN_GRAIN_SAMPLES) {
+        regionStart = 0;
+        regionEnd = length;
+    }
+    double regionLength = static_cast<double>(regionEnd - regionStart);
+    
+    float increment = stream.baseIncrement;
+    if (params.pitchSpread > 0.0f) {
+        increment *= std::exp2(params.pitchSpread * nextRandom() / 12.0f);
+    }
+    
+    int grainLength = std::max(MIN_GRAIN_SAMPLES, static_cast<int>(params.grainSizeMs * 0.001 * sampleRate));
+    float startPosition = params.position + params.positionJitter * nextRandom();
+    startPosition = std::max(0.0f, std::min(1.0f, startPosition));
+    double start = regionStart + startPosition * regionLength;
+    
+    // The last read (start + grainLength * increment) and its interpolation neighbour stay in the region
+    double span = static_cast<double>(grainLength) * increment + 2.0;
+    if (start + span > regionEnd) {
+        start = regionEnd - span;
+        if (start < regionStart) {
+            start = regionStart;
+            grainLength = static_cast<int>((regionEnd - 2.0 - start) / increment);
+            if (grainLength < MIN_GRAIN_SAMPLES) {
+                droppedGrains.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+    
+    int g = numActiveGrains++;
+    float windowIncrement = static_cast<float>(WINDOW_TABLE_SIZE) / static_cast<float>(grainLength);
+    grainPosition[g] = start + static_cast<double>(startFraction) * increment;
+    grainIncrement[g] = increment;
+    grainWindowPhase[g] = startFraction * windowIncrement;
+    grainWindowIncrement[g] = windowIncrement;
+    grainAmplitude[g] = stream.amplitude;
+    grainRemaining[g] = grainLength;
+    grainStartOffset[g] = startOffset;
+    grainStream[g] = static_cast<uint8_t>(streamIndex);
+    grainWindow[g] = static_cast<uint8_t>(params.window);
+    ++stream.liveGrains;
+}
+
+void GranularEngine::retireGrain(int g) {
+    Stream& stream = streams[grainStream[g]];
+    if (--stream.liveGrains == 0 && !stream.held) {
+        stream.sample.reset();
+        --numStreams;
+    }
+    
+    int last = --numActiveGrains;
+    if (g != last) {
+        grainPosition[g] = grainPosition[last];
+        grainIncrement[g] = grainIncrement[last];
+        grainWindowPhase[g] = grainWindowPhase[last];
+        grainWindowIncrement[g] = grainWindowIncrement[last];
+        grainAmplitude[g] = grainAmplitude[last];
+        grainRemaining[g] = grainRemaining[last];
+        grainStartOffset[g] = grainStartOffset[last];
+        grainStream[g] = grainStream[last];
+        grainWindow[g] = grainWindow[last];
+    }
+}
+
+void GranularEngine::renderGrain(int g, float* outLeft, float* outRight, int numSamples) {
+    const SampleData& sample = *streams[grainStream[g]].sample;
+    const int begin = grainStartOffset[g];
+    const int n = std::min(grainRemaining[g], numSamples - begin);
+    if (n <= 0) {
+        return;
+    }
+    
+    // Read positions are kept relative to the integer start so float lanes stay exact
+    const double position = grainPosition[g];
+    const int baseIndex = static_cast<int>(position);
+    const float baseFraction = static_cast<float>(position - baseIndex);
+    const float* left = sample.mono.data() + baseIndex;
+    const float* right = sample.isStereo() ? sample.right.data() + baseIndex : left;
+    const float* window = windowTables[grainWindow[g]];
+    const float increment = grainIncrement[g];
+    const float windowPhase = grainWindowPhase[g];
+    const float windowIncrement = grainWindowIncrement[g];
+    const float amplitude = grainAmplitude[g];
+    const bool stereoSource = (right != left);
+    float* dstLeft = outLeft + begin;
+    float* dstRight = (outRight != nullptr) ? outRight + begin : nullptr;
+    
+    int i = 0;
+
+#if defined(CORE_GRANULAR_SSE2) || defined(CORE_GRANULAR_NEON)
+    alignas(16) int32_t readIndex[4];
+    alignas(16) int32_t windowIndex[4];
+    alignas(16) float gathered[4][4];  // left0, left1, window0, window1 (right reuses 0/1 when stereo)
+#endif
+
+#if defined(CORE_GRANULAR_SSE2)
+    const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 vIncrement = _mm_set1_ps(increment);
+    const __m128 vWindowIncrement = _mm_set1_ps(windowIncrement);
+    const __m128 vBaseFraction = _mm_set1_ps(baseFraction);
+    const __m128 vWindowPhase = _mm_set1_ps(windowPhase);
+    const __m128 vAmplitude = _mm_set1_ps(amplitude);
+    const __m128 vHalf = _mm_set1_ps(0.5f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 offset = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lanes);
+        __m128 read = _mm_add_ps(vBaseFraction, _mm_mul_ps(offset, vIncrement));
+        __m128i readInt = _mm_cvttps_epi32(read);
+        __m128 readFraction = _mm_sub_ps(read, _mm_cvtepi32_ps(readInt));
+        __m128 phase = _mm_add_ps(vWindowPhase, _mm_mul_ps(offset, vWindowIncrement));
+        __m128i phaseInt = _mm_cvttps_epi32(phase);
+        __m128 phaseFraction = _mm_sub_ps(phase, _mm_cvtepi32_ps(phaseInt));
+        _mm_store_si128(reinterpret_cast<__m128i*>(readIndex), readInt);
+        _mm_store_si128(reinterpret_cast<__m128i*>(windowIndex), phaseInt);
+        for (int k = 0; k < 4; ++k) {
+            gathered[0][k] = left[readIndex[k]];
+            gathered[1][k] = left[readIndex[k] + 1];
+            gathered[2][k] = window[windowIndex[k]];
+            gathered[3][k] = window[windowIndex[k] + 1];
+        }
+        __m128 w0 = _mm_load_ps(gathered[2]);
+        __m128 w = _mm_add_ps(w0, _mm_mul_ps(phaseFraction, _mm_sub_ps(_mm_load_ps(gathered[3]), w0)));
+        w = _mm_mul_ps(w, vAmplitude);
+        __m128 l0 = _mm_load_ps(gathered[0]);
+        __m128 valueLeft = _mm_mul_ps(_mm_add_ps(l0, _mm_mul_ps(readFraction, _mm_sub_ps(_mm_load_ps(gathered[1]), l0))), w);
+        __m128 valueRight = valueLeft;
+        if (stereoSource) {
+            for (int k = 0; k < 4; ++k) {
+                gathered[0][k] = right[readIndex[k]];
+                gathered[1][k] = right[readIndex[k] + 1];
+            }
+            __m128 r0 = _mm_load_ps(gathered[0]);
+            valueRight = _mm_mul_ps(_mm_add_ps(r0, _mm_mul_ps(readFraction, _mm_sub_ps(_mm_load_ps(gathered[1]), r0))), w);
+        }
+        if (dstRight != nullptr) {
+            _mm_storeu_ps(dstLeft + i, _mm_add_ps(_mm_loadu_ps(dstLeft + i), valueLeft));
+            _mm_storeu_ps(dstRight + i, _mm_add_ps(_mm_loadu_ps(dstRight + i), valueRight));
+        } else {
+            __m128 mid = _mm_mul_ps(_mm_add_ps(valueLeft, valueRight), vHalf);
+            _mm_storeu_ps(dstLeft + i, _mm_add_ps(_mm_loadu_ps(dstLeft + i), mid));
+        }
+    }
+#elif defined(CORE_GRANULAR_NEON)
+    const float32x4_t lanes = { 0.0f, 1.0f, 2.0f, 3.0f };
+    const float32x4_t vIncrement = vdupq_n_f32(increment);
+    const float32x4_t vWindowIncrement = vdupq_n_f32(windowIncrement);
+    const float32x4_t vBaseFraction = vdupq_n_f32(baseFraction);
+    const float32x4_t vWindowPhase = vdupq_n_f32(windowPhase);
+    const float32x4_t vAmplitude = vdupq_n_f32(amplitude);
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t offset = vaddq_f32(vdupq_n_f32(static_cast<float>(i)), lanes);
+        float32x4_t read = vmlaq_f32(vBaseFraction, offset, vIncrement);
+        int32x4_t readInt = vcvtq_s32_f32(read);
+        float32x4_t readFraction = vsubq_f32(read, vcvtq_f32_s32(readInt));
+        float32x4_t phase = vmlaq_f32(vWindowPhase, offset, vWindowIncrement);
+        int32x4_t phaseInt = vcvtq_s32_f32(phase);
+        float32x4_t phaseFraction = vsubq_f32(phase, vcvtq_f32_s32(phaseInt));
+        vst1q_s32(readIndex, readInt);
+        vst1q_s32(windowIndex, phaseInt);
+        for (int k = 0; k < 4; ++k) {
+            gathered[0][k] = left[readIndex[k]];
+            gathered[1][k] = left[readIndex[k] + 1];
+            gathered[2][k] = window[windowIndex[k]];
+            gathered[3][k] = window[windowIndex[k] + 1];
+        }
+        float32x4_t w0 = vld1q_f32(gathered[2]);
+        float32x4_t w = vmulq_f32(vmlaq_f32(w0, phaseFraction, vsubq_f32(vld1q_f32(gathered[3]), w0)), vAmplitude);
+        float32x4_t l0 = vld1q_f32(gathered[0]);
+        float32x4_t valueLeft = vmulq_f32(vmlaq_f32(l0, readFraction, vsubq_f32(vld1q_f32(gathered[1]), l0)), w);
+        float32x4_t valueRight = valueLeft;
+        if (stereoSource) {
+            for (int k = 0; k < 4; ++k) {
+                gathered[0][k] = right[readIndex[k]];
+                gathered[1][k] = right[readIndex[k] + 1];
+            }
+            float32x4_t r0 = vld1q_f32(gathered[0]);
+            valueRight = vmulq_f32(vmlaq_f32(r0, readFraction, vsubq_f32(vld1q_f32(gathered[1]), r0)), w);
+        }
+        if (dstRight != nullptr) {
+            vst1q_f32(dstLeft + i, vaddq_f32(vld1q_f32(dstLeft + i), valueLeft));
+            vst1q_f32(dstRight + i, vaddq_f32(vld1q_f32(dstRight + i), valueRight));
+        } else {
+            float32x4_t mid = vmulq_n_f32(vaddq_f32(valueLeft, valueRight), 0.5f);
+            vst1q_f32(dstLeft + i, vaddq_f32(vld1q_f32(dstLeft + i), mid));
+        }
+    }
+#endif
+
+    // Scalar path (remainder, or every sample without SIMD)
+    for (; i < n; ++i) {
+        float read = baseFraction + static_cast<float>(i) * increment;
+        int readInt = static_cast<int>(read);
+        float readFraction = read - static_cast<float>(readInt);
+        float phase = windowPhase + static_cast<float>(i) * windowIncrement;
+        int phaseInt = static_cast<int>(phase);
+        float phaseFraction = phase - static_cast<float>(phaseInt);
+        float w = (window[phaseInt] + phaseFraction * (window[phaseInt + 1] - window[phaseInt])) * amplitude;
+        float valueLeft = (left[readInt] + readFraction * (left[readInt + 1] - left[readInt])) * w;
+        float valueRight = stereoSource ? (right[readInt] + readFraction * (right[readInt + 1] - right[readInt])) * w
+                                        : valueLeft;
+        if (dstRight != nullptr) {
+            dstLeft[i] += valueLeft;
+            dstRight[i] += valueRight;
+        } else {
+            dstLeft[i] += 0.5f * (valueLeft + valueRight);
+        }
+    }
+    
+    grainPosition[g] = position + static_cast<double>(n) * increment;
+    grainWindowPhase[g] = windowPhase + static_cast<float>(n) * windowIncrement;
+}
+
+void GranularEngine::updateCpuGuard(double elapsedSeconds, int numSamples) {
+    double blockSeconds = static_cast<double>(numSamples) / sampleRate;
+    float load = (blockSeconds > 0.0) ? static_cast<float>(elapsedSeconds / blockSeconds) : 0.0f;
+    cpuLoad += LOAD_SMOOTHING * (load - cpuLoad);
+    
+    if (cpuBudget > 0.0f) {
+        if (cpuLoad > cpuBudget) {
+            densityScale = std::max(MIN_DENSITY_SCALE, densityScale * GUARD_BACKOFF);
+        } else if (cpuLoad < 0.7f * cpuBudget) {
+            densityScale = std::min(1.0f, densityScale * GUARD_RECOVERY);
+        }
+    }
+    densityScalePublished.store(densityScale, std::memory_order_relaxed);
+    cpuLoadPublished.store(cpuLoad, std::memory_order_relaxed);
+}
+
+} // namespace Core
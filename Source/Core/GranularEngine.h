@@ -0,0 +1,179 @@
+#pragma once
+
+#include "SampleData.h"
+#include <atomic>
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * Polyphonic granular playback for one sample slot
+ * Portable C++ - no JUCE dependencies
+ *
+ * Extends the GranularTimeWarp grain model (windowed, resampled grains overlap-added)
+ * from two fixed grains to a pool of MAX_GRAINS:
+ * - Each held note is a stream that spawns grains at `density` grains per second,
+ *   scheduled to the sample (fractional spawn times shift the window phase)
+ * - Grain state lives in structure-of-arrays form so the render loop walks flat arrays
+ * - Windows are read from precomputed tables (one per WindowShape)
+ * - Grains are rendered four samples at a time with SSE2 (x86) or NEON (AArch64),
+ *   with a scalar fallback on other targets
+ * - A CPU guard measures process() against the block duration and scales density
+ *   down while the slot exceeds its budget (recovering slowly once under it)
+ *
+ * All storage is fixed-size; process() does not allocate
+ */
+class GranularEngine {
+public:
+    static constexpr int MAX_GRAINS = 512;
+    static constexpr int MAX_STREAMS = 8;
+    static constexpr int WINDOW_TABLE_SIZE = 1024;
+    static constexpr float DEFAULT_CPU_BUDGET = 0.2f;  // Fraction of block time this slot may use
+    
+    enum class WindowShape : int {
+        Hann = 0,
+        Tukey,      // Flat top, cosine tapers over the outer quarters - denser texture
+        Triangle,
+        NumShapes
+    };
+    
+    // Captured on noteOn (same lifetime as a sampler voice's slot parameters)
+    struct Parameters {
+        float density = 40.0f;          // Grains per second per held note
+        float grainSizeMs = 80.0f;
+        float position = 0.0f;          // Grain start, 0..1 across [startPoint, endPoint)
+        float positionJitter = 0.0f;    // Random start offset, 0..1 of the region
+        float pitchSpread = 0.0f;       // Random per-grain pitch offset, +/- semitones
+        WindowShape window = WindowShape::Hann;
+        float repitchSemitones = 0.0f;
+        int startPoint = 0;
+        int endPoint = 0;               // 0 = end of sample
+        float sampleGain = 1.0f;
+        int rootNote = 60;
+    };
+    
+    GranularEngine();
+    ~GranularEngine();
+    
+    GranularEngine(const GranularEngine&) = delete;
+    GranularEngine& operator=(const GranularEngine&) = delete;
+    
+    /**
+     * Set the output rate; blocks longer than maxBlockSize are rendered in maxBlockSize chunks
+     */
+    void prepare(double sampleRate, int maxBlockSize);
+    
+    /**
+     * Silence all grains and streams
+     */
+    void reset();
+    
+    /**
+     * Start a grain stream for note; the first grain starts sampleOffset samples into
+     * the next process() block. Returns false if the sample is empty or all streams are held
+     */
+    bool noteOn(int note, float velocity, SampleDataPtr sample, const Parameters& params, int sampleOffset = 0);
+    
+    /**
+     * Stop spawning for note; grains already sounding play to their end
+     */
+    void noteOff(int note);
+    
+    /**
+     * Add this slot's grains into output (non-interleaved [channel][sample])
+     */
+    void process(float** output, int numChannels, int numSamples);
+    
+    /**
+     * True while any stream is held or any grain is sounding
+     */
+    bool isActive() const { return numActiveGrains > 0 || numStreams > 0; }
+    
+    /**
+     * CPU guard budget as a fraction of block time (0 disables the guard)
+     */
+    void setCpuBudget(float fractionOfBlock);
+    
+    /**
+     * Upper bound on concurrently sounding grains (1..MAX_GRAINS)
+     */
+    void setMaxGrains(int maxGrains);
+    
+    /**
+     * Hold notes and note-offs back by latencyFrames so the slot stays aligned with
+     * latency-compensated warp voices (0 = off; applies from the next note)
+     */
+    void setLatencyCompensation(int latencyFrames);
+    
+    // Instrumentation (thread-safe reads)
+    int getActiveGrainCount() const { return activeGrainsPublished.load(std::memory_order_relaxed); }
+    float getDensityScale() const { return densityScalePublished.load(std::memory_order_relaxed); }
+    float getCpuLoad() const { return cpuLoadPublished.load(std::memory_order_relaxed); }
+    uint64_t getDroppedGrainCount() const { return droppedGrains.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr float MIN_DENSITY_SCALE = 0.05f;
+    static constexpr float GUARD_BACKOFF = 0.8f;      // Per over-budget block
+    static constexpr float GUARD_RECOVERY = 1.02f;    // Per block under 70% of budget
+    static constexpr float LOAD_SMOOTHING = 0.2f;     // One-pole weight of the newest block
+    
+    struct Stream {
+        SampleDataPtr sample;
+        Parameters params;
+        int note = -1;
+        float amplitude = 0.0f;         // Velocity * gain, normalised for grain overlap
+        float baseIncrement = 1.0f;     // Source samples per output sample at the note pitch
+        double samplesToNextGrain = 0.0;
+        bool held = false;
+        int liveGrains = 0;             // Grains still reading this stream's sample
+        int compensation = 0;           // Latency compensation captured on noteOn
+        int noteOffCountdown = -1;      // Samples until a deferred noteOff stops spawning (-1 = none)
+    };
+    
+    double sampleRate;
+    int maxBlockSize;
+    float cpuBudget;
+    int maxGrains;
+    int latencyCompensation;
+    
+    Stream streams[MAX_STREAMS];
+    int numStreams;  // Streams held or still draining
+    
+    // Grain pool (structure of arrays); active grains are packed into [0, numActiveGrains)
+    int numActiveGrains;
+    double grainPosition[MAX_GRAINS];       // Source read position (samples)
+    float grainIncrement[MAX_GRAINS];       // Source samples per output sample
+    float grainWindowPhase[MAX_GRAINS];     // Window table position
+    float grainWindowIncrement[MAX_GRAINS];
+    float grainAmplitude[MAX_GRAINS];
+    int grainRemaining[MAX_GRAINS];         // Output samples left
+    int grainStartOffset[MAX_GRAINS];       // Samples into the current chunk before the grain starts
+    uint8_t grainStream[MAX_GRAINS];
+    uint8_t grainWindow[MAX_GRAINS];
+    
+    // Window tables (guard points keep interpolation in range at the very end)
+    float windowTables[static_cast<int>(WindowShape::NumShapes)][WINDOW_TABLE_SIZE + 2];
+    
+    float densityScale;
+    float cpuLoad;
+    uint32_t randomState;
+    
+    std::atomic<int> activeGrainsPublished{0};
+    std::atomic<float> densityScalePublished{1.0f};
+    std::atomic<float> cpuLoadPublished{0.0f};
+    std::atomic<uint64_t> droppedGrains{0};
+    
+    void buildWindowTables();
+    
+    void processChunk(float** output, int numChannels, int numSamples);
+    void spawnGrain(int streamIndex, int startOffset, float startFraction);
+    void renderGrain(int grain, float* outLeft, float* outRight, int numSamples);
+    void retireGrain(int grain);
+    void updateCpuGuard(double elapsedSeconds, int numSamples);
+    void stopStream(Stream& stream);
+    
+    // Uniform random in [-1, 1)
+    float nextRandom();
+};
+
+} // namespace Core
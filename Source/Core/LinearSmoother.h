@@ -39,6 +39,17 @@ public:
         return currentValue;
     }
     
+    // Advance by numSamples in one step (for block/segment-rate parameter updates)
+    void skip(int numSamples) {
+        if (samplesRemaining > numSamples) {
+            currentValue += stepSize * static_cast<float>(numSamples);
+            samplesRemaining -= numSamples;
+        } else {
+            currentValue = targetValue;
+            samplesRemaining = 0;
+        }
+    }
+    
     float getCurrentValue() const {
         return currentValue;
     }
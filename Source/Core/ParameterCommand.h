@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Core {
+
+// Engine parameters that can be changed while audio is running
+// Ramped parameters are smoothed on the audio thread; the rest apply once per block
+enum class ParamId : uint8_t {
+    // Ramped (continuous)
+    Gain = 0,
+    Repitch,
+    SampleGain,
+    Sustain,
+    // Applied at block start (times, positions, switches)
+    Attack,
+    Decay,
+    Release,
+    StartPoint,
+    EndPoint,
+    LoopEnabled,
+    LoopStart,
+    LoopEnd,
+    Count
+};
+
+static constexpr int NUM_PARAM_IDS = static_cast<int>(ParamId::Count);
+
+// Parameter change command (POD - copied through the lock-free queue)
+// Continuous parameters use value, sample positions and switches use intValue
+struct ParameterCommand {
+    ParamId id;
+    int32_t intValue;
+    float value;
+    
+    ParameterCommand() : id(ParamId::Gain), intValue(0), value(0.0f) {}
+    ParameterCommand(ParamId i, float v, int32_t iv = 0) : id(i), intValue(iv), value(v) {}
+};
+
+} // namespace Core
@@ -0,0 +1,53 @@
+#include "ParameterCommandQueue.h"
+
+namespace Core {
+
+ParameterCommandQueue::ParameterCommandQueue() {
+    for (int i = 0; i < CAPACITY; ++i) {
+        commands[i] = ParameterCommand();
+    }
+}
+
+bool ParameterCommandQueue::push(const ParameterCommand& command) {
+    uint32_t currentWrite = writePos.load(std::memory_order_relaxed);
+    uint32_t nextWrite = currentWrite + 1;
+    uint32_t currentRead = readPos.load(std::memory_order_acquire);
+    
+    // Check if queue is full (writePos + 1 == readPos)
+    if (getIndex(nextWrite) == getIndex(currentRead)) {
+        return false; // Queue full
+    }
+    
+    // Write command
+    commands[getIndex(currentWrite)] = command;
+    
+    // Update write position (release ensures command is written before position update)
+    writePos.store(nextWrite, std::memory_order_release);
+    return true;
+}
+
+bool ParameterCommandQueue::pop(ParameterCommand& command) {
+    uint32_t currentRead = readPos.load(std::memory_order_relaxed);
+    uint32_t currentWrite = writePos.load(std::memory_order_acquire);
+    
+    // Check if queue is empty
+    if (getIndex(currentRead) == getIndex(currentWrite)) {
+        return false; // Queue empty
+    }
+    
+    // Read command
+    command = commands[getIndex(currentRead)];
+    
+    // Update read position (release ensures command is read before position update)
+    readPos.store(currentRead + 1, std::memory_order_release);
+    return true;
+}
+
+int ParameterCommandQueue::size() const {
+    uint32_t w = writePos.load(std::memory_order_acquire);
+    uint32_t r = readPos.load(std::memory_order_acquire);
+    int diff = static_cast<int>(w - r);
+    return (diff < 0) ? (diff + CAPACITY) : diff;
+}
+
+} // namespace Core
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ParameterCommand.h"
+#include <atomic>
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * Lock-free ring buffer for parameter change commands
+ * Portable C++ - no JUCE dependencies
+ * Single producer (UI thread), single consumer (audio thread)
+ */
+class ParameterCommandQueue {
+public:
+    static constexpr int CAPACITY = 256; // Power of 2 - room for a fast knob sweep between blocks
+    
+    ParameterCommandQueue();
+    
+    /**
+     * Push command from UI thread (non-blocking)
+     * Returns true if successful, false if queue is full
+     */
+    bool push(const ParameterCommand& command);
+    
+    /**
+     * Pop command in audio thread (non-blocking)
+     * Returns true if a command was popped, false if queue is empty
+     */
+    bool pop(ParameterCommand& command);
+    
+    /**
+     * Get number of commands in queue (approximate, for debugging)
+     */
+    int size() const;
+
+private:
+    ParameterCommand commands[CAPACITY];
+    std::atomic<uint32_t> writePos{0}; // Write position (UI thread)
+    std::atomic<uint32_t> readPos{0};  // Read position (audio thread)
+    
+    // Helper: get actual index from position
+    int getIndex(uint32_t pos) const { return pos & (CAPACITY - 1); }
+};
+
+} // namespace Core
@@ -0,0 +1,87 @@
+#include "ParameterRampBank.h"
+#include <algorithm>
+
+namespace Core {
+
+ParameterRampBank::ParameterRampBank()
+    : sampleRate(44100.0)
+{
+    // Default ramp times - continuous parameters only
+    // Everything else (times, positions, switches) applies at the next segment
+    setRampTimeMs(ParamId::Gain, 10.0f);
+    setRampTimeMs(ParamId::Repitch, 30.0f);
+    setRampTimeMs(ParamId::SampleGain, 20.0f);
+    setRampTimeMs(ParamId::Sustain, 20.0f);
+}
+
+void ParameterRampBank::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
+    for (auto& p : params) {
+        updateRampSamples(p);
+    }
+}
+
+void ParameterRampBank::setRampTimeMs(ParamId id, float rampMs) {
+    int index = static_cast<int>(id);
+    if (index < 0 || index >= NUM_PARAM_IDS) {
+        return;
+    }
+    params[index].rampMs = std::max(0.0f, rampMs);
+    updateRampSamples(params[index]);
+}
+
+float ParameterRampBank::getRampTimeMs(ParamId id) const {
+    int index = static_cast<int>(id);
+    if (index < 0 || index >= NUM_PARAM_IDS) {
+        return 0.0f;
+    }
+    return params[index].rampMs;
+}
+
+void ParameterRampBank::setValueImmediate(ParamId id, float value, int intValue) {
+    int index = static_cast<int>(id);
+    if (index < 0 || index >= NUM_PARAM_IDS) {
+        return;
+    }
+    ParamState& p = params[index];
+    p.smoother.setValueImmediate(value);
+    p.target = value;
+    p.intValue = intValue;
+    p.dirty = false;
+}
+
+void ParameterRampBank::push(const ParameterCommand& command) {
+    int index = static_cast<int>(command.id);
+    if (index < 0 || index >= NUM_PARAM_IDS) {
+        return;
+    }
+    // Last write wins - intermediate values of a sweep are never applied to voices
+    ParamState& p = params[index];
+    p.target = command.value;
+    p.intValue = command.intValue;
+    p.dirty = true;
+}
+
+bool ParameterRampBank::isActive() const {
+    for (const auto& p : params) {
+        if (p.dirty || p.smoother.isSmoothing()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParameterRampBank::isRamping() const {
+    for (const auto& p : params) {
+        if (p.smoother.isSmoothing() || (p.dirty && p.rampSamples > 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParameterRampBank::updateRampSamples(ParamState& p) {
+    p.rampSamples = static_cast<int>(sampleRate * static_cast<double>(p.rampMs) / 1000.0);
+}
+
+} // namespace Core
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ParameterCommand.h"
+#include "LinearSmoother.h"
+#include <array>
+
+namespace Core {
+
+// Audio-thread side of the parameter command queue - portable, no JUCE
+// Coalesces commands (last write wins) so a knob sweep costs one voice update per
+// parameter per segment, and ramps continuous parameters over a per-parameter time
+class ParameterRampBank {
+public:
+    static constexpr int RAMP_SEGMENT = 32;  // Samples between voice updates while ramping
+    
+    ParameterRampBank();
+    
+    void prepare(double sampleRate);
+    
+    // Ramp time for a parameter (0 = apply at the next segment without smoothing)
+    void setRampTimeMs(ParamId id, float rampMs);
+    float getRampTimeMs(ParamId id) const;
+    
+    // Set initial value without ramping or marking dirty (construction/prepare only)
+    void setValueImmediate(ParamId id, float value, int intValue);
+    
+    // Record a command from the queue (coalesced - nothing is applied yet)
+    void push(const ParameterCommand& command);
+    
+    // True if any parameter is pending or still ramping
+    bool isActive() const;
+    
+    // True if any ramp is pending or in progress (render must be split into segments)
+    bool isRamping() const;
+    
+    // Advance all pending/ramping parameters by numSamples and hand each changed value
+    // to apply(ParamId, float value, int intValue) exactly once
+    template <typename ApplyFn>
+    void advance(int numSamples, ApplyFn&& apply) {
+        for (int i = 0; i < NUM_PARAM_IDS; ++i) {
+            ParamState& p = params[i];
+            if (!p.dirty && !p.smoother.isSmoothing()) {
+                continue;
+            }
+            if (p.dirty) {
+                p.dirty = false;
+                if (p.rampSamples > 0) {
+                    p.smoother.setTarget(p.target, p.rampSamples);
+                } else {
+                    p.smoother.setValueImmediate(p.target);
+                }
+            }
+            p.smoother.skip(numSamples);
+            apply(static_cast<ParamId>(i), p.smoother.getCurrentValue(), p.intValue);
+        }
+    }
+
+private:
+    struct ParamState {
+        LinearSmoother smoother;
+        float rampMs;
+        int rampSamples;
+        float target;
+        int intValue;
+        bool dirty;
+        
+        ParamState() : rampMs(0.0f), rampSamples(0), target(0.0f), intValue(0), dirty(false) {}
+    };
+    
+    std::array<ParamState, NUM_PARAM_IDS> params;
+    double sampleRate;
+    
+    void updateRampSamples(ParamState& p);
+};
+
+} // namespace Core
@@ -1,23 +1,34 @@
 #include "PitchShiftTSM.h"
+#include "DSP/VectorMath.h"
 #include <cmath>
 #include <algorithm>
 #include <cstring>
 
 namespace Core {
 
+using namespace DSP::VectorMath;
+
 PitchShiftTSM::PitchShiftTSM()
-    : frameSize(DEFAULT_FRAME_SIZE)
-    , hopSize(DEFAULT_HOP_SIZE)
+    : baseFrameSize(DEFAULT_FRAME_SIZE)
+    , frameScale(0)
+    , frameSize(DEFAULT_FRAME_SIZE)
+    , hopSize(DEFAULT_FRAME_SIZE / HOP_DIVISOR)
+    , numBins(DEFAULT_FRAME_SIZE / 2 + 1)
+    , numChannels(1)
     , sampleRate(44100.0)
-    , lastPhase(nullptr)
-    , currentPhase(nullptr)
-    , magnitude(nullptr)
-    , complexSpectrum(nullptr)
+    , prepared(false)
     , pitchRatio(1.0f)
-    , numBins(0)
-    , readHead(0.0)
-    , lastMagnitude(nullptr)
-    , spectralFluxThreshold(0.1f)
+    , timeRatio(1.0f)
+    , fifoPos(0)
+    , tailRemaining(0)
+    , complexSpectrum(nullptr)
+    , shiftedSpectrum(nullptr)
+    , magnitude(nullptr)
+    , phase(nullptr)
+    , outPhase(nullptr)
+    , targetBin(nullptr)
+    , peaks(nullptr)
+    , frameOutput(nullptr)
 {
 }
 
@@ -26,321 +37,352 @@ PitchShiftTSM::~PitchShiftTSM()
     deallocateBuffers();
 }
 
-void PitchShiftTSM::prepare(double rate, int maxBlockSize)
+void PitchShiftTSM::prepare(const TimePitchConfig& config)
 {
-    sampleRate = rate;
-    
-    // Use default frame size (1024) and hop (256)
-    frameSize = DEFAULT_FRAME_SIZE;
-    hopSize = DEFAULT_HOP_SIZE;
-    
-    // Prepare STFT
-    stft.prepare(frameSize, hopSize, sampleRate);
-    
-    // Prepare circular buffers (need enough space for frame + some extra)
-    int bufferSize = frameSize * 4; // Enough for multiple frames
-    inputBuffer.prepare(bufferSize);
-    outputBuffer.prepare(bufferSize);
-    
-    numBins = frameSize / 2 + 1;
+    sampleRate = config.sampleRate > 0.0 ? config.sampleRate : 44100.0;
+    numChannels = std::max(1, std::min(MAX_CHANNELS, config.channels));
+    
+    // Keep ~23 ms frames at high rates so low partials stay resolved
+    baseFrameSize = (sampleRate > 64000.0) ? DEFAULT_FRAME_SIZE * 2 : DEFAULT_FRAME_SIZE;
+    for (int c = 0; c < numChannels; ++c) {
+        for (int scale = 0; scale < NUM_FRAME_SCALES; ++scale) {
+            int size = baseFrameSize << scale;
+            channels[c].stft[scale].prepare(size, size / HOP_DIVISOR, sampleRate);
+        }
+    }
     allocateBuffers();
+    prepared = true;
     
+    selectFrameScale(frameScaleFor(pitchRatio));
     reset();
 }
 
+int PitchShiftTSM::frameScaleFor(float ratio)
+{
+    // Downward shifts pack the partials closer by the ratio; a longer frame keeps them
+    // resolved as separate peaks in the shifted spectrum
+    int scale = 0;
+    while (scale < NUM_FRAME_SCALES - 1 && ratio * static_cast<float>(1 << scale) < MIN_SCALED_RATIO) {
+        ++scale;
+    }
+    return scale;
+}
+
+void PitchShiftTSM::selectFrameScale(int scale)
+{
+    frameScale = scale;
+    frameSize = baseFrameSize << scale;
+    hopSize = frameSize / HOP_DIVISOR;
+    numBins = frameSize / 2 + 1;
+}
+
 void PitchShiftTSM::setPitchRatio(float ratio)
 {
     // Clamp to reasonable range
     pitchRatio = std::max(0.25f, std::min(4.0f, ratio));
+    
+    int scale = frameScaleFor(pitchRatio);
+    if (prepared && scale != frameScale) {
+        selectFrameScale(scale);
+        reset();  // The streamed frames belong to the old size
+    }
+}
+
+void PitchShiftTSM::setPitchSemitones(float semitones)
+{
+    setPitchRatio(std::pow(2.0f, semitones / 12.0f));
+}
+
+void PitchShiftTSM::setTimeRatio(float ratio)
+{
+    // Constant-duration backend: stored for callers that query it, not applied
+    timeRatio = ratio;
 }
 
-int PitchShiftTSM::process(const float* input, float* output, int numSamples)
+int PitchShiftTSM::process(const float* in, int inN, float* out, int outN)
 {
-    if (input == nullptr || output == nullptr || numSamples <= 0) {
+    if (out == nullptr || outN <= 0) {
         return 0;
     }
-    
-    // TEMPORARY: Use simple resampling until FFT is fixed
-    // This provides pitch shifting without time-stretching, but at least it works
-    // For time-stretching, we need the phase vocoder which requires working FFT
-    
-    // Simple approach: if pitchRatio == 1.0, just pass through
-    // Otherwise, resample the input block
-    if (std::abs(pitchRatio - 1.0f) < 0.001f) {
-        // No pitch shift - pass through
-        std::memcpy(output, input, numSamples * sizeof(float));
-        return numSamples;
+    int n = std::min(inN, outN);
+    if (!prepared || in == nullptr || n <= 0) {
+        std::fill(out, out + static_cast<size_t>(outN) * numChannels, 0.0f);
+        return 0;
     }
     
-    // Simple pitch shifting via resampling (no time-stretching)
-    // Read from input at a rate determined by pitchRatio
-    for (int i = 0; i < numSamples; ++i) {
-        int idx0 = static_cast<int>(readHead);
-        int idx1 = idx0 + 1;
-        float fraction = static_cast<float>(readHead - static_cast<double>(idx0));
-        
-        if (idx0 >= numSamples) {
-            output[i] = 0.0f;
-        } else if (idx1 >= numSamples) {
-            output[i] = input[idx0];
-        } else {
-            output[i] = input[idx0] * (1.0f - fraction) + input[idx1] * fraction;
-        }
-        
-        // Advance read head at pitch ratio speed
-        // For pitch up (ratio > 1), read faster through input
-        // For pitch down (ratio < 1), read slower
-        readHead += pitchRatio;
-        
-        // Wrap or stop when we've read all input
-        if (readHead >= numSamples) {
-            readHead = 0.0; // Loop for now
-        }
+    processSamples(in, out, n);
+    tailRemaining = getLatency();
+    return n;
+}
+
+int PitchShiftTSM::flush(float* out, int outN)
+{
+    if (!prepared || out == nullptr || outN <= 0) {
+        return 0;
     }
     
-    return numSamples;
+    int n = std::min(outN, tailRemaining);
+    processSamples(nullptr, out, n);
+    tailRemaining -= n;
+    return n;
+}
+
+void PitchShiftTSM::reset()
+{
+    // The fifo starts full of (silent) history, so the first frame runs after one hop
+    fifoPos = frameSize - hopSize;
+    tailRemaining = 0;
     
-    /* ORIGINAL PHASE VOCODER CODE - DISABLED UNTIL FFT IS FIXED
-    // Safety check: ensure pitch shifter is prepared
-    if (numBins == 0 || lastPhase == nullptr || complexSpectrum == nullptr) {
-        // Not prepared - return zeros to prevent crashes
-        std::fill(output, output + numSamples, 0.0f);
-        return numSamples;
+    if (!prepared) {
+        return;
     }
-    
-    // Zero output buffer first (for overlap-add)
-    std::fill(output, output + numSamples, 0.0f);
-    
-    // Write input to circular buffer (accumulates across calls)
-    inputBuffer.write(input, numSamples);
-    
-    // Process frames until we have enough output or run out of input
-    int outputSamples = 0;
-    int maxIterations = 10; // Prevent infinite loops
-    int iterations = 0;
-    
-    while (inputBuffer.getNumAvailable() >= frameSize && 
-           outputSamples < numSamples &&
-           iterations < maxIterations) {
-        processFrame();
-        iterations++;
-        
-        // Read output frame (overlap-add result)
-        float frameOutput[1024]; // Max frame size
-        int frameSamples = outputBuffer.read(frameOutput, frameSize);
+    const int maxFrameSize = getMaxFrameSize();
+    const int maxBins = maxFrameSize / 2 + 1;
+    for (int c = 0; c < numChannels; ++c) {
+        Channel& channel = channels[c];
+        std::fill(channel.inputFifo, channel.inputFifo + maxFrameSize, 0.0f);
+        std::fill(channel.outputFifo, channel.outputFifo + maxFrameSize / HOP_DIVISOR, 0.0f);
+        std::fill(channel.outputAccum, channel.outputAccum + maxFrameSize, 0.0f);
+        std::fill(channel.lastPhase, channel.lastPhase + maxBins, 0.0f);
+        std::fill(channel.synthPhase, channel.synthPhase + maxBins, 0.0f);
+        std::fill(channel.lastMagnitude, channel.lastMagnitude + maxBins, 0.0f);
+    }
+}
+
+void PitchShiftTSM::processSamples(const float* in, float* out, int n)
+{
+    const int frameStart = frameSize - hopSize;
+    int done = 0;
+    
+    while (done < n) {
+        // Copy up to the next frame boundary
+        int chunk = std::min(n - done, frameSize - fifoPos);
+        for (int c = 0; c < numChannels; ++c) {
+            Channel& channel = channels[c];
+            float* fifo = channel.inputFifo + fifoPos;
+            const float* delayed = channel.outputFifo + (fifoPos - frameStart);
+            for (int i = 0; i < chunk; ++i) {
+                size_t index = static_cast<size_t>(done + i) * numChannels + c;
+                fifo[i] = (in != nullptr) ? in[index] : 0.0f;
+                out[index] = delayed[i];
+            }
+        }
+        fifoPos += chunk;
+        done += chunk;
         
-        // Copy to output with overlap-add
-        int toCopy = std::min(frameSamples, numSamples - outputSamples);
-        for (int i = 0; i < toCopy; ++i) {
-            output[outputSamples + i] += frameOutput[i];
+        if (fifoPos >= frameSize) {
+            for (int c = 0; c < numChannels; ++c) {
+                processFrame(channels[c]);
+            }
+            fifoPos = frameStart;
         }
+    }
+}
+
+void PitchShiftTSM::processFrame(Channel& channel)
+{
+    STFT& stft = channel.stft[frameScale];
+    stft.analyze(channel.inputFifo, complexSpectrum);
+    DSP::VectorMath::cartesianToPolar(complexSpectrum, magnitude, phase, numBins);
+    
+    const float* synthesis = complexSpectrum;
+    if (std::abs(pitchRatio - 1.0f) > 1.0e-4f) {
+        bool transient = detectTransient(magnitude, channel.lastMagnitude) > TRANSIENT_FLUX;
+        shiftPeakRegions(channel, transient);
         
-        outputSamples += toCopy;
+        // Scatter the moved bins; regions that land on the same bin add
+        DSP::VectorMath::polarToCartesian(magnitude, outPhase, complexSpectrum, numBins);
+        std::fill(shiftedSpectrum, shiftedSpectrum + frameSize + 2, 0.0f);
+        for (int k = 0; k < numBins; ++k) {
+            int target = targetBin[k];
+            if (target >= 0) {
+                shiftedSpectrum[target * 2] += complexSpectrum[k * 2];
+                shiftedSpectrum[target * 2 + 1] += complexSpectrum[k * 2 + 1];
+            }
+        }
+        synthesis = shiftedSpectrum;
+    } else {
+        // Unity ratio: resynthesise the analysis frame, keeping phase state continuous
+        std::memcpy(channel.synthPhase, phase, static_cast<size_t>(numBins) * sizeof(float));
     }
     
-    // If we didn't produce enough output but have some input, 
-    // we need to wait for more input (latency). Return what we have.
-    // The circular buffer will accumulate more input on next call.
+    std::memcpy(channel.lastPhase, phase, static_cast<size_t>(numBins) * sizeof(float));
+    std::memcpy(channel.lastMagnitude, magnitude, static_cast<size_t>(numBins) * sizeof(float));
     
-    // Always return at least numSamples (zero-padded if needed)
-    // This ensures notes always trigger, even with latency
-    if (outputSamples < numSamples) {
-        // Pad with zeros - this is expected during initial latency period
-        std::fill(output + outputSamples, output + numSamples, 0.0f);
-        return numSamples;
+    // Overlap-add; the STFT window is normalised to sum(w^2) = frameSize, so
+    // analysis x synthesis windows at hop H sum to frameSize / H
+    stft.synthesize(synthesis, frameOutput);
+    const float olaGain = static_cast<float>(hopSize) / static_cast<float>(frameSize);
+    for (int i = 0; i < frameSize; ++i) {
+        channel.outputAccum[i] += frameOutput[i] * olaGain;
     }
     
-    return outputSamples;
-    */
+    // Emit one hop, shift the accumulator and the input history
+    std::memcpy(channel.outputFifo, channel.outputAccum, static_cast<size_t>(hopSize) * sizeof(float));
+    std::memmove(channel.outputAccum, channel.outputAccum + hopSize, static_cast<size_t>(frameSize - hopSize) * sizeof(float));
+    std::fill(channel.outputAccum + (frameSize - hopSize), channel.outputAccum + frameSize, 0.0f);
+    std::memmove(channel.inputFifo, channel.inputFifo + hopSize, static_cast<size_t>(frameSize - hopSize) * sizeof(float));
 }
 
-void PitchShiftTSM::processFrame()
+void PitchShiftTSM::shiftPeakRegions(Channel& channel, bool transient)
 {
-    // DISABLED - using simple resampling instead until FFT is fixed
-    // Phase vocoder code is commented out - see original implementation below
-    return;
+    std::fill(targetBin, targetBin + numBins, -1);
     
-    /* ORIGINAL PHASE VOCODER CODE - DISABLED
-    // Safety check
-    if (numBins == 0 || lastPhase == nullptr || currentPhase == nullptr || 
-        magnitude == nullptr || complexSpectrum == nullptr) {
-        return;
+    // Peak picking: local maxima over +/-2 bins above the floor
+    float maxMagnitude = 0.0f;
+    for (int k = 0; k < numBins; ++k) {
+        maxMagnitude = std::max(maxMagnitude, magnitude[k]);
     }
-    
-    // Read frame from input buffer
-    float frameInput[1024];
-    int read = inputBuffer.peek(frameInput, frameSize);
-    if (read < frameSize) {
-        return; // Not enough data
+    float floor = maxMagnitude * PEAK_FLOOR;
+    int numPeaks = 0;
+    for (int k = 2; k < numBins - 2; ++k) {
+        float m = magnitude[k];
+        if (m > floor && m > magnitude[k - 1] && m >= magnitude[k + 1] && m > magnitude[k - 2] && m >= magnitude[k + 2]) {
+            // Downward shifts can land neighbouring peaks on one bin; keep the louder
+            int target = static_cast<int>(std::lround(static_cast<float>(k) * pitchRatio));
+            if (numPeaks > 0 && std::lround(static_cast<float>(peaks[numPeaks - 1]) * pitchRatio) == target) {
+                if (m > magnitude[peaks[numPeaks - 1]]) {
+                    peaks[numPeaks - 1] = k;
+                }
+                continue;
+            }
+            peaks[numPeaks++] = k;
+        }
     }
-    
-    // Analyze frame
-    stft.analyze(frameInput, complexSpectrum);
-    
-    // Extract magnitude and phase
-    const double pi = 3.14159265358979323846;
-    const double twoPi = 2.0 * pi;
-    const double phaseIncrement = twoPi * hopSize / frameSize;
-    
-    for (int i = 0; i < numBins; ++i) {
-        float real = complexSpectrum[i * 2];
-        float imag = complexSpectrum[i * 2 + 1];
-        
-        magnitude[i] = std::sqrt(real * real + imag * imag);
-        currentPhase[i] = std::atan2(imag, real);
+    if (numPeaks == 0) {
+        return;  // Silence (or noise floor only) - output an empty frame
     }
     
-    // Phase unwrapping and pitch shifting
-    // This is the core of the phase vocoder algorithm
-    for (int i = 0; i < numBins; ++i) {
-        // Calculate expected phase advance for this bin
-        double expectedPhaseAdvance = phaseIncrement * i;
-        
-        // Calculate actual phase difference
-        float phaseDiff = currentPhase[i] - lastPhase[i];
-        
-        // Unwrap phase (handle 2π wraparound)
-        while (phaseDiff > pi) phaseDiff -= twoPi;
-        while (phaseDiff < -pi) phaseDiff += twoPi;
+    const float hop = static_cast<float>(hopSize);
+    const float binToOmega = TWO_PI / static_cast<float>(frameSize);  // rad/sample per bin
+    
+    int previousTarget = -1;
+    for (int p = 0; p < numPeaks; ++p) {
+        int peak = peaks[p];
+        int regionStart = (p == 0) ? 0 : (peaks[p - 1] + peak + 1) / 2;
+        int regionEnd = (p == numPeaks - 1) ? numBins - 1 : (peak + peaks[p + 1]) / 2;
+        int target = static_cast<int>(std::lround(static_cast<float>(peak) * pitchRatio));
+        int shift = target - peak;
+        if (target >= numBins) {
+            continue;  // Moved past Nyquist
+        }
         
-        // Add expected advance to get unwrapped phase
-        float unwrappedPhase = lastPhase[i] + phaseDiff + static_cast<float>(expectedPhaseAdvance);
+        // Moved regions end halfway to the neighbouring targets, so a downward shift
+        // cannot overwrite another peak's bins (and its phase history)
+        int nextTarget = (p == numPeaks - 1) ? 2 * numBins
+                                             : static_cast<int>(std::lround(static_cast<float>(peaks[p + 1]) * pitchRatio));
+        int firstDestination = std::max({ regionStart + shift, (previousTarget + target + 1) / 2, 0 });
+        int lastDestination = std::min({ regionEnd + shift, (target + nextTarget) / 2, numBins - 1 });
+        previousTarget = target;
         
-        // Scale phase advance by pitch ratio (this changes pitch)
-        // For pitch up: phase advances faster, for pitch down: slower
-        float scaledPhase = lastPhase[i] + phaseDiff * pitchRatio + static_cast<float>(expectedPhaseAdvance * pitchRatio);
+        // True frequency of the peak from its phase advance over one hop
+        float expected = binToOmega * static_cast<float>(peak) * hop;
+        float deviation = wrapPhase(phase[peak] - channel.lastPhase[peak] - expected);
+        float omega = binToOmega * static_cast<float>(peak) + deviation / hop;
         
-        // Store for next frame
-        lastPhase[i] = scaledPhase;
+        float peakPhase = transient ? phase[peak]
+                                    : wrapPhase(channel.synthPhase[target] + hop * omega * pitchRatio);
         
-        // Reconstruct complex spectrum with new phase
-        complexSpectrum[i * 2] = magnitude[i] * std::cos(scaledPhase);     // Real
-        complexSpectrum[i * 2 + 1] = magnitude[i] * std::sin(scaledPhase); // Imag
-    }
-    
-    // Simple transient detection (spectral flux)
-    float flux = detectTransient(magnitude);
-    bool isTransient = (flux > spectralFluxThreshold);
-    
-    // For transients, reduce phase propagation to avoid phasiness
-    if (isTransient) {
-        // Use more of the current phase, less of the propagated phase
-        for (int i = 1; i < numBins - 1; ++i) {
-            float real = complexSpectrum[i * 2];
-            float imag = complexSpectrum[i * 2 + 1];
-            float mag = std::sqrt(real * real + imag * imag);
-            float phase = std::atan2(imag, real);
-            
-            // Blend between current and propagated phase
-            float blendedPhase = 0.7f * phase + 0.3f * lastPhase[i];
-            
-            complexSpectrum[i * 2] = mag * std::cos(blendedPhase);
-            complexSpectrum[i * 2 + 1] = mag * std::sin(blendedPhase);
+        // Identity phase locking: the region keeps its phase relation to the peak
+        for (int destination = firstDestination; destination <= lastDestination; ++destination) {
+            int k = destination - shift;
+            targetBin[k] = destination;
+            outPhase[k] = wrapPhase(peakPhase + (phase[k] - phase[peak]));
         }
     }
     
-    // Synthesize frame
-    float frameOutput[1024];
-    stft.synthesize(complexSpectrum, frameOutput);
-    
-    // Write to output buffer (overlap-add will happen in process())
-    outputBuffer.write(frameOutput, frameSize);
-    
-    // Advance input buffer by hop size
-    float dummy[256];
-    inputBuffer.read(dummy, hopSize);
-    
-    // Update last magnitude for transient detection
-    std::memcpy(lastMagnitude, magnitude, numBins * sizeof(float));
-    */
-}
-
-void PitchShiftTSM::unwrapPhase(float* phase, const float* lastPhase, int numBins)
-{
-    const double pi = 3.14159265358979323846;
-    const double twoPi = 2.0 * pi;
-    
-    for (int i = 0; i < numBins; ++i) {
-        float diff = phase[i] - lastPhase[i];
-        
-        // Unwrap: add/subtract 2π to bring diff into [-π, π]
-        while (diff > pi) diff -= twoPi;
-        while (diff < -pi) diff += twoPi;
-        
-        phase[i] = lastPhase[i] + diff;
+    // Remember the phase each destination bin was given, for the next frame's peaks
+    for (int k = 0; k < numBins; ++k) {
+        if (targetBin[k] >= 0) {
+            channel.synthPhase[targetBin[k]] = outPhase[k];
+        } else {
+            outPhase[k] = 0.0f;  // Keep polarToCartesian inputs bounded
+        }
     }
 }
 
-float PitchShiftTSM::detectTransient(const float* magnitude)
+float PitchShiftTSM::detectTransient(const float* currentMagnitude, const float* previousMagnitude) const
 {
-    if (lastMagnitude == nullptr) {
-        return 0.0f;
-    }
-    
+    // Positive spectral flux relative to the previous frame's total magnitude
     float flux = 0.0f;
-    for (int i = 1; i < numBins; ++i) {
-        float diff = magnitude[i] - lastMagnitude[i];
+    float total = 0.0f;
+    for (int k = 1; k < numBins; ++k) {
+        float diff = currentMagnitude[k] - previousMagnitude[k];
         if (diff > 0.0f) {
             flux += diff;
         }
+        total += previousMagnitude[k];
     }
-    
-    // Normalize by number of bins
-    return flux / static_cast<float>(numBins);
-}
-
-void PitchShiftTSM::reset()
-{
-    inputBuffer.clear();
-    outputBuffer.clear();
-    
-    // Reset simple resampling read head
-    readHead = 0.0;
-    
-    if (lastPhase != nullptr) {
-        std::fill(lastPhase, lastPhase + numBins, 0.0f);
-        std::fill(currentPhase, currentPhase + numBins, 0.0f);
-        std::fill(magnitude, magnitude + numBins, 0.0f);
-    }
-    
-    if (lastMagnitude != nullptr) {
-        std::fill(lastMagnitude, lastMagnitude + numBins, 0.0f);
-    }
+    return flux / (total + 1.0e-9f);
 }
 
 void PitchShiftTSM::allocateBuffers()
 {
     deallocateBuffers();
     
-    numBins = frameSize / 2 + 1;
-    
-    lastPhase = new float[numBins];
-    currentPhase = new float[numBins];
-    magnitude = new float[numBins];
-    complexSpectrum = new float[frameSize + 2]; // Complex spectrum
-    lastMagnitude = new float[numBins];
+    // Sized for the largest frame so a pitch change never allocates
+    const int maxFrameSize = getMaxFrameSize();
+    const int maxBins = maxFrameSize / 2 + 1;
+    for (int c = 0; c < numChannels; ++c) {
+        Channel& channel = channels[c];
+        channel.inputFifo = new float[maxFrameSize];
+        channel.outputFifo = new float[maxFrameSize / HOP_DIVISOR];
+        channel.outputAccum = new float[maxFrameSize];
+        channel.lastPhase = new float[maxBins];
+        channel.synthPhase = new float[maxBins];
+        channel.lastMagnitude = new float[maxBins];
+    }
     
-    std::fill(lastPhase, lastPhase + numBins, 0.0f);
-    std::fill(currentPhase, currentPhase + numBins, 0.0f);
-    std::fill(magnitude, magnitude + numBins, 0.0f);
-    std::fill(complexSpectrum, complexSpectrum + frameSize + 2, 0.0f);
-    std::fill(lastMagnitude, lastMagnitude + numBins, 0.0f);
+    complexSpectrum = new float[maxFrameSize + 2];
+    shiftedSpectrum = new float[maxFrameSize + 2];
+    magnitude = new float[maxBins];
+    phase = new float[maxBins];
+    outPhase = new float[maxBins];
+    targetBin = new int[maxBins];
+    peaks = new int[maxBins];
+    frameOutput = new float[maxFrameSize];
+    
+    std::fill(complexSpectrum, complexSpectrum + maxFrameSize + 2, 0.0f);
+    std::fill(shiftedSpectrum, shiftedSpectrum + maxFrameSize + 2, 0.0f);
+    std::fill(outPhase, outPhase + maxBins, 0.0f);
 }
 
 void PitchShiftTSM::deallocateBuffers()
 {
-    delete[] lastPhase;
-    delete[] currentPhase;
-    delete[] magnitude;
+    for (Channel& channel : channels) {
+        delete[] channel.inputFifo;
+        delete[] channel.outputFifo;
+        delete[] channel.outputAccum;
+        delete[] channel.lastPhase;
+        delete[] channel.synthPhase;
+        delete[] channel.lastMagnitude;
+        
+        channel.inputFifo = nullptr;
+        channel.outputFifo = nullptr;
+        channel.outputAccum = nullptr;
+        channel.lastPhase = nullptr;
+        channel.synthPhase = nullptr;
+        channel.lastMagnitude = nullptr;
+    }
+    
     delete[] complexSpectrum;
-    delete[] lastMagnitude;
+    delete[] shiftedSpectrum;
+    delete[] magnitude;
+    delete[] phase;
+    delete[] outPhase;
+    delete[] targetBin;
+    delete[] peaks;
+    delete[] frameOutput;
     
-    lastPhase = nullptr;
-    currentPhase = nullptr;
-    magnitude = nullptr;
     complexSpectrum = nullptr;
-    lastMagnitude = nullptr;
+    shiftedSpectrum = nullptr;
+    magnitude = nullptr;
+    phase = nullptr;
+    outPhase = nullptr;
+    targetBin = nullptr;
+    peaks = nullptr;
+    frameOutput = nullptr;
+    prepared = false;
 }
 
 } // namespace Core
-
@@ -1,40 +1,62 @@
 #pragma once
 
+#include "ITimePitch.h"
 #include "STFT.h"
-#include "CircularBuffer.h"
 
 namespace Core {
 
 /**
- * Pitch Shifter with Time-Scale Modification (TSM)
- * Implements Phase Vocoder algorithm based on Bernsee's approach
- * 
+ * Phase-locked vocoder pitch shifter (constant duration)
+ * Portable C++ - no JUCE dependencies
+ * Implements ITimePitch; all buffers are allocated in prepare()
+ *
  * Algorithm overview:
- * - Uses STFT with constant hop size (Ha = Hs) to maintain constant duration
- * - Pitch shifting achieved by scaling phase advances in frequency domain
- * - Phase unwrapping and propagation for smooth pitch changes
- * 
+ * - STFT with constant hop size (Ha = Hs), so duration is unchanged
+ * - Spectral peaks are picked each frame; each peak's region of influence (bins up to
+ *   the midpoint to the next peak) is moved rigidly to round(peak * ratio), and trimmed
+ *   to the midpoints between the moved peaks so regions never overlap when shifting down
+ * - Identity phase locking (Laroche & Dolson): only the peak phase is propagated
+ *   from its true frequency; the other bins in the region keep their analysis phase
+ *   offset from the peak, preserving the partial's shape and avoiding phasiness
+ * - Frames with a spectral-flux onset reset peak phases to the analysis phases
+ * - Polar conversion uses the SIMD approximations in DSP/VectorMath
+ *
  * Frame/hop choices:
- * - Frame size: 1024 or 2048 (larger = better quality, more CPU, more latency)
+ * - Frame size: 1024 at 44.1/48 kHz, 2048 at 88.2/96 kHz (same time resolution)
+ * - Shifting down compresses partial spacing by the ratio, so the frame doubles for
+ *   ratios below MIN_SCALED_RATIO (about -16 st); both sizes are allocated in prepare().
+ *   A pitch change across that boundary restarts the stream (and changes the latency),
+ *   so set the pitch before a note starts
  * - Hop: frameSize/4 (75% overlap, standard for phase vocoder)
- * - Why constant duration: Ha = Hs means time-scale = 1.0, duration unchanged
- * 
- * Quality vs CPU tradeoffs:
- * - Larger frame size: better frequency resolution, smoother pitch shifts, more CPU
- * - Smaller hop: better time resolution, more CPU (more frames to process)
- * - Phase locking: optional improvement for transients (not implemented yet)
+ * - Latency: frameSize samples (the last frame covering a sample ends frameSize later)
+ *
+ * Time ratio is not supported: setTimeRatio() values other than 1.0 are ignored
  */
-class PitchShiftTSM {
+class PitchShiftTSM : public ITimePitch {
 public:
+    static constexpr int MAX_CHANNELS = 2;
+    
     PitchShiftTSM();
-    ~PitchShiftTSM();
+    ~PitchShiftTSM() override;
+    
+    PitchShiftTSM(const PitchShiftTSM&) = delete;
+    PitchShiftTSM& operator=(const PitchShiftTSM&) = delete;
+    
+    // ITimePitch
+    void prepare(const TimePitchConfig& config) override;
+    void reset() override;
+    void setPitchSemitones(float semitones) override;
+    void setTimeRatio(float ratio) override;
     
     /**
-     * Prepare pitch shifter
-     * sampleRate: audio sample rate
-     * maxBlockSize: maximum block size for processing
+     * Process interleaved audio; produces min(inN, outN) samples per channel
+     * Output is delayed by getInputLatency() samples
      */
-    void prepare(double sampleRate, int maxBlockSize);
+    int process(const float* in, int inN, float* out, int outN) override;
+    int getInputLatency() const override { return frameSize; }
+    int getOutputLatency() const override { return 0; }
+    int flush(float* out, int outN) override;
+    bool isPrepared() const override { return prepared; }
     
     /**
      * Set pitch ratio
@@ -44,58 +66,72 @@ public:
     void setPitchRatio(float ratio);
     
     /**
-     * Process audio block
-     * Input and output buffers must be pre-allocated
-     * numSamples: number of samples to process
-     * Returns number of output samples generated (may be less than numSamples due to latency)
-     */
-    int process(const float* input, float* output, int numSamples);
-    
-    /**
-     * Reset internal state (clear buffers, reset phases)
+     * Get latency in samples (one frame)
      */
-    void reset();
-    
-    /**
-     * Get latency in samples (due to frame size and overlap)
-     */
-    int getLatency() const { return frameSize - hopSize; }
+    int getLatency() const { return frameSize; }
 
 private:
     // STFT parameters
     static constexpr int DEFAULT_FRAME_SIZE = 1024;
-    static constexpr int DEFAULT_HOP_SIZE = 256; // frameSize / 4
+    static constexpr int HOP_DIVISOR = 4;  // 75% overlap
+    static constexpr int NUM_FRAME_SCALES = 2;  // 1x and 2x the base frame
+    static constexpr float MIN_SCALED_RATIO = 0.4f;  // Smallest ratio * frame scale before doubling
+    static constexpr float PEAK_FLOOR = 1.0e-4f;  // Peaks below -80 dB of the frame maximum are ignored
+    static constexpr float TRANSIENT_FLUX = 0.5f;  // Rise in total magnitude that counts as an onset
+    
+    struct Channel {
+        STFT stft[NUM_FRAME_SCALES];      // One per frame size (index = log2 of the scale)
+        float* inputFifo = nullptr;       // frameSize: latest input, oldest first
+        float* outputFifo = nullptr;      // hopSize: finished output of the last frame
+        float* outputAccum = nullptr;     // frameSize: overlap-add accumulator
+        float* lastPhase = nullptr;       // numBins: analysis phase of the previous frame
+        float* synthPhase = nullptr;      // numBins: synthesis phase of the previous frame
+        float* lastMagnitude = nullptr;   // numBins: for onset detection
+    };
     
+    int baseFrameSize;  // Frame size at unity and upward ratios
+    int frameScale;     // Index into Channel::stft for the current ratio
     int frameSize;
     int hopSize;
+    int numBins;
+    int numChannels;
     double sampleRate;
-    
-    STFT stft;
-    CircularBuffer inputBuffer;
-    CircularBuffer outputBuffer;
-    
-    // Phase vocoder state
-    float* lastPhase;
-    float* currentPhase;
-    float* magnitude;
-    float* complexSpectrum;
+    bool prepared;
     
     float pitchRatio;
-    int numBins;
+    float timeRatio;
     
-    // Simple resampling state (temporary until FFT is fixed)
-    double readHead;
+    Channel channels[MAX_CHANNELS];
+    int fifoPos;        // Write position in inputFifo (starts one hop before the end)
+    int tailRemaining;  // Samples flush() still has to drain
     
-    // Transient detection (simple spectral flux)
-    float* lastMagnitude;
-    float spectralFluxThreshold;
+    // Shared frame scratch (one channel is processed at a time); buffers are sized for
+    // the largest frame
+    float* complexSpectrum;   // frameSize + 2
+    float* shiftedSpectrum;   // frameSize + 2
+    float* magnitude;         // numBins
+    float* phase;             // numBins
+    float* outPhase;          // numBins: synthesis phase for each source bin
+    int* targetBin;           // numBins: destination bin for each source bin (-1 = dropped)
+    int* peaks;               // numBins
+    float* frameOutput;       // frameSize
     
     void allocateBuffers();
     void deallocateBuffers();
-    void processFrame();
-    void unwrapPhase(float* phase, const float* lastPhase, int numBins);
-    float detectTransient(const float* magnitude);
+    
+    int getMaxFrameSize() const { return baseFrameSize << (NUM_FRAME_SCALES - 1); }
+    
+    // Frame scale index for a pitch ratio, and switching the active frame size to it
+    static int frameScaleFor(float ratio);
+    void selectFrameScale(int scale);
+    
+    // Push n interleaved samples (nullptr = silence) and pull n delayed output samples
+    void processSamples(const float* in, float* out, int n);
+    void processFrame(Channel& channel);
+    
+    // Build targetBin/outPhase from magnitude/phase for the current pitch ratio
+    void shiftPeakRegions(Channel& channel, bool transient);
+    float detectTransient(const float* magnitude, const float* lastMagnitude) const;
 };
 
 } // namespace Core
-
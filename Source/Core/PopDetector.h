@@ -155,10 +155,11 @@ public:
         lastMixOutR = 0.0f;
     }
     
-    void processBlock(float** output, int numChannels, int numSamples,
+    // Returns true when the block popped (the event is also available from getLastEvent)
+    bool processBlock(float** output, int numChannels, int numSamples,
                      PopEventRingBuffer& eventBuffer) {
         if (numChannels == 0 || output[0] == nullptr || numSamples == 0) {
-            return;
+            return false;
         }
         
         float maxMixDeltaL = 0.0f;
@@ -202,7 +203,8 @@ public:
         
         // Check for pop at mix level
         float maxMixDelta = std::max(maxMixDeltaL, maxMixDeltaR);
-        if (maxMixDelta > threshold) {
+        bool popped = maxMixDelta > threshold;
+        if (popped) {
             PopEvent event;
             event.frameCounterGlobal = frameCounter;
             event.voiceId = -1;  // Mix-level pop, not voice-specific
@@ -220,16 +222,31 @@ public:
             event.flags = 0;
             
             eventBuffer.write(event);
+            lastEvent = event;
         }
         
         frameCounter += static_cast<uint64_t>(numSamples);
+        return popped;
+    }
+    
+    // Keep the frame counter and block-edge state current without scanning (detection off)
+    void skipBlock(float** output, int numChannels, int numSamples) {
+        if (numChannels > 0 && output[0] != nullptr && numSamples > 0) {
+            lastMixOutL = output[0][numSamples - 1];
+            lastMixOutR = (numChannels > 1 && output[1] != nullptr) ? output[1][numSamples - 1] : lastMixOutL;
+            frameCounter += static_cast<uint64_t>(numSamples);
+        }
     }
     
     void setThreshold(float thresh) { threshold = thresh; }
     
     uint64_t getFrameCounter() const { return frameCounter; }
     
+    // Most recent pop (audio thread)
+    const PopEvent& getLastEvent() const { return lastEvent; }
+    
 private:
+    PopEvent lastEvent;
     uint64_t frameCounter;
     float threshold;
     float lastMixOutL;
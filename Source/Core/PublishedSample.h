@@ -0,0 +1,55 @@
+#pragma once
+
+#include "SampleData.h"
+#include <atomic>
+#include <thread>
+
+namespace Core {
+
+/**
+ * Lock-free publication of a SampleDataPtr
+ * Portable C++ - no JUCE dependencies
+ * Single writer (UI/loader thread), any number of readers (audio thread)
+ *
+ * std::atomic_load/atomic_store on a shared_ptr take a mutex from a global pool in
+ * libstdc++ and libc++, so they cannot be used on the audio thread. Here the writer fills
+ * the unpublished one of two slots and flips the index; a reader pins the pair while it
+ * copies the published slot (a refcount increment). The writer waits only for a reader
+ * that is mid-copy, never the other way round.
+ */
+class PublishedSample {
+public:
+    /**
+     * Copy the current sample (any thread; never blocks)
+     */
+    SampleDataPtr load() const noexcept {
+        // Sequentially consistent pin/index pair with publish(): either the writer sees the
+        // pin and waits, or this reads the index published last, never the slot being filled
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        SampleDataPtr data = slots[published.load(std::memory_order_seq_cst)];
+        readers.fetch_sub(1, std::memory_order_release);
+        return data;
+    }
+    
+    /**
+     * Replace the current sample (writer thread only)
+     * The previous sample stays referenced until the next publish()
+     */
+    void publish(SampleDataPtr data) noexcept {
+        // A reader that loaded the index before the previous flip may still be copying the
+        // slot about to be overwritten
+        while (readers.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+        int next = 1 - published.load(std::memory_order_relaxed);
+        slots[next] = std::move(data);
+        published.store(next, std::memory_order_seq_cst);
+    }
+
+private:
+    SampleDataPtr slots[2];
+    std::atomic<int> published{0};
+    mutable std::atomic<int> readers{0};
+};
+
+} // namespace Core
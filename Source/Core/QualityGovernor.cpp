@@ -0,0 +1,139 @@
+#include "QualityGovernor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Core {
+
+QualityGovernor::QualityGovernor()
+    : sampleRate(44100.0)
+    , smoothedLoad(0.0f)
+    , secondsAbove(0.0f)
+    , secondsBelow(0.0f)
+    , secondsSinceChange(0.0f)
+    , blockIndex(0)
+{
+}
+
+void QualityGovernor::prepare(double newSampleRate) {
+    sampleRate = (newSampleRate > 0.0) ? newSampleRate : 44100.0;
+    smoothedLoad = 0.0f;
+    secondsAbove = 0.0f;
+    secondsBelow = 0.0f;
+    secondsSinceChange = config.cooldownSeconds;
+    blockIndex = 0;
+    level.store(static_cast<int>(QualityLevel::Full), std::memory_order_relaxed);
+}
+
+bool QualityGovernor::update(float blockLoad, int numSamples) {
+    if (numSamples <= 0) {
+        return false;
+    }
+    const int current = level.load(std::memory_order_relaxed);
+    ++blockIndex;
+    
+    if (!enabled.load(std::memory_order_relaxed)) {
+        smoothedLoad = 0.0f;
+        secondsAbove = 0.0f;
+        secondsBelow = 0.0f;
+        if (current != static_cast<int>(QualityLevel::Full)) {
+            changeLevel(static_cast<int>(QualityLevel::Full), blockLoad);
+            return true;
+        }
+        return false;
+    }
+    
+    // One-pole smoothing with a time constant independent of the block size
+    const float blockSeconds = static_cast<float>(numSamples / sampleRate);
+    const float alpha = (config.smoothingSeconds > 0.0f) ? 1.0f - std::exp(-blockSeconds / config.smoothingSeconds) : 1.0f;
+    smoothedLoad += alpha * (blockLoad - smoothedLoad);
+    secondsSinceChange += blockSeconds;
+    secondsAbove = (smoothedLoad > config.downLoad) ? secondsAbove + blockSeconds : 0.0f;
+    secondsBelow = (smoothedLoad < config.upLoad) ? secondsBelow + blockSeconds : 0.0f;
+    
+    if (secondsSinceChange < config.cooldownSeconds) {
+        return false;
+    }
+    
+    const int lowest = std::min(NUM_LEVELS - 1, std::max(0, floorLevel.load(std::memory_order_relaxed)));
+    const bool missedDeadline = blockLoad >= 1.0f;
+    if ((missedDeadline || secondsAbove >= config.downHoldSeconds) && current < lowest) {
+        changeLevel(current + 1, blockLoad);
+        return true;
+    }
+    if (secondsBelow >= config.upHoldSeconds && current > 0) {
+        changeLevel(current - 1, blockLoad);
+        return true;
+    }
+    if (current > lowest) {
+        changeLevel(lowest, blockLoad);  // Floor raised while degraded
+        return true;
+    }
+    return false;
+}
+
+void QualityGovernor::changeLevel(int newLevel, float blockLoad) {
+    const int oldLevel = level.load(std::memory_order_relaxed);
+    level.store(newLevel, std::memory_order_relaxed);
+    secondsSinceChange = 0.0f;
+    secondsAbove = 0.0f;
+    secondsBelow = 0.0f;
+    
+    int write = eventWrite.load(std::memory_order_relaxed);
+    int next = (write + 1) % CHANGE_EVENTS;
+    if (next != eventRead.load(std::memory_order_acquire)) {
+        QualityChangeEvent& event = events[write];
+        event.blockIndex = blockIndex;
+        event.from = static_cast<QualityLevel>(oldLevel);
+        event.to = static_cast<QualityLevel>(newLevel);
+        event.smoothedLoad = smoothedLoad;
+        event.blockLoad = blockLoad;
+        eventWrite.store(next, std::memory_order_release);
+    }
+}
+
+int QualityGovernor::readChanges(QualityChangeEvent* out, int maxCount) {
+    int count = 0;
+    int read = eventRead.load(std::memory_order_relaxed);
+    const int write = eventWrite.load(std::memory_order_acquire);
+    while (count < maxCount && read != write) {
+        out[count++] = events[read];
+        read = (read + 1) % CHANGE_EVENTS;
+    }
+    eventRead.store(read, std::memory_order_release);
+    return count;
+}
+
+QualitySettings QualityGovernor::getSettings(QualityLevel level) {
+    QualitySettings settings;
+    switch (level) {
+        case QualityLevel::Minimal:
+            settings.interpolate = false;
+            settings.heldVoiceLimit = 2;
+            [[fallthrough]];
+        case QualityLevel::Economy:
+            settings.liveWarp = false;
+            settings.heldVoiceLimit = std::min(settings.heldVoiceLimit, 4);
+            [[fallthrough]];
+        case QualityLevel::Reduced:
+            settings.popDiagnostics = false;
+            settings.filterModInterval = 32;
+            break;
+        case QualityLevel::Full:
+        case QualityLevel::NumLevels:
+            break;
+    }
+    return settings;
+}
+
+const char* QualityGovernor::getLevelName(QualityLevel level) {
+    switch (level) {
+        case QualityLevel::Full:      return "full";
+        case QualityLevel::Reduced:   return "reduced";
+        case QualityLevel::Economy:   return "economy";
+        case QualityLevel::Minimal:   return "minimal";
+        case QualityLevel::NumLevels: break;
+    }
+    return "unknown";
+}
+
+} // namespace Core
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * Render quality steps, most expensive first
+ */
+enum class QualityLevel : int {
+    Full = 0,   // Everything on
+    Reduced,    // Diagnostics off, coarser filter modulation
+    Economy,    // + new warp notes resample, 4 held voices per group
+    Minimal,    // + drop-sample reads for new notes, 2 held voices per group
+    NumLevels
+};
+
+/**
+ * What the engine renders at one quality level
+ */
+struct QualitySettings {
+    bool popDiagnostics = true;      // Engine pop detector (diagnostic only, no audible effect)
+    int filterModInterval = 8;       // Samples between filter coefficient updates under envelope modulation
+    bool liveWarp = true;            // New warp notes lease a stretcher (false = resampled unless pre-rendered)
+    int heldVoiceLimit = 6;          // Held voices per blend group (new notes steal beyond this)
+    bool interpolate = true;         // New notes interpolate sample reads (false = drop-sample)
+};
+
+/**
+ * One governor decision, as recorded for the UI and logs
+ */
+struct QualityChangeEvent {
+    uint64_t blockIndex = 0;         // Blocks seen by the governor before this decision
+    QualityLevel from = QualityLevel::Full;
+    QualityLevel to = QualityLevel::Full;
+    float smoothedLoad = 0.0f;       // Load that triggered the change (1.0 = deadline)
+    float blockLoad = 0.0f;          // Load of the block that triggered the change
+};
+
+/**
+ * CPU-adaptive quality governor
+ * Portable C++ - no JUCE dependencies
+ *
+ * Fed the callback load of every block (CallbackLoadMeter), it smooths the load and
+ * steps quality down one level once the smoothed load has stayed above downLoad for
+ * downHoldSeconds, or at once on a missed deadline. It steps back up only after the load
+ * has stayed below upLoad for upHoldSeconds, and never changes twice within
+ * cooldownSeconds. The caller applies getSettings(getLevel()) between blocks; every
+ * setting is chosen so the switch is click-free (see QualitySettings).
+ *
+ * Audio thread: prepare, update. Any thread: getLevel, setEnabled, setFloor, readChanges
+ * (single reader)
+ */
+class QualityGovernor {
+public:
+    static constexpr int NUM_LEVELS = static_cast<int>(QualityLevel::NumLevels);
+    static constexpr int CHANGE_EVENTS = 32;
+    
+    struct Config {
+        float downLoad = 0.75f;          // Step down above this smoothed load...
+        float downHoldSeconds = 0.05f;   // ...held this long
+        float upLoad = 0.45f;            // Step up below this smoothed load...
+        float upHoldSeconds = 3.0f;      // ...held this long
+        float cooldownSeconds = 0.5f;    // Minimum time between changes
+        float smoothingSeconds = 0.1f;   // Load smoothing time constant
+    };
+    
+    QualityGovernor();
+    
+    /**
+     * Reset to Full for a new sample rate (audio thread or while stopped)
+     */
+    void prepare(double sampleRate);
+    
+    /**
+     * Feed one block's load; returns true if the level changed (audio thread)
+     */
+    bool update(float blockLoad, int numSamples);
+    
+    QualityLevel getLevel() const { return static_cast<QualityLevel>(level.load(std::memory_order_relaxed)); }
+    
+    // Disabled = Full from the next update (thread-safe)
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+    
+    // Lowest level the governor may step down to (thread-safe)
+    void setFloor(QualityLevel lowest) { floorLevel.store(static_cast<int>(lowest), std::memory_order_relaxed); }
+    
+    // Not thread-safe - call while the audio callback is stopped
+    void setConfig(const Config& newConfig) { config = newConfig; }
+    const Config& getConfig() const { return config; }
+    
+    /**
+     * Drain recorded level changes (oldest first); returns the number copied
+     */
+    int readChanges(QualityChangeEvent* out, int maxCount);
+    
+    static QualitySettings getSettings(QualityLevel level);
+    static const char* getLevelName(QualityLevel level);
+
+private:
+    Config config;
+    double sampleRate;
+    
+    // Audio thread state
+    float smoothedLoad;
+    float secondsAbove;     // Time the smoothed load has spent above downLoad
+    float secondsBelow;     // Time the smoothed load has spent below upLoad
+    float secondsSinceChange;
+    uint64_t blockIndex;
+    
+    std::atomic<int> level{0};
+    std::atomic<bool> enabled{true};
+    std::atomic<int> floorLevel{NUM_LEVELS - 1};
+    
+    // Change events (single producer: audio thread, single consumer: UI; full = drop)
+    QualityChangeEvent events[CHANGE_EVENTS];
+    std::atomic<int> eventWrite{0};
+    std::atomic<int> eventRead{0};
+    
+    void changeLevel(int newLevel, float blockLoad);
+};
+
+} // namespace Core
@@ -0,0 +1,149 @@
+#include "RealtimeSanitizer.h"
+#include <algorithm>
+#include <cstdio>
+
+#if OP1_RT_SANITIZER && (defined(__GLIBC__) || defined(__APPLE__))
+#include <execinfo.h>
+#define OP1_RT_BACKTRACE 1
+#else
+#define OP1_RT_BACKTRACE 0
+#endif
+
+// The depth counters are read from inside malloc; initial-exec TLS never allocates on access
+#if defined(__GLIBC__)
+#define OP1_RT_THREAD_LOCAL thread_local __attribute__((tls_model("initial-exec")))
+#else
+#define OP1_RT_THREAD_LOCAL thread_local
+#endif
+
+namespace Core {
+
+namespace {
+
+OP1_RT_THREAD_LOCAL int realtimeDepth = 0;
+OP1_RT_THREAD_LOCAL int reportDepth = 0;  // Inside reportViolation: calls it makes are not violations
+
+struct LogSlot {
+    std::atomic<bool> ready { false };
+    RealtimeViolation violation;
+};
+
+LogSlot violationLog[RealtimeSanitizer::LOG_CAPACITY];
+std::atomic<uint64_t> violationCount { 0 };
+std::atomic<uint64_t> kindCounts[static_cast<int>(RealtimeViolationKind::NumKinds)] = {};
+
+#if OP1_RT_BACKTRACE
+// The first backtrace() loads the unwinder (dlopen + malloc); do that before any audio runs
+struct BacktraceWarmup {
+    BacktraceWarmup() {
+        void* frames[2];
+        backtrace(frames, 2);
+    }
+};
+BacktraceWarmup backtraceWarmup;
+#endif
+
+} // namespace
+
+void RealtimeSanitizer::enterRealtime() {
+    ++realtimeDepth;
+}
+
+void RealtimeSanitizer::exitRealtime() {
+    --realtimeDepth;
+}
+
+bool RealtimeSanitizer::isRealtimeThread() {
+    return realtimeDepth > 0;
+}
+
+void RealtimeSanitizer::reportViolation(RealtimeViolationKind kind, const char* function) {
+    if (realtimeDepth <= 0 || reportDepth > 0) {
+        return;
+    }
+    ++reportDepth;
+    kindCounts[static_cast<int>(kind)].fetch_add(1, std::memory_order_relaxed);
+    
+    // Slots are claimed once; later violations only count
+    uint64_t index = violationCount.fetch_add(1, std::memory_order_relaxed);
+    if (index < static_cast<uint64_t>(LOG_CAPACITY)) {
+        LogSlot& slot = violationLog[index];
+        slot.violation.kind = kind;
+        slot.violation.function = function;
+#if OP1_RT_BACKTRACE
+        slot.violation.numFrames = backtrace(slot.violation.frames, RealtimeViolation::MAX_FRAMES);
+#else
+        slot.violation.numFrames = 0;
+#endif
+        slot.ready.store(true, std::memory_order_release);
+    }
+    
+    --reportDepth;
+}
+
+uint64_t RealtimeSanitizer::getViolationCount() {
+    return violationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t RealtimeSanitizer::getViolationCount(RealtimeViolationKind kind) {
+    int index = static_cast<int>(kind);
+    if (index < 0 || index >= static_cast<int>(RealtimeViolationKind::NumKinds)) {
+        return 0;
+    }
+    return kindCounts[index].load(std::memory_order_relaxed);
+}
+
+int RealtimeSanitizer::readViolations(RealtimeViolation* out, int maxCount) {
+    if (out == nullptr || maxCount <= 0) {
+        return 0;
+    }
+    uint64_t logged = std::min<uint64_t>(getViolationCount(), static_cast<uint64_t>(LOG_CAPACITY));
+    int count = 0;
+    for (uint64_t i = 0; i < logged && count < maxCount; ++i) {
+        if (violationLog[i].ready.load(std::memory_order_acquire)) {
+            out[count++] = violationLog[i].violation;
+        }
+    }
+    return count;
+}
+
+void RealtimeSanitizer::printViolations(int maxCount) {
+    RealtimeViolation violations[LOG_CAPACITY];
+    int count = readViolations(violations, std::min(maxCount, LOG_CAPACITY));
+    uint64_t total = getViolationCount();
+    if (total == 0) {
+        return;
+    }
+    fprintf(stderr, "Real-time violations: %llu (%d logged)\n", static_cast<unsigned long long>(total), count);
+    for (int i = 0; i < count; ++i) {
+        const RealtimeViolation& v = violations[i];
+        fprintf(stderr, "#%d %s in %s\n", i, getKindName(v.kind), v.function);
+#if OP1_RT_BACKTRACE
+        fflush(stderr);
+        backtrace_symbols_fd(v.frames, v.numFrames, fileno(stderr));  // No allocation
+#endif
+    }
+}
+
+void RealtimeSanitizer::reset() {
+    for (auto& slot : violationLog) {
+        slot.ready.store(false, std::memory_order_relaxed);
+    }
+    for (auto& count : kindCounts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    violationCount.store(0, std::memory_order_release);
+}
+
+const char* RealtimeSanitizer::getKindName(RealtimeViolationKind kind) {
+    switch (kind) {
+        case RealtimeViolationKind::Allocation:   return "allocation";
+        case RealtimeViolationKind::Deallocation: return "deallocation";
+        case RealtimeViolationKind::MutexLock:    return "mutex lock";
+        case RealtimeViolationKind::FileIo:       return "file I/O";
+        case RealtimeViolationKind::NumKinds:     break;
+    }
+    return "unknown";
+}
+
+} // namespace Core
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Audio-thread safety checks are compiled out unless OP1_RT_SANITIZER=1 (CMake option
+// OP1_RT_SANITIZER); OP1_REALTIME_SCOPE then expands to nothing
+#ifndef OP1_RT_SANITIZER
+#define OP1_RT_SANITIZER 0
+#endif
+
+namespace Core {
+
+enum class RealtimeViolationKind : int {
+    Allocation = 0,  // malloc/calloc/realloc/aligned alloc, operator new
+    Deallocation,    // free, operator delete
+    MutexLock,       // pthread_mutex_lock (std::mutex, JUCE CriticalSection, ...)
+    FileIo,          // open/fopen/read/write/close (std::ofstream, printf, ...)
+    NumKinds
+};
+
+/**
+ * One blocking call made inside a real-time scope, with the stack that made it
+ */
+struct RealtimeViolation {
+    static constexpr int MAX_FRAMES = 24;
+    
+    RealtimeViolationKind kind = RealtimeViolationKind::Allocation;
+    const char* function = "";  // Interposed call, e.g. "operator new" or "fopen"
+    int numFrames = 0;
+    void* frames[MAX_FRAMES] = {};
+};
+
+/**
+ * Real-time safety sanitizer for the audio thread (debug builds)
+ * Portable C++ - no JUCE dependencies
+ *
+ * OP1_REALTIME_SCOPE marks the current thread as real-time until the end of the enclosing
+ * block (processBlock, render worker tasks, the stress harness callback). With
+ * OP1_RT_SANITIZER=1 the build replaces the global operator new/delete and, on glibc,
+ * interposes malloc/free, pthread_mutex_lock and the file calls. A hooked call made inside a
+ * scope is recorded with its stack trace in a fixed, lock-free log (first LOG_CAPACITY
+ * violations since reset; the count keeps going) and then proceeds normally.
+ *
+ * Interposition covers code linked into an executable (Standalone app, harnesses); a plugin
+ * binary loaded by a host resolves the allocator to the host's copy first
+ */
+class RealtimeSanitizer {
+public:
+    static constexpr int LOG_CAPACITY = 64;
+    
+    static constexpr bool isEnabled() { return OP1_RT_SANITIZER != 0; }
+    
+    // Real-time scope nesting for the calling thread
+    static void enterRealtime();
+    static void exitRealtime();
+    static bool isRealtimeThread();
+    
+    // Called by the interposed functions; records only inside a real-time scope
+    static void reportViolation(RealtimeViolationKind kind, const char* function);
+    
+    // Violations since the last reset, in total or of one kind (any thread)
+    static uint64_t getViolationCount();
+    static uint64_t getViolationCount(RealtimeViolationKind kind);
+    
+    // Copy up to maxCount logged violations, oldest first (any thread)
+    static int readViolations(RealtimeViolation* out, int maxCount);
+    
+    // Logged violations with symbolised stacks on stderr. Not real-time safe
+    static void printViolations(int maxCount = LOG_CAPACITY);
+    
+    // Clear the log. Call while no real-time scope is active
+    static void reset();
+    
+    static const char* getKindName(RealtimeViolationKind kind);
+};
+
+/**
+ * Marks the calling thread real-time for its lifetime (use OP1_REALTIME_SCOPE)
+ */
+class ScopedRealtimeContext {
+public:
+    ScopedRealtimeContext() { RealtimeSanitizer::enterRealtime(); }
+    ~ScopedRealtimeContext() { RealtimeSanitizer::exitRealtime(); }
+    
+    ScopedRealtimeContext(const ScopedRealtimeContext&) = delete;
+    ScopedRealtimeContext& operator=(const ScopedRealtimeContext&) = delete;
+};
+
+} // namespace Core
+
+#if OP1_RT_SANITIZER
+#define OP1_REALTIME_SCOPE(name) ::Core::ScopedRealtimeContext name
+#else
+#define OP1_REALTIME_SCOPE(name) do {} while (false)
+#endif
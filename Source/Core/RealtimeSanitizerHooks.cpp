@@ -0,0 +1,330 @@
+#include "RealtimeSanitizer.h"
+
+// Interposers for RealtimeSanitizer, only built into OP1_RT_SANITIZER builds
+// Kept apart from the other sources: the C hooks are declared here by hand rather than
+// through <stdio.h>/<unistd.h>, whose fortified inline wrappers would clash with them
+
+#if OP1_RT_SANITIZER
+
+#include <cstdarg>
+#include <cstddef>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <atomic>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/types.h>
+#define OP1_RT_LIBC_HOOKS 1
+#else
+#include <cstdlib>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+#define OP1_RT_LIBC_HOOKS 0
+#endif
+
+namespace {
+
+using Core::RealtimeSanitizer;
+using Core::RealtimeViolationKind;
+
+} // namespace
+
+#if OP1_RT_LIBC_HOOKS
+
+// glibc's allocator entry points; calling them skips the malloc hooks below
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+void* rawAlloc(size_t size) { return __libc_malloc(size); }
+void* rawAlignedAlloc(size_t alignment, size_t size) { return __libc_memalign(alignment, size); }
+void rawFree(void* ptr) { __libc_free(ptr); }
+void rawAlignedFree(void* ptr) { __libc_free(ptr); }
+
+/**
+ * Next definition of an interposed libc function, looked up once
+ * Resolved at load time by the constructor below; the lazy path covers calls made earlier
+ */
+template <typename Fn>
+class NextSymbol {
+public:
+    explicit constexpr NextSymbol(const char* symbolName) : name(symbolName) {}
+    
+    Fn get() {
+        Fn fn = resolved.load(std::memory_order_relaxed);
+        if (fn == nullptr) {
+            fn = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+            resolved.store(fn, std::memory_order_relaxed);
+        }
+        return fn;
+    }
+
+private:
+    const char* name;
+    std::atomic<Fn> resolved { nullptr };
+};
+
+NextSymbol<int (*)(pthread_mutex_t*)> nextMutexLock("pthread_mutex_lock");
+NextSymbol<int (*)(const char*, int, ...)> nextOpen("open");
+NextSymbol<int (*)(const char*, int, ...)> nextOpen64("open64");
+NextSymbol<int (*)(int, const char*, int, ...)> nextOpenAt("openat");
+NextSymbol<void* (*)(const char*, const char*)> nextFopen("fopen");
+NextSymbol<void* (*)(const char*, const char*)> nextFopen64("fopen64");
+NextSymbol<int (*)(void*)> nextFclose("fclose");
+NextSymbol<size_t (*)(const void*, size_t, size_t, void*)> nextFwrite("fwrite");
+NextSymbol<ssize_t (*)(int, void*, size_t)> nextRead("read");
+NextSymbol<ssize_t (*)(int, const void*, size_t)> nextWrite("write");
+NextSymbol<int (*)(int)> nextClose("close");
+
+__attribute__((constructor)) void resolveNextSymbols() {
+    nextMutexLock.get();
+    nextOpen.get();
+    nextOpen64.get();
+    nextOpenAt.get();
+    nextFopen.get();
+    nextFopen64.get();
+    nextFclose.get();
+    nextFwrite.get();
+    nextRead.get();
+    nextWrite.get();
+    nextClose.get();
+}
+
+// O_CREAT and O_TMPFILE carry a mode argument (values from <fcntl.h>, Linux)
+bool openTakesMode(int flags) {
+    return (flags & 0100) != 0 || (flags & 020000000) != 0;
+}
+
+} // namespace
+
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::Allocation, "malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::Allocation, "calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::Allocation, "realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::Allocation, "aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) noexcept {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::Allocation, "posix_memalign");
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) {
+        return 22;  // EINVAL
+    }
+    void* ptr = __libc_memalign(alignment, size);
+    if (ptr == nullptr) {
+        return 12;  // ENOMEM
+    }
+    *out = ptr;
+    return 0;
+}
+
+void free(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        RealtimeSanitizer::reportViolation(RealtimeViolationKind::Deallocation, "free");
+    }
+    __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::MutexLock, "pthread_mutex_lock");
+    return nextMutexLock.get()(mutex);
+}
+
+int open(const char* path, int flags, ...) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "open");
+    int mode = 0;
+    if (openTakesMode(flags)) {
+        va_list args;
+        va_start(args, flags);
+        mode = va_arg(args, int);
+        va_end(args);
+    }
+    return nextOpen.get()(path, flags, mode);
+}
+
+int open64(const char* path, int flags, ...) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "open64");
+    int mode = 0;
+    if (openTakesMode(flags)) {
+        va_list args;
+        va_start(args, flags);
+        mode = va_arg(args, int);
+        va_end(args);
+    }
+    return nextOpen64.get()(path, flags, mode);
+}
+
+int openat(int dirFd, const char* path, int flags, ...) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "openat");
+    int mode = 0;
+    if (openTakesMode(flags)) {
+        va_list args;
+        va_start(args, flags);
+        mode = va_arg(args, int);
+        va_end(args);
+    }
+    return nextOpenAt.get()(dirFd, path, flags, mode);
+}
+
+// FILE* is passed through as void*: C linkage only matches the symbol name
+void* fopen(const char* path, const char* modes) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "fopen");
+    return nextFopen.get()(path, modes);
+}
+
+void* fopen64(const char* path, const char* modes) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "fopen64");
+    return nextFopen64.get()(path, modes);
+}
+
+int fclose(void* stream) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "fclose");
+    return nextFclose.get()(stream);
+}
+
+size_t fwrite(const void* data, size_t size, size_t count, void* stream) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "fwrite");
+    return nextFwrite.get()(data, size, count, stream);
+}
+
+ssize_t read(int fd, void* buffer, size_t count) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "read");
+    return nextRead.get()(fd, buffer, count);
+}
+
+ssize_t write(int fd, const void* buffer, size_t count) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "write");
+    return nextWrite.get()(fd, buffer, count);
+}
+
+int close(int fd) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::FileIo, "close");
+    return nextClose.get()(fd);
+}
+
+} // extern "C"
+
+#else
+
+namespace {
+
+void* rawAlloc(size_t size) { return std::malloc(size); }
+void rawFree(void* ptr) { std::free(ptr); }
+
+void* rawAlignedAlloc(size_t alignment, size_t size) {
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void rawAlignedFree(void* ptr) {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+#endif // OP1_RT_LIBC_HOOKS
+
+// Replacement global operator new/delete (every platform)
+namespace {
+
+void* checkedNew(size_t size, const char* function) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::Allocation, function);
+    void* ptr = rawAlloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* checkedAlignedNew(size_t size, std::align_val_t alignment, const char* function) {
+    RealtimeSanitizer::reportViolation(RealtimeViolationKind::Allocation, function);
+    size_t align = static_cast<size_t>(alignment);
+    if (align < sizeof(void*)) {
+        align = sizeof(void*);
+    }
+    void* ptr = rawAlignedAlloc(align, size == 0 ? align : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void checkedDelete(void* ptr, const char* function) {
+    if (ptr != nullptr) {
+        RealtimeSanitizer::reportViolation(RealtimeViolationKind::Deallocation, function);
+    }
+    rawFree(ptr);
+}
+
+void checkedAlignedDelete(void* ptr, const char* function) {
+    if (ptr != nullptr) {
+        RealtimeSanitizer::reportViolation(RealtimeViolationKind::Deallocation, function);
+    }
+    rawAlignedFree(ptr);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return checkedNew(size, "operator new"); }
+void* operator new[](size_t size) { return checkedNew(size, "operator new[]"); }
+void* operator new(size_t size, std::align_val_t alignment) { return checkedAlignedNew(size, alignment, "operator new"); }
+void* operator new[](size_t size, std::align_val_t alignment) { return checkedAlignedNew(size, alignment, "operator new[]"); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return checkedNew(size, "operator new"); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return checkedNew(size, "operator new[]"); } catch (...) { return nullptr; }
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return checkedAlignedNew(size, alignment, "operator new"); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return checkedAlignedNew(size, alignment, "operator new[]"); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* ptr) noexcept { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr) noexcept { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, size_t) noexcept { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, size_t) noexcept { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { checkedDelete(ptr, "operator delete[]"); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { checkedAlignedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { checkedAlignedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { checkedAlignedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { checkedAlignedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { checkedAlignedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { checkedAlignedDelete(ptr, "operator delete[]"); }
+
+#endif // OP1_RT_SANITIZER
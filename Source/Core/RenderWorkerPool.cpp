@@ -0,0 +1,264 @@
+#include "RenderWorkerPool.h"
+#include "RealtimeSanitizer.h"
+#include <thread>
+#include <algorithm>
+
+#if defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#include <pthread.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define CORE_WORKER_X86 1
+#endif
+
+namespace Core {
+
+namespace {
+
+// Spin-wait hint (keeps the spinning core from starving its hyperthread sibling)
+inline void cpuPause() {
+#if defined(CORE_WORKER_X86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Workers run DSP too, so they need the same flush-to-zero mode as the audio thread
+void disableDenormals() {
+#if defined(CORE_WORKER_X86)
+    _mm_setcsr(_mm_getcsr() | 0x8040);  // FTZ | DAZ
+#elif defined(__aarch64__)
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1ULL << 24)));  // FZ
+#endif
+}
+
+// Best effort: raise priority and pin to a core; failures (no permission) are ignored
+void configureWorkerThread(int workerIndex) {
+    unsigned int numCores = std::max(1u, std::thread::hardware_concurrency());
+    // Core 0 is left to the host's audio thread
+    unsigned int core = (static_cast<unsigned int>(workerIndex) + 1) % numCores;
+
+#if defined(__APPLE__)
+    pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+    // macOS has no hard pinning; an affinity tag keeps workers on separate L2 domains
+    thread_affinity_policy_data_t policy = { static_cast<integer_t>(workerIndex + 1) };
+    thread_policy_set(pthread_mach_thread_np(pthread_self()), THREAD_AFFINITY_POLICY,
+                      reinterpret_cast<thread_policy_t>(&policy), THREAD_AFFINITY_POLICY_COUNT);
+    (void)core;
+#elif defined(_WIN32)
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+    if (core < 64) {
+        SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core);
+    }
+#else
+    sched_param param;
+    param.sched_priority = std::max(1, sched_get_priority_max(SCHED_FIFO) - 2);
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+#if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(core, &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif
+#endif
+}
+
+// Counting semaphore used to park idle workers
+// post() from the audio thread is a user-space atomic unless a worker is actually parked
+class WakeSemaphore {
+public:
+#if defined(__APPLE__)
+    WakeSemaphore() : sem(dispatch_semaphore_create(0)) {}
+    ~WakeSemaphore() { dispatch_release(sem); }
+    void post() { dispatch_semaphore_signal(sem); }
+    void wait() { dispatch_semaphore_wait(sem, DISPATCH_TIME_FOREVER); }
+private:
+    dispatch_semaphore_t sem;
+#elif defined(_WIN32)
+    WakeSemaphore() : sem(CreateSemaphore(nullptr, 0, 0x7FFFFFFF, nullptr)) {}
+    ~WakeSemaphore() { CloseHandle(sem); }
+    void post() { ReleaseSemaphore(sem, 1, nullptr); }
+    void wait() { WaitForSingleObject(sem, INFINITE); }
+private:
+    HANDLE sem;
+#else
+    WakeSemaphore() { sem_init(&sem, 0, 0); }
+    ~WakeSemaphore() { sem_destroy(&sem); }
+    void post() { sem_post(&sem); }
+    void wait() { while (sem_wait(&sem) != 0) {} }  // Retry on EINTR
+private:
+    sem_t sem;
+#endif
+};
+
+} // namespace
+
+struct RenderWorkerPool::Worker {
+    std::thread thread;
+    WakeSemaphore wake;
+};
+
+RenderWorkerPool::RenderWorkerPool()
+    : numWorkers(0)
+    , taskFn(nullptr)
+    , taskContext(nullptr)
+    , generation(0)
+{
+}
+
+RenderWorkerPool::~RenderWorkerPool() {
+    stop();
+}
+
+void RenderWorkerPool::start(int requestedWorkers) {
+    stop();
+    
+    // Never more workers than spare cores: an oversubscribed spinning worker steals
+    // the core the audio thread is waiting on
+    int spareCores = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    requestedWorkers = std::max(0, std::min({ requestedWorkers, spareCores, MAX_WORKERS }));
+    stopping.store(false, std::memory_order_release);
+    for (int i = 0; i < requestedWorkers; ++i) {
+        workers[i] = std::make_unique<Worker>();
+    }
+    // Publish the count before threads start so run() never sees a partially built pool
+    numWorkers = requestedWorkers;
+    for (int i = 0; i < requestedWorkers; ++i) {
+        workers[i]->thread = std::thread(&RenderWorkerPool::workerLoop, this, i);
+    }
+}
+
+void RenderWorkerPool::stop() {
+    if (numWorkers == 0) {
+        return;
+    }
+    
+    stopping.store(true, std::memory_order_release);
+    for (int i = 0; i < numWorkers; ++i) {
+        workers[i]->wake.post();
+    }
+    for (int i = 0; i < numWorkers; ++i) {
+        if (workers[i]->thread.joinable()) {
+            workers[i]->thread.join();
+        }
+        workers[i].reset();
+    }
+    numWorkers = 0;
+}
+
+void RenderWorkerPool::run(TaskFn fn, void* context, int numTasks) {
+    if (fn == nullptr || numTasks <= 0) {
+        return;
+    }
+    
+    // Serial: no workers, or nothing to split
+    if (numWorkers == 0 || numTasks == 1 || numTasks > MAX_TASKS) {
+        for (int i = 0; i < numTasks; ++i) {
+            fn(context, i);
+        }
+        return;
+    }
+    
+    // Publish the job: plain fields first, then the dispatch word (release)
+    taskFn = fn;
+    taskContext = context;
+    completed.store(0, std::memory_order_relaxed);
+    ++generation;
+    if (generation == 0) {
+        generation = 1;  // 0 is the initial "no job seen" value of every worker
+    }
+    dispatch.store((static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(numTasks) << 16),
+                   std::memory_order_release);
+    
+    // Wake only as many workers as there are tasks beyond the caller's first
+    int toWake = std::min(numWorkers, numTasks - 1);
+    for (int i = 0; i < toWake; ++i) {
+        workers[i]->wake.post();
+    }
+    
+    // The audio thread works too, then waits for tasks claimed by workers
+    while (runOneTask(generation)) {
+    }
+    int spins = 0;
+    while (completed.load(std::memory_order_acquire) < numTasks) {
+        cpuPause();
+        if (++spins == SPIN_ITERATIONS) {
+            spins = 0;
+            std::this_thread::yield();  // Only reached if a worker was preempted mid-task
+        }
+    }
+}
+
+bool RenderWorkerPool::runOneTask(uint32_t taskGeneration) {
+    uint64_t word = dispatch.load(std::memory_order_acquire);
+    for (;;) {
+        if (getGeneration(word) != taskGeneration || getNextTask(word) >= getTaskCount(word)) {
+            return false;
+        }
+        if (dispatch.compare_exchange_weak(word, word + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            break;
+        }
+    }
+    
+    // The claim succeeded, so the job fields belong to this generation until it completes
+    taskFn(taskContext, getNextTask(word));
+    completed.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void RenderWorkerPool::workerLoop(int workerIndex) {
+    configureWorkerThread(workerIndex);
+    disableDenormals();
+    
+    Worker& self = *workers[workerIndex];
+    uint32_t seenGeneration = 0;
+    
+    for (;;) {
+        // Wait for a new generation: spin first, then park
+        // A post that arrives while spinning leaves the semaphore signalled; the next
+        // wait() then returns immediately, finds no new work and parks again
+        uint32_t taskGeneration = 0;
+        int spins = 0;
+        for (;;) {
+            if (stopping.load(std::memory_order_acquire)) {
+                return;
+            }
+            taskGeneration = getGeneration(dispatch.load(std::memory_order_acquire));
+            if (taskGeneration != seenGeneration) {
+                break;
+            }
+            if (++spins < SPIN_ITERATIONS) {
+                cpuPause();
+            } else {
+                self.wake.wait();
+                spins = 0;
+            }
+        }
+        seenGeneration = taskGeneration;
+        
+        // Voice tasks run under the audio thread's rules
+        OP1_REALTIME_SCOPE(realtimeScope);
+        uint64_t ran = 0;
+        while (runOneTask(taskGeneration)) {
+            ++ran;
+        }
+        if (ran > 0) {
+            tasksRunOnWorkers.fetch_add(ran, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Core {
+
+/**
+ * Real-time worker pool for splitting one block's rendering across cores
+ * Portable C++ - no JUCE dependencies
+ *
+ * Workers are pinned to cores and wait spin-then-park: after finishing a block they
+ * spin briefly (the next block usually arrives soon), then park on a semaphore.
+ * The audio thread publishes a batch of tasks with a single atomic store, wakes the
+ * workers, and claims tasks itself alongside them, so a worker that is slow to wake
+ * never stalls the block - the audio thread simply runs more tasks.
+ *
+ * Tasks are claimed in index order: callers sort them by descending estimated cost
+ * so the expensive ones start first (longest-processing-time scheduling).
+ * The pool never allocates, locks or blocks inside run().
+ */
+class RenderWorkerPool {
+public:
+    static constexpr int MAX_WORKERS = 8;
+    static constexpr int MAX_TASKS = 0xFFFF;  // Task count/index fit in 16 bits of the dispatch word
+    static constexpr int SPIN_ITERATIONS = 20000;  // ~50-100us of spinning before parking
+    
+    using TaskFn = void (*)(void* context, int taskIndex);
+    
+    RenderWorkerPool();
+    ~RenderWorkerPool();
+    
+    RenderWorkerPool(const RenderWorkerPool&) = delete;
+    RenderWorkerPool& operator=(const RenderWorkerPool&) = delete;
+    
+    /**
+     * Start numWorkers background threads (0 = no threads, run() executes serially)
+     * Clamped to hardware threads - 1 so workers never compete with the audio thread
+     * Stops any running workers first. Not real-time safe - call from prepare
+     */
+    void start(int numWorkers);
+    
+    /**
+     * Stop and join all workers. Not real-time safe
+     */
+    void stop();
+    
+    int getNumWorkers() const { return numWorkers; }
+    
+    /**
+     * Run fn(context, i) for i in [0, numTasks) and return when all have finished
+     * Called from the audio thread only; the calling thread executes tasks too
+     */
+    void run(TaskFn fn, void* context, int numTasks);
+    
+    /**
+     * Tasks executed by worker threads (not the calling thread) since start (thread-safe)
+     */
+    uint64_t getTasksRunOnWorkers() const { return tasksRunOnWorkers.load(std::memory_order_acquire); }
+
+private:
+    struct Worker;  // Thread + wake semaphore (platform specific, defined in .cpp)
+    
+    std::array<std::unique_ptr<Worker>, MAX_WORKERS> workers;
+    int numWorkers;
+    
+    // Dispatch word: generation (32 bits) | task count (16 bits) | next task (16 bits)
+    // Claiming a task is a CAS on this word, so a worker can only take tasks of the
+    // generation it observed and the job fields below stay stable while it runs
+    alignas(64) std::atomic<uint64_t> dispatch{0};
+    alignas(64) std::atomic<int> completed{0};
+    alignas(64) std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> tasksRunOnWorkers{0};
+    
+    // Current job (written by the audio thread before dispatch is published)
+    TaskFn taskFn;
+    void* taskContext;
+    uint32_t generation;
+    
+    void workerLoop(int workerIndex);
+    
+    // Claim and run one task of the given generation; false when none are left
+    bool runOneTask(uint32_t taskGeneration);
+    
+    static uint32_t getGeneration(uint64_t word) { return static_cast<uint32_t>(word >> 32); }
+    static int getTaskCount(uint64_t word) { return static_cast<int>((word >> 16) & 0xFFFF); }
+    static int getNextTask(uint64_t word) { return static_cast<int>(word & 0xFFFF); }
+};
+
+} // namespace Core
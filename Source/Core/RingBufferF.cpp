@@ -1,95 +1,65 @@
 #include "RingBufferF.h"
+#include <algorithm>
 
 namespace Core {
 
 RingBufferF::RingBufferF()
-    : buf_(nullptr)
-    , cap_(0)
-    , r_(0)
-    , w_(0)
-    , size_(0)
 {
 }
 
 void RingBufferF::init(float* storage, int capacity)
 {
-    buf_ = storage;
-    cap_ = capacity;
-    r_ = 0;
-    w_ = 0;
-    size_ = 0;
+    ring.attach(&storage, 1, capacity);
 }
 
 int RingBufferF::push(const float* in, int n)
 {
-    if (buf_ == nullptr || in == nullptr || n <= 0) {
+    if (in == nullptr || n <= 0) {
         return 0;
     }
     
-    int can = std::min(n, freeSpace());
-    for (int i = 0; i < can; ++i) {
-        buf_[w_] = in[i];
-        w_ = (w_ + 1) % cap_;
-    }
-    size_ += can;
-    return can;
+    return ring.write(&in, n);
 }
 
 int RingBufferF::peek(float* out, int n, int offset) const
 {
-    if (buf_ == nullptr || out == nullptr || n <= 0 || offset < 0) {
+    if (out == nullptr || n <= 0 || offset < 0) {
         return 0;
     }
     
-    int can = std::min(n, size_ - offset);
+    int can = ring.peek(&out, n, offset);
     if (can <= 0) {
         return 0;
     }
     
-    int idx = (r_ + offset) % cap_;
-    for (int i = 0; i < can; ++i) {
-        out[i] = buf_[idx];
-        idx = (idx + 1) % cap_;
-    }
-    
     // Zero remaining if requested more than available
-    for (int i = can; i < n; ++i) {
-        out[i] = 0.0f;
-    }
+    std::fill(out + can, out + n, 0.0f);
     
     return can;
 }
 
 int RingBufferF::pop(float* out, int n)
 {
-    if (buf_ == nullptr || n <= 0) {
+    if (n <= 0) {
         return 0;
     }
     
-    int can = std::min(n, size_);
-    for (int i = 0; i < can; ++i) {
-        if (out != nullptr) {
-            out[i] = buf_[r_];
-        }
-        r_ = (r_ + 1) % cap_;
+    if (out == nullptr) {
+        int can = std::min(n, size());
+        ring.discard(can);
+        return can;
     }
-    size_ -= can;
-    return can;
+    return ring.read(&out, n);
 }
 
 void RingBufferF::discard(int n)
 {
-    int can = std::min(n, size_);
-    r_ = (r_ + can) % cap_;
-    size_ -= can;
+    ring.discard(n);
 }
 
 void RingBufferF::reset()
 {
-    r_ = 0;
-    w_ = 0;
-    size_ = 0;
+    ring.reset();
 }
 
 } // namespace Core
-
@@ -1,7 +1,6 @@
 #pragma once
 
-#include <cstddef>
-#include <algorithm>
+#include "DSP/PlanarRingBuffer.h"
 
 namespace Core {
 
@@ -9,6 +8,7 @@ namespace Core {
  * Fixed-size ring buffer for streaming audio processing
  * Portable C++ - no JUCE dependencies
  * No allocations in process() - storage provided externally
+ * Single-channel view over PlanarRingBuffer (bulk copies, one wraparound split)
  */
 class RingBufferF {
 public:
@@ -24,17 +24,17 @@ public:
     /**
      * Get current size (number of samples available)
      */
-    int size() const { return size_; }
+    int size() const { return ring.availableToRead(); }
     
     /**
      * Get capacity
      */
-    int capacity() const { return cap_; }
+    int capacity() const { return ring.getCapacity(); }
     
     /**
      * Get free space available
      */
-    int freeSpace() const { return cap_ - size_; }
+    int freeSpace() const { return ring.availableToWrite(); }
     
     /**
      * Push samples into buffer
@@ -66,11 +66,7 @@ public:
     void reset();
 
 private:
-    float* buf_;
-    int cap_;
-    int r_;      // Read position
-    int w_;      // Write position
-    int size_;   // Current size
+    PlanarRingBuffer<float> ring;
 };
 
 } // namespace Core
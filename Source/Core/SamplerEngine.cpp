@@ -1,19 +1,18 @@
 #include "SamplerEngine.h"
 #include "LockFreeMidiQueue.h"
+#include "StageProfiler.h"
 #include <algorithm>
-#include <fstream>
-#include <chrono>
 #include <vector>
-#include <atomic>  // For atomic_load_explicit/atomic_store_explicit on shared_ptr
+#include <atomic>
 #include <cmath>   // For std::isfinite
 
 namespace Core {
 
 SamplerEngine::SamplerEngine()
-    : currentSampleRate(44100.0)
+    : maxWarpVoices(DEFAULT_MAX_WARP_VOICES)
+    , currentSampleRate(44100.0)
     , currentBlockSize(512)
     , currentNumChannels(2)
-    , targetGain(1.0f)
     , filterCutoffHz(20000.0f)  // Start fully open (20kHz = no filtering) so it doesn't reduce volume
     , filterCutoffTarget(20000.0f)  // Track target for smoother
     , filterResonance(1.0f)
@@ -28,10 +27,33 @@ SamplerEngine::SamplerEngine()
     , tempBuffer(nullptr)
     , limiterGain(1.0f)
     , activeVoiceCount(0)
-    , currentSample_(nullptr)
+    , appliedLoopStart(0)
+    , appliedLoopEnd(0)
+    , rejectedNoteOns(0)
+    , blendWeightsSet(false)
+    , popDiagnosticsEnabled(true)
+    , filterModInterval(8)
     , lastBlockSampleL(0.0f)
     , lastBlockSampleR(0.0f)
 {
+    // Parameter defaults (match SamplerVoice defaults)
+    const float defaults[NUM_PARAM_IDS] = {
+        1.0f,     // Gain
+        0.0f,     // Repitch
+        1.0f,     // SampleGain
+        1.0f,     // Sustain
+        800.0f,   // Attack
+        0.0f,     // Decay
+        1000.0f,  // Release
+        0.0f, 0.0f, 0.0f, 0.0f, 0.0f  // StartPoint, EndPoint, LoopEnabled, LoopStart, LoopEnd
+    };
+    for (int i = 0; i < NUM_PARAM_IDS; ++i) {
+        paramValues[i].store(defaults[i], std::memory_order_relaxed);
+        paramIntValues[i].store(0, std::memory_order_relaxed);
+        paramRamps.setValueImmediate(static_cast<ParamId>(i), defaults[i], 0);
+    }
+    // Gain fades in from silence on the first block after prepare
+    paramRamps.setValueImmediate(ParamId::Gain, 0.0f, 0);
 }
 
 SamplerEngine::~SamplerEngine() {
@@ -50,8 +72,14 @@ void SamplerEngine::prepare(double sampleRate, int blockSize, int numChannels) {
     mixSlewLimiter.setMaxStep(slewMaxStep);
     mixSlewLimiter.reset();
     
-    // Reset gain smoother with current block size
-    gainSmoother.setTarget(targetGain, blockSize);
+    loadMeter.prepare(sampleRate);
+    xrunsOrOverruns.store(false, std::memory_order_release);
+    governor.prepare(sampleRate);
+    applyQualitySettings(QualityLevel::Full);
+    
+    // Ramp times in samples depend on sample rate; re-post gain so it ramps in
+    paramRamps.prepare(sampleRate);
+    paramRamps.push(ParameterCommand(ParamId::Gain, paramValues[static_cast<int>(ParamId::Gain)].load(std::memory_order_relaxed)));
     
     // Initialize cutoff smoother
     cutoffSmoother.setValueImmediate(filterCutoffHz);
@@ -77,22 +105,31 @@ void SamplerEngine::prepare(double sampleRate, int blockSize, int numChannels) {
     
     // Time warp speed removed - fixed at 1.0 (constant duration)
     
+    // Per-voice render lanes for parallel rendering (max block size)
+    voiceManager.prepare(blockSize, numChannels);
+    
+    // Time-stretch processors are built here, never on a note-on
+    // Voices drop their leases first - the pool rebuilds every processor
+    voiceManager.setWarpProcessorPool(nullptr);
+    warpPool.prepare(sampleRate, blockSize, maxWarpVoices);
+    voiceManager.setWarpProcessorPool(&warpPool);
+    
+    // Background stretch renders (independent of the host rate - renders keep the source rate)
+    stretchCache.start();
+    voiceManager.setStretchRenderCache(&stretchCache);
+    
     // Allocate temporary buffer for processing (max block size)
     delete[] tempBuffer;
     tempBuffer = new float[static_cast<size_t>(blockSize)];
 }
 
 SampleDataPtr SamplerEngine::getSampleData() const noexcept {
-    // Atomic load on plain shared_ptr (standard-safe, C++11 compatible)
-    // Uses free function atomic_load_explicit with acquire semantics
-    return std::atomic_load_explicit(&currentSample_, std::memory_order_acquire);
+    return currentSample_.load();
 }
 
 void SamplerEngine::setSampleData(SampleDataPtr sampleData) noexcept {
-    // Atomic store on plain shared_ptr (standard-safe, C++11 compatible)
-    // Uses free function atomic_store_explicit with release semantics
     // UI thread swaps in new sample, audio thread continues with old sample until next noteOn
-    std::atomic_store_explicit(&currentSample_, std::move(sampleData), std::memory_order_release);
+    currentSample_.publish(std::move(sampleData));
 }
 
 // DEPRECATED: setSample() removed - use setSampleData() instead
@@ -109,7 +146,131 @@ void SamplerEngine::setRootNote(int rootNote) {
 
 bool SamplerEngine::pushMidiEvent(const MidiEvent& event) {
     // Push event to lock-free queue (UI/MIDI thread)
-    return midiQueue.push(event);
+    if (midiQueue.push(event)) {
+        return true;
+    }
+    // Queue full - the event is lost; count lost note-ons so drops are never silent
+    if (event.type == MidiEvent::NoteOn) {
+        queueDroppedNotes.fetch_add(1, std::memory_order_relaxed);
+    }
+    return false;
+}
+
+void SamplerEngine::postParameter(ParamId id, float value, int intValue) {
+    int index = static_cast<int>(id);
+    
+    // Skip unchanged values - setters called every block or every UI event cost nothing
+    if (paramValues[index].load(std::memory_order_relaxed) == value &&
+        paramIntValues[index].load(std::memory_order_relaxed) == intValue) {
+        return;
+    }
+    paramValues[index].store(value, std::memory_order_release);
+    paramIntValues[index].store(intValue, std::memory_order_release);
+    
+    if (!paramQueue.push(ParameterCommand(id, value, intValue))) {
+        // Queue full - flag the parameter so the audio thread rereads its latest value
+        paramResyncMask.fetch_or(1u << index, std::memory_order_release);
+    }
+}
+
+void SamplerEngine::drainParameterCommands() {
+    // Coalesce every pending command - nothing touches the voices here
+    ParameterCommand command;
+    while (paramQueue.pop(command)) {
+        paramRamps.push(command);
+    }
+    
+    uint32_t resync = paramResyncMask.exchange(0, std::memory_order_acq_rel);
+    for (int i = 0; resync != 0 && i < NUM_PARAM_IDS; ++i) {
+        if (resync & (1u << i)) {
+            paramRamps.push(ParameterCommand(static_cast<ParamId>(i),
+                                             paramValues[i].load(std::memory_order_acquire),
+                                             paramIntValues[i].load(std::memory_order_acquire)));
+        }
+    }
+}
+
+void SamplerEngine::applyParameter(ParamId id, float value, int intValue) {
+    // Audio thread only - one voice update per changed parameter per segment
+    switch (id) {
+        case ParamId::Gain:        voiceManager.setGain(value); break;
+        case ParamId::Repitch:     voiceManager.setRepitch(value); break;
+        case ParamId::SampleGain:  voiceManager.setSampleGain(value); break;
+        case ParamId::Sustain:     voiceManager.setSustainLevel(value); break;
+        case ParamId::Attack:      voiceManager.setAttackTime(value); break;
+        case ParamId::Decay:       voiceManager.setDecayTime(value); break;
+        case ParamId::Release:     voiceManager.setReleaseTime(value); break;
+        case ParamId::StartPoint:  voiceManager.setStartPoint(intValue); break;
+        case ParamId::EndPoint:    voiceManager.setEndPoint(intValue); break;
+        case ParamId::LoopEnabled: voiceManager.setLoopEnabled(intValue != 0); break;
+        case ParamId::LoopStart:
+            appliedLoopStart = intValue;
+            voiceManager.setLoopPoints(appliedLoopStart, appliedLoopEnd);
+            break;
+        case ParamId::LoopEnd:
+            appliedLoopEnd = intValue;
+            voiceManager.setLoopPoints(appliedLoopStart, appliedLoopEnd);
+            break;
+        case ParamId::Count:
+            break;
+    }
+}
+
+void SamplerEngine::renderVoices(float** output, int numChannels, int numSamples) {
+    auto apply = [this](ParamId id, float value, int intValue) { applyParameter(id, value, intValue); };
+    
+    // Common case: no ramp in progress - apply pending steps once, render the whole block
+    constexpr int maxSegmentChannels = 8;
+    if (!paramRamps.isRamping() || numChannels > maxSegmentChannels) {
+        paramRamps.advance(numSamples, apply);
+        voiceManager.setBlendWeights(blendWeightsSet ? blendWeights.data() : nullptr);
+        voiceManager.process(output, numChannels, numSamples, currentSampleRate);
+        blendWeightsSet = false;
+        return;
+    }
+    
+    // Ramping: render in short segments, updating voice parameters between segments
+    float* segmentOutput[maxSegmentChannels];
+    const float* segmentWeights[VoiceManager::MAX_BLEND_GROUPS];
+    for (int offset = 0; offset < numSamples; offset += ParameterRampBank::RAMP_SEGMENT) {
+        int segmentLength = std::min(ParameterRampBank::RAMP_SEGMENT, numSamples - offset);
+        paramRamps.advance(segmentLength, apply);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            segmentOutput[ch] = (output[ch] != nullptr) ? output[ch] + offset : nullptr;
+        }
+        if (blendWeightsSet) {
+            for (int g = 0; g < VoiceManager::MAX_BLEND_GROUPS; ++g) {
+                segmentWeights[g] = (blendWeights[g] != nullptr) ? blendWeights[g] + offset : nullptr;
+            }
+            voiceManager.setBlendWeights(segmentWeights);
+        }
+        voiceManager.process(segmentOutput, numChannels, segmentLength, currentSampleRate);
+    }
+    blendWeightsSet = false;
+}
+
+void SamplerEngine::setBlendWeights(const float* const* weights) {
+    blendWeightsSet = (weights != nullptr);
+    for (int g = 0; g < VoiceManager::MAX_BLEND_GROUPS; ++g) {
+        blendWeights[g] = (weights != nullptr) ? weights[g] : nullptr;
+    }
+}
+
+void SamplerEngine::setParameterRampTime(ParamId id, float rampMs) {
+    paramRamps.setRampTimeMs(id, rampMs);
+}
+
+void SamplerEngine::setStealPolicy(VoiceStealer::Policy policy) {
+    // Applied by the audio thread at the next block (VoiceManager is audio-thread owned)
+    pendingStealPolicy.store(static_cast<int>(policy), std::memory_order_release);
+}
+
+void SamplerEngine::publishStealStats() {
+    const VoiceStealStats& stats = voiceManager.getStealStats();
+    totalVoicesStolen.store(static_cast<int>(stats.steals), std::memory_order_release);
+    tailHandoffs.store(static_cast<int>(stats.tailHandoffs), std::memory_order_release);
+    tailMisses.store(static_cast<int>(stats.tailMisses), std::memory_order_release);
+    droppedNotes.store(static_cast<int>(stats.droppedNotes) + rejectedNoteOns, std::memory_order_release);
 }
 
 bool SamplerEngine::triggerNoteOnWithSample(int note, float velocity, SampleDataPtr sampleData) {
@@ -125,30 +286,37 @@ bool SamplerEngine::triggerNoteOnWithSample(int note, float velocity, SampleData
                 voicesStolenThisBlock.store(voicesStolenThisBlock.load(std::memory_order_relaxed) + 1, std::memory_order_release);
             }
         }
+        publishStealStats();
         return started;
     }
+    rejectedNoteOns++;
+    publishStealStats();
     return false;
 }
 
 bool SamplerEngine::triggerNoteOnWithSample(int note, float velocity, SampleDataPtr sampleData,
                                             float repitchSemitones, int startPoint, int endPoint, float sampleGain,
                                             float attackMs, float decayMs, float sustain, float releaseMs,
-                                            bool loopEnabled, int loopStartPoint, int loopEndPoint) {
+                                            bool loopEnabled, int loopStartPoint, int loopEndPoint,
+                                            int priority, int blendGroup) {
     // Trigger note on with slot-specific parameters (applied to the allocated voice, not globally)
     if (sampleData && sampleData->length > 0) {
         bool wasStolen = false;
         bool started = voiceManager.noteOn(note, velocity, sampleData, wasStolen, 0,
                                            repitchSemitones, startPoint, endPoint, sampleGain,
                                            attackMs, decayMs, sustain, releaseMs,
-                                           loopEnabled, loopStartPoint, loopEndPoint);
+                                           loopEnabled, loopStartPoint, loopEndPoint, priority, blendGroup);
         if (started) {
             voicesStartedThisBlock.store(voicesStartedThisBlock.load(std::memory_order_relaxed) + 1, std::memory_order_release);
             if (wasStolen) {
                 voicesStolenThisBlock.store(voicesStolenThisBlock.load(std::memory_order_relaxed) + 1, std::memory_order_release);
             }
         }
+        publishStealStats();
         return started;
     }
+    rejectedNoteOns++;
+    publishStealStats();
     return false;
 }
 
@@ -182,11 +350,64 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
         return;
     }
     
+    uint64_t blockStart = loadMeter.beginBlock();
+    renderBlock(output, numChannels, numSamples);
+    if (loadMeter.endBlock(blockStart, numSamples)) {
+        xrunsOrOverruns.store(true, std::memory_order_release);
+    }
+    if (governor.update(loadMeter.getLastLoad(), numSamples)) {
+        applyQualitySettings(governor.getLevel());
+    }
+    if (telemetry.isOpen()) {
+        publishTelemetry(numSamples);
+    }
+}
+
+void SamplerEngine::publishTelemetry(int numSamples) {
+    TelemetryStatus status;
+    status.sampleRate = currentSampleRate;
+    status.blockSize = numSamples;
+    status.activeVoices = activeVoicesCount.load(std::memory_order_relaxed);
+    status.blockPeak = blockPeak.load(std::memory_order_relaxed);
+    status.clippedSamples = clippedSamples.load(std::memory_order_relaxed);
+    status.voicesStolen = totalVoicesStolen.load(std::memory_order_relaxed);
+    status.droppedNotes = getDroppedNotes();
+    status.load = loadMeter.getLastLoad();
+    status.maxLoad = loadMeter.getMaxLoad();
+    status.overruns = loadMeter.getOverrunCount();
+    status.qualityLevel = static_cast<int32_t>(governor.getLevel());
+    telemetry.publishBlock(status);
+}
+
+void SamplerEngine::applyQualitySettings(QualityLevel level) {
+    const QualitySettings settings = QualityGovernor::getSettings(level);
+    popDiagnosticsEnabled = settings.popDiagnostics;
+    filterModInterval = settings.filterModInterval;
+    voiceManager.setLiveWarpEnabled(settings.liveWarp);
+    voiceManager.setHeldVoiceLimit(settings.heldVoiceLimit);
+    voiceManager.setInterpolationEnabled(settings.interpolate);
+}
+
+void SamplerEngine::renderBlock(float** output, int numChannels, int numSamples) {
+    // Stage timing (debug builds); each OP1_PROFILE_NEXT closes the previous stage
+    OP1_PROFILE_SCOPE(blockScope, Engine);
+    OP1_PROFILE_SCOPE(stageScope, EngineParams);
+    
     // Reset instrumentation for this block
     voicesStartedThisBlock.store(0, std::memory_order_relaxed);
     voicesStolenThisBlock.store(0, std::memory_order_relaxed);
     
+    // Collect parameter changes posted since the last block (applied during voice rendering)
+    drainParameterCommands();
+    
+    // Apply pending steal policy change (UI thread -> audio thread)
+    int stealPolicy = pendingStealPolicy.exchange(-1, std::memory_order_acq_rel);
+    if (stealPolicy >= 0) {
+        voiceManager.setStealPolicy(static_cast<VoiceStealer::Policy>(stealPolicy));
+    }
+    
     // Process MIDI events from lock-free queue (audio thread only)
+    OP1_PROFILE_NEXT(stageScope, EngineMidi);
     MidiEvent event;
     int voicesStarted = 0;
     int voicesStolen = 0;
@@ -203,6 +424,8 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
                     voicesStolen++;
                 }
             }
+        } else if (event.type == MidiEvent::NoteOn) {
+            rejectedNoteOns++;  // No sample loaded - note cannot sound
         } else if (event.type == MidiEvent::NoteOff) {
             voiceManager.noteOff(event.note);
         }
@@ -210,8 +433,10 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
     
     voicesStartedThisBlock.store(voicesStarted, std::memory_order_release);
     voicesStolenThisBlock.store(voicesStolen, std::memory_order_release);
+    publishStealStats();
     
     // Clear output buffer
+    OP1_PROFILE_NEXT(stageScope, EngineVoices);
     for (int ch = 0; ch < numChannels; ++ch) {
         if (output[ch] != nullptr) {
             for (int i = 0; i < numSamples; ++i) {
@@ -220,23 +445,16 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
         }
     }
     
-    // Update gain - use current smoothed value
-    // For simplicity, we set gain once per block (smoother transitions across blocks)
-    float currentGain = gainSmoother.getCurrentValue();
-    voiceManager.setGain(currentGain);
+    // Gain is ramped with the other parameters in renderVoices()
     
     // Calculate polyphonic gain scaling to prevent overdrive
     // With N voices, scale each voice so N voices sum to ~0.5x total (prevents overdrive)
     // Formula: each voice = 0.5 / N, so sum = 0.5x regardless of voice count
-    int activeVoiceCount = voiceManager.getActiveVoiceCount();
+    // A note blended across orbit slots counts once (getMixVoiceCount)
+    int activeVoiceCount = voiceManager.getMixVoiceCount();
     float polyphonicVoiceGain = 0.5f / std::max(1.0f, static_cast<float>(activeVoiceCount));
     voiceManager.setVoiceGain(polyphonicVoiceGain);
     
-    // Advance smoother (for next block)
-    for (int i = 0; i < numSamples; ++i) {
-        gainSmoother.getNextValue();
-    }
-    
     // CRITICAL: Clear output buffers at start of block
     // Mix voices by accumulation only; do not overwrite unintentionally
     for (int ch = 0; ch < numChannels; ++ch) {
@@ -250,15 +468,26 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
     // The mutex in setSample() ensures pointer updates are atomic, and once set, the pointers
     // remain valid until the next setSample() call. The audio thread can safely read from these
     // pointers without locking.
-    voiceManager.process(output, numChannels, numSamples, currentSampleRate);
+    renderVoices(output, numChannels, numSamples);
     
     // Apply aggressive mix-level slew limiter (catches any remaining clicks from overlapping voices)
     // Increased aggressiveness to handle multiple voices starting simultaneously
     // Then apply block boundary smoothing for seamless transitions
+    OP1_PROFILE_NEXT(stageScope, EngineMixSlew);
+    int nonFiniteThisBlock = 0;
     for (int i = 0; i < numSamples; ++i) {
         float mixL = (output[0] != nullptr) ? output[0][i] : 0.0f;
         float mixR = (numChannels > 1 && output[1] != nullptr) ? output[1][i] : mixL;
         
+        // Paranoid builds: a non-finite voice sum would latch the slew limiter state
+        if constexpr (ActiveDiagnostics::mixNanScrub) {
+            if (!std::isfinite(mixL) || !std::isfinite(mixR)) {
+                ++nonFiniteThisBlock;
+                mixL = std::isfinite(mixL) ? mixL : 0.0f;
+                mixR = std::isfinite(mixR) ? mixR : 0.0f;
+            }
+        }
+        
         // Apply mix-level slew limiting - CRITICAL for preventing clicks when multiple voices overlap
         // More aggressive slew limiting to handle sudden additions of multiple voices
         mixSlewLimiter.process(mixL, mixR);
@@ -285,14 +514,31 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
         }
     }
     
+    if (nonFiniteThisBlock > 0) {
+        nonFiniteSamples.fetch_add(nonFiniteThisBlock, std::memory_order_relaxed);
+    }
+    
     // Run pop detector on output (after slew limiting)
-    popDetector.processBlock(output, numChannels, numSamples, popEventBuffer);
+    OP1_PROFILE_NEXT(stageScope, EnginePopDetect);
+    if constexpr (ActiveDiagnostics::popForensics) {
+        if (!popDiagnosticsEnabled) {
+            popDetector.skipBlock(output, numChannels, numSamples);
+        } else if (popDetector.processBlock(output, numChannels, numSamples, popEventBuffer) && telemetry.isOpen()) {
+            const PopEvent& event = popDetector.getLastEvent();
+            TelemetryPop pop;
+            pop.frame = event.frameCounterGlobal;
+            pop.mixDelta = event.mixDelta;
+            pop.mixPeak = event.mixOutL;
+            telemetry.publishPop(pop);
+        }
+    }
     
     // Update active voices count
     int activeVoices = voiceManager.getActiveVoiceCount();
     activeVoicesCount.store(activeVoices, std::memory_order_release);
     
     // First pass: detect peak and count clipped samples BEFORE any gain adjustment
+    OP1_PROFILE_NEXT(stageScope, EngineMaster);
     float peak = 0.0f;
     int clipped = 0;
     
@@ -385,20 +631,12 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
     }
     
     // Apply filter and effects (global processing on mixed output)
+    OP1_PROFILE_NEXT(stageScope, EngineFilterFx);
     // Only process if engine is properly prepared and buffers are valid
     // Skip filter processing entirely if not prepared (safe fallback)
     // NOTE: We skip filter processing if tempBuffer is null (prepare() not called yet)
     // This is safe - audio will just pass through without filtering
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H2\",\"location\":\"SamplerEngine.cpp:126\",\"message\":\"filter processing check\",\"data\":{\"numChannels\":" << numChannels << ",\"output0Null\":" << (output[0] == nullptr ? 1 : 0) << ",\"currentSampleRate\":" << currentSampleRate << ",\"tempBufferNull\":" << (tempBuffer == nullptr ? 1 : 0) << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     // Apply filter and effects only if enabled
     if (filterEffectsEnabled && numChannels > 0 && output[0] != nullptr && currentSampleRate > 0.0 && tempBuffer != nullptr) {
         // Process first channel (mono filter for now, can be extended to stereo)
@@ -459,7 +697,7 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
             // Process per-sample with envelope modulation
             // Update filter coefficients less frequently to prevent instability
             float currentFilterCutoff = filterCutoffHz;
-            const int updateInterval = 8; // Update filter every 8 samples
+            const int updateInterval = filterModInterval; // 8 samples at full quality
             int samplesSinceUpdate = 0;
             
             for (int i = 0; i < numSamples; ++i) {
@@ -579,44 +817,54 @@ void SamplerEngine::process(float** output, int numChannels, int numSamples) {
 }
 
 void SamplerEngine::setGain(float gain) {
-    targetGain = std::max(0.0f, std::min(1.0f, gain));
-    gainSmoother.setTarget(targetGain, currentBlockSize);
+    // Gain is set from processBlock (audio thread) - the queue has a single producer (UI thread),
+    // so gain goes through the latest-value slot only (same coalesce + ramp on the audio side)
+    float value = std::max(0.0f, std::min(1.0f, gain));
+    int index = static_cast<int>(ParamId::Gain);
+    if (paramValues[index].load(std::memory_order_relaxed) != value) {
+        paramValues[index].store(value, std::memory_order_release);
+        paramResyncMask.fetch_or(1u << index, std::memory_order_release);
+    }
 }
 
 void SamplerEngine::setADSR(float attackMs, float decayMs, float sustain, float releaseMs) {
-    voiceManager.setADSR(attackMs, decayMs, sustain, releaseMs);
+    postParameter(ParamId::Attack, attackMs);
+    postParameter(ParamId::Decay, decayMs);
+    postParameter(ParamId::Sustain, sustain);
+    postParameter(ParamId::Release, releaseMs);
 }
 
 void SamplerEngine::setRepitch(float semitones) {
-    voiceManager.setRepitch(semitones);
+    postParameter(ParamId::Repitch, semitones);
 }
 
 void SamplerEngine::setStartPoint(int sampleIndex) {
-    voiceManager.setStartPoint(sampleIndex);
+    postParameter(ParamId::StartPoint, static_cast<float>(sampleIndex), sampleIndex);
 }
 
 void SamplerEngine::setEndPoint(int sampleIndex) {
-    voiceManager.setEndPoint(sampleIndex);
+    postParameter(ParamId::EndPoint, static_cast<float>(sampleIndex), sampleIndex);
 }
 
 void SamplerEngine::setSampleGain(float gain) {
-    voiceManager.setSampleGain(gain);
+    postParameter(ParamId::SampleGain, std::max(0.0f, std::min(2.0f, gain)));
 }
 
+// Getters return the latest posted value (UI thread safe - voices are audio-thread owned)
 float SamplerEngine::getRepitch() const {
-    return voiceManager.getRepitch();
+    return paramValues[static_cast<int>(ParamId::Repitch)].load(std::memory_order_acquire);
 }
 
 int SamplerEngine::getStartPoint() const {
-    return voiceManager.getStartPoint();
+    return paramIntValues[static_cast<int>(ParamId::StartPoint)].load(std::memory_order_acquire);
 }
 
 int SamplerEngine::getEndPoint() const {
-    return voiceManager.getEndPoint();
+    return paramIntValues[static_cast<int>(ParamId::EndPoint)].load(std::memory_order_acquire);
 }
 
 float SamplerEngine::getSampleGain() const {
-    return voiceManager.getSampleGain();
+    return paramValues[static_cast<int>(ParamId::SampleGain)].load(std::memory_order_acquire);
 }
 
 void SamplerEngine::getDebugInfo(int& actualInN, int& outN, int& primeRemaining, int& nonZeroCount) const {
@@ -687,11 +935,12 @@ void SamplerEngine::setPlaybackMode(bool polyphonic) {
 }
 
 void SamplerEngine::setLoopEnabled(bool enabled) {
-    voiceManager.setLoopEnabled(enabled);
+    postParameter(ParamId::LoopEnabled, enabled ? 1.0f : 0.0f, enabled ? 1 : 0);
 }
 
 void SamplerEngine::setLoopPoints(int startPoint, int endPoint) {
-    voiceManager.setLoopPoints(startPoint, endPoint);
+    postParameter(ParamId::LoopStart, static_cast<float>(startPoint), startPoint);
+    postParameter(ParamId::LoopEnd, static_cast<float>(endPoint), endPoint);
 }
 
 void SamplerEngine::setWarpEnabled(bool enabled) {
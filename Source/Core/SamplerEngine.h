@@ -9,7 +9,17 @@
 #include "DriveEffect.h"
 #include "LofiEffect.h"
 #include "SampleData.h"
+#include "PublishedSample.h"
 #include "PopDetector.h"
+#include "DiagnosticsPolicy.h"
+#include "CallbackLoadMeter.h"
+#include "QualityGovernor.h"
+#include "TelemetrySegment.h"
+#include "ParameterCommandQueue.h"
+#include "ParameterRampBank.h"
+#include "DSP/WarpProcessorPool.h"
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <atomic>
 
@@ -30,7 +40,7 @@ public:
     // This method is disabled to prevent raw pointer usage
     // void setSample(const float* data, int length, double sourceSampleRate); // DELETED
     
-    // Set sample data (thread-safe, lock-free)
+    // Set sample data (single writer thread; waits out a reader still copying the old slot)
     // UI thread: creates SampleData and atomically swaps it in
     void setSampleData(SampleDataPtr sampleData) noexcept;
     
@@ -54,21 +64,35 @@ public:
     
     // Trigger note on with sample data and slot-specific parameters
     // Applies parameters to the allocated voice, not globally
+    // blendGroup: orbit slot whose weight ramp the voice is mixed through (-1 = unweighted)
     bool triggerNoteOnWithSample(int note, float velocity, SampleDataPtr sampleData,
                                  float repitchSemitones, int startPoint, int endPoint, float sampleGain,
                                  float attackMs, float decayMs, float sustain, float releaseMs,
-                                 bool loopEnabled, int loopStartPoint, int loopEndPoint);
+                                 bool loopEnabled, int loopStartPoint, int loopEndPoint,
+                                 int priority = 0, int blendGroup = -1);
+    
+    // Per-sample blend weights for the next process() call (audio thread)
+    // weights[g] holds numSamples gains for blend group g (orbit slot); nullptr = no weighting
+    // Must stay valid until process() returns; cleared after every block
+    void setBlendWeights(const float* const* weights);
     
     // Process audio block
     // output: non-interleaved buffer [channel][sample]
     void process(float** output, int numChannels, int numSamples);
     
+    // Parameter setters below are lock-free: they post commands to the parameter queue
+    // and the audio thread applies them at the start of (or ramped within) the next block
+    
     // Set gain parameter (0.0 to 1.0)
     void setGain(float gain);
     
     // Set ADSR envelope parameters (in milliseconds, except sustain which is 0.0-1.0)
     void setADSR(float attackMs, float decayMs, float sustain, float releaseMs);
     
+    // Set ramp time for a parameter (0 = step at next block)
+    // Not thread-safe - call before audio starts or from the audio thread
+    void setParameterRampTime(ParamId id, float rampMs);
+    
     // Set sample editing parameters
     void setRepitch(float semitones);
     void setStartPoint(int sampleIndex);
@@ -109,6 +133,9 @@ public:
     // Enable/disable time-warp processing
     void setWarpEnabled(bool enabled);
     
+    // Latency the host should compensate (stretcher latency while warp is on, otherwise 0)
+    int getLatencySamples() const { return voiceManager.getLatencySamples(); }
+    
     // Set time ratio (1.0 = constant duration, != 1.0 = time stretching)
     void setTimeRatio(double ratio);
     
@@ -130,17 +157,90 @@ public:
     int getActiveVoicesCount() const { return activeVoicesCount.load(std::memory_order_acquire); }
     int getVoicesStartedThisBlock() const { return voicesStartedThisBlock.load(std::memory_order_acquire); }
     int getVoicesStolenThisBlock() const { return voicesStolenThisBlock.load(std::memory_order_acquire); }
+    // Latched when a process() call overran its real-time budget; cleared by resetLoadStats()
     bool getXrunsOrOverruns() const { return xrunsOrOverruns.load(std::memory_order_acquire); }
+    // Non-finite voice-mix samples scrubbed so far (always 0 unless built with ParanoidDiagnostics)
+    int getNonFiniteSampleCount() const { return nonFiniteSamples.load(std::memory_order_relaxed); }
+    
+    // process() load as a fraction of numSamples / sampleRate (p50/p99/max, overruns)
+    CallbackLoadStats getLoadStats() const { return loadMeter.getStats(); }
+    int readLoadOverruns(LoadOverrunEvent* out, int maxCount) { return loadMeter.readOverruns(out, maxCount); }
+    void resetLoadStats() {
+        loadMeter.requestReset();
+        xrunsOrOverruns.store(false, std::memory_order_release);
+    }
+    
+    // CPU-adaptive quality: steps diagnostics, filter modulation rate, live warp, polyphony and
+    // interpolation down while process() load stays high and back up once it has recovered
+    // Enabled by default; changes apply between blocks and to new notes (thread-safe)
+    void setQualityGovernorEnabled(bool enabled) { governor.setEnabled(enabled); }
+    bool isQualityGovernorEnabled() const { return governor.isEnabled(); }
+    void setQualityFloor(QualityLevel lowest) { governor.setFloor(lowest); }
+    QualityLevel getQualityLevel() const { return governor.getLevel(); }
+    // Governor decisions since the last read (single reader, e.g. UI thread)
+    int readQualityChanges(QualityChangeEvent* out, int maxCount) { return governor.readChanges(out, maxCount); }
+    
+    // Pop detector events since the last read (single reader, e.g. UI thread)
+    int getPopEvents(PopEvent* out, int maxCount) {
+        return popEventBuffer.read(out, maxCount);
+    }
+    
+    // Publish the instrumentation above to a shared-memory segment every block, for
+    // monitors that run without the editor (Op1CloneTelemetry). Empty name = default
+    // "/op1clone-<pid>-<n>". Not thread-safe - call while process() is not running
+    bool enableTelemetry(const std::string& name = std::string()) { return telemetry.open(name); }
+    void disableTelemetry() { telemetry.close(); }
+    const std::string& getTelemetryName() const { return telemetry.getName(); }
+    
+    // Voice stealing counters (cumulative since construction, thread-safe reads)
+    int getTotalVoicesStolen() const { return totalVoicesStolen.load(std::memory_order_acquire); }
+    int getTailHandoffs() const { return tailHandoffs.load(std::memory_order_acquire); }
+    int getTailMisses() const { return tailMisses.load(std::memory_order_acquire); }
+    // Note-ons that produced no voice (invalid sample data or MIDI queue full)
+    int getDroppedNotes() const {
+        return droppedNotes.load(std::memory_order_acquire) + queueDroppedNotes.load(std::memory_order_acquire);
+    }
+    
+    // Set voice stealing policy (Oldest, Quietest, SameNote, LowestPrioritySlot)
+    void setStealPolicy(VoiceStealer::Policy policy);
+    
+    // Render voices on a worker pool (nullptr = serial). Not thread-safe - call from prepare
+    // The pool is owned by the caller and may be shared by engines processed in sequence
+    void setRenderPool(RenderWorkerPool* pool) { voiceManager.setRenderPool(pool); }
+    
+    // Maximum concurrently time-stretched voices (size of the warp processor pool built in prepare)
+    // Warp note-ons beyond this play resampled. Not thread-safe - call before prepare
+    void setMaxWarpVoices(int maxVoices) { maxWarpVoices = std::max(0, maxVoices); }
+    int getMaxWarpVoices() const { return maxWarpVoices; }
+    
+    // Warp note-ons that found no free processor (thread-safe)
+    uint64_t getWarpPoolExhaustedCount() const { return warpPool.getExhaustedCount(); }
+    
+    // Pre-rendered warp playback: each distinct note pitch is stretched once on a background
+    // thread and replayed as a sample; notes stretch live until their render is ready
+    void setStretchCacheEnabled(bool enabled) { stretchCache.setEnabled(enabled); }
+    void setStretchCacheBudgetBytes(size_t bytes) { stretchCache.setBudgetBytes(bytes); }
+    StretchRenderCache::Stats getStretchCacheStats() const { return stretchCache.getStats(); }
+    
+    // Render lowNote..highNote of a sample ahead of time (message thread)
+    void prefetchStretchRenders(SampleDataPtr sample, float repitchSemitones, int rootNote, int lowNote, int highNote) {
+        stretchCache.prefetch(sample, repitchSemitones, 1.0, rootNote, lowNote, highNote);
+    }
+    
+    // Default pool size: every held voice of one blend group plus the tail voices
+    static constexpr int DEFAULT_MAX_WARP_VOICES = VoiceManager::MAX_VOICES + VoiceManager::TAIL_VOICES;
     
 private:
+    // Declared before voiceManager: voices hold leases into the pool
+    WarpProcessorPool warpPool;
+    int maxWarpVoices;
+    StretchRenderCache stretchCache;
     VoiceManager voiceManager;
-    LinearSmoother gainSmoother;
     LinearSmoother cutoffSmoother;  // Smooth cutoff changes to prevent instability
     float lastAppliedFilterCutoff;  // Track last applied cutoff to avoid frequent updates
     double currentSampleRate;
     int currentBlockSize;
     int currentNumChannels;
-    float targetGain;
     
     // Filter and effects
     MoogLadderFilter filter;
@@ -176,14 +276,26 @@ private:
     // Track active voices for envelope triggering
     int activeVoiceCount;
     
-    // Current sample data (plain shared_ptr with atomic operations)
-    // UI thread writes via atomic_store_explicit, audio thread reads via atomic_load_explicit
-    // This is the standard-safe way to atomically swap shared_ptr (C++11 compatible)
-    mutable SampleDataPtr currentSample_;
+    // Current sample data (UI thread publishes, audio thread copies it without locking)
+    PublishedSample currentSample_;
     
     // Lock-free MIDI event queue (UI thread pushes, audio thread pops)
     LockFreeMidiQueue midiQueue;
     
+    // Lock-free parameter command queue (UI thread pushes, audio thread pops)
+    ParameterCommandQueue paramQueue;
+    
+    // Audio-thread parameter state: coalesced commands and per-parameter ramps
+    ParameterRampBank paramRamps;
+    int appliedLoopStart;
+    int appliedLoopEnd;
+    
+    // Latest posted value of each parameter (UI thread writes, getters read)
+    // Also used to resync the audio thread if the command queue overflows
+    std::array<std::atomic<float>, NUM_PARAM_IDS> paramValues;
+    std::array<std::atomic<int>, NUM_PARAM_IDS> paramIntValues;
+    std::atomic<uint32_t> paramResyncMask{0};
+    
     // Instrumentation metrics (atomic, updated in audio thread, read from UI thread)
     mutable std::atomic<float> blockPeak{0.0f};
     mutable std::atomic<int> clippedSamples{0};
@@ -191,11 +303,35 @@ private:
     mutable std::atomic<int> voicesStartedThisBlock{0};
     mutable std::atomic<int> voicesStolenThisBlock{0};
     mutable std::atomic<bool> xrunsOrOverruns{false};
+    CallbackLoadMeter loadMeter;
+    mutable std::atomic<int> totalVoicesStolen{0};
+    mutable std::atomic<int> tailHandoffs{0};
+    mutable std::atomic<int> tailMisses{0};
+    mutable std::atomic<int> droppedNotes{0};       // Written by audio thread (from VoiceManager stats)
+    mutable std::atomic<int> queueDroppedNotes{0};  // Written by MIDI/UI thread on queue overflow
+    mutable std::atomic<int> nonFiniteSamples{0};   // Written by audio thread (ParanoidDiagnostics only)
+    
+    int rejectedNoteOns;  // Audio thread: note-ons rejected before reaching VoiceManager
     
-    // Pop detection
+    // Blend weights for the next block (setBlendWeights), offset per ramp segment in renderVoices
+    std::array<const float*, VoiceManager::MAX_BLEND_GROUPS> blendWeights{};
+    bool blendWeightsSet;
+    
+    // Pending steal policy (UI thread writes, audio thread applies at block start)
+    std::atomic<int> pendingStealPolicy{-1};
+    
+    // Pop detection (compiled out of the render loop unless ActiveDiagnostics::popForensics)
     PopDetector popDetector;
     PopEventRingBuffer popEventBuffer;
     
+    // Shared-memory telemetry (closed unless enableTelemetry was called)
+    TelemetryPublisher telemetry;
+    
+    // Quality governor and the settings it last applied (audio thread)
+    QualityGovernor governor;
+    bool popDiagnosticsEnabled;
+    int filterModInterval;  // Samples between filter coefficient updates under envelope modulation
+    
     // Slew limiter for final mix (click suppressor)
     SlewLimiter mixSlewLimiter;
     
@@ -203,11 +339,6 @@ private:
     float lastBlockSampleL;
     float lastBlockSampleR;
     
-    // Get pop events (UI thread)
-    int getPopEvents(PopEvent* out, int maxCount) {
-        return popEventBuffer.read(out, maxCount);
-    }
-    
     // Set pop detection threshold
     void setPopThreshold(float threshold) {
         popDetector.setThreshold(threshold);
@@ -220,6 +351,24 @@ private:
     
     void updateActiveVoiceCount();
     void updateLofiParameters();
+    void publishStealStats();
+    
+    // Parameter command plumbing
+    void postParameter(ParamId id, float value, int intValue = 0);
+    void drainParameterCommands();
+    void applyParameter(ParamId id, float value, int intValue);
+    
+    // Body of process() (timed by loadMeter)
+    void renderBlock(float** output, int numChannels, int numSamples);
+    
+    // Copy this block's instrumentation into the telemetry segment
+    void publishTelemetry(int numSamples);
+    
+    // Apply a governor level (between blocks)
+    void applyQualitySettings(QualityLevel level);
+    
+    // Render voices, splitting the block into ramp segments while parameters are ramping
+    void renderVoices(float** output, int numChannels, int numSamples);
 };
 
 } // namespace Core
@@ -1,5 +1,5 @@
 #include "SamplerVoice.h"
-#include "DSP/SignalsmithStretchWrapper.h"
+#include "StageProfiler.h"
 #include <atomic>
 #include <cmath>
 #include <algorithm>
@@ -34,9 +34,19 @@ SamplerVoice::SamplerVoice()
     , inRelease(false)
     , currentSampleRate(44100.0)
     , sampleReadPos(0.0)
+    , warpLease(nullptr)
+    , warpEnabled(false)  // Disabled - fix simple path first
+    , timeRatio(1.0)  // Normal speed (no time stretching)
+    , latencyCompensationFrames(0)
+    , noteCompensationFrames(0)
+    , compensationHoldRemaining(0)
+    , pendingNoteOffFrames(-1)
+    , warpPrerolled(false)
+    , warpLookaheadFrames(0.0)
+    , interpolationEnabled(true)
+    , noteInterpolates(true)
     , sineTestEnabled(false)
     , sinePhase(0.0)
-    , primeRemainingSamples(0)
     , loopEnabled(false)
     , loopStartPoint(0)
     , loopEndPoint(0)
@@ -84,42 +94,42 @@ SamplerVoice::SamplerVoice()
     , startPoint(0)
     , endPoint(0)
     , sampleGain(1.0f)
-    , warpProcessor(nullptr)
-    , warpEnabled(false)  // Disabled - fix simple path first
-    , timeRatio(1.0)  // Normal speed (no time stretching)
-    , warpInputPlanar(nullptr)
-    , warpOutputPlanar(nullptr)
-    , warpBufferSize(0)
-    , warpPriming(false)
-    , warpCrossfadeActive(false)
-    , warpCrossfadePos(0.0f)
-    , warpCrossfadeInc(0.0f)
-    , warpCrossfadeSamples(0)
-    , warpCrossfadeCounter(0)
-    , dryRMS(0.0f)
-    , warpRMS(0.0f)
-    , gainMatch(1.0f)
-    , gainMatchTarget(1.0f)
-    , gainMatchAttack(0.0f)
-    , gainMatchRelease(0.0f)
+    , lastLimiterGain(1.0f)
 {
 }
 
 SamplerVoice::~SamplerVoice() {
     // Sample data is owned by caller, we don't delete it
-    // Clean up warp buffers
-    if (warpInputPlanar != nullptr) {
-        delete[] warpInputPlanar[0];
-        delete[] warpInputPlanar[1];
-        delete[] warpInputPlanar;
+    // The warp lease belongs to the engine's pool, we don't delete it either
+}
+
+void SamplerVoice::attachWarpLease(WarpProcessorPool::Lease* lease, double /*sampleRate*/) {
+    warpLease = lease;
+    if (warpLease == nullptr) {
+        return;
     }
-    if (warpOutputPlanar != nullptr) {
-        delete[] warpOutputPlanar[0];
-        delete[] warpOutputPlanar[1];
-        delete[] warpOutputPlanar;
+    
+    // Fresh processor: its lookahead is pre-rolled from the sample on the first warp block
+    warpPrerolled = false;
+    warpLookaheadFrames = 0.0;
+    lastLimiterGain = 1.0f;
+    warpLease->processor->setTimeRatio(timeRatio);
+}
+
+void SamplerVoice::setPrerenderedSample(SampleDataPtr rendered) {
+    prerenderedSample_ = std::move(rendered);
+    if (prerenderedSample_) {
+        updateAntiAliasFilter(1.0f);  // Plays at unity pitch - no resampling aliasing to filter
     }
 }
 
+WarpProcessorPool::Lease* SamplerVoice::detachWarpLease() {
+    WarpProcessorPool::Lease* lease = warpLease;
+    warpLease = nullptr;
+    warpPrerolled = false;
+    return lease;
+}
+
 void SamplerVoice::setSampleData(SampleDataPtr sampleData) {
     // Capture sample data snapshot (thread-safe, immutable)
     sampleData_ = sampleData;
@@ -141,14 +151,17 @@ void SamplerVoice::setSampleData(SampleDataPtr sampleData) {
 //     // Voices must only receive SampleDataPtr via setSampleData() on noteOn
 // }
 
-void SamplerVoice::noteOn(int note, float velocity) {
-    noteOn(note, velocity, 0);
+bool SamplerVoice::noteOn(int note, float velocity) {
+    return noteOn(note, velocity, 0);
 }
 
-void SamplerVoice::noteOn(int note, float velocity, int startDelayOffset) {
+bool SamplerVoice::noteOn(int note, float velocity, int startDelayOffset) {
     // No logging in audio thread - performance critical path
     
     currentNote = note;
+    // A render belongs to one note's pitch; VoiceManager sets the new one after noteOn
+    // (the cache still references the old one, so dropping it here never frees memory)
+    prerenderedSample_.reset();
     currentVelocity = clamp(velocity, 0.0f, 1.0f);
     
     bool wasActive = active;
@@ -166,12 +179,9 @@ void SamplerVoice::noteOn(int note, float velocity, int startDelayOffset) {
     // PART 1: Safety ramp initialization (always applied, separate from ADSR)
     // If voice was being stolen, wait until safety ramp fade-out completes
     if (active && currentSampleRate > 0.0) {
-        // PART 4: Voice stealing - ensure fade-out completes before reusing
-        if (isBeingStolen && safetyRampState == SafetyRampState::RampOut && safetyRampValue > 0.001f) {
-            // Voice is still fading out from steal - wait until safety ramp reaches 0
-            // Cannot start new note until old one is fully silent
-            return; // Don't start new note yet
-        }
+        // PART 4: Voice stealing - the old note's fade-out is handed to a tail voice by
+        // VoiceManager, so a stolen voice always restarts here (never drops the new note)
+        // If no tail was free, the ramp below restarts from 0 under the slew limiter
         
         // Initialize safety ramp: CRITICAL - must be long enough to prevent clicks on overlap
         // 20ms provides enough time for smooth transition when multiple voices start simultaneously
@@ -225,12 +235,8 @@ void SamplerVoice::noteOn(int note, float velocity, int startDelayOffset) {
         slewLastOutR = 0.0f;
         
         // Reset warp processor if enabled
-        if (warpEnabled && timeRatio != 1.0 && warpProcessor) {
-            warpProcessor->reset();
-            warpPriming = false;
-            warpCrossfadeActive = false;
-            warpCrossfadePos = 0.0f;
-            warpCrossfadeCounter = 0;
+        if (warpEnabled && timeRatio != 1.0 && warpLease) {
+            warpLease->processor->reset();
         }
     }
     
@@ -249,9 +255,11 @@ void SamplerVoice::noteOn(int note, float velocity, int startDelayOffset) {
     releaseStartValue = 0.0f;
     
     // Reset debug counters
-    oobGuardHits.store(0, std::memory_order_relaxed);
-    numClippedSamples.store(0, std::memory_order_relaxed);
-    peakOut.store(0.0f, std::memory_order_relaxed);
+    if constexpr (ActiveDiagnostics::voiceMeters) {
+        oobGuardHits.store(0, std::memory_order_relaxed);
+        numClippedSamples.store(0, std::memory_order_relaxed);
+        peakOut.store(0.0f, std::memory_order_relaxed);
+    }
     
     // Calculate sample counts from ADSR parameters
     // CRITICAL: Always use minimum attack time (even at 0ms) to prevent pops
@@ -287,6 +295,16 @@ void SamplerVoice::noteOn(int note, float velocity, int startDelayOffset) {
     startDelaySamples = startDelayOffset;
     startDelayCounter = 0;
     
+    // A retriggered stretcher keeps running; pre-rolling seeks it to the new start
+    warpPrerolled = false;
+    warpLookaheadFrames = 0.0;
+    
+    // Hold the note back by the compensation latency (its note-off follows the same delay)
+    noteCompensationFrames = latencyCompensationFrames;
+    compensationHoldRemaining = noteCompensationFrames;
+    pendingNoteOffFrames = -1;
+    noteInterpolates = interpolationEnabled;
+    
     // CRITICAL: If retriggering an active voice, ensure smooth transition
     // Reset any ongoing fade-out to prevent clicks
     if (wasActive && isFadingOut) {
@@ -317,11 +335,27 @@ void SamplerVoice::noteOn(int note, float velocity, int startDelayOffset) {
         float totalSemitones = static_cast<float>(semitones) + repitchSemitones;
         float pitchRatio = std::pow(2.0f, totalSemitones / 12.0f);
         updateAntiAliasFilter(pitchRatio);
+    
+    return active;
 }
 
 void SamplerVoice::noteOff(int note) {
     // Only start release if this voice is playing the specified note
     if (currentNote == note && active && !inRelease) {
+        // Latency-compensated note: release lands the same distance after the note-off as
+        // the note itself landed after its note-on
+        if (noteCompensationFrames > 0) {
+            if (pendingNoteOffFrames < 0) {
+                pendingNoteOffFrames = noteCompensationFrames;
+            }
+            return;
+        }
+        beginRelease();
+    }
+}
+
+void SamplerVoice::beginRelease() {
+    if (active && !inRelease) {
         // Start release phase instead of immediately stopping
         // Store current envelope value as starting point for release BEFORE setting inRelease
         releaseStartValue = envelopeValue;
@@ -367,12 +401,28 @@ void SamplerVoice::noteOff(int note) {
 
 // Start voice steal fade-out (called when voice is being stolen)
 void SamplerVoice::startStealFadeOut() {
+    // 20ms fade-out (matches fade-in)
+    startFastRelease(20.0f);
+}
+
+void SamplerVoice::startFastRelease(float fadeMs) {
+    // Voice is still in its staggered start delay or compensation hold - nothing audible yet, stop now
+    if (active && (startDelayCounter < startDelaySamples || compensationHoldRemaining > 0)) {
+        active = false;
+        compensationHoldRemaining = 0;
+        pendingNoteOffFrames = -1;
+        isBeingStolen = false;
+        safetyRampValue = 0.0f;
+        safetyRampState = SafetyRampState::RampOff;
+        return;
+    }
+    
     // PART 4: Voice stealing MUST fade out using safety ramp
-    // Mark as being stolen - new note cannot start until safety ramp reaches 0
+    // Mark as being stolen - voice deactivates when safety ramp reaches 0
     isBeingStolen = true;
     
-        // Start safety ramp fade-out: CRITICAL - must match fade-in duration
-        float safetyRampMs = 20.0f;  // 20ms fade-out (matches fade-in)
+        // Start safety ramp fade-out from the current ramp value
+        float safetyRampMs = std::max(fadeMs, 1.0f);
         safetyRampSamples = static_cast<int>(currentSampleRate * safetyRampMs / 1000.0f);
         if (safetyRampSamples < 1) safetyRampSamples = 1;
         // Calculate step to fade from current value to 0
@@ -392,6 +442,103 @@ void SamplerVoice::startStealFadeOut() {
 }
 
 void SamplerVoice::process(float** output, int numChannels, int numSamples, double sampleRate) {
+    OP1_PROFILE_SCOPE(voiceScope, Voice);
+    if (!active || output == nullptr || (compensationHoldRemaining <= 0 && pendingNoteOffFrames < 0)) {
+        renderBlock(output, numChannels, numSamples, sampleRate);
+        return;
+    }
+    
+    // Latency compensation: split the block where the hold ends and where a deferred
+    // note-off lands. During the hold nothing is audible; a stretcher keeps reading
+    currentSampleRate = sampleRate;
+    float* segment[2] = { nullptr, nullptr };
+    int segmentChannels = std::min(numChannels, 2);
+    int offset = 0;
+    while (offset < numSamples) {
+        if (pendingNoteOffFrames == 0) {
+            pendingNoteOffFrames = -1;
+            beginRelease();
+        }
+        
+        int frames = numSamples - offset;
+        if (pendingNoteOffFrames > 0) {
+            frames = std::min(frames, pendingNoteOffFrames);
+        }
+        if (compensationHoldRemaining > 0) {
+            frames = std::min(frames, compensationHoldRemaining);
+            advanceWarpHold(frames);
+            compensationHoldRemaining -= frames;
+        } else {
+            for (int ch = 0; ch < segmentChannels; ++ch) {
+                segment[ch] = (output[ch] != nullptr) ? output[ch] + offset : nullptr;
+            }
+            renderBlock(segment, segmentChannels, frames, sampleRate);
+        }
+        
+        if (pendingNoteOffFrames > 0) {
+            pendingNoteOffFrames -= frames;
+        }
+        offset += frames;
+    }
+    if (pendingNoteOffFrames == 0) {
+        pendingNoteOffFrames = -1;
+        beginRelease();
+    }
+}
+
+void SamplerVoice::updateWarpSettings() {
+    // Set time ratio to 1.0 for constant duration (all notes same length)
+    warpLease->processor->setTimeRatio(1.0);
+    // Set pitch based on note (this changes pitch while keeping duration constant)
+    int semitones = currentNote - rootMidiNote;
+    float totalSemitones = static_cast<float>(semitones) + repitchSemitones;
+    warpLease->processor->setPitchSemitones(totalSemitones);
+}
+
+WarpSampleView SamplerVoice::makeWarpView(const SampleData& playData) const {
+    // The stretcher reads the sample in place (no interpolated copy): it consumes
+    // source-rate frames from playhead and compensates the rate difference in pitch, so
+    // the note still lands on its pitch at constant duration. Sample gain is applied as
+    // frames are read; reads past endPoint are silent
+    const int len = playData.length;
+    WarpSampleView view;
+    view.channels[0] = playData.mono.data();
+    view.channels[1] = playData.mono.data();  // Mono source duplicated, as before
+    view.startFrame = std::max(0, startPoint);
+    view.endFrame = std::min(len, endPoint);
+    view.loopStart = loopStartPoint;
+    view.loopEnd = std::min(len, loopEndPoint);
+    view.looping = loopEnabled && !inRelease && loopEndPoint > loopStartPoint;
+    view.gain = sampleGain;
+    view.sampleRate = playData.sourceSampleRate;
+    view.position = playhead;
+    return view;
+}
+
+void SamplerVoice::advanceWarpHold(int numSamples) {
+    // Without a stretcher the note just starts later - nothing to run
+    if (!warpEnabled || warpLease == nullptr || prerenderedSample_ || !sampleData_
+        || !warpLease->processor->isPrepared()) {
+        return;
+    }
+    
+    IWarpProcessor* warpProcessor = warpLease->processor.get();
+    updateWarpSettings();
+    WarpSampleView view = makeWarpView(*sampleData_);
+    if (!warpPrerolled) {
+        int lookahead = warpProcessor->prerollPull(view);
+        warpLookaheadFrames = static_cast<double>(lookahead)
+                            + static_cast<double>(noteCompensationFrames) * view.sampleRate / currentSampleRate;
+        warpPrerolled = true;
+    }
+    for (int offset = 0; offset < numSamples; offset += warpLease->bufferSize) {
+        int frames = std::min(warpLease->bufferSize, numSamples - offset);
+        warpProcessor->processPull(view, warpLease->output, frames);
+    }
+    playhead = view.position;
+}
+
+void SamplerVoice::renderBlock(float** output, int numChannels, int numSamples, double sampleRate) {
     // No logging in audio thread - performance critical path
     
     // Update current sample rate (used for safety ramp calculations)
@@ -425,13 +572,28 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
         return;
     }
     
+    // Leased warp buffers hold one prepared block; render larger host blocks in pieces
+    if (warpEnabled && warpLease != nullptr && !prerenderedSample_ && numSamples > warpLease->bufferSize) {
+        float* chunkOutput[2] = { nullptr, nullptr };
+        int chunkChannels = std::min(numChannels, 2);
+        for (int offset = 0; offset < numSamples; offset += warpLease->bufferSize) {
+            for (int ch = 0; ch < chunkChannels; ++ch) {
+                chunkOutput[ch] = (output[ch] != nullptr) ? output[ch] + offset : nullptr;
+            }
+            renderBlock(chunkOutput, chunkChannels, std::min(warpLease->bufferSize, numSamples - offset), sampleRate);
+        }
+        return;
+    }
+    
     // Store local copies for safe access throughout the function
-    const float* data = sampleData_->mono.data();
-    const int len = sampleData_->length;
-    const double sourceSampleRate = sampleData_->sourceSampleRate;
+    // A pre-rendered stretch replaces the source (already pitched, same positions)
+    const SampleData& playData = prerenderedSample_ ? *prerenderedSample_ : *sampleData_;
+    const float* data = playData.mono.data();
+    const int len = playData.length;
+    const double sourceSampleRate = playData.sourceSampleRate;
     
     // Final safety check: if invalid, output silence for entire block
-    if (!data || len <= 0 || len != static_cast<int>(sampleData_->mono.size())) {
+    if (!data || len <= 0 || len != static_cast<int>(playData.mono.size())) {
         // PART 1: Still update safety ramp even when outputting silence
         for (int i = 0; i < numSamples; ++i) {
             if (safetyRampState == SafetyRampState::RampOut) {
@@ -455,8 +617,6 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
         return;
     }
     
-    // Update sample rate if changed
-    bool sampleRateChanged = (std::abs(currentSampleRate - sampleRate) > 0.1);
     currentSampleRate = sampleRate;
     
     // Set loop crossfade duration based on sample rate (~50ms for smooth crossfade - longer to prevent pops)
@@ -465,192 +625,72 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
         loopCrossfadeSamples = std::max(512, std::min(loopCrossfadeSamples, 8192)); // Clamp to reasonable range
     }
     
-    // Prepare warp processor if needed
+    // Configure the leased warp processor (prepared by the pool, never here)
     // When warp is enabled, use Signalsmith Stretch to maintain constant duration (timeRatio = 1.0)
     // while allowing pitch to change via setTransposeSemitones()
-    if (warpEnabled) {
-        if (!warpProcessor) {
-            warpProcessor = std::make_unique<SignalsmithStretchWrapper>();
-        }
-        if (sampleRateChanged || !warpProcessor->isPrepared()) {
-            warpProcessor->prepare(sampleRate, 2, numSamples);
-            // Initialize gain matching coefficients
-            gainMatchAttack = 1.0f - std::exp(-1.0f / (0.005f * sampleRate)); // 5ms attack
-            gainMatchRelease = 1.0f - std::exp(-1.0f / (0.1f * sampleRate));  // 100ms release
-            gainMatch = 1.0f;
-            gainMatchTarget = 1.0f;
-            dryRMS = 0.0f;
-            warpRMS = 0.0f;
-        }
-        // Set time ratio to 1.0 for constant duration (all notes same length)
-        warpProcessor->setTimeRatio(1.0);
-        // Set pitch based on note (this changes pitch while keeping duration constant)
-        int semitones = currentNote - rootMidiNote;
-        float totalSemitones = static_cast<float>(semitones) + repitchSemitones;
-        warpProcessor->setPitchSemitones(totalSemitones);
+    if (warpEnabled && warpLease) {
+        updateWarpSettings();
     }
     
     // Base amplitude (velocity * gain)
     const float amplitudeScale = 1.0f;
     float baseAmplitude = currentVelocity * gain * amplitudeScale;
     
-    // Decision logic: use warp path when enabled AND processor is ready
-    // When warp is disabled OR processor not ready, use simple resampling
+    // Decision logic: use warp path when enabled AND a processor is leased
+    // When warp is disabled OR the pool had no processor free, use simple resampling
     bool useWarpPath = false;
     if (warpEnabled) {
         // Only use warp if processor exists and is prepared
-        if (warpProcessor && warpProcessor->isPrepared()) {
+        if (warpLease && warpLease->processor->isPrepared() && !prerenderedSample_) {
             useWarpPath = true;
         }
     }
     
     if (useWarpPath) {
         // --- Time Stretch Path (Signalsmith) ---
-        // Allocate buffers if needed
-        if (warpBufferSize < numSamples) {
-            if (warpInputPlanar != nullptr) {
-                delete[] warpInputPlanar[0];
-                delete[] warpInputPlanar[1];
-                delete[] warpInputPlanar;
-            }
-            if (warpOutputPlanar != nullptr) {
-                delete[] warpOutputPlanar[0];
-                delete[] warpOutputPlanar[1];
-                delete[] warpOutputPlanar;
-            }
-            warpBufferSize = numSamples;
-            warpInputPlanar = new float*[2];
-            warpOutputPlanar = new float*[2];
-            warpInputPlanar[0] = new float[static_cast<size_t>(warpBufferSize)];
-            warpInputPlanar[1] = new float[static_cast<size_t>(warpBufferSize)];
-            warpOutputPlanar[0] = new float[static_cast<size_t>(warpBufferSize)];
-            warpOutputPlanar[1] = new float[static_cast<size_t>(warpBufferSize)];
-        }
-        
-        // Read sample at original speed (no pitch adjustment - warp handles pitch)
-        // For constant duration (timeRatio = 1.0), input frames = output frames
-        int inFramesNeeded = numSamples;  // 1:1 ratio for constant duration
-        inFramesNeeded = std::max(1, std::min(inFramesNeeded, warpBufferSize));
+        OP1_PROFILE_SCOPE(stageScope, VoiceWarp);
+        IWarpProcessor* warpProcessor = warpLease->processor.get();
+        float* const* warpOutputPlanar = warpLease->output;
+        const int warpBufferSize = warpLease->bufferSize;
+        const int warpFrames = std::max(1, std::min(numSamples, warpBufferSize));
         
-        // Read sample data at original speed into warpInputPlanar
-        double originalSpeed = sourceSampleRate / sampleRate; // No pitch adjustment
-        for (int i = 0; i < inFramesNeeded; ++i) {
-            // Handle looping
-            bool shouldLoop = loopEnabled && !inRelease && loopEndPoint > loopStartPoint;
-            if (shouldLoop && playhead >= static_cast<double>(loopEndPoint)) {
-                playhead = static_cast<double>(loopStartPoint);
-            }
-            
-            // Read sample with linear interpolation
-            float sample = 0.0f;
-            if (playhead >= static_cast<double>(endPoint - 1)) {
-                    int lastIdx = std::max(startPoint, endPoint - 1);
-                    if (lastIdx >= 0 && lastIdx < len) {
-                    sample = data[lastIdx] * sampleGain;
-                }
-                if (!inRelease && (!loopEnabled || playhead >= static_cast<double>(loopEndPoint))) {
-                    inRelease = true;
-                    releaseCounter = 0;
-                    releaseStartValue = envelopeValue;
-                }
-            } else if (playhead >= static_cast<double>(startPoint)) {
-                int index0 = static_cast<int>(playhead);
-                int index1 = index0 + 1;
-                index0 = std::max(startPoint, std::min(endPoint - 1, index0));
-                index1 = std::max(startPoint, std::min(endPoint - 1, index1));
-                if (index0 >= 0 && index0 < len && index1 >= 0 && index1 < len) {
-                    float fraction = static_cast<float>(playhead - static_cast<double>(index0));
-                    float s0 = data[index0];
-                    float s1 = data[index1];
-                    sample = (s0 * (1.0f - fraction) + s1 * fraction) * sampleGain;
-                    
-                    // CRITICAL: Apply additional fade-in at playback start only if startPoint != 0
-                    // If startPoint == 0, sample data already has fade-in, so this is redundant
-                    // Only needed when starting playback from non-zero startPoint
-                    if (startPoint > 0) {
-                        int samplesFromStart = index0 - startPoint;
-                        if (samplesFromStart >= 0 && samplesFromStart < 256) {
-                            float playheadFadeGain = static_cast<float>(samplesFromStart) / 256.0f;
-                            // Use smooth curve (sine ease-in) for natural fade
-                            playheadFadeGain = std::sin(playheadFadeGain * 1.5707963267948966f); // sin(PI/2 * t)
-                            sample *= playheadFadeGain;
-                        }
-                    }
-                }
-            }
-            
-            // Write to planar buffer (stereo - duplicate mono)
-            warpInputPlanar[0][i] = sample;
-            warpInputPlanar[1][i] = sample;
-            
-            playhead += originalSpeed;
-            if (!std::isfinite(playhead)) {
-                playhead = static_cast<double>(startPoint);
-            }
-        }
-        
-        // Process through warp processor
-        int outFrames = warpProcessor->process(
-            const_cast<const float* const*>(warpInputPlanar), inFramesNeeded,
-            warpOutputPlanar, numSamples
-        );
+        WarpSampleView view = makeWarpView(playData);
         
-        // Update crossfade state
-        if (!warpPriming && warpProcessor->getOutputRingFill() >= warpProcessor->getLatencyFrames()) {
-            warpPriming = true;
-            warpCrossfadeActive = true;
-            warpCrossfadePos = 0.0f;
-            warpCrossfadeSamples = static_cast<int>(std::round(0.01 * sampleRate)); // 10ms
-            warpCrossfadeInc = 1.0f / static_cast<float>(warpCrossfadeSamples);
-            warpCrossfadeCounter = 0;
+        // First block of the note (no compensation hold ran): fill the stretcher's lookahead
+        // from the sample so the note's first frame comes out getLatencyFrames() from now
+        if (!warpPrerolled) {
+            int lookahead = warpProcessor->prerollPull(view);
+            warpLookaheadFrames = static_cast<double>(lookahead)
+                                + static_cast<double>(warpProcessor->getLatencyFrames()) * sourceSampleRate / sampleRate;
+            warpPrerolled = true;
         }
         
-        // Update crossfade position
-        if (warpCrossfadeActive && warpCrossfadeCounter < warpCrossfadeSamples) {
-            warpCrossfadePos += warpCrossfadeInc;
-            warpCrossfadeCounter++;
-            if (warpCrossfadePos >= 1.0f) {
-                warpCrossfadePos = 1.0f;
-                warpCrossfadeActive = false;
-            }
-        }
+        int outFrames = warpProcessor->processPull(view, warpOutputPlanar, warpFrames);
+        OP1_PROFILE_NEXT(stageScope, VoiceWarpMix);
         
-        // Compute RMS for gain matching
-        float blockDryRMS = 0.0f;
-        float blockWarpRMS = 0.0f;
-        for (int i = 0; i < outFrames; ++i) {
-            float warpL = warpOutputPlanar[0][i];
-            float warpR = warpOutputPlanar[1][i];
-            blockWarpRMS += warpL * warpL + warpR * warpR;
+        playhead = view.position;
+        if (!std::isfinite(playhead)) {
+            playhead = static_cast<double>(startPoint);
         }
-        blockWarpRMS = std::sqrt(blockWarpRMS / static_cast<float>(outFrames * 2));
-        
-        // Smooth RMS values
-        float rmsAlpha = (blockWarpRMS > warpRMS) ? gainMatchAttack : gainMatchRelease;
-        warpRMS = warpRMS + rmsAlpha * (blockWarpRMS - warpRMS);
         
-        // Compute gain match (dry reference would be computed from simple resampling)
-        // For now, use a fixed reference or compute from dry path
-        if (dryRMS < 1e-4f) {
-            dryRMS = blockWarpRMS; // Initialize from warp if dry not available
+        // End of sample: start the release once the audible position (read position less
+        // the stretcher's lookahead and latency) passes the last frame
+        double audiblePosition = playhead - warpLookaheadFrames;
+        if (!inRelease && audiblePosition >= static_cast<double>(endPoint - 1)
+            && (!loopEnabled || audiblePosition >= static_cast<double>(loopEndPoint))) {
+            inRelease = true;
+            releaseCounter = 0;
+            releaseStartValue = envelopeValue;
         }
         
-        float newGainMatch = (dryRMS > 1e-6f) ? (dryRMS / std::max(warpRMS, 1e-6f)) : 1.0f;
-        newGainMatch = std::max(0.5f, std::min(2.0f, newGainMatch)); // Clamp to [0.5, 2.0]
         
-        // Smooth gain match
-        float matchAlpha = (newGainMatch > gainMatchTarget) ? gainMatchAttack : gainMatchRelease;
-        gainMatchTarget = gainMatchTarget + matchAlpha * (newGainMatch - gainMatchTarget);
-        gainMatch = gainMatchTarget;
-        
-        // Apply gain matching and process output
+        // Safety limiter over the stretcher output
         float limiterGain = 1.0f;
         float blockPeak = 0.0f;
         
         for (int i = 0; i < outFrames; ++i) {
-            // Apply gain matching
-            float warpL = warpOutputPlanar[0][i] * gainMatch;
-            float warpR = warpOutputPlanar[1][i] * gainMatch;
+            float warpL = warpOutputPlanar[0][i];
+            float warpR = warpOutputPlanar[1][i];
             
             // Safety limiter
             float peak = std::max(std::abs(warpL), std::abs(warpR));
@@ -715,23 +755,18 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
                 }
             }
             
-            // Get warp output with gain matching and limiter
-            float warpL = warpOutputPlanar[0][i] * gainMatch * lastLimiterGain;
-            float warpR = warpOutputPlanar[1][i] * gainMatch * lastLimiterGain;
-            
-            // Apply crossfade (if priming, fade in from silence)
-            float crossfade = warpPriming ? warpCrossfadePos : 1.0f;
-            warpL *= crossfade;
-            warpR *= crossfade;
+            // Get warp output with limiter
+            float warpL = warpOutputPlanar[0][i] * lastLimiterGain;
+            float warpR = warpOutputPlanar[1][i] * lastLimiterGain;
             
             // Apply envelope, ramp, and voice gain
             float amplitude = baseAmplitude * envelopeValue;
             float voiceOutL = warpL * voiceGain * rampGain * amplitude;
             float voiceOutR = warpR * voiceGain * rampGain * amplitude;
             
-            // Safety processing
-            if (!std::isfinite(voiceOutL)) voiceOutL = 0.0f;
-            if (!std::isfinite(voiceOutR)) voiceOutR = 0.0f;
+            // Safety processing (NaN guard before the clamp, every policy)
+            voiceOutL = guardVoiceSample(voiceOutL);
+            voiceOutR = guardVoiceSample(voiceOutR);
             voiceOutL = std::max(-1.0f, std::min(1.0f, voiceOutL));
             voiceOutR = std::max(-1.0f, std::min(1.0f, voiceOutR));
             
@@ -781,14 +816,21 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
         bool canDeactivate = (playhead >= static_cast<double>(endPoint) && inRelease && 
                              releaseCounter >= releaseSamples && 
                              rampGain <= 0.001f);
+        // Once the release has run out the envelope holds the stretcher's tail at exactly zero,
+        // so stop here and let the processor go back to the pool instead of idling to the sample end
+        if (inRelease && releaseCounter >= releaseSamples && envelopeValue == 0.0f) {
+            canDeactivate = true;
+        }
         if (canDeactivate) {
             active = false;
         }
     } else {
         // --- Simple pitch path (no time-warp) ---
+        OP1_PROFILE_SCOPE(stageScope, VoiceResample);
         // Calculate pitch ratio and playback speed (include repitch offset)
+        // A pre-rendered stretch already carries the pitch, so it plays at unity
         int semitones = currentNote - rootMidiNote;
-        float totalSemitones = static_cast<float>(semitones) + repitchSemitones;
+        float totalSemitones = prerenderedSample_ ? 0.0f : static_cast<float>(semitones) + repitchSemitones;
         double pitchRatio = std::pow(2.0, totalSemitones / 12.0);
         double speed = (sourceSampleRate / sampleRate) * pitchRatio;
         
@@ -1015,20 +1057,11 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
                     float outputSample = sample * voiceGain * rampGain * amplitude * initialFade * velocityFade;
                     
                     // Safety processing: Only NaN guard and hard clamp - no soft clip
-                    if (!std::isfinite(outputSample)) {
-                        outputSample = 0.0f;
-                    }
+                    outputSample = guardVoiceSample(outputSample);
                     outputSample = std::max(-1.0f, std::min(1.0f, outputSample));
                     
-                    // Peak measurement (atomic, lock-free)
-                    float absSample = std::abs(outputSample);
-                    float currentPeak = peakOut.load(std::memory_order_relaxed);
-                    if (absSample > currentPeak) {
-                        peakOut.store(absSample, std::memory_order_relaxed);
-                    }
-                    if (absSample > 1.0f) {
-                        numClippedSamples.fetch_add(1, std::memory_order_relaxed);
-                    }
+                    // Peak measurement (atomic, lock-free; diagnostics builds)
+                    trackVoicePeak<ActiveDiagnostics>(peakOut, std::abs(outputSample));
                     
                     // Update oobGuardHits if we hit bounds (already counted above)
                     
@@ -1149,7 +1182,7 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
                 // Read sample from current position (loop end region)
                 float sampleEnd = 0.0f;
                 if (index0 >= 0 && index0 < len && index1 >= 0 && index1 < len) {
-                    float fraction = static_cast<float>(playhead - static_cast<double>(index0));
+                    float fraction = noteInterpolates ? static_cast<float>(playhead - static_cast<double>(index0)) : 0.0f;
                     fraction = std::max(0.0f, std::min(1.0f, fraction));
                     float s0 = data[index0];
                     float s1 = data[index1];
@@ -1189,7 +1222,7 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
                     
                     float sampleStart = 0.0f;
                     if (loopIndex0 >= 0 && loopIndex0 < len && loopIndex1 >= 0 && loopIndex1 < len) {
-                        float loopFraction = static_cast<float>(loopStartPlayhead - static_cast<double>(loopIndex0));
+                        float loopFraction = noteInterpolates ? static_cast<float>(loopStartPlayhead - static_cast<double>(loopIndex0)) : 0.0f;
                         loopFraction = std::max(0.0f, std::min(1.0f, loopFraction));
                         float ls0 = data[loopIndex0];
                         float ls1 = data[loopIndex1];
@@ -1279,20 +1312,11 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
                 float outputSample = sample * voiceGain * rampGain * baseAmplitude * finalEnvelope;
                 
                 // Safety: NaN guard and hard clamp
-                if (!std::isfinite(outputSample)) {
-                    outputSample = 0.0f;
-                }
+                outputSample = guardVoiceSample(outputSample);
                 outputSample = std::max(-1.0f, std::min(1.0f, outputSample));
                 
-                // Peak measurement (atomic, lock-free)
-                float absSample = std::abs(outputSample);
-                float currentPeak = peakOut.load(std::memory_order_relaxed);
-                if (absSample > currentPeak) {
-                    peakOut.store(absSample, std::memory_order_relaxed);
-                }
-                if (absSample > 1.0f) {
-                    numClippedSamples.fetch_add(1, std::memory_order_relaxed);
-                }
+                // Peak measurement (atomic, lock-free; diagnostics builds)
+                trackVoicePeak<ActiveDiagnostics>(peakOut, std::abs(outputSample));
                 
             // Apply per-voice slew limiter (click suppressor)
             float voiceOutL = outputSample;
@@ -1313,6 +1337,31 @@ void SamplerVoice::process(float** output, int numChannels, int numSamples, doub
             slewLastOutL = voiceOutL;
             slewLastOutR = voiceOutR;
             
+            // PART 1: Update safety ramp state (process every sample)
+            // Needed here too - otherwise a stolen voice never finishes its fade-out on this path
+            if (safetyRampState == SafetyRampState::RampIn) {
+                safetyRampValue += safetyRampStep;
+                if (safetyRampValue >= 1.0f) {
+                    safetyRampValue = 1.0f;
+                    safetyRampState = SafetyRampState::RampOff;
+                }
+            } else if (safetyRampState == SafetyRampState::RampOut) {
+                safetyRampValue -= safetyRampStep;
+                if (safetyRampValue <= 0.0f) {
+                    safetyRampValue = 0.0f;
+                    safetyRampState = SafetyRampState::RampOff;
+                    // PART 4: Voice is now silent - can be deactivated and reused
+                    if (isBeingStolen) {
+                        active = false;
+                        isBeingStolen = false;
+                    }
+                }
+            }
+            
+            // PART 1: Apply safety ramp to FINAL voice output (multiplies everything)
+            voiceOutL *= safetyRampValue;
+            voiceOutR *= safetyRampValue;
+            
             // Track per-voice pop detection (after slew limiting)
             float deltaL_raw = std::abs(voiceOutL - lastVoiceSampleL);
             float deltaR_raw = (numChannels > 1) ? std::abs(voiceOutR - lastVoiceSampleR) : deltaL_raw;
@@ -1382,19 +1431,16 @@ void SamplerVoice::setVoiceGain(float g) {
 
 void SamplerVoice::setWarpEnabled(bool enabled) {
     warpEnabled = enabled;
-    if (!enabled && warpProcessor) {
-        // Reset processor when disabling
-        warpProcessor.reset();
-        warpPriming = false;
-        warpCrossfadeActive = false;
-        warpCrossfadePos = 0.0f;
+    if (!enabled && warpLease) {
+        // VoiceManager returns the lease to the pool before the next block
+        warpPrerolled = false;
     }
 }
 
 void SamplerVoice::setTimeRatio(double ratio) {
     timeRatio = std::max(0.25, std::min(4.0, ratio));
-    if (warpProcessor && warpProcessor->isPrepared()) {
-        warpProcessor->setTimeRatio(timeRatio);
+    if (warpLease && warpLease->processor->isPrepared()) {
+        warpLease->processor->setTimeRatio(timeRatio);
     }
 }
 
@@ -2,7 +2,8 @@
 
 #include "SampleData.h"
 #include "PopDetector.h"
-#include "DSP/IWarpProcessor.h"
+#include "DiagnosticsPolicy.h"
+#include "DSP/WarpProcessorPool.h"
 #include <memory>
 #include <atomic>
 #include <cmath>
@@ -25,12 +26,14 @@ public:
     
     // Set root note (MIDI note that plays at original pitch)
     void setRootNote(int rootNote) { rootMidiNote = rootNote; }
+    int getRootNote() const { return rootMidiNote; }
     
     // Trigger note on
-    void noteOn(int note, float velocity);
+    // Returns false only if the voice has no valid sample data (note cannot sound)
+    bool noteOn(int note, float velocity);
     
     // Trigger note on with start delay offset (for staggering voice starts)
-    void noteOn(int note, float velocity, int startDelayOffset);
+    bool noteOn(int note, float velocity, int startDelayOffset);
     
     // Trigger note off (only if playing this note)
     void noteOff(int note);
@@ -38,12 +41,40 @@ public:
     // Start voice steal fade-out (called when voice is being stolen)
     void startStealFadeOut();
     
+    // Fade out over fadeMs via the safety ramp, then deactivate (tail voice hand-off)
+    // A voice still waiting on its start delay has produced no audio and stops immediately
+    void startFastRelease(float fadeMs);
+    
+    // Check if voice is fading out after being stolen
+    bool isFadingAfterSteal() const { return active && isBeingStolen; }
+    
     // Check if voice is active (playing, not in release)
     bool isActive() const { return active && !inRelease; }
     
     // Check if voice is playing (including release phase)
     bool isPlaying() const { return active; }
     
+    // Check if time-warp processing is enabled (warp voices cost far more to render)
+    bool isWarpEnabled() const { return warpEnabled; }
+    
+    // Time-stretch processor checked out from the engine's WarpProcessorPool (managed by VoiceManager)
+    // A warp-enabled voice without a lease plays through the resampling path
+    void attachWarpLease(WarpProcessorPool::Lease* lease, double sampleRate);
+    WarpProcessorPool::Lease* detachWarpLease();
+    bool hasWarpLease() const { return warpLease != nullptr; }
+    
+    // True once the lease can go back to the pool (voice finished its tail, warp was disabled,
+    // or the note plays a pre-rendered sample)
+    bool canReturnWarpLease() const { return warpLease != nullptr && (!active || !warpEnabled || prerenderedSample_); }
+    
+    // Pre-rendered stretch of this note's sample at its pitch (see StretchRenderCache)
+    // Played as an ordinary sample at unity pitch instead of stretching live; cleared on noteOn
+    void setPrerenderedSample(SampleDataPtr rendered);
+    bool hasPrerenderedSample() const { return prerenderedSample_ != nullptr; }
+    
+    // Sample captured on noteOn (the source of any pre-rendered stretch)
+    const SampleDataPtr& getSampleData() const { return sampleData_; }
+    
     // Get the MIDI note this voice is currently playing
     int getCurrentNote() const { return currentNote; }
     
@@ -68,6 +99,17 @@ public:
     // Set time ratio (1.0 = constant duration, != 1.0 = time stretching)
     void setTimeRatio(double ratio);
     
+    // Latency-compensated warp mode (frames at the host rate, 0 = off; applies from the next note)
+    // Notes and their note-offs take effect latencyFrames late, matching the latency the plugin
+    // reports. A stretcher voice starts reading at note-on, so its output is already there when
+    // the envelope starts; any other voice simply starts and stops latencyFrames later
+    void setLatencyCompensation(int latencyFrames) { latencyCompensationFrames = std::max(0, latencyFrames); }
+    int getLatencyCompensation() const { return latencyCompensationFrames; }
+    
+    // Interpolated sample reads (default) or drop-sample reads, for notes started from now on
+    // Set by the quality governor; a sounding note keeps its mode so the switch cannot click
+    void setInterpolationEnabled(bool enabled) { interpolationEnabled = enabled; }
+    
     // DEBUG: Enable sine test mode (outputs 220Hz sine instead of sample data)
     void setSineTestEnabled(bool enabled) { sineTestEnabled = enabled; }
     
@@ -116,6 +158,9 @@ private:
     // Captured on noteOn, remains valid until voice releases it
     SampleDataPtr sampleData_;
     
+    // Pitched render of sampleData_ for the current note (nullptr = pitch live)
+    SampleDataPtr prerenderedSample_;
+    
     double playhead;        // Current playback position (samples, can be fractional)
     bool active;
     int currentNote;
@@ -145,38 +190,26 @@ private:
     // Sample read position (advances at original speed)
     double sampleReadPos;
     
-    // Time-stretching processor
-    std::unique_ptr<IWarpProcessor> warpProcessor;
+    // Time-stretching processor and its planar buffers (leased, not owned)
+    WarpProcessorPool::Lease* warpLease;
     bool warpEnabled;
     double timeRatio;  // 1.0 = constant duration, != 1.0 = time stretch
     
-    // Buffers for warp processing (planar format)
-    float** warpInputPlanar;   // [2][maxBlockSize] for feeding warp
-    float** warpOutputPlanar;  // [2][maxBlockSize] for warp output
-    int warpBufferSize;
-    
-    // Warp priming and crossfade state
-    bool warpPriming;
-    bool warpCrossfadeActive;
-    float warpCrossfadePos;     // 0.0 = dry, 1.0 = warp
-    float warpCrossfadeInc;     // Crossfade increment per sample
-    int warpCrossfadeSamples;   // Total crossfade duration in samples
-    int warpCrossfadeCounter;   // Current crossfade position
-    
-    // Gain matching state (warp vs dry reference)
-    float dryRMS;           // Running RMS of dry path (smoothed)
-    float warpRMS;          // Running RMS of warp path (smoothed)
-    float gainMatch;        // Current gain match factor (dryRMS/warpRMS)
-    float gainMatchTarget;  // Target gain match (smoothed)
-    float gainMatchAttack;  // Attack coefficient (5ms)
-    float gainMatchRelease; // Release coefficient (100ms)
+    // Latency compensation (see setLatencyCompensation)
+    int latencyCompensationFrames;  // Applied to notes started from now on
+    int noteCompensationFrames;     // Captured by the current note
+    int compensationHoldRemaining;  // Frames before the note becomes audible
+    int pendingNoteOffFrames;       // Frames until a deferred note-off applies (-1 = none)
+    bool warpPrerolled;             // Stretcher lookahead filled from sample memory for this note
+    double warpLookaheadFrames;     // Source frames between the read position and what is audible
+    
+    // Sample read interpolation (see setInterpolationEnabled)
+    bool interpolationEnabled;      // Applied to notes started from now on
+    bool noteInterpolates;          // Captured by the current note
     
     // DEBUG: Sine test mode (outputs 220Hz sine instead of sample data)
     bool sineTestEnabled;
     
-    // Latency priming state
-    int primeRemainingSamples;
-    
     // Processor prepared state (per-voice, not shared)
     
     // Debug info (updated during process, read from UI thread)
@@ -251,7 +284,7 @@ private:
     int startDelaySamples;   // Delay before voice starts outputting (0-63 samples)
     int startDelayCounter;   // Current delay counter
     
-    // Peak measurement (atomic, for UI display)
+    // Peak measurement (atomic, for UI display; only updated when ActiveDiagnostics::voiceMeters)
     mutable std::atomic<float> peakOut{0.0f};
     mutable std::atomic<int> numClippedSamples{0};
     mutable std::atomic<int> oobGuardHits{0}; // Out-of-bounds guard hits (debug counter)
@@ -272,6 +305,21 @@ private:
     // DEBUG: Sine test phase (for 220Hz sine generation)
     double sinePhase;
     
+    // Render numSamples with no hold or deferred note-off inside the block
+    void renderBlock(float** output, int numChannels, int numSamples, double sampleRate);
+    
+    // Start the release phase now (noteOff once any compensation delay has passed)
+    void beginRelease();
+    
+    // Pitch and time ratio for the leased stretcher (per block)
+    void updateWarpSettings();
+    
+    // View of playData at the playhead, with this voice's loop/end points and gain
+    WarpSampleView makeWarpView(const SampleData& playData) const;
+    
+    // Run the stretcher through the compensation hold (output is discarded - nothing is audible yet)
+    void advanceWarpHold(int numSamples);
+    
     // Cubic Hermite interpolation helper
     static float cubicHermite(float y0, float y1, float y2, float y3, float t);
     
@@ -284,8 +332,8 @@ private:
     }
     
     inline float safetyProcess(float x) const {
-        // NaN/Inf guard
-        if (!std::isfinite(x)) x = 0.0f;
+        // NaN/Inf guard (every policy; the clamp below would turn NaN into +2)
+        x = guardVoiceSample(x);
         // Hard clamp to prevent explosion
         x = std::max(-2.0f, std::min(2.0f, x));
         // Soft clip
@@ -10,8 +10,6 @@
 #include <cmath>
 #include <cfloat>
 #include <vector>
-#include <fstream>
-#include <chrono>
 
 namespace Core {
 
@@ -67,20 +65,9 @@ void SignalsmithTimePitch::prepare(const TimePitchConfig& config)
     int configuredIntervalSamples = std::max(32, static_cast<int>(intervalSamplesConfig));
     impl->stretch.configure(config.channels, configuredBlockSamples, configuredIntervalSamples, true);
     
-    // Get latency values and block sizes
+    // Get latency values
     inputLatency = impl->stretch.inputLatency();
     outputLatency = impl->stretch.outputLatency();
-    int blockSamples = impl->stretch.blockSamples();
-    int intervalSamples = impl->stretch.intervalSamples();
-    
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"D\",\"location\":\"SignalsmithTimePitch.cpp:65\",\"message\":\"Stretcher prepared\",\"data\":{\"sampleRate\":" << config.sampleRate << ",\"channels\":" << config.channels << ",\"inputLatency\":" << inputLatency << ",\"outputLatency\":" << outputLatency << ",\"blockSamples\":" << blockSamples << ",\"intervalSamples\":" << intervalSamples << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
     
     // Allocate internal buffers for handling small blocks
     allocateBuffers();
@@ -147,9 +134,6 @@ int SignalsmithTimePitch::process(const float* in, int inN, float* out, int outN
         return 0;
     }
     
-    int inputRingSizeBefore = inputRing.size();
-    int outputRingSizeBefore = outputRing.size();
-    
     // Push input into input ring buffer
     if (in != nullptr && inN > 0) {
         pushToInputRing(in, inN);
@@ -183,23 +167,6 @@ int SignalsmithTimePitch::process(const float* in, int inN, float* out, int outN
     // But we should NOT return 0 if we have ANY output available
     // The issue is that we're pulling all available output, leaving nothing for next call
     
-    // Count non-zero samples for debugging
-    int nonZeroCount = 0;
-    for (int i = 0; i < actualOutN; ++i) {
-        if (std::abs(out[i]) > 1e-6f) {
-            nonZeroCount++;
-        }
-    }
-    
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"B\",\"location\":\"SignalsmithTimePitch.cpp:109\",\"message\":\"Stretcher process\",\"data\":{\"inN\":" << inN << ",\"outN\":" << outN << ",\"actualOutN\":" << actualOutN << ",\"inputRingBefore\":" << inputRingSizeBefore << ",\"inputRingAfter\":" << inputRing.size() << ",\"outputRingBefore\":" << outputRingSizeBefore << ",\"outputRingAfter\":" << outputRing.size() << ",\"iterations\":" << iterations << ",\"nonZeroCount\":" << nonZeroCount << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     // Return actual output count
     // If we got less than requested, that's OK - we'll get more on next call
     // The voice will mix whatever we produce
@@ -298,7 +265,6 @@ void SignalsmithTimePitch::processAccumulatedInput()
     // when it has accumulated enough input (at least intervalSamples).
     // We need to accumulate input until we have enough for the stretcher to process blocks.
     int intervalSamples = impl->stretch.intervalSamples();
-    int blockSamples = impl->stretch.blockSamples();
     
     // For polyphony: process larger chunks less frequently to reduce CPU load
     // The stretcher accumulates input internally, so we can process in larger batches
@@ -306,25 +272,8 @@ void SignalsmithTimePitch::processAccumulatedInput()
     const int preferredChunkSize = std::max(128, intervalSamples / 2); // Process in larger chunks, but not full interval
     int inputAvailable = inputRing.size();
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"E\",\"location\":\"SignalsmithTimePitch.cpp:260\",\"message\":\"processAccumulatedInput called\",\"data\":{\"inputAvailable\":" << inputAvailable << ",\"minChunkSize\":" << minChunkSize << ",\"preferredChunkSize\":" << preferredChunkSize << ",\"intervalSamples\":" << intervalSamples << ",\"blockSamples\":" << blockSamples << ",\"outputRingSize\":" << outputRing.size() << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     if (inputAvailable < minChunkSize) {
         // Not enough input yet - wait for more
-        // #region agent log
-        {
-            std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-            if (log.is_open()) {
-                log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"B\",\"location\":\"SignalsmithTimePitch.cpp:275\",\"message\":\"Not enough input, returning early\",\"data\":{\"inputAvailable\":" << inputAvailable << ",\"minChunkSize\":" << minChunkSize << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-            }
-        }
-        // #endregion
         return;
     }
     
@@ -360,12 +309,9 @@ void SignalsmithTimePitch::processAccumulatedInput()
         }
         
         // Sanitize output samples
-        int nonZeroInOutput = 0;
         for (int i = 0; i < outputRequested; ++i) {
             if (!std::isfinite(tempOutputBuffer[i])) {
                 tempOutputBuffer[i] = 0.0f;
-            } else if (std::abs(tempOutputBuffer[i]) > 1e-6f) {
-                nonZeroInOutput++;
             }
         }
         
@@ -374,15 +320,6 @@ void SignalsmithTimePitch::processAccumulatedInput()
         
         // Discard consumed input
         inputRing.discard(peeked);
-        
-        // #region agent log
-        {
-            std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-            if (log.is_open()) {
-                log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"E\",\"location\":\"SignalsmithTimePitch.cpp:315\",\"message\":\"Processed chunk through stretcher\",\"data\":{\"peeked\":" << peeked << ",\"outputRingSizeAfter\":" << outputRing.size() << ",\"nonZeroInOutput\":" << nonZeroInOutput << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-            }
-        }
-        // #endregion
     }
 }
 
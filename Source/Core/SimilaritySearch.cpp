@@ -0,0 +1,335 @@
+#include "SimilaritySearch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CORE_SEARCH_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CORE_SEARCH_NEON 1
+#endif
+
+namespace Core {
+
+namespace {
+
+// Relative cost of one SimpleFFT point-stage versus one SIMD multiply-accumulate (measured with
+// Debug/WsolaSearchBench); the coarse pass uses the FFT only when it is cheaper
+constexpr double FFT_COST_PER_POINT = 8.0;
+
+int nextPowerOf2(int n) {
+    int p = 2;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+double fftCost(int size) {
+    int stages = 0;
+    for (int s = size; s > 1; s >>= 1) {
+        ++stages;
+    }
+    // Two forward transforms and one inverse
+    return 3.0 * FFT_COST_PER_POINT * static_cast<double>(size) * static_cast<double>(stages);
+}
+
+// Sum each group of factor samples (box filter + decimation)
+void decimate(const float* in, int outLength, int factor, float* out) {
+    for (int j = 0; j < outLength; ++j) {
+        const float* group = in + j * factor;
+        float sum = 0.0f;
+        for (int d = 0; d < factor; ++d) {
+            sum += group[d];
+        }
+        out[j] = sum;
+    }
+}
+
+} // namespace
+
+SimilaritySearch::SimilaritySearch()
+    : templateLength(0)
+    , maxOffsets(0)
+    , coarseTemplate(nullptr)
+    , coarseRegion(nullptr)
+    , coarseScores(nullptr)
+    , fftSize(0)
+    , fftInput(nullptr)
+    , templateSpectrum(nullptr)
+    , regionSpectrum(nullptr)
+    , correlationOut(nullptr)
+{
+}
+
+SimilaritySearch::~SimilaritySearch()
+{
+    deallocateBuffers();
+}
+
+void SimilaritySearch::prepare(int length, int offsets)
+{
+    deallocateBuffers();
+    
+    templateLength = std::max(1, length);
+    maxOffsets = std::max(1, offsets);
+    
+    int coarseLength = templateLength / DECIMATION;
+    int coarseOffsets = (maxOffsets - 1) / DECIMATION + 1;
+    int coarseRegionLength = coarseOffsets + coarseLength;
+    
+    coarseTemplate = new float[std::max(1, coarseLength)];
+    coarseRegion = new float[coarseRegionLength];
+    coarseScores = new float[coarseOffsets];
+    
+    fftSize = nextPowerOf2(coarseRegionLength);
+    fft.prepare(fftSize);
+    fftInput = new float[fftSize];
+    templateSpectrum = new float[fftSize + 2];
+    regionSpectrum = new float[fftSize + 2];
+    correlationOut = new float[fftSize];
+}
+
+int SimilaritySearch::findBestOffset(const float* tmpl, const float* region, int numOffsets, float* bestScore)
+{
+    numOffsets = std::min(numOffsets, maxOffsets);
+    if (tmpl == nullptr || region == nullptr || numOffsets <= 0 || coarseRegion == nullptr) {
+        if (bestScore != nullptr) {
+            *bestScore = -1.0f;
+        }
+        return 0;
+    }
+    
+    const int length = templateLength;
+    const int coarseLength = length / DECIMATION;
+    
+    // Small search (or too short to decimate): exhaustive at full resolution
+    if (static_cast<long long>(numOffsets) * length <= DIRECT_SEARCH_LIMIT || coarseLength < 4) {
+        return searchDirect(tmpl, region, length, numOffsets, nullptr, bestScore);
+    }
+    
+    // Coarse pass: score every DECIMATION-th offset on the decimated signals
+    const int coarseOffsets = (numOffsets - 1) / DECIMATION + 1;
+    const int coarseRegionLength = coarseOffsets + coarseLength - 1;
+    decimate(tmpl, coarseLength, DECIMATION, coarseTemplate);
+    decimate(region, coarseRegionLength, DECIMATION, coarseRegion);
+    
+    double directCost = static_cast<double>(coarseOffsets) * coarseLength;
+    if (coarseRegionLength <= fftSize && fftCost(nextPowerOf2(coarseRegionLength)) < directCost) {
+        correlateFFT(coarseTemplate, coarseRegion, coarseLength, coarseOffsets);
+        std::memcpy(coarseScores, correlationOut, static_cast<size_t>(coarseOffsets) * sizeof(float));
+        normaliseScores(coarseTemplate, coarseRegion, coarseLength, coarseOffsets, coarseScores);
+    } else {
+        searchDirect(coarseTemplate, coarseRegion, coarseLength, coarseOffsets, coarseScores, nullptr);
+    }
+    
+    // Keep the strongest local maxima; the decimated score of a tonal signal is
+    // periodic, so the global coarse peak alone can land one period away from the true best
+    int candidates[REFINE_CANDIDATES];
+    float candidateScores[REFINE_CANDIDATES];
+    int numCandidates = 0;
+    for (int k = 0; k < coarseOffsets; ++k) {
+        float s = coarseScores[k];
+        bool isPeak = (k == 0 || s >= coarseScores[k - 1]) && (k == coarseOffsets - 1 || s >= coarseScores[k + 1]);
+        if (!isPeak) {
+            continue;
+        }
+        int slot = numCandidates;
+        if (numCandidates < REFINE_CANDIDATES) {
+            ++numCandidates;
+        } else if (s <= candidateScores[REFINE_CANDIDATES - 1]) {
+            continue;
+        } else {
+            slot = REFINE_CANDIDATES - 1;
+        }
+        while (slot > 0 && candidateScores[slot - 1] < s) {
+            candidates[slot] = candidates[slot - 1];
+            candidateScores[slot] = candidateScores[slot - 1];
+            --slot;
+        }
+        candidates[slot] = k;
+        candidateScores[slot] = s;
+    }
+    if (numCandidates == 0) {
+        candidates[0] = 0;  // All scores invalid (non-finite input)
+        numCandidates = 1;
+    }
+    
+    // Refine: full-resolution search within one coarse step of each peak
+    int bestOffset = candidates[0] * DECIMATION;
+    float best = -2.0f;
+    for (int c = 0; c < numCandidates; ++c) {
+        int centre = candidates[c] * DECIMATION;
+        int first = std::max(0, centre - (DECIMATION - 1));
+        int last = std::min(numOffsets - 1, centre + (DECIMATION - 1));
+        for (int offset = first; offset <= last; ++offset) {
+            float score = normalisedCorrelation(tmpl, region + offset, length);
+            if (score > best) {
+                best = score;
+                bestOffset = offset;
+            }
+        }
+    }
+    
+    if (bestScore != nullptr) {
+        *bestScore = best;
+    }
+    return bestOffset;
+}
+
+int SimilaritySearch::searchDirect(const float* tmpl, const float* region, int length, int numOffsets,
+                                   float* scores, float* bestScore) const
+{
+    double templateEnergy = 0.0;
+    double windowEnergy = 0.0;
+    for (int i = 0; i < length; ++i) {
+        templateEnergy += static_cast<double>(tmpl[i]) * tmpl[i];
+        windowEnergy += static_cast<double>(region[i]) * region[i];
+    }
+    
+    int bestOffset = 0;
+    float best = -2.0f;
+    for (int k = 0; k < numOffsets; ++k) {
+        if (k > 0) {
+            // Slide the window energy by one sample
+            double leaving = region[k - 1];
+            double entering = region[k + length - 1];
+            windowEnergy = std::max(0.0, windowEnergy - leaving * leaving + entering * entering);
+        }
+        
+        double denom = std::sqrt(templateEnergy * windowEnergy) + 1e-12;
+        float score = static_cast<float>(dot(tmpl, region + k, length) / denom);
+        if (!std::isfinite(score)) {
+            score = -1.0f;
+        }
+        if (scores != nullptr) {
+            scores[k] = score;
+        }
+        if (score > best) {
+            best = score;
+            bestOffset = k;
+        }
+    }
+    
+    if (bestScore != nullptr) {
+        *bestScore = best;
+    }
+    return bestOffset;
+}
+
+void SimilaritySearch::correlateFFT(const float* tmpl, const float* region, int length, int numOffsets)
+{
+    // Zero-padding to fftSize >= region length keeps lags 0..numOffsets-1 free of wrap-around
+    int regionLength = numOffsets + length - 1;
+    
+    std::memcpy(fftInput, tmpl, static_cast<size_t>(length) * sizeof(float));
+    std::fill(fftInput + length, fftInput + fftSize, 0.0f);
+    fft.forward(fftInput, templateSpectrum);
+    
+    std::memcpy(fftInput, region, static_cast<size_t>(regionLength) * sizeof(float));
+    std::fill(fftInput + regionLength, fftInput + fftSize, 0.0f);
+    fft.forward(fftInput, regionSpectrum);
+    
+    // corr[k] = sum tmpl[i] * region[i + k]  <=>  IFFT(conj(T) * R)
+    int numBins = fftSize / 2 + 1;
+    for (int b = 0; b < numBins; ++b) {
+        float tr = templateSpectrum[b * 2];
+        float ti = templateSpectrum[b * 2 + 1];
+        float rr = regionSpectrum[b * 2];
+        float ri = regionSpectrum[b * 2 + 1];
+        regionSpectrum[b * 2] = tr * rr + ti * ri;
+        regionSpectrum[b * 2 + 1] = tr * ri - ti * rr;
+    }
+    fft.inverse(regionSpectrum, correlationOut);
+}
+
+void SimilaritySearch::normaliseScores(const float* tmpl, const float* region, int length, int numOffsets, float* scores)
+{
+    double templateEnergy = 0.0;
+    double windowEnergy = 0.0;
+    for (int i = 0; i < length; ++i) {
+        templateEnergy += static_cast<double>(tmpl[i]) * tmpl[i];
+        windowEnergy += static_cast<double>(region[i]) * region[i];
+    }
+    
+    for (int k = 0; k < numOffsets; ++k) {
+        if (k > 0) {
+            double leaving = region[k - 1];
+            double entering = region[k + length - 1];
+            windowEnergy = std::max(0.0, windowEnergy - leaving * leaving + entering * entering);
+        }
+        double denom = std::sqrt(templateEnergy * windowEnergy) + 1e-12;
+        float score = static_cast<float>(scores[k] / denom);
+        scores[k] = std::isfinite(score) ? score : -1.0f;
+    }
+}
+
+float SimilaritySearch::normalisedCorrelation(const float* a, const float* b, int n)
+{
+    if (a == nullptr || b == nullptr || n <= 0) {
+        return -1.0f;
+    }
+    
+    double ab = dot(a, b, n);
+    double aa = dot(a, a, n);
+    double bb = dot(b, b, n);
+    float result = static_cast<float>(ab / (std::sqrt(std::max(0.0, aa * bb)) + 1e-12));
+    return std::isfinite(result) ? result : -1.0f;
+}
+
+float SimilaritySearch::dot(const float* a, const float* b, int n)
+{
+    int i = 0;
+    float sum = 0.0f;
+
+#if defined(CORE_SEARCH_SSE)
+    // Two independent accumulators hide the add latency
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(CORE_SEARCH_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    sum = (vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)) + (vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3));
+#endif
+
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void SimilaritySearch::deallocateBuffers()
+{
+    delete[] coarseTemplate;
+    delete[] coarseRegion;
+    delete[] coarseScores;
+    delete[] fftInput;
+    delete[] templateSpectrum;
+    delete[] regionSpectrum;
+    delete[] correlationOut;
+    
+    coarseTemplate = nullptr;
+    coarseRegion = nullptr;
+    coarseScores = nullptr;
+    fftInput = nullptr;
+    templateSpectrum = nullptr;
+    regionSpectrum = nullptr;
+    correlationOut = nullptr;
+    fftSize = 0;
+}
+
+} // namespace Core
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "SimpleFFT.h"
+
+namespace Core {
+
+/**
+ * Normalised cross-correlation search for WSOLA overlap alignment
+ * Portable C++ - no JUCE dependencies
+ * No allocations in findBestOffset() - buffers sized in prepare()
+ *
+ * Finds the offset in a search region whose window best matches a template
+ * (the tail of the previous synthesis frame), scoring each candidate by
+ * dot(template, window) / sqrt(energy(template) * energy(window)).
+ *
+ * Small searches are exhaustive with SIMD dot products. Larger ones run a coarse
+ * pass on both signals box-filtered and decimated by DECIMATION, then refine the
+ * best few coarse peaks at full resolution. The coarse correlation switches to an
+ * FFT (one transform per signal plus one inverse) once the direct cost
+ * offsets x length outweighs it, so cost grows ~N log N with the seek range
+ * instead of O(seekRange x overlap).
+ */
+class SimilaritySearch {
+public:
+    static constexpr int DECIMATION = 4;            // Coarse pass resolution (samples)
+    static constexpr int REFINE_CANDIDATES = 3;     // Coarse peaks refined at full resolution
+    static constexpr int DIRECT_SEARCH_LIMIT = 16384;  // Max offsets x length searched exhaustively
+    
+    SimilaritySearch();
+    ~SimilaritySearch();
+    
+    SimilaritySearch(const SimilaritySearch&) = delete;
+    SimilaritySearch& operator=(const SimilaritySearch&) = delete;
+    
+    /**
+     * Allocate for templates of templateLength samples and up to maxOffsets candidates
+     * Not real-time safe
+     */
+    void prepare(int templateLength, int maxOffsets);
+    
+    /**
+     * Best candidate offset in [0, numOffsets)
+     * tmpl: templateLength samples
+     * region: numOffsets + templateLength - 1 samples; candidate k starts at region + k
+     * bestScore (optional): normalised correlation of the chosen candidate (-1..1)
+     */
+    int findBestOffset(const float* tmpl, const float* region, int numOffsets, float* bestScore = nullptr);
+    
+    /**
+     * Normalised correlation of two n-sample windows (SIMD dot products)
+     */
+    static float normalisedCorrelation(const float* a, const float* b, int n);
+    
+    /**
+     * Dot product of two n-sample buffers (SSE on x86, NEON on ARM, scalar otherwise)
+     */
+    static float dot(const float* a, const float* b, int n);
+    
+    int getTemplateLength() const { return templateLength; }
+    int getMaxOffsets() const { return maxOffsets; }
+
+private:
+    int templateLength;
+    int maxOffsets;
+    
+    // Coarse (decimated) signals and their correlation
+    float* coarseTemplate;
+    float* coarseRegion;
+    float* coarseScores;
+    
+    // FFT correlation (coarse pass only)
+    SimpleFFT fft;
+    int fftSize;
+    float* fftInput;
+    float* templateSpectrum;
+    float* regionSpectrum;
+    float* correlationOut;
+    
+    // Exhaustive NCC over numOffsets candidates; scores written if non-null
+    int searchDirect(const float* tmpl, const float* region, int length, int numOffsets,
+                     float* scores, float* bestScore) const;
+    
+    // Raw cross-correlation via FFT into correlationOut[0..numOffsets)
+    void correlateFFT(const float* tmpl, const float* region, int length, int numOffsets);
+    
+    // Normalise raw dot products in place by template and sliding window energy
+    static void normaliseScores(const float* tmpl, const float* region, int length, int numOffsets, float* scores);
+    
+    void deallocateBuffers();
+};
+
+} // namespace Core
@@ -10,6 +10,7 @@ SimpleFFT::SimpleFFT()
     , twiddleFactors(nullptr)
     , bitReverseTable(nullptr)
     , bitReverseIndices(nullptr)
+    , scratch(nullptr)
 {
 }
 
@@ -18,6 +19,7 @@ SimpleFFT::~SimpleFFT()
     delete[] twiddleFactors;
     delete[] bitReverseTable;
     delete[] bitReverseIndices;
+    delete[] scratch;
 }
 
 void SimpleFFT::prepare(int size)
@@ -43,6 +45,10 @@ void SimpleFFT::prepare(int size)
     delete[] bitReverseIndices;
     bitReverseIndices = new int[frameSize];
     
+    // Bit-reversal scratch for inverse() (kept here so transforms never allocate)
+    delete[] scratch;
+    scratch = new float[frameSize * 2];
+    
     computeTwiddleFactors();
     computeBitReverseTable();
 }
@@ -145,16 +151,15 @@ void SimpleFFT::inverse(const float* input, float* output)
     }
     
     // Apply bit reversal
-    float* temp = new float[frameSize * 2];
     for (int i = 0; i < frameSize; ++i) {
         int reversed = bitReverseIndices[i];
-        temp[i * 2] = bitReverseTable[reversed * 2];
-        temp[i * 2 + 1] = bitReverseTable[reversed * 2 + 1];
+        scratch[i * 2] = bitReverseTable[reversed * 2];
+        scratch[i * 2 + 1] = bitReverseTable[reversed * 2 + 1];
     }
-    std::memcpy(bitReverseTable, temp, frameSize * 2 * sizeof(float));
-    delete[] temp;
+    std::memcpy(bitReverseTable, scratch, frameSize * 2 * sizeof(float));
     
-    // Radix-2 IFFT (same as FFT but with conjugated twiddles)
+    // Radix-2 FFT of the conjugated spectrum: conj(FFT(conj(X))) / N = IFFT(X),
+    // and the final conjugate drops out because only the real part is kept
     int stages = log2(frameSize);
     int step = 1;
     
@@ -170,18 +175,18 @@ void SimpleFFT::inverse(const float* input, float* output)
                 int twiddleIdx = twiddleIndex * 2;
                 if (twiddleIdx + 1 < frameSize && twiddleFactors != nullptr) {
                     wr = twiddleFactors[twiddleIdx];
-                    wi = -twiddleFactors[twiddleIdx + 1]; // Conjugate for IFFT
+                    wi = twiddleFactors[twiddleIdx + 1];
                 } else {
                     // Fallback: compute directly
                     const double pi = 3.14159265358979323846;
-                    double angle = 2.0 * pi * twiddleIndex / frameSize; // Positive for IFFT
+                    double angle = -2.0 * pi * twiddleIndex / frameSize;
                     wr = static_cast<float>(std::cos(angle));
                     wi = static_cast<float>(std::sin(angle));
                 }
             } else {
                 // Shouldn't happen, but compute directly as fallback
                 const double pi = 3.14159265358979323846;
-                double angle = 2.0 * pi * twiddleIndex / frameSize; // Positive for IFFT
+                double angle = -2.0 * pi * twiddleIndex / frameSize;
                 wr = static_cast<float>(std::cos(angle));
                 wi = static_cast<float>(std::sin(angle));
             }
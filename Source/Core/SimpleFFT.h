@@ -30,7 +30,7 @@ public:
     /**
      * Perform inverse FFT (frequency -> time)
      * Input: complex spectrum (frameSize + 2 floats)
-     * Output: real samples (frameSize)
+     * Output: real samples (frameSize), scaled by 1/frameSize
      */
     void inverse(const float* input, float* output);
     
@@ -44,6 +44,7 @@ private:
     float* twiddleFactors;
     float* bitReverseTable;
     int* bitReverseIndices;
+    float* scratch;
     
     bool isPowerOf2(int n) const;
     int log2(int n) const;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Core {
+
+// Per-slot playback parameters read by the audio thread on NoteOn
+// POD only (no strings, no pointers) so a whole set can be published through TripleBuffer
+// The editor-side SlotSnapshot keeps the sample name and UI-only values
+struct SlotParameterBlock {
+    float repitchSemitones = 0.0f;
+    int32_t startPoint = 0;
+    int32_t endPoint = 0;
+    float sampleGain = 1.0f;
+    float attackMs = 800.0f;
+    float decayMs = 0.0f;
+    float sustain = 1.0f;
+    float releaseMs = 1000.0f;
+    int32_t loopStartPoint = 0;
+    int32_t loopEndPoint = 0;
+    bool loopEnabled = false;
+    
+    // Granular playback: NoteOns start a GranularEngine grain stream instead of a voice
+    bool granularEnabled = false;
+    float grainDensity = 40.0f;         // Grains per second per held note
+    float grainSizeMs = 80.0f;
+    float grainPosition = 0.0f;         // 0..1 across start/end points
+    float grainPositionJitter = 0.0f;   // 0..1 of the region
+    float grainPitchSpread = 0.0f;      // +/- semitones per grain
+    int32_t grainWindow = 0;            // GranularEngine::WindowShape
+};
+
+// Parameters for all slots A-E, published as one coherent snapshot per change
+struct SlotParameterSet {
+    static constexpr int NUM_SLOTS = 5;
+    SlotParameterBlock slots[NUM_SLOTS];
+};
+
+static_assert(std::is_trivially_copyable<SlotParameterSet>::value, "SlotParameterSet must stay POD");
+
+} // namespace Core
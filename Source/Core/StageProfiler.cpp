@@ -0,0 +1,69 @@
+#include "StageProfiler.h"
+
+namespace Core {
+
+namespace {
+
+struct StageInfo {
+    const char* name;
+    ProfileStage parent;
+};
+
+// Indexed by ProfileStage
+const StageInfo stageTable[StageProfiler::NUM_STAGES] = {
+    { "Engine",           ProfileStage::NumStages },
+    { "Params",           ProfileStage::Engine },
+    { "MIDI",             ProfileStage::Engine },
+    { "Voices",           ProfileStage::Engine },
+    { "Parallel",         ProfileStage::EngineVoices },
+    { "Serial",           ProfileStage::EngineVoices },
+    { "Warp leases",      ProfileStage::EngineVoices },
+    { "Voice",            ProfileStage::EngineVoices },
+    { "Warp",             ProfileStage::Voice },
+    { "Warp mix",         ProfileStage::Voice },
+    { "Resample",         ProfileStage::Voice },
+    { "Mix slew",         ProfileStage::Engine },
+    { "Pop detect",       ProfileStage::Engine },
+    { "Master",           ProfileStage::Engine },
+    { "Filter/FX",        ProfileStage::Engine },
+    { "Orbit",            ProfileStage::NumStages },
+    { "Notes",            ProfileStage::Orbit },
+    { "Weights",          ProfileStage::Orbit },
+    { "Engine",           ProfileStage::Orbit },
+};
+
+bool isValid(ProfileStage stage) {
+    return static_cast<int>(stage) >= 0 && stage < ProfileStage::NumStages;
+}
+
+} // namespace
+
+StageProfiler::Counter StageProfiler::counters[StageProfiler::NUM_STAGES];
+
+void StageProfiler::snapshot(StageTotals* out) {
+    if (out == nullptr) {
+        return;
+    }
+    for (int i = 0; i < NUM_STAGES; ++i) {
+        out[i].ticks = counters[i].ticks.load(std::memory_order_relaxed);
+        out[i].calls = counters[i].calls.load(std::memory_order_relaxed);
+    }
+}
+
+const char* StageProfiler::getName(ProfileStage stage) {
+    return isValid(stage) ? stageTable[static_cast<int>(stage)].name : "";
+}
+
+ProfileStage StageProfiler::getParent(ProfileStage stage) {
+    return isValid(stage) ? stageTable[static_cast<int>(stage)].parent : ProfileStage::NumStages;
+}
+
+int StageProfiler::getDepth(ProfileStage stage) {
+    int depth = 0;
+    for (ProfileStage parent = getParent(stage); parent != ProfileStage::NumStages; parent = getParent(parent)) {
+        ++depth;
+    }
+    return depth;
+}
+
+} // namespace Core
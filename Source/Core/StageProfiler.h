@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CallbackLoadMeter.h"
+#include <atomic>
+#include <cstdint>
+
+// Per-stage scopes are compiled in for debug builds; define OP1_PROFILING=1 (CMake option
+// OP1_STAGE_PROFILING) to keep them in a release build, or OP1_PROFILING=0 to drop them
+#ifndef OP1_PROFILING
+#if defined(NDEBUG)
+#define OP1_PROFILING 0
+#else
+#define OP1_PROFILING 1
+#endif
+#endif
+
+namespace Core {
+
+/**
+ * Timed stages of the render graph, parents before children (see StageProfiler::getParent)
+ */
+enum class ProfileStage : int {
+    Engine = 0,        // SamplerEngine::process (one block or orbit chunk)
+    EngineParams,      // Parameter commands and steal policy
+    EngineMidi,        // MIDI queue drain and note-ons
+    EngineVoices,      // Output clear, voice gain, voice rendering
+    VoicesParallel,    // VoiceManager: cost sort, worker pool run, lane mix
+    VoicesSerial,      // VoiceManager: voices rendered on the audio thread
+    VoiceLeases,       // VoiceManager: warp processors returned to the pool
+    Voice,             // SamplerVoice::process (summed over voices and worker threads)
+    VoiceWarp,         // Stretcher pull (preroll and processPull)
+    VoiceWarpMix,      // Stretcher output limiter, envelope and mix
+    VoiceResample,     // Resampling path: interpolation, envelope and mix
+    EngineMixSlew,     // Mix slew limiter and block boundary smoothing
+    EnginePopDetect,   // Pop detector
+    EngineMaster,      // Peak detection, soft clip and limiter
+    EngineFilterFx,    // Filter, envelope, drive and lofi
+    Orbit,             // JuceEngineAdapter::processOrbitMode
+    OrbitNotes,        // Note-ons and note-offs fanned out to slots A-D
+    OrbitWeights,      // Blend weight ramps
+    OrbitEngine,       // Engine render per chunk
+    NumStages
+};
+
+/**
+ * Accumulated totals for one stage
+ */
+struct StageTotals {
+    uint64_t ticks = 0;   // CallbackLoadMeter::now() ticks spent in the stage
+    uint64_t calls = 0;   // Times the stage was entered
+};
+
+/**
+ * Fixed per-stage counters fed by ProfileScope
+ * Portable C++ - no JUCE dependencies
+ *
+ * Counters are process-wide and only ever grow; readers take two snapshots and work with
+ * the difference. Stages run on the audio thread and, for voices, on render workers too,
+ * so they accumulate with relaxed fetch_add. A child's time is included in its parent's;
+ * voice stages are summed across workers and can exceed their parent in parallel mode.
+ *
+ * Any thread: record, snapshot, and the static stage table
+ */
+class StageProfiler {
+public:
+    static constexpr int NUM_STAGES = static_cast<int>(ProfileStage::NumStages);
+    static constexpr bool isEnabled() { return OP1_PROFILING != 0; }
+    
+    static void record(ProfileStage stage, uint64_t ticks) {
+        Counter& counter = counters[static_cast<int>(stage)];
+        counter.ticks.fetch_add(ticks, std::memory_order_relaxed);
+        counter.calls.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    /**
+     * Copy every stage's totals into out[NUM_STAGES]
+     */
+    static void snapshot(StageTotals* out);
+    
+    static const char* getName(ProfileStage stage);
+    static ProfileStage getParent(ProfileStage stage);  // NumStages for top-level stages
+    static int getDepth(ProfileStage stage);            // 0 for top-level stages
+
+private:
+    // One cache line per stage so workers timing different stages don't share lines
+    struct alignas(64) Counter {
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> calls{0};
+    };
+    
+    static Counter counters[NUM_STAGES];
+};
+
+/**
+ * Times a stage from construction to destruction; next() closes the current stage and
+ * opens another, so consecutive stages of one function share a scope, and end() closes
+ * it early. No allocation
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileStage stage)
+        : current(stage)
+        , start(CallbackLoadMeter::now())
+    {
+    }
+    
+    ~ProfileScope() {
+        end();
+    }
+    
+    void next(ProfileStage stage) {
+        uint64_t now = CallbackLoadMeter::now();
+        StageProfiler::record(current, now - start);
+        current = stage;
+        start = now;
+    }
+    
+    void end() {
+        if (current != ProfileStage::NumStages) {
+            StageProfiler::record(current, CallbackLoadMeter::now() - start);
+            current = ProfileStage::NumStages;
+        }
+    }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileStage current;
+    uint64_t start;
+};
+
+} // namespace Core
+
+#if OP1_PROFILING
+#define OP1_PROFILE_SCOPE(name, stage) ::Core::ProfileScope name(::Core::ProfileStage::stage)
+#define OP1_PROFILE_NEXT(name, stage) name.next(::Core::ProfileStage::stage)
+#define OP1_PROFILE_END(name) name.end()
+#else
+#define OP1_PROFILE_SCOPE(name, stage) do {} while (false)
+#define OP1_PROFILE_NEXT(name, stage) do {} while (false)
+#define OP1_PROFILE_END(name) do {} while (false)
+#endif
@@ -0,0 +1,383 @@
+#include "StretchRenderCache.h"
+#include "../../ThirdParty/signalsmith/signalsmith-stretch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace Core {
+
+namespace {
+
+constexpr int FINGERPRINT_SAMPLES = 64;  // Samples hashed to identify sample content
+constexpr auto RETIRED_RECHECK = std::chrono::milliseconds(100);  // While evicted renders are still playing
+
+inline uint64_t fnvMix(uint64_t hash, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+StretchRenderCache::StretchRenderCache()
+    : bytesUsed(0)
+{
+}
+
+StretchRenderCache::~StretchRenderCache() {
+    stop();
+}
+
+void StretchRenderCache::start(int numThreads) {
+    if (running.load(std::memory_order_acquire)) {
+        return;
+    }
+    running.store(true, std::memory_order_release);
+    numThreads = std::max(1, numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back(&StretchRenderCache::renderLoop, this);
+    }
+}
+
+void StretchRenderCache::stop() {
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        running.store(false, std::memory_order_release);
+    }
+    workAvailable.notify_all();
+    for (auto& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads.clear();
+}
+
+uint64_t StretchRenderCache::makeKey(const SampleData& source, float semitones, double timeRatio) {
+    // Content fingerprint rather than pointer identity: callers may copy a slot's sample
+    // into a fresh SampleData for every note-on
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = fnvMix(hash, static_cast<uint64_t>(source.length));
+    uint64_t rateBits = 0;
+    std::memcpy(&rateBits, &source.sourceSampleRate, sizeof(rateBits));
+    hash = fnvMix(hash, rateBits);
+    int length = std::min(source.length, static_cast<int>(source.mono.size()));
+    if (length > 0) {
+        int stride = std::max(1, length / FINGERPRINT_SAMPLES);
+        for (int i = 0; i < length; i += stride) {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &source.mono[static_cast<size_t>(i)], sizeof(bits));
+            hash = fnvMix(hash, bits);
+        }
+    }
+    // Cents and 1/1000 ratio steps - finer differences are inaudible
+    hash = fnvMix(hash, static_cast<uint64_t>(static_cast<int64_t>(std::lround(semitones * 100.0f))));
+    hash = fnvMix(hash, static_cast<uint64_t>(static_cast<int64_t>(std::llround(timeRatio * 1000.0))));
+    return (hash == 0) ? 1 : hash;  // 0 marks an empty entry
+}
+
+SampleDataPtr StretchRenderCache::lookup(const SampleDataPtr& source, float semitones, double timeRatio) {
+    if (!isEnabled() || !source || source->length <= 0) {
+        return nullptr;
+    }
+    
+    uint64_t key = makeKey(*source, semitones, timeRatio);
+    for (auto& entry : entries) {
+        if (entry.key.load(std::memory_order_acquire) != key) {
+            continue;
+        }
+        if (entry.state.load(std::memory_order_acquire) == Ready) {
+            SampleDataPtr data = pinAndCopy(entry, key);
+            if (data) {
+                entry.lastUsed.store(useClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return data;
+            }
+        }
+        // Pending or failed - stay on live processing without queueing again
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    misses.fetch_add(1, std::memory_order_relaxed);
+    if (pushRequest(source, semitones, timeRatio, key)) {
+        // Without workMutex, so a request pushed while a render thread is between its check and
+        // its wait is picked up on the next wake (the next miss or prefetch re-requests it)
+        workAvailable.notify_one();
+    }
+    return nullptr;
+}
+
+SampleDataPtr StretchRenderCache::pinAndCopy(Entry& entry, uint64_t key) {
+    // Sequentially consistent pin/state pair with evictEntry: either eviction sees the pin and
+    // waits, or this sees the entry leave Ready and copies nothing. The copy is a refcount increment
+    entry.readers.fetch_add(1, std::memory_order_seq_cst);
+    SampleDataPtr data;
+    if (entry.state.load(std::memory_order_seq_cst) == Ready
+        && entry.key.load(std::memory_order_seq_cst) == key) {
+        data = entry.data;
+    }
+    entry.readers.fetch_sub(1, std::memory_order_release);
+    return data;
+}
+
+void StretchRenderCache::prefetch(const SampleDataPtr& source, float repitchSemitones, double timeRatio,
+                                  int rootNote, int lowNote, int highNote) {
+    if (!source || source->length <= 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        for (int note = std::max(0, lowNote); note <= std::min(127, highNote); ++note) {
+            Request request;
+            request.source = source;
+            request.semitones = static_cast<float>(note - rootNote) + repitchSemitones;
+            request.timeRatio = timeRatio;
+            request.key = makeKey(*source, request.semitones, timeRatio);
+            prefetchRequests.push_back(std::move(request));
+        }
+    }
+    workAvailable.notify_all();
+}
+
+void StretchRenderCache::clear() {
+    std::lock_guard<std::mutex> lock(workMutex);
+    Request discarded;
+    while (takeRequest(discarded)) {
+        discarded.source.reset();
+    }
+    for (int i = 0; i < MAX_ENTRIES; ++i) {
+        if (entries[i].state.load(std::memory_order_acquire) != Empty) {
+            evictEntry(i);
+        }
+    }
+    releaseRetired();
+}
+
+StretchRenderCache::Stats StretchRenderCache::getStats() const {
+    Stats stats;
+    stats.hits = hits.load(std::memory_order_relaxed);
+    stats.misses = misses.load(std::memory_order_relaxed);
+    stats.renders = renders.load(std::memory_order_relaxed);
+    stats.evictions = evictions.load(std::memory_order_relaxed);
+    stats.bytesUsed = bytesUsedPublished.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool StretchRenderCache::pushRequest(const SampleDataPtr& source, float semitones, double timeRatio, uint64_t key) {
+    uint32_t currentWrite = requestWritePos.load(std::memory_order_relaxed);
+    uint32_t currentRead = requestReadPos.load(std::memory_order_acquire);
+    if (currentWrite - currentRead >= static_cast<uint32_t>(REQUEST_CAPACITY)) {
+        return false;  // Full - the next miss asks again
+    }
+    
+    // The consumer moved the previous source out, so this assignment never frees sample memory
+    Request& slot = requests[currentWrite & (REQUEST_CAPACITY - 1)];
+    slot.source = source;
+    slot.semitones = semitones;
+    slot.timeRatio = timeRatio;
+    slot.key = key;
+    requestWritePos.store(currentWrite + 1, std::memory_order_release);
+    return true;
+}
+
+bool StretchRenderCache::takeRequest(Request& request) {
+    // Lazy requests first: a note is already playing live and waiting for them
+    uint32_t currentRead = requestReadPos.load(std::memory_order_relaxed);
+    if (currentRead != requestWritePos.load(std::memory_order_acquire)) {
+        request = std::move(requests[currentRead & (REQUEST_CAPACITY - 1)]);
+        requests[currentRead & (REQUEST_CAPACITY - 1)].source.reset();
+        requestReadPos.store(currentRead + 1, std::memory_order_release);
+        return true;
+    }
+    if (!prefetchRequests.empty()) {
+        request = std::move(prefetchRequests.front());
+        prefetchRequests.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool StretchRenderCache::hasRequests() const {
+    return requestReadPos.load(std::memory_order_relaxed) != requestWritePos.load(std::memory_order_acquire)
+        || !prefetchRequests.empty();
+}
+
+void StretchRenderCache::renderLoop() {
+    std::unique_lock<std::mutex> lock(workMutex);
+    while (running.load(std::memory_order_acquire)) {
+        releaseRetired();
+        Request request;
+        if (!takeRequest(request)) {
+            auto wake = [this] { return !running.load(std::memory_order_acquire) || hasRequests(); };
+            if (retired.empty()) {
+                workAvailable.wait(lock, wake);
+            } else {
+                // Evicted renders are freed once their voices let go, so look again shortly
+                workAvailable.wait_for(lock, RETIRED_RECHECK, wake);
+            }
+            continue;
+        }
+        lock.unlock();
+        processRequest(request);
+        lock.lock();
+    }
+}
+
+void StretchRenderCache::processRequest(Request& request) {
+    int index = -1;
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        index = claimEntry(request.key);
+    }
+    if (index < 0) {
+        return;  // Already rendered or being rendered
+    }
+    
+    SampleDataPtr rendered = render(*request.source, request.semitones, request.timeRatio);
+    request.source.reset();
+    
+    std::lock_guard<std::mutex> lock(workMutex);
+    Entry& entry = entries[index];
+    if (entry.key.load(std::memory_order_acquire) != request.key
+        || entry.state.load(std::memory_order_acquire) != Pending) {
+        return;  // Cleared while rendering
+    }
+    if (!rendered) {
+        entry.state.store(Failed, std::memory_order_release);
+        return;
+    }
+    
+    entry.bytes = (rendered->mono.size() + rendered->right.size()) * sizeof(float);
+    entry.data = std::move(rendered);  // No lookup copies it until state is Ready
+    entry.lastUsed.store(useClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    entry.state.store(Ready, std::memory_order_release);
+    bytesUsed += entry.bytes;
+    renders.fetch_add(1, std::memory_order_relaxed);
+    
+    enforceBudget(index);
+    bytesUsedPublished.store(bytesUsed, std::memory_order_relaxed);
+}
+
+int StretchRenderCache::claimEntry(uint64_t key) {
+    int freeIndex = -1;
+    int lruIndex = -1;
+    uint64_t lruTime = UINT64_MAX;
+    for (int i = 0; i < MAX_ENTRIES; ++i) {
+        int state = entries[i].state.load(std::memory_order_acquire);
+        if (state == Empty) {
+            if (freeIndex < 0) {
+                freeIndex = i;
+            }
+            continue;
+        }
+        if (entries[i].key.load(std::memory_order_acquire) == key) {
+            return -1;
+        }
+        uint64_t used = entries[i].lastUsed.load(std::memory_order_relaxed);
+        if (state != Pending && used < lruTime) {
+            lruTime = used;
+            lruIndex = i;
+        }
+    }
+    
+    if (freeIndex < 0) {
+        if (lruIndex < 0) {
+            return -1;  // Every entry is mid-render
+        }
+        evictEntry(lruIndex);
+        freeIndex = lruIndex;
+    }
+    
+    Entry& entry = entries[freeIndex];
+    entry.key.store(key, std::memory_order_release);
+    entry.state.store(Pending, std::memory_order_release);
+    return freeIndex;
+}
+
+void StretchRenderCache::evictEntry(int index) {
+    Entry& entry = entries[index];
+    bool wasReady = (entry.state.load(std::memory_order_acquire) == Ready);
+    entry.state.store(Empty, std::memory_order_seq_cst);
+    // A lookup that pinned the entry before it left Ready is still copying data (a few
+    // instructions); no new pin can copy it now
+    while (entry.readers.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    SampleDataPtr old = std::move(entry.data);
+    entry.data.reset();
+    entry.key.store(0, std::memory_order_release);
+    if (old) {
+        // A voice may still be playing it - free it here once the last voice lets go
+        retired.push_back(std::move(old));
+    }
+    if (wasReady) {
+        bytesUsed -= std::min(bytesUsed, entry.bytes);
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    entry.bytes = 0;
+    bytesUsedPublished.store(bytesUsed, std::memory_order_relaxed);
+}
+
+void StretchRenderCache::enforceBudget(int keepIndex) {
+    size_t budget = budgetBytes.load(std::memory_order_acquire);
+    while (bytesUsed > budget) {
+        int lruIndex = -1;
+        uint64_t lruTime = UINT64_MAX;
+        for (int i = 0; i < MAX_ENTRIES; ++i) {
+            if (i == keepIndex || entries[i].state.load(std::memory_order_acquire) != Ready) {
+                continue;
+            }
+            uint64_t used = entries[i].lastUsed.load(std::memory_order_relaxed);
+            if (used < lruTime) {
+                lruTime = used;
+                lruIndex = i;
+            }
+        }
+        if (lruIndex < 0) {
+            // Only the new render is left and it alone exceeds the budget
+            evictEntry(keepIndex);
+            break;
+        }
+        evictEntry(lruIndex);
+    }
+}
+
+void StretchRenderCache::releaseRetired() {
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [](const SampleDataPtr& data) { return data.use_count() <= 1; }),
+                  retired.end());
+}
+
+SampleDataPtr StretchRenderCache::render(const SampleData& source, float semitones, double timeRatio) {
+    double ratio = std::max(0.25, std::min(4.0, timeRatio));
+    int inLength = std::min(source.length, static_cast<int>(source.mono.size()));
+    int outLength = static_cast<int>(std::lround(static_cast<double>(inLength) / ratio));
+    if (inLength <= 0 || outLength <= 0) {
+        return nullptr;
+    }
+    
+    // Same analysis settings as the live path (SignalsmithStretchWrapper) so cached and
+    // live voices sound alike; mono, because voices only read the mono channel
+    float sampleRate = static_cast<float>(source.sourceSampleRate);
+    signalsmith::stretch::SignalsmithStretch<float> stretch;
+    stretch.configure(1, static_cast<int>(sampleRate * 0.15f), static_cast<int>(sampleRate * 0.02f), false);
+    stretch.setTransposeSemitones(std::max(-24.0f, std::min(24.0f, semitones)));
+    
+    auto rendered = std::make_shared<SampleData>();
+    rendered->mono.assign(static_cast<size_t>(outLength), 0.0f);
+    const float* input[1] = { source.mono.data() };
+    float* output[1] = { rendered->mono.data() };
+    // exact() compensates the stretcher's latency, so sample positions line up with the source
+    if (!stretch.exact(input, inLength, output, outLength)) {
+        return nullptr;  // Shorter than one analysis block
+    }
+    rendered->length = outLength;
+    rendered->sourceSampleRate = source.sourceSampleRate;
+    return rendered;
+}
+
+} // namespace Core
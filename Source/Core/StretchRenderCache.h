@@ -0,0 +1,161 @@
+#pragma once
+
+#include "SampleData.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core {
+
+/**
+ * Background cache of pre-rendered time-stretched/pitched samples
+ * Portable C++ - no JUCE dependencies
+ *
+ * With fixed warp settings a voice's stretch output is deterministic, so instead of
+ * running the phase vocoder live for every note, each distinct (sample, semitones,
+ * time ratio) is rendered once offline on a background thread and voices play the
+ * result as an ordinary sample. Renders are requested lazily by lookup() on the
+ * audio thread (the voice stretches live until the render is ready) or up front
+ * with prefetch() for a key range.
+ *
+ * lookup() never locks or allocates: it pins an entry with a reader count and copies
+ * the render's shared_ptr, and eviction waits for the pin to drop before releasing
+ * it. Render memory is capped by a byte budget; least recently used renders are
+ * evicted first, and their memory is freed on the render thread once no voice still
+ * plays them. Idle render threads sleep on a condition variable.
+ */
+class StretchRenderCache {
+public:
+    static constexpr int MAX_ENTRIES = 64;
+    static constexpr int REQUEST_CAPACITY = 64;  // Power of 2 - pending lazy render requests
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 128u * 1024u * 1024u;
+    
+    struct Stats {
+        uint64_t hits;          // Note-ons served from a finished render
+        uint64_t misses;        // Note-ons that fell back to live stretching
+        uint64_t renders;       // Renders completed
+        uint64_t evictions;     // Renders dropped to stay within the budget
+        size_t bytesUsed;       // Memory held by finished renders
+    };
+    
+    StretchRenderCache();
+    ~StretchRenderCache();
+    
+    StretchRenderCache(const StretchRenderCache&) = delete;
+    StretchRenderCache& operator=(const StretchRenderCache&) = delete;
+    
+    /**
+     * Start the render threads (no-op if already running). Not real-time safe
+     */
+    void start(int numThreads = 1);
+    
+    /**
+     * Stop and join the render threads. Not real-time safe
+     */
+    void stop();
+    
+    /**
+     * Enable or disable cache lookups (thread-safe); disabled lookups always miss
+     */
+    void setEnabled(bool enabled) { enabledFlag.store(enabled, std::memory_order_release); }
+    bool isEnabled() const { return enabledFlag.load(std::memory_order_acquire); }
+    
+    /**
+     * Memory budget for finished renders (thread-safe, applied after the next render)
+     */
+    void setBudgetBytes(size_t bytes) { budgetBytes.store(bytes, std::memory_order_release); }
+    
+    /**
+     * Finished render of source at the given pitch/ratio, or nullptr (audio thread)
+     * A miss queues a render request; the caller should process live meanwhile
+     * The rendered sample has the same rate as source and length / timeRatio frames
+     */
+    SampleDataPtr lookup(const SampleDataPtr& source, float semitones, double timeRatio);
+    
+    /**
+     * Queue renders for notes lowNote..highNote relative to rootNote (message thread)
+     */
+    void prefetch(const SampleDataPtr& source, float repitchSemitones, double timeRatio,
+                  int rootNote, int lowNote, int highNote);
+    
+    /**
+     * Drop all renders and pending requests (message thread)
+     */
+    void clear();
+    
+    Stats getStats() const;
+
+private:
+    enum EntryState : int {
+        Empty = 0,
+        Pending,   // Claimed by a render thread
+        Ready,     // data holds the render
+        Failed     // Sample too short to stretch - callers stay on live processing
+    };
+    
+    struct Entry {
+        std::atomic<uint64_t> key{0};
+        std::atomic<int> state{Empty};
+        std::atomic<uint64_t> lastUsed{0};
+        std::atomic<int> readers{0};  // lookup() calls currently copying data
+        SampleDataPtr data;  // Set before state becomes Ready; reset only with state Empty and no readers
+        size_t bytes = 0;    // Render threads only
+    };
+    
+    struct Request {
+        SampleDataPtr source;
+        float semitones = 0.0f;
+        double timeRatio = 1.0;
+        uint64_t key = 0;
+    };
+    
+    std::array<Entry, MAX_ENTRIES> entries;
+    
+    // Lazy requests: single producer (audio thread), consumed by render threads under workMutex
+    std::array<Request, REQUEST_CAPACITY> requests;
+    std::atomic<uint32_t> requestWritePos{0};
+    std::atomic<uint32_t> requestReadPos{0};
+    
+    // Render threads only (guarded by workMutex)
+    std::mutex workMutex;
+    std::condition_variable workAvailable;  // Requests queued, or stop
+    std::deque<Request> prefetchRequests;
+    std::vector<SampleDataPtr> retired;  // Evicted renders still referenced by a voice
+    size_t bytesUsed;
+    
+    std::vector<std::thread> threads;
+    std::atomic<bool> running{false};
+    std::atomic<bool> enabledFlag{true};
+    std::atomic<size_t> budgetBytes{DEFAULT_BUDGET_BYTES};
+    std::atomic<uint64_t> useClock{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> renders{0};
+    std::atomic<uint64_t> evictions{0};
+    std::atomic<size_t> bytesUsedPublished{0};
+    
+    static uint64_t makeKey(const SampleData& source, float semitones, double timeRatio);
+    static SampleDataPtr render(const SampleData& source, float semitones, double timeRatio);
+    
+    bool pushRequest(const SampleDataPtr& source, float semitones, double timeRatio, uint64_t key);
+    bool takeRequest(Request& request);  // workMutex held
+    bool hasRequests() const;            // workMutex held
+    
+    // Copy a Ready entry's render if it still holds key (audio thread, lock-free)
+    static SampleDataPtr pinAndCopy(Entry& entry, uint64_t key);
+    
+    void renderLoop();
+    void processRequest(Request& request);
+    int claimEntry(uint64_t key);                     // workMutex held; -1 if already cached/pending
+    void evictEntry(int index);                       // workMutex held
+    void enforceBudget(int keepIndex);                // workMutex held
+    void releaseRetired();                            // workMutex held
+};
+
+} // namespace Core
@@ -0,0 +1,328 @@
+#include "TelemetrySegment.h"
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OP1_TELEMETRY_SHM 1
+#else
+#define OP1_TELEMETRY_SHM 0
+#endif
+
+#if defined(__linux__)
+#include <cstring>
+#include <dirent.h>
+#endif
+
+namespace Core {
+
+// The segment is shared with other processes: every field must be a plain lock-free word
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "telemetry needs lock-free 64-bit atomics");
+static_assert(std::atomic<double>::is_always_lock_free, "telemetry needs lock-free double atomics");
+static_assert(std::atomic<float>::is_always_lock_free, "telemetry needs lock-free float atomics");
+static_assert(std::is_standard_layout<TelemetryLayout>::value, "telemetry layout must be standard layout");
+
+namespace {
+
+// Seqlock readers give up after this many torn reads (writer died mid-update)
+constexpr int MAX_READ_ATTEMPTS = 1000;
+
+std::atomic<int> instanceCounter{0};
+
+std::string normaliseName(const std::string& name) {
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+
+template <typename T>
+void put(std::atomic<T>& field, T value) {
+    field.store(value, std::memory_order_relaxed);
+}
+
+template <typename T>
+T get(const std::atomic<T>& field) {
+    return field.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+TelemetryPublisher::~TelemetryPublisher() {
+    close();
+}
+
+std::string TelemetryPublisher::makeDefaultName() {
+#if OP1_TELEMETRY_SHM
+    const int pid = static_cast<int>(getpid());
+#else
+    const int pid = 0;
+#endif
+    return "/" + std::string(NAME_PREFIX) + std::to_string(pid) + "-"
+        + std::to_string(instanceCounter.fetch_add(1, std::memory_order_relaxed));
+}
+
+bool TelemetryPublisher::open(const std::string& segmentName) {
+    close();
+#if OP1_TELEMETRY_SHM
+    const std::string fullName = segmentName.empty() ? makeDefaultName() : normaliseName(segmentName);
+    
+    // Replace a stale segment of the same name (e.g. left by a crashed process)
+    shm_unlink(fullName.c_str());
+    int fd = shm_open(fullName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(sizeof(TelemetryLayout))) != 0) {
+        ::close(fd);
+        shm_unlink(fullName.c_str());
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(TelemetryLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(fullName.c_str());
+        return false;
+    }
+    
+    // ftruncate zero-fills: every counter and sequence starts at 0
+    auto* layout = new (memory) TelemetryLayout;
+    layout->version = TelemetryLayout::VERSION;
+    layout->size = static_cast<uint32_t>(sizeof(TelemetryLayout));
+    layout->pid = static_cast<int32_t>(getpid());
+    layout->magic.store(TelemetryLayout::MAGIC, std::memory_order_release);
+    
+    name = fullName;
+    segment.store(layout, std::memory_order_release);
+    return true;
+#else
+    (void) segmentName;
+    return false;
+#endif
+}
+
+void TelemetryPublisher::close() {
+    TelemetryLayout* layout = segment.exchange(nullptr, std::memory_order_acq_rel);
+    if (layout == nullptr) {
+        return;
+    }
+#if OP1_TELEMETRY_SHM
+    munmap(layout, sizeof(TelemetryLayout));
+    shm_unlink(name.c_str());
+#endif
+    name.clear();
+}
+
+void TelemetryPublisher::publishBlock(const TelemetryStatus& status) {
+    TelemetryLayout* layout = segment.load(std::memory_order_acquire);
+    if (layout == nullptr) {
+        return;
+    }
+    
+    // Cumulative histogram first: it is not part of the seqlock
+    const int bin = std::min(TelemetryLayout::LOAD_BINS - 1, static_cast<int>(status.load * 100.0f));
+    auto& binCount = layout->loadHistogram[std::max(0, bin)];
+    put(binCount, get(binCount) + 1);
+    
+    // Single writer: open the record (odd), store, close it (even)
+    const uint32_t sequence = get(layout->statusSequence);
+    put(layout->statusSequence, sequence + 1);
+    std::atomic_thread_fence(std::memory_order_release);
+    put(layout->blocks, get(layout->blocks) + 1);
+    put(layout->frames, get(layout->frames) + static_cast<uint64_t>(std::max(0, status.blockSize)));
+    put(layout->sampleRate, status.sampleRate);
+    put(layout->blockSize, status.blockSize);
+    put(layout->activeVoices, status.activeVoices);
+    put(layout->blockPeak, status.blockPeak);
+    put(layout->clippedSamples, status.clippedSamples);
+    put(layout->clippedTotal, get(layout->clippedTotal) + static_cast<uint64_t>(std::max(0, status.clippedSamples)));
+    put(layout->voicesStolen, status.voicesStolen);
+    put(layout->droppedNotes, status.droppedNotes);
+    put(layout->load, status.load);
+    put(layout->maxLoad, status.maxLoad);
+    put(layout->overruns, status.overruns);
+    put(layout->qualityLevel, status.qualityLevel);
+    layout->statusSequence.store(sequence + 2, std::memory_order_release);
+}
+
+void TelemetryPublisher::publishPop(const TelemetryPop& pop) {
+    TelemetryLayout* layout = segment.load(std::memory_order_acquire);
+    if (layout == nullptr) {
+        return;
+    }
+    
+    const uint64_t index = get(layout->popCount);
+    auto& record = layout->pops[index % TelemetryLayout::POP_RECORDS];
+    const uint32_t sequence = get(record.sequence);
+    put(record.sequence, sequence + 1);
+    std::atomic_thread_fence(std::memory_order_release);
+    put(record.index, index);
+    put(record.frame, pop.frame);
+    put(record.mixDelta, pop.mixDelta);
+    put(record.mixPeak, pop.mixPeak);
+    record.sequence.store(sequence + 2, std::memory_order_release);
+    layout->popCount.store(index + 1, std::memory_order_release);
+}
+
+TelemetryReader::~TelemetryReader() {
+    close();
+}
+
+bool TelemetryReader::open(const std::string& segmentName) {
+    close();
+#if OP1_TELEMETRY_SHM
+    const std::string fullName = normaliseName(segmentName);
+    int fd = shm_open(fullName.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        error = "no telemetry segment " + fullName;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(offsetof(TelemetryLayout, statusSequence))) {
+        ::close(fd);
+        error = fullName + " is not a telemetry segment";
+        return false;
+    }
+    const size_t bytes = static_cast<size_t>(info.st_size);
+    void* memory = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        error = "cannot map " + fullName;
+        return false;
+    }
+    
+    const auto* layout = static_cast<const TelemetryLayout*>(memory);
+    if (layout->magic.load(std::memory_order_acquire) != TelemetryLayout::MAGIC) {
+        error = fullName + " is not a telemetry segment (or is still being created)";
+    } else if (layout->version != TelemetryLayout::VERSION || layout->size != sizeof(TelemetryLayout)
+               || bytes < sizeof(TelemetryLayout)) {
+        error = fullName + " has layout version " + std::to_string(layout->version)
+            + ", this monitor reads version " + std::to_string(TelemetryLayout::VERSION);
+    } else {
+        segment = layout;
+        mappedBytes = bytes;
+        error.clear();
+        return true;
+    }
+    munmap(memory, bytes);
+    return false;
+#else
+    (void) segmentName;
+    error = "shared-memory telemetry is not supported on this platform";
+    return false;
+#endif
+}
+
+void TelemetryReader::close() {
+#if OP1_TELEMETRY_SHM
+    if (segment != nullptr) {
+        munmap(const_cast<TelemetryLayout*>(segment), mappedBytes);
+    }
+#endif
+    segment = nullptr;
+    mappedBytes = 0;
+}
+
+int TelemetryReader::getWriterPid() const {
+    return segment != nullptr ? segment->pid : 0;
+}
+
+bool TelemetryReader::isWriterAlive() const {
+#if OP1_TELEMETRY_SHM
+    const int pid = getWriterPid();
+    return pid > 0 && (kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+#else
+    return segment != nullptr;
+#endif
+}
+
+bool TelemetryReader::readStatus(TelemetryStatus& out) const {
+    if (segment == nullptr) {
+        return false;
+    }
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        const uint32_t before = segment->statusSequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0) {
+            continue;
+        }
+        TelemetryStatus copy;
+        copy.blocks = get(segment->blocks);
+        copy.frames = get(segment->frames);
+        copy.sampleRate = get(segment->sampleRate);
+        copy.blockSize = get(segment->blockSize);
+        copy.activeVoices = get(segment->activeVoices);
+        copy.blockPeak = get(segment->blockPeak);
+        copy.clippedSamples = get(segment->clippedSamples);
+        copy.clippedTotal = get(segment->clippedTotal);
+        copy.voicesStolen = get(segment->voicesStolen);
+        copy.droppedNotes = get(segment->droppedNotes);
+        copy.load = get(segment->load);
+        copy.maxLoad = get(segment->maxLoad);
+        copy.overruns = get(segment->overruns);
+        copy.qualityLevel = get(segment->qualityLevel);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (get(segment->statusSequence) == before) {
+            out = copy;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TelemetryReader::readLoadHistogram(uint64_t* out) const {
+    for (int bin = 0; bin < TelemetryLayout::LOAD_BINS; ++bin) {
+        out[bin] = segment != nullptr ? get(segment->loadHistogram[bin]) : 0;
+    }
+}
+
+uint64_t TelemetryReader::readPops(uint64_t sinceCount, std::vector<TelemetryPop>& out) const {
+    if (segment == nullptr) {
+        return sinceCount;
+    }
+    const uint64_t count = segment->popCount.load(std::memory_order_acquire);
+    const uint64_t oldest = count > TelemetryLayout::POP_RECORDS ? count - TelemetryLayout::POP_RECORDS : 0;
+    for (uint64_t index = std::max(sinceCount, oldest); index < count; ++index) {
+        const auto& record = segment->pops[index % TelemetryLayout::POP_RECORDS];
+        for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+            const uint32_t before = record.sequence.load(std::memory_order_acquire);
+            if ((before & 1u) != 0) {
+                continue;
+            }
+            TelemetryPop pop;
+            pop.index = get(record.index);
+            pop.frame = get(record.frame);
+            pop.mixDelta = get(record.mixDelta);
+            pop.mixPeak = get(record.mixPeak);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (get(record.sequence) == before) {
+                if (pop.index == index) {  // Otherwise already overwritten by a newer pop
+                    out.push_back(pop);
+                }
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+std::vector<std::string> TelemetryReader::listSegments() {
+    std::vector<std::string> names;
+#if defined(__linux__)
+    if (DIR* dir = opendir("/dev/shm")) {
+        const size_t prefixLength = std::strlen(TelemetryPublisher::NAME_PREFIX);
+        while (dirent* entry = readdir(dir)) {
+            if (std::strncmp(entry->d_name, TelemetryPublisher::NAME_PREFIX, prefixLength) == 0) {
+                names.push_back("/" + std::string(entry->d_name));
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(names.begin(), names.end());
+#endif
+    return names;
+}
+
+} // namespace Core
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "CallbackLoadMeter.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The plugin publishes telemetry from construction only when built with OP1_TELEMETRY=1
+// (CMake option OP1_TELEMETRY, off by default); the classes below are always available
+#ifndef OP1_TELEMETRY
+#define OP1_TELEMETRY 0
+#endif
+
+namespace Core {
+
+/**
+ * One block's engine instrumentation, as published to and read from the telemetry segment
+ */
+struct TelemetryStatus {
+    uint64_t blocks = 0;          // Since the segment was opened (counted by the publisher)
+    uint64_t frames = 0;          // Since the segment was opened (counted by the publisher)
+    double sampleRate = 0.0;
+    int32_t blockSize = 0;        // Last block
+    int32_t activeVoices = 0;
+    float blockPeak = 0.0f;       // Pre-limiter peak of the last block
+    int32_t clippedSamples = 0;   // Samples above 1.0 in the last block
+    uint64_t clippedTotal = 0;    // Since the segment was opened (counted by the publisher)
+    int32_t voicesStolen = 0;     // Cumulative
+    int32_t droppedNotes = 0;     // Cumulative
+    float load = 0.0f;            // Last block's load (1.0 = deadline)
+    float maxLoad = 0.0f;         // Since the load meter's last reset
+    uint64_t overruns = 0;        // Since the load meter's last reset
+    int32_t qualityLevel = 0;     // QualityLevel the governor has applied (0 = full)
+};
+
+/**
+ * One pop detector event as kept in the segment
+ */
+struct TelemetryPop {
+    uint64_t index = 0;           // Pop number since the segment was opened
+    uint64_t frame = 0;           // Engine frame counter at the block that popped
+    float mixDelta = 0.0f;        // Largest sample-to-sample step
+    float mixPeak = 0.0f;
+};
+
+/**
+ * Layout of the shared-memory segment (version VERSION)
+ * Plain fixed-size data so another process can map it: the header is written once, the
+ * status record and each pop record are seqlocks (odd sequence = write in progress), and
+ * the load histogram holds cumulative per-bin block counts. Every field the audio thread
+ * writes is a relaxed lock-free atomic, which is a plain store on the supported targets
+ */
+struct TelemetryLayout {
+    static constexpr uint32_t MAGIC = 0x5431504f;  // "OP1T"
+    static constexpr uint32_t VERSION = 2;
+    static constexpr int LOAD_BINS = CallbackLoadMeter::NUM_BINS;  // 1% bins, last is >= 200%
+    static constexpr int POP_RECORDS = 32;
+    
+    struct PopRecord {
+        std::atomic<uint32_t> sequence;
+        std::atomic<uint64_t> index;
+        std::atomic<uint64_t> frame;
+        std::atomic<float> mixDelta;
+        std::atomic<float> mixPeak;
+    };
+    
+    // Header (magic is stored last, once the rest is initialised, then everything is constant)
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t size;                // sizeof(TelemetryLayout) of the writer
+    int32_t pid;
+    
+    // Status seqlock
+    std::atomic<uint32_t> statusSequence;
+    std::atomic<uint64_t> blocks;
+    std::atomic<uint64_t> frames;
+    std::atomic<double> sampleRate;
+    std::atomic<int32_t> blockSize;
+    std::atomic<int32_t> activeVoices;
+    std::atomic<float> blockPeak;
+    std::atomic<int32_t> clippedSamples;
+    std::atomic<uint64_t> clippedTotal;
+    std::atomic<int32_t> voicesStolen;
+    std::atomic<int32_t> droppedNotes;
+    std::atomic<float> load;
+    std::atomic<float> maxLoad;
+    std::atomic<uint64_t> overruns;
+    std::atomic<int32_t> qualityLevel;
+    
+    // Cumulative blocks per load bin (single writer, readers difference two snapshots)
+    std::atomic<uint64_t> loadHistogram[LOAD_BINS];
+    
+    // Pop events: record (popCount - 1) % POP_RECORDS is the newest
+    std::atomic<uint64_t> popCount;
+    PopRecord pops[POP_RECORDS];
+};
+
+/**
+ * Writer side: owns the segment and publishes from the audio thread
+ *
+ * open/close create and remove the segment (message thread). publishBlock and publishPop
+ * are audio-thread only: a sequence bump, the field stores and a closing bump - no
+ * syscalls, no allocation. POSIX shared memory only; elsewhere open() returns false and
+ * publishing is a no-op
+ */
+class TelemetryPublisher {
+public:
+    TelemetryPublisher() = default;
+    ~TelemetryPublisher();
+    
+    TelemetryPublisher(const TelemetryPublisher&) = delete;
+    TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+    
+    // Create (or replace) the segment; empty name = makeDefaultName()
+    // open and close must not overlap a publish call - use them while audio is stopped
+    bool open(const std::string& name = std::string());
+    void close();
+    bool isOpen() const { return segment.load(std::memory_order_acquire) != nullptr; }
+    const std::string& getName() const { return name; }
+    
+    // blocks, frames and clippedTotal are accumulated here; the fields in status are ignored
+    void publishBlock(const TelemetryStatus& status);
+    // index is assigned here
+    void publishPop(const TelemetryPop& pop);
+    
+    // "/op1clone-<pid>-<n>", n counting instances within the process
+    static std::string makeDefaultName();
+    
+    // Segment name prefix, for monitors that list segments
+    static constexpr const char* NAME_PREFIX = "op1clone-";
+
+private:
+    std::atomic<TelemetryLayout*> segment{nullptr};
+    std::string name;
+};
+
+/**
+ * Reader side (monitor process): maps a segment read-only and takes consistent snapshots
+ */
+class TelemetryReader {
+public:
+    TelemetryReader() = default;
+    ~TelemetryReader();
+    
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+    
+    // Map a segment; fails on a missing segment or a magic/version/size mismatch (see getError)
+    bool open(const std::string& name);
+    void close();
+    const std::string& getError() const { return error; }
+    
+    int getWriterPid() const;
+    bool isWriterAlive() const;
+    
+    // Consistent copy of the status record (retries while the writer is mid-update)
+    bool readStatus(TelemetryStatus& out) const;
+    
+    // Cumulative per-bin block counts (LOAD_BINS entries)
+    void readLoadHistogram(uint64_t* out) const;
+    
+    // Pops with index >= sinceCount (at most POP_RECORDS back); returns the new pop count
+    uint64_t readPops(uint64_t sinceCount, std::vector<TelemetryPop>& out) const;
+    
+    // Segments currently present (Linux: /dev/shm; empty where shm cannot be listed)
+    static std::vector<std::string> listSegments();
+
+private:
+    const TelemetryLayout* segment = nullptr;
+    size_t mappedBytes = 0;
+    std::string error;
+};
+
+} // namespace Core
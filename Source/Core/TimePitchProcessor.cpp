@@ -2,7 +2,8 @@
 #include "TimePitchError.h"
 #include <algorithm>
 #include <cstring>
-#include <cfloat>  // For isfinite
+#include <cfloat>
+#include <cmath>   // For std::isfinite
 
 namespace Core {
 
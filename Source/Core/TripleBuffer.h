@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace Core {
+
+/**
+ * Lock-free triple buffer for publishing POD state
+ * Portable C++ - no JUCE dependencies
+ * Single writer (UI thread), single reader (audio thread)
+ *
+ * The writer fills its private back buffer and publishes it by swapping with the
+ * shared middle buffer; the reader swaps the middle buffer into its front buffer
+ * when a new value is flagged. Neither side ever waits, and the reader always sees
+ * a complete value (no tearing) because no buffer is written while it can be read.
+ */
+template <typename T>
+class TripleBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "TripleBuffer requires a trivially copyable (POD) type");
+
+public:
+    TripleBuffer()
+        : writeIndex(0)
+        , readIndex(2)
+    {
+        middle.store(1, std::memory_order_relaxed);
+    }
+    
+    explicit TripleBuffer(const T& initial)
+        : TripleBuffer()
+    {
+        for (auto& b : buffers) {
+            b.value = initial;
+        }
+    }
+    
+    /**
+     * Copy value into the back buffer and publish it (writer thread only)
+     */
+    void write(const T& value) {
+        buffers[writeIndex].value = value;
+        publish();
+    }
+    
+    /**
+     * Writer's private buffer - modify in place, then call publish() (writer thread only)
+     */
+    T& getWriteBuffer() { return buffers[writeIndex].value; }
+    
+    /**
+     * Publish the back buffer (writer thread only)
+     */
+    void publish() {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(writeIndex | NEW_DATA), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+    
+    /**
+     * Acquire the latest published value (reader thread only)
+     * Returned reference stays valid and unchanged until the next read() call
+     */
+    const T& read() {
+        if (middle.load(std::memory_order_relaxed) & NEW_DATA) {
+            uint8_t previous = middle.exchange(static_cast<uint8_t>(readIndex), std::memory_order_acq_rel);
+            readIndex = previous & INDEX_MASK;
+        }
+        return buffers[readIndex].value;
+    }
+    
+    /**
+     * Value returned by the last read() (reader thread only)
+     */
+    const T& current() const { return buffers[readIndex].value; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t NEW_DATA = 0x4;
+    
+    // Separate cache lines so writer and reader never share a line
+    struct alignas(64) Slot {
+        T value{};
+    };
+    
+    Slot buffers[3];
+    alignas(64) std::atomic<uint8_t> middle;  // Index of shared buffer + NEW_DATA flag
+    alignas(64) uint8_t writeIndex;           // Writer thread only
+    alignas(64) uint8_t readIndex;            // Reader thread only
+};
+
+} // namespace Core
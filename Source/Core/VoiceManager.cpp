@@ -1,15 +1,35 @@
 #include "VoiceManager.h"
+#include "StageProfiler.h"
 #include <algorithm>
-#include <fstream>
-#include <chrono>
 
 namespace Core {
 
 VoiceManager::VoiceManager()
-    : nextVoiceIndex(0)
+    : noteOnCounter(0)
+    , nextVoiceIndex(0)
     , isPolyphonicMode(true)
+    , heldVoiceLimit(MAX_VOICES)
+    , liveWarpEnabled(true)
+    , warpPool(nullptr)
+    , stretchCache(nullptr)
+    , warpMode(false)
+    , renderPool(nullptr)
+    , laneCapacity(0)
+    , laneChannels(0)
+    , blendWeightsSet(false)
+    , renderNumChannels(0)
+    , renderNumSamples(0)
+    , renderSampleRate(44100.0)
 {
     voicesStartedThisBlock = 0;
+    voiceStartOrder.fill(0);
+    voicePriority.fill(0);
+    voiceBlendGroup.fill(-1);
+    blendWeights.fill(nullptr);
+    renderOrder.fill(0);
+    for (auto& lane : lanes) {
+        lane.fill(nullptr);
+    }
 }
 
 VoiceManager::~VoiceManager() {
@@ -31,49 +51,172 @@ void VoiceManager::setRootNote(int rootNote) {
 
 
 
-int VoiceManager::allocateVoice() {
-    // First, try to find a free voice (not active)
-    // Search through all voices to find an inactive one
-    for (int i = 0; i < MAX_VOICES; ++i) {
-        int idx = (nextVoiceIndex + i) % MAX_VOICES;
-        if (!voices[idx].isActive()) {
-            nextVoiceIndex = (idx + 1) % MAX_VOICES;
+int VoiceManager::findFreeVoice() {
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        int idx = (nextVoiceIndex + i) % POOL_SIZE;
+        if (!voices[idx].isPlaying()) {
+            nextVoiceIndex = (idx + 1) % POOL_SIZE;
             return idx;
         }
     }
+    return -1;
+}
+
+int VoiceManager::findVoiceForNote(int note, int blendGroup) const {
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        if (voices[i].isPlaying() && !voices[i].isFadingAfterSteal() && voices[i].getCurrentNote() == note
+            && voiceBlendGroup[i] == blendGroup) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int VoiceManager::countHeldVoices(int blendGroup) const {
+    int count = 0;
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        if (voices[i].isPlaying() && !voices[i].isFadingAfterSteal() && voiceBlendGroup[i] == blendGroup) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int VoiceManager::allocateVoice(int note, int blendGroup, bool& wasStolen) {
+    wasStolen = false;
     
-    // All voices active - try to find a voice in release phase to steal (less disruptive)
-    for (int i = 0; i < MAX_VOICES; ++i) {
-        int idx = (nextVoiceIndex + i) % MAX_VOICES;
-        if (voices[idx].isInRelease()) {
-            // Steal this voice that's already releasing
-            nextVoiceIndex = (idx + 1) % MAX_VOICES;
-            return idx;
+    // First, a free voice while under the group's held-voice limit
+    int freeIndex = findFreeVoice();
+    int heldCount = countHeldVoices(blendGroup);
+    if (freeIndex >= 0 && heldCount < heldVoiceLimit) {
+        return freeIndex;
+    }
+    
+    // Steal: candidates are the held voices when at the limit; otherwise the pool is
+    // full of fading tails and the least disruptive tail is cut short
+    bool stealHeld = (heldCount >= heldVoiceLimit);
+    VoiceSlotInfo candidates[POOL_SIZE];
+    int candidateIndex[POOL_SIZE];
+    int numCandidates = 0;
+    
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        const SamplerVoice& voice = voices[i];
+        if (!voice.isPlaying() || voice.isFadingAfterSteal() == stealHeld) {
+            continue;
         }
+        if (stealHeld && voiceBlendGroup[i] != blendGroup) {
+            continue;  // A note only displaces held notes of its own group
+        }
+        VoiceSlotInfo& info = candidates[numCandidates];
+        info.playing = true;
+        info.inRelease = voice.isInRelease();
+        info.envelope = voice.getEnvelopeValue();
+        info.note = voice.getCurrentNote();
+        info.startOrder = voiceStartOrder[i];
+        info.priority = voicePriority[i];
+        candidateIndex[numCandidates] = i;
+        numCandidates++;
     }
     
-    // No voices in release - steal the quietest voice (lowest envelope value)
-    // This minimizes audible artifacts when stealing
-    int quietestIdx = -1;
-    float quietestEnvelope = 1.0f;
+    if (numCandidates == 0) {
+        return freeIndex >= 0 ? freeIndex : nextVoiceIndex;
+    }
     
-    for (int i = 0; i < MAX_VOICES; ++i) {
-        int idx = (nextVoiceIndex + i) % MAX_VOICES;
-        float env = voices[idx].getEnvelopeValue();
-        if (env < quietestEnvelope) {
-            quietestIdx = idx;
-            quietestEnvelope = env;
+    int victim = candidateIndex[stealer.chooseVictim(candidates, numCandidates, note)];
+    nextVoiceIndex = (victim + 1) % POOL_SIZE;
+    
+    if (stealHeld) {
+        wasStolen = true;
+        stealStats.steals++;
+        
+        // Hand the stolen note's fade-out to a tail voice - the new note starts now on a fresh voice
+        if (freeIndex >= 0) {
+            voices[victim].startFastRelease(STEAL_FADE_MS);
+            stealStats.tailHandoffs++;
+            return freeIndex;
         }
+        stealStats.tailMisses++;
     }
     
-    if (quietestIdx == -1) {
-        quietestIdx = nextVoiceIndex;
+    // Held note with no idle tail, or a fading tail cut short - restart the victim in place
+    // (safety ramp restarts from 0, slew limiter smooths the cut)
+    return victim;
+}
+
+int VoiceManager::retriggerVoice(int heldIndex) {
+    // Same note retriggered while audible: fade the old note on a tail voice instead of cutting it
+    int freeIndex = findFreeVoice();
+    if (freeIndex >= 0) {
+        voices[heldIndex].startFastRelease(STEAL_FADE_MS);
+        stealStats.tailHandoffs++;
+        return freeIndex;
+    }
+    // Pool exhausted - retrigger in place (noteOn ramps in from 0)
+    return heldIndex;
+}
+
+bool VoiceManager::validateSampleData(const SampleDataPtr& sampleData) {
+    if (!sampleData || sampleData->length <= 0 || 
+        sampleData->mono.empty() || sampleData->mono.data() == nullptr) {
+        stealStats.droppedNotes++;
+        return false;
     }
+    return true;
+}
+
+void VoiceManager::markVoiceStarted(int voiceIndex, int priority, int blendGroup) {
+    voiceStartOrder[voiceIndex] = noteOnCounter++;
+    voicePriority[voiceIndex] = priority;
+    voiceBlendGroup[voiceIndex] = blendGroup;
     
-    // Start fade-out on stolen voice (don't hard-cut)
-    voices[quietestIdx].startStealFadeOut();
-    nextVoiceIndex = (quietestIdx + 1) % MAX_VOICES;
-    return quietestIdx;
+    // Warp settings are fixed per note, so a finished render plays back as an ordinary sample
+    // (voices always stretch at constant duration - time ratio 1.0)
+    SamplerVoice& voice = voices[voiceIndex];
+    if (stretchCache != nullptr && voice.isWarpEnabled()) {
+        float semitones = static_cast<float>(voice.getCurrentNote() - voice.getRootNote()) + voice.getRepitch();
+        SampleDataPtr rendered = stretchCache->lookup(voice.getSampleData(), semitones, 1.0);
+        if (rendered) {
+            voice.setPrerenderedSample(std::move(rendered));
+            return;  // Any lease it still holds goes back to the pool after this block
+        }
+    }
+    
+    // Check a stretcher out for the new note (a retriggered voice keeps the one it has)
+    if (warpPool != nullptr && liveWarpEnabled && voice.isWarpEnabled() && !voice.hasWarpLease()) {
+        WarpProcessorPool::Lease* lease = warpPool->acquire();
+        if (lease != nullptr) {
+            voice.attachWarpLease(lease, warpPool->getSampleRate());
+        }
+    }
+}
+
+void VoiceManager::setWarpProcessorPool(WarpProcessorPool* pool) {
+    for (auto& voice : voices) {
+        voice.detachWarpLease();
+    }
+    warpPool = pool;
+    updateLatencyCompensation();
+}
+
+void VoiceManager::updateLatencyCompensation() {
+    int latency = (warpMode && warpPool != nullptr) ? warpPool->getLatencyFrames() : 0;
+    for (auto& voice : voices) {
+        voice.setLatencyCompensation(latency);
+    }
+    latencySamples.store(latency, std::memory_order_relaxed);
+}
+
+void VoiceManager::returnWarpLeases() {
+    if (warpPool == nullptr) {
+        return;
+    }
+    for (auto& voice : voices) {
+        if (voice.canReturnWarpLease()) {
+            warpPool->release(voice.detachWarpLease());
+        }
+    }
+    // Amortise processor resets: at most one per block, off the note-on path
+    warpPool->maintain();
 }
 
 void VoiceManager::noteOn(int note, float velocity) {
@@ -88,6 +231,8 @@ bool VoiceManager::noteOn(int note, float velocity, SampleDataPtr sampleData, bo
 }
 
 bool VoiceManager::noteOn(int note, float velocity, SampleDataPtr sampleData, bool& wasStolen, int startDelayOffset) {
+    wasStolen = false;
+    
     // In mono mode, turn off all currently playing voices
     if (!isPolyphonicMode) {
         for (auto& voice : voices) {
@@ -97,64 +242,50 @@ bool VoiceManager::noteOn(int note, float velocity, SampleDataPtr sampleData, bo
         }
     }
     
-    // CRITICAL: Check if there's already a voice that was playing this exact note
-    // If so, retrigger that voice (restart from beginning) instead of allocating a new one
+    // Set sample data snapshot before triggering note
+    // Comprehensive validation before allocating (never steal a voice for a note that cannot sound)
+    if (!validateSampleData(sampleData)) {
+        // No valid sample - voice will remain inactive
+        return false; // Don't trigger note if no valid sample
+    }
+    
+    // CRITICAL: Check if there's already a voice holding this exact note
+    // If so, retrigger (restart from beginning) instead of allocating a new one
     // This provides true retrigger behavior for rapid key presses
-    // Check both active voices and voices in release phase (recently played this note)
-    for (int i = 0; i < MAX_VOICES; ++i) {
-        if (voices[i].getCurrentNote() == note) {
-            // Found a voice that was playing this note (active or in release) - retrigger it
-            voices[i].setSampleData(sampleData);
-            voices[i].noteOn(note, velocity, startDelayOffset);
-            wasStolen = false; // Not stolen, just retriggered
-            return true;
-        }
+    int heldIndex = findVoiceForNote(note);
+    if (heldIndex >= 0) {
+        int voiceIndex = retriggerVoice(heldIndex);
+        voices[voiceIndex].setSampleData(sampleData);
+        voices[voiceIndex].noteOn(note, velocity, startDelayOffset);
+        markVoiceStarted(voiceIndex, voicePriority[heldIndex]);
+        return true;
     }
     
-    // No voice playing this note - allocate a new voice
-    int voiceIndex = allocateVoice();
-    wasStolen = voices[voiceIndex].isActive() || voices[voiceIndex].isPlaying();
+    // No voice holding this note - allocate a new voice
+    int voiceIndex = allocateVoice(note, -1, wasStolen);
     
     // Increment voice start counter for this block
     voicesStartedThisBlock++;
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"F\",\"location\":\"VoiceManager.cpp:61\",\"message\":\"Voice allocated for note\",\"data\":{\"note\":" << note << ",\"velocity\":" << velocity << ",\"voiceIndex\":" << voiceIndex << ",\"wasActive\":" << (voices[voiceIndex].isActive() ? 1 : 0) << ",\"hasSampleData\":" << (sampleData != nullptr ? 1 : 0) << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
-    // Set sample data snapshot before triggering note
-    // Comprehensive validation before setting
-    if (!sampleData || sampleData->length <= 0 || 
-        sampleData->mono.empty() || sampleData->mono.data() == nullptr) {
-        // No valid sample - voice will remain inactive
-        // #region agent log
-        {
-            std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-            if (log.is_open()) {
-                log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"F\",\"location\":\"VoiceManager.cpp:80\",\"message\":\"noteOn with invalid sample data\",\"data\":{\"note\":" << note << ",\"sampleDataNull\":" << (sampleData == nullptr ? 1 : 0) << ",\"length\":" << (sampleData ? sampleData->length : 0) << ",\"empty\":" << (sampleData && sampleData->mono.empty() ? 1 : 0) << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-            }
-        }
-        // #endregion
-        return false; // Don't trigger note if no valid sample
-    }
-    
     voices[voiceIndex].setSampleData(sampleData);
     
     // Calculate start delay: stagger voices within the block
     int calculatedDelay = (voicesStartedThisBlock * 8) % 64;
     voices[voiceIndex].noteOn(note, velocity, calculatedDelay + startDelayOffset);
+    markVoiceStarted(voiceIndex, 0);
     return true;
 }
 
 bool VoiceManager::noteOn(int note, float velocity, SampleDataPtr sampleData, bool& wasStolen, int startDelayOffset,
                           float repitchSemitones, int startPoint, int endPoint, float sampleGain,
                           float attackMs, float decayMs, float sustain, float releaseMs,
-                          bool loopEnabled, int loopStartPoint, int loopEndPoint) {
+                          bool loopEnabled, int loopStartPoint, int loopEndPoint, int priority,
+                          int blendGroup) {
+    wasStolen = false;
+    if (blendGroup < -1 || blendGroup >= MAX_BLEND_GROUPS) {
+        blendGroup = -1;
+    }
+    
     // In mono mode, turn off all currently playing voices
     if (!isPolyphonicMode) {
         for (auto& voice : voices) {
@@ -164,47 +295,42 @@ bool VoiceManager::noteOn(int note, float velocity, SampleDataPtr sampleData, bo
         }
     }
     
+    // Validate before allocating - never steal a voice for a note that cannot sound
+    if (!validateSampleData(sampleData)) {
+        return false; // Don't trigger note if no valid sample
+    }
+    
     // CRITICAL: Smart retrigger - when same note retriggers, use smooth transition
-    // Check if there's already a voice that was playing this exact note
-    // If so, retrigger it with smooth fade-in (noteOn preserves slew state when wasActive)
-    // This prevents the abrupt cut-off that causes clicks
-    for (int i = 0; i < MAX_VOICES; ++i) {
-        if (voices[i].getCurrentNote() == note) {
-            // Found a voice that was playing this note (active or in release) - retrigger it
-            // noteOn will detect wasActive=true and preserve slew state for smooth transition
-            // rampGain and envelope will fade in from 0 over 256 samples
-            // Apply slot parameters to this voice
-            voices[i].setRepitch(repitchSemitones);
-            voices[i].setStartPoint(startPoint);
-            voices[i].setEndPoint(endPoint);
-            voices[i].setSampleGain(sampleGain);
-            voices[i].setAttackTime(attackMs);
-            voices[i].setDecayTime(decayMs);
-            voices[i].setSustainLevel(sustain);
-            voices[i].setReleaseTime(releaseMs);
-            voices[i].setLoopEnabled(loopEnabled);
-            voices[i].setLoopPoints(loopStartPoint, loopEndPoint);
-            voices[i].setSampleData(sampleData);
-            // Retrigger - noteOn will handle smooth transition (preserves slew, fades in)
-            voices[i].noteOn(note, velocity, startDelayOffset);
-            wasStolen = false; // Not stolen, just retriggered
-            return true;
-        }
+    // Check if there's already a voice holding this exact note
+    // If so, the old note fades out on a tail voice while the retrigger starts on a fresh one
+    // (falls back to retriggering in place when the pool is exhausted)
+    int heldIndex = findVoiceForNote(note, blendGroup);
+    if (heldIndex >= 0) {
+        int voiceIndex = retriggerVoice(heldIndex);
+        // rampGain and envelope will fade in from 0 over 256 samples
+        // Apply slot parameters to this voice
+        voices[voiceIndex].setRepitch(repitchSemitones);
+        voices[voiceIndex].setStartPoint(startPoint);
+        voices[voiceIndex].setEndPoint(endPoint);
+        voices[voiceIndex].setSampleGain(sampleGain);
+        voices[voiceIndex].setAttackTime(attackMs);
+        voices[voiceIndex].setDecayTime(decayMs);
+        voices[voiceIndex].setSustainLevel(sustain);
+        voices[voiceIndex].setReleaseTime(releaseMs);
+        voices[voiceIndex].setLoopEnabled(loopEnabled);
+        voices[voiceIndex].setLoopPoints(loopStartPoint, loopEndPoint);
+        voices[voiceIndex].setSampleData(sampleData);
+        voices[voiceIndex].noteOn(note, velocity, startDelayOffset);
+        markVoiceStarted(voiceIndex, priority, blendGroup);
+        return true;
     }
     
-    // No voice playing this note - allocate a new voice
-    int voiceIndex = allocateVoice();
-    wasStolen = voices[voiceIndex].isActive() || voices[voiceIndex].isPlaying();
+    // No voice holding this note - allocate a new voice
+    int voiceIndex = allocateVoice(note, blendGroup, wasStolen);
     
     // Increment voice start counter for this block
     voicesStartedThisBlock++;
     
-    // Set sample data snapshot before triggering note
-    if (!sampleData || sampleData->length <= 0 || 
-        sampleData->mono.empty() || sampleData->mono.data() == nullptr) {
-        return false; // Don't trigger note if no valid sample
-    }
-    
     voices[voiceIndex].setSampleData(sampleData);
     
     // Apply slot-specific parameters to this voice BEFORE noteOn
@@ -220,29 +346,152 @@ bool VoiceManager::noteOn(int note, float velocity, SampleDataPtr sampleData, bo
     // Calculate start delay: stagger voices within the block
     int calculatedDelay = (voicesStartedThisBlock * 8) % 64;
     voices[voiceIndex].noteOn(note, velocity, calculatedDelay + startDelayOffset);
+    markVoiceStarted(voiceIndex, priority, blendGroup);
     return true;
 }
 
 void VoiceManager::noteOff(int note) {
     // Find voice playing this note and turn it off
     // Use isPlaying() to include voices in release phase
+    // Skip tail voices fading after a steal - they already released this note
     for (auto& voice : voices) {
-        if (voice.isPlaying() && voice.getCurrentNote() == note) {
+        if (voice.isPlaying() && !voice.isFadingAfterSteal() && voice.getCurrentNote() == note) {
             voice.noteOff(note);
             break; // Only turn off one voice per note (in case of duplicates)
         }
     }
 }
 
+void VoiceManager::prepare(int maxBlockSize, int numChannels) {
+    laneCapacity = std::max(0, maxBlockSize);
+    laneChannels = std::max(0, std::min(numChannels, MAX_LANE_CHANNELS));
+    laneStorage.assign(static_cast<size_t>(POOL_SIZE) * laneChannels * laneCapacity, 0.0f);
+    for (int v = 0; v < POOL_SIZE; ++v) {
+        for (int ch = 0; ch < MAX_LANE_CHANNELS; ++ch) {
+            lanes[v][ch] = (ch < laneChannels)
+                ? laneStorage.data() + (static_cast<size_t>(v) * laneChannels + ch) * laneCapacity
+                : nullptr;
+        }
+    }
+}
+
+float VoiceManager::estimateRenderCost(const SamplerVoice& voice) const {
+    if (!voice.isPlaying()) {
+        return 0.0f;
+    }
+    return voice.hasWarpLease() ? WARP_VOICE_COST : 1.0f;
+}
+
+void VoiceManager::renderVoiceToLane(int voiceIndex) {
+    float* lane[MAX_LANE_CHANNELS];
+    for (int ch = 0; ch < renderNumChannels; ++ch) {
+        lane[ch] = lanes[voiceIndex][ch];
+        std::fill(lane[ch], lane[ch] + renderNumSamples, 0.0f);
+    }
+    voices[voiceIndex].process(lane, renderNumChannels, renderNumSamples, renderSampleRate);
+}
+
+void VoiceManager::mixLane(int voiceIndex, float** output, int numChannels, int numSamples) const {
+    const float* weights = isVoiceWeighted(voiceIndex) ? blendWeights[voiceBlendGroup[voiceIndex]] : nullptr;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        if (output[ch] == nullptr) {
+            continue;
+        }
+        const float* lane = lanes[voiceIndex][ch];
+        float* out = output[ch];
+        if (weights != nullptr) {
+            for (int s = 0; s < numSamples; ++s) {
+                out[s] += lane[s] * weights[s];
+            }
+        } else {
+            for (int s = 0; s < numSamples; ++s) {
+                out[s] += lane[s];
+            }
+        }
+    }
+}
+
+void VoiceManager::renderVoiceTask(void* context, int taskIndex) {
+    VoiceManager& self = *static_cast<VoiceManager*>(context);
+    self.renderVoiceToLane(self.renderOrder[taskIndex]);
+}
+
+void VoiceManager::setBlendWeights(const float* const* weights) {
+    blendWeightsSet = (weights != nullptr);
+    for (int g = 0; g < MAX_BLEND_GROUPS; ++g) {
+        blendWeights[g] = (weights != nullptr) ? weights[g] : nullptr;
+    }
+}
+
+bool VoiceManager::processParallel(float** output, int numChannels, int numSamples) {
+    if (renderPool == nullptr || renderPool->getNumWorkers() == 0) {
+        return false;
+    }
+    
+    // Collect playing voices, most expensive first (ties keep voice order)
+    float cost[POOL_SIZE];
+    float totalCost = 0.0f;
+    int numTasks = 0;
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        cost[i] = estimateRenderCost(voices[i]);
+        if (cost[i] > 0.0f) {
+            renderOrder[numTasks++] = i;
+            totalCost += cost[i];
+        }
+    }
+    if (numTasks < 2 || totalCost < MIN_PARALLEL_COST) {
+        return false;  // Too little work to split - serial rendering avoids the lane copy
+    }
+    std::stable_sort(renderOrder.begin(), renderOrder.begin() + numTasks,
+                     [&cost](int a, int b) { return cost[a] > cost[b]; });
+    
+    renderPool->run(&VoiceManager::renderVoiceTask, this, numTasks);
+    
+    // Sum lanes in voice index order (same order as serial rendering, so output is deterministic)
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        if (cost[i] > 0.0f) {
+            mixLane(i, output, numChannels, numSamples);
+        }
+    }
+    return true;
+}
+
 void VoiceManager::process(float** output, int numChannels, int numSamples, double sampleRate) {
     // Reset voice start counter at the beginning of each audio block
     voicesStartedThisBlock = 0;
-    // Process all playing voices (including those in release)
-    for (auto& voice : voices) {
-        if (voice.isPlaying()) {
-            voice.process(output, numChannels, numSamples, sampleRate);
+    
+    // Lanes are needed for parallel rendering and blend weighting; without them render unweighted
+    bool lanesUsable = (numChannels <= laneChannels && numSamples <= laneCapacity);
+    if (!lanesUsable) {
+        blendWeightsSet = false;
+    }
+    renderNumChannels = numChannels;
+    renderNumSamples = numSamples;
+    renderSampleRate = sampleRate;
+    
+    OP1_PROFILE_SCOPE(stageScope, VoicesParallel);
+    if (!lanesUsable || !processParallel(output, numChannels, numSamples)) {
+        // Process all playing voices (including those in release)
+        OP1_PROFILE_NEXT(stageScope, VoicesSerial);
+        // Weighted voices go through their lane; the rest accumulate straight into the output
+        for (int i = 0; i < POOL_SIZE; ++i) {
+            if (!voices[i].isPlaying()) {
+                continue;
+            }
+            if (isVoiceWeighted(i)) {
+                renderVoiceToLane(i);
+                mixLane(i, output, numChannels, numSamples);
+            } else {
+                voices[i].process(output, numChannels, numSamples, sampleRate);
+            }
         }
     }
+    
+    // Weights are per block - the caller sets them again before the next process()
+    blendWeightsSet = false;
+    
+    OP1_PROFILE_NEXT(stageScope, VoiceLeases);
+    returnWarpLeases();
 }
 
 void VoiceManager::setGain(float gain) {
@@ -266,6 +515,30 @@ void VoiceManager::setADSR(float attackMs, float decayMs, float sustain, float r
     }
 }
 
+void VoiceManager::setAttackTime(float attackMs) {
+    for (auto& voice : voices) {
+        voice.setAttackTime(attackMs);
+    }
+}
+
+void VoiceManager::setDecayTime(float decayMs) {
+    for (auto& voice : voices) {
+        voice.setDecayTime(decayMs);
+    }
+}
+
+void VoiceManager::setSustainLevel(float sustain) {
+    for (auto& voice : voices) {
+        voice.setSustainLevel(sustain);
+    }
+}
+
+void VoiceManager::setReleaseTime(float releaseMs) {
+    for (auto& voice : voices) {
+        voice.setReleaseTime(releaseMs);
+    }
+}
+
 void VoiceManager::setRepitch(float semitones) {
     for (auto& voice : voices) {
         voice.setRepitch(semitones);
@@ -303,9 +576,17 @@ void VoiceManager::setLoopPoints(int startPoint, int endPoint) {
 }
 
 void VoiceManager::setWarpEnabled(bool enabled) {
+    warpMode = enabled;
     for (auto& voice : voices) {
         voice.setWarpEnabled(enabled);
     }
+    updateLatencyCompensation();
+}
+
+void VoiceManager::setInterpolationEnabled(bool enabled) {
+    for (auto& voice : voices) {
+        voice.setInterpolationEnabled(enabled);
+    }
 }
 
 void VoiceManager::setTimeRatio(double ratio) {
@@ -321,28 +602,28 @@ void VoiceManager::setSineTestEnabled(bool enabled) {
 }
 
 float VoiceManager::getRepitch() const {
-    if (MAX_VOICES > 0) {
+    if (POOL_SIZE > 0) {
         return voices[0].getRepitch();
     }
     return 0.0f;
 }
 
 int VoiceManager::getStartPoint() const {
-    if (MAX_VOICES > 0) {
+    if (POOL_SIZE > 0) {
         return voices[0].getStartPoint();
     }
     return 0;
 }
 
 int VoiceManager::getEndPoint() const {
-    if (MAX_VOICES > 0) {
+    if (POOL_SIZE > 0) {
         return voices[0].getEndPoint();
     }
     return 0;
 }
 
 float VoiceManager::getSampleGain() const {
-    if (MAX_VOICES > 0) {
+    if (POOL_SIZE > 0) {
         return voices[0].getSampleGain();
     }
     return 1.0f;
@@ -377,6 +658,26 @@ int VoiceManager::getActiveVoiceCount() const {
     return count;
 }
 
+int VoiceManager::getMixVoiceCount() const {
+    int unweighted = 0;
+    int perGroup[MAX_BLEND_GROUPS] = {};
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        if (!voices[i].isPlaying()) {
+            continue;
+        }
+        if (voiceBlendGroup[i] >= 0) {
+            perGroup[voiceBlendGroup[i]]++;
+        } else {
+            unweighted++;
+        }
+    }
+    int largestGroup = 0;
+    for (int g = 0; g < MAX_BLEND_GROUPS; ++g) {
+        largestGroup = std::max(largestGroup, perGroup[g]);
+    }
+    return unweighted + largestGroup;
+}
+
 double VoiceManager::getPlayheadPosition() const {
     // Find the most recently triggered active voice (highest playhead position)
     // This gives us the "current" playback position for UI display
@@ -3,15 +3,31 @@
 #include "SamplerVoice.h"
 #include "MidiEvent.h"
 #include "SampleData.h"
+#include "VoiceStealer.h"
+#include "RenderWorkerPool.h"
+#include "StretchRenderCache.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
 
 namespace Core {
 
 // Manages multiple voices for polyphonic playback
-// Simple voice allocation: find free voice or steal oldest
+// Voice allocation: find free voice, or steal one by policy and hand its fade-out to a tail voice
+// Voices can be tagged with a blend group (orbit slot); each group has its own held-voice limit
+// and its voices are mixed through a per-sample weight ramp (see setBlendWeights)
 class VoiceManager {
 public:
-    static constexpr int MAX_VOICES = 6;  // Further reduced to prevent crackling with fast multiple notes
+    static constexpr int MAX_VOICES = 6;  // Held voices per blend group - reduced to prevent crackling with fast multiple notes
+    static constexpr int MAX_BLEND_GROUPS = 4;  // Orbit slots A-D
+    static constexpr int TAIL_VOICES = 4;  // Reserve voices that only carry fade-outs of stolen notes
+    static constexpr int POOL_SIZE = MAX_VOICES * MAX_BLEND_GROUPS + TAIL_VOICES;
+    static constexpr float STEAL_FADE_MS = 12.0f;  // Fast release applied to a stolen voice
+    static constexpr int MAX_LANE_CHANNELS = 8;  // Parallel rendering supports up to this many channels
+    static constexpr float WARP_VOICE_COST = 12.0f;  // Render cost of a time-stretched voice relative to a resampled one
+    static constexpr float MIN_PARALLEL_COST = 2.0f * WARP_VOICE_COST;  // Below this, waking workers costs more than it saves
     
     VoiceManager();
     ~VoiceManager();
@@ -39,15 +55,42 @@ public:
     
     // Handle note on with sample data, start delay offset, and slot-specific parameters
     // Sets parameters on the allocated voice before triggering noteOn
+    // priority: used by the LowestPrioritySlot steal policy (smaller = stolen first)
+    // blendGroup: 0..MAX_BLEND_GROUPS-1 to mix the voice through that group's weight ramp, -1 = unweighted
+    // The same note may sound once per blend group (retrigger only replaces a voice of the same group)
     bool noteOn(int note, float velocity, SampleDataPtr sampleData, bool& wasStolen, int startDelayOffset,
                 float repitchSemitones, int startPoint, int endPoint, float sampleGain,
                 float attackMs, float decayMs, float sustain, float releaseMs,
-                bool loopEnabled, int loopStartPoint, int loopEndPoint);
+                bool loopEnabled, int loopStartPoint, int loopEndPoint, int priority = 0,
+                int blendGroup = -1);
     
     // Handle note off - releases voice playing this note
     void noteOff(int note);
     
+    // Allocate per-voice render lanes for parallel rendering (not real-time safe)
+    void prepare(int maxBlockSize, int numChannels);
+    
+    // Worker pool for parallel voice rendering (nullptr = render serially on the calling thread)
+    // The pool may be shared between managers that are processed one after another
+    void setRenderPool(RenderWorkerPool* pool) { renderPool = pool; }
+    
+    // Time-stretch processors for warp-enabled voices (checked out on note-on, returned when the
+    // voice goes idle). Drops every lease a voice still holds - call before re-preparing the pool
+    void setWarpProcessorPool(WarpProcessorPool* pool);
+    
+    // Pre-rendered stretches for warp voices (nullptr = always stretch live)
+    // A warp note-on whose render is ready plays it instead of leasing a processor
+    void setStretchRenderCache(StretchRenderCache* cache) { stretchCache = cache; }
+    
+    // Per-sample mix weights for blend groups, used by the next process() call only
+    // weights[g] points to numSamples gains for group g (nullptr = unity); weights == nullptr disables
+    // weighting. Pointers must stay valid until process() returns
+    void setBlendWeights(const float* const* weights);
+    
     // Process all active voices
+    // With a render pool, each voice renders into its own lane and the lanes are summed
+    // in voice order - bit-identical to serial rendering for any worker count
+    // Blend-group voices always render into their lane and are mixed with their group's weights
     void process(float** output, int numChannels, int numSamples, double sampleRate);
     
     // Set gain for all voices
@@ -57,7 +100,12 @@ public:
     void setVoiceGain(float gain);
     
     // Set ADSR envelope parameters for all voices
+    // Parameter setters are audio-thread only (SamplerEngine applies queued commands)
     void setADSR(float attackMs, float decayMs, float sustain, float releaseMs);
+    void setAttackTime(float attackMs);
+    void setDecayTime(float decayMs);
+    void setSustainLevel(float sustain);
+    void setReleaseTime(float releaseMs);
     
     // Set sample editing parameters for all voices
     void setRepitch(float semitones);
@@ -71,8 +119,12 @@ public:
     void setSineTestEnabled(bool enabled);
     
     // Enable/disable time-warp processing on all voices
+    // Warp mode is latency compensated: every voice is held back by the stretcher latency
     void setWarpEnabled(bool enabled);
     
+    // Constant latency of the voice output (stretcher latency in warp mode, otherwise 0; thread-safe)
+    int getLatencySamples() const { return latencySamples.load(std::memory_order_relaxed); }
+    
     // Set time ratio for all voices (1.0 = constant duration, != 1.0 = time stretching)
     void setTimeRatio(double ratio);
     
@@ -88,6 +140,10 @@ public:
     // Get count of active voices (for envelope triggering)
     int getActiveVoiceCount() const;
     
+    // Voice count for polyphonic gain scaling: a note sounding in several blend groups counts once
+    // (unweighted voices + the largest per-group count), so orbit blending keeps the stacked level
+    int getMixVoiceCount() const;
+    
     // Set playback mode (mono or poly)
     void setPolyphonic(bool polyphonic);  // true = poly, false = mono
     
@@ -103,14 +159,110 @@ public:
     // Fills the output vectors with playhead positions and envelope values for all active voices
     void getAllActivePlayheads(std::vector<double>& positions, std::vector<float>& envelopeValues) const;
     
+    // Quality governor controls (audio thread, between blocks; sounding notes are never cut)
+    // Held voices per blend group before new notes steal (1..MAX_VOICES)
+    void setHeldVoiceLimit(int limit) { heldVoiceLimit = std::max(1, std::min(MAX_VOICES, limit)); }
+    int getHeldVoiceLimit() const { return heldVoiceLimit; }
+    // New warp notes lease a stretcher (false = they play resampled unless a render is cached)
+    void setLiveWarpEnabled(bool enabled) { liveWarpEnabled = enabled; }
+    // Interpolated or drop-sample reads for new notes (see SamplerVoice::setInterpolationEnabled)
+    void setInterpolationEnabled(bool enabled);
+    
+    // Voice stealing policy (audio thread)
+    void setStealPolicy(VoiceStealer::Policy policy) { stealer.setPolicy(policy); }
+    VoiceStealer::Policy getStealPolicy() const { return stealer.getPolicy(); }
+    
+    // Cumulative stealing counters (audio thread only - SamplerEngine publishes them atomically)
+    const VoiceStealStats& getStealStats() const { return stealStats; }
+    
 private:
-    std::array<SamplerVoice, MAX_VOICES> voices;
+    // Pool of MAX_VOICES playable voices plus TAIL_VOICES reserve for stolen-voice fade-outs
+    // At most MAX_VOICES voices hold notes; the rest are fading or idle
+    std::array<SamplerVoice, POOL_SIZE> voices;
+    std::array<uint32_t, POOL_SIZE> voiceStartOrder; // noteOnCounter value when each voice started
+    std::array<int, POOL_SIZE> voicePriority;        // Slot priority of each voice's note
+    std::array<int, POOL_SIZE> voiceBlendGroup;      // Blend group of each voice (-1 = unweighted)
+    uint32_t noteOnCounter; // Monotonic note-on counter (for Oldest policy)
     int nextVoiceIndex; // For round-robin allocation
     bool isPolyphonicMode; // true = poly, false = mono
     int voicesStartedThisBlock; // Counter for voices started in current block (for staggering)
+    int heldVoiceLimit;    // Held voices per blend group (MAX_VOICES unless the governor lowers it)
+    bool liveWarpEnabled;  // New warp notes may lease a stretcher
+    
+    VoiceStealer stealer;
+    VoiceStealStats stealStats;
+    
+    // Warp processors are leased from here (nullptr = warp voices play resampled)
+    WarpProcessorPool* warpPool;
+    StretchRenderCache* stretchCache;
+    bool warpMode;
+    std::atomic<int> latencySamples{0};
+    
+    // Push the current warp-mode latency to every voice
+    void updateLatencyCompensation();
+    
+    // Parallel rendering: one lane per pool voice, [voice][channel][sample]
+    RenderWorkerPool* renderPool;
+    std::vector<float> laneStorage;
+    std::array<std::array<float*, MAX_LANE_CHANNELS>, POOL_SIZE> lanes;
+    int laneCapacity;   // Samples per lane channel
+    int laneChannels;
+    
+    // Blend weights for the current block (set by setBlendWeights, cleared after process)
+    std::array<const float*, MAX_BLEND_GROUPS> blendWeights;
+    bool blendWeightsSet;
+    
+    // Current parallel render job (set on the audio thread before the pool runs it)
+    std::array<int, POOL_SIZE> renderOrder;  // Voice index per task, most expensive first
+    int renderNumChannels;
+    int renderNumSamples;
+    double renderSampleRate;
+    
+    // Estimated render cost of a voice (0 if idle)
+    float estimateRenderCost(const SamplerVoice& voice) const;
+    
+    // Render voices through the worker pool (at renderSampleRate); false if the block can't use the lanes
+    bool processParallel(float** output, int numChannels, int numSamples);
+    
+    // Render one voice into its (cleared) lane using the current render job dimensions
+    void renderVoiceToLane(int voiceIndex);
+    
+    // Add a voice's lane to the output, through its blend group's weights when weighting is on
+    void mixLane(int voiceIndex, float** output, int numChannels, int numSamples) const;
+    
+    // True if the voice's output goes through a weight ramp this block
+    bool isVoiceWeighted(int voiceIndex) const {
+        return blendWeightsSet && voiceBlendGroup[voiceIndex] >= 0;
+    }
+    
+    // Pool task: render voice renderOrder[taskIndex] into its lane
+    static void renderVoiceTask(void* context, int taskIndex);
+    
+    // Find an idle voice (round-robin), or -1 if every pool voice is sounding
+    int findFreeVoice();
+    
+    // Find a voice of this blend group holding this note (not fading after a steal), or -1
+    int findVoiceForNote(int note, int blendGroup = -1) const;
+    
+    // Count voices of this blend group holding notes (playing and not fading after a steal)
+    int countHeldVoices(int blendGroup = -1) const;
+    
+    // Allocate a voice for a new note: free voice, or steal by policy (within the same blend group)
+    // Stolen voices fade out on a tail voice; if none is idle the victim restarts in place
+    int allocateVoice(int note, int blendGroup, bool& wasStolen);
+    
+    // Retrigger target for a note already held: hand the old note to a tail voice when one is idle
+    int retriggerVoice(int heldIndex);
+    
+    // Check sample data is playable (counts a dropped note if not)
+    bool validateSampleData(const SampleDataPtr& sampleData);
+    
+    // Record start order, priority and blend group of a voice that just started, and give
+    // a warp voice its pre-rendered stretch, or a processor lease when none is ready
+    void markVoiceStarted(int voiceIndex, int priority, int blendGroup = -1);
     
-    // Find a free voice, or steal the oldest one
-    int allocateVoice();
+    // Return leases of voices that went idle (or disabled warp) and reset one returned processor
+    void returnWarpLeases();
     
     // Reset voice start counter (called at start of each audio block)
     void resetVoiceStartCounter() { voicesStartedThisBlock = 0; }
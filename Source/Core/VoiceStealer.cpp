@@ -0,0 +1,60 @@
+#include "VoiceStealer.h"
+#include <cstdlib>
+
+namespace Core {
+
+int VoiceStealer::chooseVictim(const VoiceSlotInfo* slots, int numSlots, int newNote) const {
+    if (slots == nullptr || numSlots <= 0) {
+        return 0;
+    }
+    
+    int best = 0;
+    for (int i = 1; i < numSlots; ++i) {
+        if (isBetterVictim(slots[i], slots[best], newNote)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+bool VoiceStealer::isBetterVictim(const VoiceSlotInfo& a, const VoiceSlotInfo& b, int newNote) const {
+    // Silent slots first, then releasing slots - both are the least disruptive to take
+    if (a.playing != b.playing) {
+        return !a.playing;
+    }
+    if (a.inRelease != b.inRelease) {
+        return a.inRelease;
+    }
+    
+    switch (policy) {
+        case Policy::Quietest:
+            if (a.envelope != b.envelope) {
+                return a.envelope < b.envelope;
+            }
+            break;
+        
+        case Policy::SameNote: {
+            int distA = std::abs(a.note - newNote);
+            int distB = std::abs(b.note - newNote);
+            if (distA != distB) {
+                return distA < distB;
+            }
+            break;
+        }
+        
+        case Policy::LowestPrioritySlot:
+            if (a.priority != b.priority) {
+                return a.priority < b.priority;
+            }
+            break;
+        
+        case Policy::Oldest:
+            break;
+    }
+    
+    // Tie-break (and Oldest policy): the voice that started first
+    // Unsigned subtraction keeps ordering correct across counter wraparound
+    return static_cast<int32_t>(a.startOrder - b.startOrder) < 0;
+}
+
+} // namespace Core
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * Snapshot of one voice slot, filled by VoiceManager before a steal decision
+ * POD only - built on the audio thread without allocation
+ */
+struct VoiceSlotInfo {
+    bool playing;          // Voice is producing audio (including release)
+    bool inRelease;        // Voice is in its release phase
+    float envelope;        // Current amplitude envelope (0.0 to 1.0)
+    int note;              // MIDI note the voice is playing
+    uint32_t startOrder;   // Monotonic note-on counter (smaller = older)
+    int priority;          // Slot priority (smaller = less important)
+};
+
+/**
+ * Cumulative voice stealing counters (audio thread writes, published by SamplerEngine)
+ */
+struct VoiceStealStats {
+    uint32_t steals = 0;        // Sounding voices taken over by a new note
+    uint32_t tailHandoffs = 0;  // Stolen/retriggered voices whose fade moved to a tail voice
+    uint32_t tailMisses = 0;    // Steals with no idle tail voice (restarted in place)
+    uint32_t droppedNotes = 0;  // Note-ons that produced no voice
+};
+
+/**
+ * Chooses which voice slot to steal when every slot is busy
+ * Portable C++ - no JUCE dependencies, no allocations
+ *
+ * Releasing voices are always preferred; the policy decides between held voices.
+ */
+class VoiceStealer {
+public:
+    enum class Policy {
+        Oldest,             // Steal the voice that started first
+        Quietest,           // Steal the voice with the lowest envelope
+        SameNote,           // Steal the voice closest in pitch (exact match first)
+        LowestPrioritySlot  // Steal the voice from the lowest-priority slot
+    };
+
+    VoiceStealer() : policy(Policy::Quietest) {}
+
+    void setPolicy(Policy newPolicy) { policy = newPolicy; }
+    Policy getPolicy() const { return policy; }
+
+    /**
+     * Pick a slot to steal
+     * @param slots Slot snapshots [numSlots]
+     * @param numSlots Number of slots
+     * @param newNote Note that needs a voice
+     * @return Slot index to steal (always valid when numSlots > 0)
+     */
+    int chooseVictim(const VoiceSlotInfo* slots, int numSlots, int newNote) const;
+
+private:
+    Policy policy;
+
+    // Returns true if candidate a should be stolen before candidate b
+    bool isBetterVictim(const VoiceSlotInfo& a, const VoiceSlotInfo& b, int newNote) const;
+};
+
+} // namespace Core
@@ -18,6 +18,11 @@ WSOLA::WSOLA()
     , tempFrame(nullptr)
     , window(nullptr)
     , basePos(0)
+    , frameSize(DEFAULT_FRAME_SIZE)
+    , overlap(DEFAULT_OVERLAP)
+    , analysisHop(DEFAULT_FRAME_SIZE - DEFAULT_OVERLAP)
+    , seekRange(DEFAULT_SEEK_RANGE)
+    , searchRegion(nullptr)
 {
 }
 
@@ -26,9 +31,13 @@ WSOLA::~WSOLA()
     deallocateBuffers();
 }
 
-void WSOLA::prepare(double rate)
+void WSOLA::prepare(double rate, int newFrameSize, int newOverlap, int newSeekRange)
 {
     sampleRate = rate;
+    frameSize = std::max(MIN_FRAME_SIZE, newFrameSize);
+    overlap = std::max(1, std::min(frameSize / 2, newOverlap));
+    analysisHop = frameSize - overlap;
+    seekRange = std::max(0, std::min(MAX_SEEK_RANGE, newSeekRange));
     allocateBuffers();
     reset();
 }
@@ -50,11 +59,11 @@ void WSOLA::reset()
     basePos = 0;
     
     if (olaBuffer != nullptr) {
-        std::fill(olaBuffer, olaBuffer + FRAME_SIZE, 0.0f);
+        std::fill(olaBuffer, olaBuffer + frameSize, 0.0f);
     }
     
     if (prevTail != nullptr) {
-        std::fill(prevTail, prevTail + OVERLAP, 0.0f);
+        std::fill(prevTail, prevTail + overlap, 0.0f);
     }
 }
 
@@ -92,99 +101,44 @@ int WSOLA::process(const float* in, int inCount, float* out, int outCapacity)
     inputBuffer.push(in, inCount);
     
     int outputSamples = 0;
-    int synthesisHop = static_cast<int>(static_cast<float>(ANALYSIS_HOP) * timeScale);
+    int synthesisHop = static_cast<int>(static_cast<float>(analysisHop) * timeScale);
     if (synthesisHop < 1) synthesisHop = 1;
     
     // Process frames until we can't produce more output or run out of input
     while (outputSamples < outCapacity) {
         // Check if we have enough input for a frame
-        // Need: basePos + ANALYSIS_HOP + SEEK_RANGE + FRAME_SIZE + 4 (extra safety)
-        int neededInput = basePos + ANALYSIS_HOP + SEEK_RANGE + FRAME_SIZE + 4;
+        // Need: basePos + analysisHop + seekRange + frameSize + 4 (extra safety)
+        int neededInput = basePos + analysisHop + seekRange + frameSize + 4;
         if (inputBuffer.size() < neededInput) {
             if (outputSamples == 0) {
                 // First frame - not enough input yet
                 TimePitchErrorStatus::getInstance().setError(TimePitchError::WSOLA_UNDERFLOW);
             }
-            // Not enough input yet - but if we have some output ready, emit it
-            // This helps reduce latency
-            if (outputSamples > 0) {
-                break;
-            }
-            // On first frame, we need to wait for enough input
-            // But try to produce at least some output by using a simpler method
-            if (inputBuffer.size() >= FRAME_SIZE && basePos + FRAME_SIZE <= inputBuffer.size()) {
-                // Simple overlap-add without correlation search (lower quality but works immediately)
-                int peeked = inputBuffer.peek(tempFrame, FRAME_SIZE, basePos);
-                if (peeked < FRAME_SIZE) {
-                    break; // Not enough data
-                }
-                
-                // Apply window
-                for (int i = 0; i < FRAME_SIZE; ++i) {
-                    tempFrame[i] *= window[i];
-                }
-                
-                // Overlap-add into accumulator
-                for (int i = 0; i < FRAME_SIZE; ++i) {
-                    olaBuffer[i] += tempFrame[i];
-                }
-                
-                // Emit synthesisHop samples
-                int toEmit = std::min(synthesisHop, outCapacity - outputSamples);
-                for (int i = 0; i < toEmit; ++i) {
-                    out[outputSamples + i] = olaBuffer[i];
-                }
-                outputSamples += toEmit;
-                
-                // Shift accumulator
-                if (synthesisHop < FRAME_SIZE) {
-                    std::memmove(olaBuffer, olaBuffer + synthesisHop, static_cast<size_t>(FRAME_SIZE - synthesisHop) * sizeof(float));
-                    std::fill(olaBuffer + (FRAME_SIZE - synthesisHop), olaBuffer + FRAME_SIZE, 0.0f);
-                } else {
-                    std::fill(olaBuffer, olaBuffer + FRAME_SIZE, 0.0f);
-                }
-                
-                // Advance input position
-                basePos += ANALYSIS_HOP;
-                
-                // Discard processed input
-                if (basePos > ANALYSIS_HOP) {
-                    int toDiscard = basePos - ANALYSIS_HOP;
-                    inputBuffer.discard(toDiscard);
-                    basePos = ANALYSIS_HOP;
-                }
-                
-                continue; // Try next frame
-            }
+            // Wait for a full search window rather than emitting unaligned frames: an
+            // unsearched frame consumes input as fast as it arrives, so the ring would
+            // never fill far enough for the correlation path to run
             break; // Not enough input
         }
         
         // Get previous frame tail for correlation (from olaBuffer, not input buffer)
-        // The prevTail should be the last OVERLAP samples from the previous synthesis frame
+        // The prevTail should be the last overlap samples from the previous synthesis frame
         // which are already in olaBuffer
         
         // Find best offset by correlating overlap regions
-        float bestCorr = -1.0f;
-        int bestOffset = 0;
-        
-        // Use prevTail from olaBuffer (last OVERLAP samples)
+        // Use prevTail from olaBuffer (last overlap samples)
         // On first frame, prevTail might be zeros, which is OK
-        float* prevTailData = olaBuffer + (FRAME_SIZE - OVERLAP);
+        float* prevTailData = olaBuffer + (frameSize - overlap);
         
         // Clamp seek range to valid offsets given current ring size
-        int maxOffset = SEEK_RANGE;
-        int minOffset = -SEEK_RANGE;
+        int maxOffset = seekRange;
+        int minOffset = -seekRange;
         
-        // Ensure we don't search beyond available input
-        int maxValidPos = inputBuffer.size() - OVERLAP;
-        int minValidPos = 0;
-        
-        // Adjust search range based on available input
-        if (basePos + ANALYSIS_HOP + maxOffset + OVERLAP > inputBuffer.size()) {
-            maxOffset = inputBuffer.size() - (basePos + ANALYSIS_HOP + OVERLAP);
+        // Every candidate needs a whole frame of input after it
+        if (basePos + analysisHop + maxOffset + frameSize > inputBuffer.size()) {
+            maxOffset = inputBuffer.size() - (basePos + analysisHop + frameSize);
         }
-        if (basePos + ANALYSIS_HOP + minOffset < 0) {
-            minOffset = -(basePos + ANALYSIS_HOP);
+        if (basePos + analysisHop + minOffset < 0) {
+            minOffset = -(basePos + analysisHop);
         }
         
         // Ensure valid range
@@ -193,51 +147,30 @@ int WSOLA::process(const float* in, int inCount, float* out, int outCapacity)
             break; // Invalid search range
         }
         
-        for (int offset = minOffset; offset <= maxOffset; ++offset) {
-            int candidatePos = basePos + ANALYSIS_HOP + offset;
-            
-            // Double-check bounds
-            if (candidatePos < 0 || candidatePos + OVERLAP > inputBuffer.size() || 
-                candidatePos + FRAME_SIZE > inputBuffer.size()) {
-                continue; // Skip invalid positions
-            }
-            
-            // Get candidate overlap region from input buffer
-            float candidateOverlap[OVERLAP];
-            int peeked = inputBuffer.peek(candidateOverlap, OVERLAP, candidatePos);
-            if (peeked < OVERLAP) {
-                continue; // Not enough data
-            }
-            
-            // Correlate with previous frame tail
-            float corr = correlation(prevTailData, candidateOverlap, OVERLAP);
-            
-            // Check for NaN/Inf
-            if (!std::isfinite(corr)) {
-                corr = -1.0f; // Invalid correlation
-            }
-            
-            if (corr > bestCorr) {
-                bestCorr = corr;
-                bestOffset = offset;
-            }
+        // Peek the whole search region once; candidate k overlaps searchRegion[k .. k + overlap)
+        int numOffsets = maxOffset - minOffset + 1;
+        int regionLength = numOffsets + overlap - 1;
+        if (inputBuffer.peek(searchRegion, regionLength, basePos + analysisHop + minOffset) < regionLength) {
+            TimePitchErrorStatus::getInstance().setError(TimePitchError::WSOLA_UNDERFLOW);
+            break;
         }
+        int bestOffset = minOffset + search.findBestOffset(prevTailData, searchRegion, numOffsets);
         
         // Copy chosen frame with bounds checking
-        int chosenPos = basePos + ANALYSIS_HOP + bestOffset;
-        if (chosenPos < 0 || chosenPos + FRAME_SIZE > inputBuffer.size()) {
+        int chosenPos = basePos + analysisHop + bestOffset;
+        if (chosenPos < 0 || chosenPos + frameSize > inputBuffer.size()) {
             TimePitchErrorStatus::getInstance().setError(TimePitchError::WSOLA_OOB);
             break; // Invalid position
         }
         
-        int peeked = inputBuffer.peek(tempFrame, FRAME_SIZE, chosenPos);
-        if (peeked < FRAME_SIZE) {
+        int peeked = inputBuffer.peek(tempFrame, frameSize, chosenPos);
+        if (peeked < frameSize) {
             TimePitchErrorStatus::getInstance().setError(TimePitchError::WSOLA_UNDERFLOW);
             break; // Not enough data
         }
         
         // Apply window and check for NaN/Inf
-        for (int i = 0; i < FRAME_SIZE; ++i) {
+        for (int i = 0; i < frameSize; ++i) {
             tempFrame[i] *= window[i];
             if (!std::isfinite(tempFrame[i])) {
                 tempFrame[i] = 0.0f;
@@ -245,7 +178,7 @@ int WSOLA::process(const float* in, int inCount, float* out, int outCapacity)
         }
         
         // Overlap-add into accumulator
-        for (int i = 0; i < FRAME_SIZE; ++i) {
+        for (int i = 0; i < frameSize; ++i) {
             olaBuffer[i] += tempFrame[i];
             if (!std::isfinite(olaBuffer[i])) {
                 olaBuffer[i] = 0.0f;
@@ -264,88 +197,56 @@ int WSOLA::process(const float* in, int inCount, float* out, int outCapacity)
         outputSamples += toEmit;
         
         // Shift accumulator left by synthesisHop
-        if (synthesisHop < FRAME_SIZE) {
-            std::memmove(olaBuffer, olaBuffer + synthesisHop, static_cast<size_t>(FRAME_SIZE - synthesisHop) * sizeof(float));
-            std::fill(olaBuffer + (FRAME_SIZE - synthesisHop), olaBuffer + FRAME_SIZE, 0.0f);
+        if (synthesisHop < frameSize) {
+            std::memmove(olaBuffer, olaBuffer + synthesisHop, static_cast<size_t>(frameSize - synthesisHop) * sizeof(float));
+            std::fill(olaBuffer + (frameSize - synthesisHop), olaBuffer + frameSize, 0.0f);
         } else {
-            std::fill(olaBuffer, olaBuffer + FRAME_SIZE, 0.0f);
+            std::fill(olaBuffer, olaBuffer + frameSize, 0.0f);
         }
         
-        // Advance input position
-        basePos += ANALYSIS_HOP + bestOffset;
+        // Advance the nominal input position; the offset only shifts this frame, so the
+        // input rate stays analysisHop per synthesisHop (accumulating it drifts the read
+        // position backwards whenever seekRange >= analysisHop)
+        basePos += analysisHop;
     }
     
     // Discard processed input (but keep some for next frame)
     // Only discard if we've processed enough
-    if (basePos > ANALYSIS_HOP) {
-        int toDiscard = basePos - ANALYSIS_HOP;
+    if (basePos > analysisHop) {
+        int toDiscard = basePos - analysisHop;
         inputBuffer.discard(toDiscard);
-        basePos = ANALYSIS_HOP;
+        basePos = analysisHop;
     }
     
     return outputSamples;
 }
 
-float WSOLA::correlation(const float* a, const float* b, int n)
-{
-    if (a == nullptr || b == nullptr || n <= 0) {
-        return -1.0f;
-    }
-    
-    // Normalized dot product (avoid div by 0)
-    double dot = 0.0;
-    double ea = 0.0;
-    double eb = 0.0;
-    
-    for (int i = 0; i < n; ++i) {
-        double x = static_cast<double>(a[i]);
-        double y = static_cast<double>(b[i]);
-        
-        // Check for NaN/Inf
-        if (!std::isfinite(x)) x = 0.0;
-        if (!std::isfinite(y)) y = 0.0;
-        
-        dot += x * y;
-        ea += x * x;
-        eb += y * y;
-    }
-    
-    // Ensure non-negative (should always be, but be safe)
-    ea = std::max(0.0, ea);
-    eb = std::max(0.0, eb);
-    
-    double denom = std::sqrt(ea * eb) + 1e-12;
-    float result = static_cast<float>(dot / denom);
-    
-    // Check result for NaN/Inf
-    if (!std::isfinite(result)) {
-        result = -1.0f;
-    }
-    
-    return result;
-}
-
 void WSOLA::allocateBuffers()
 {
     deallocateBuffers();
     
-    // Input buffer needs frameSize + seekRange + some extra
-    inputBufferCapacity = FRAME_SIZE + SEEK_RANGE + ANALYSIS_HOP * 2;
+    // Steady state keeps analysisHop samples behind basePos, so a frame needs
+    // 2 * analysisHop + seekRange + frameSize + 4 (see process); one more frame of headroom
+    // lets the caller push a block on top of that
+    inputBufferCapacity = 2 * analysisHop + seekRange + 2 * frameSize + 4;
     inputBufferStorage = new float[inputBufferCapacity];
     std::fill(inputBufferStorage, inputBufferStorage + inputBufferCapacity, 0.0f);
     inputBuffer.init(inputBufferStorage, inputBufferCapacity);
     
-    olaBuffer = new float[FRAME_SIZE];
-    prevTail = new float[OVERLAP];
-    tempFrame = new float[FRAME_SIZE];
-    window = new float[FRAME_SIZE];
+    olaBuffer = new float[frameSize];
+    prevTail = new float[overlap];
+    tempFrame = new float[frameSize];
+    window = new float[frameSize];
+    searchRegion = new float[2 * seekRange + overlap];
     
-    std::fill(olaBuffer, olaBuffer + FRAME_SIZE, 0.0f);
-    std::fill(prevTail, prevTail + OVERLAP, 0.0f);
-    std::fill(tempFrame, tempFrame + FRAME_SIZE, 0.0f);
+    std::fill(olaBuffer, olaBuffer + frameSize, 0.0f);
+    std::fill(prevTail, prevTail + overlap, 0.0f);
+    std::fill(tempFrame, tempFrame + frameSize, 0.0f);
     
     // Generate Hann window
-    makeHann(window, FRAME_SIZE);
+    makeHann(window, frameSize);
+    
+    search.prepare(overlap, 2 * seekRange + 1);
 }
 
 void WSOLA::deallocateBuffers()
@@ -355,12 +256,14 @@ void WSOLA::deallocateBuffers()
     delete[] prevTail;
     delete[] tempFrame;
     delete[] window;
+    delete[] searchRegion;
     
     inputBufferStorage = nullptr;
     olaBuffer = nullptr;
     prevTail = nullptr;
     tempFrame = nullptr;
     window = nullptr;
+    searchRegion = nullptr;
 }
 
 } // namespace Core
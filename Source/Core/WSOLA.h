@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RingBufferF.h"
+#include "SimilaritySearch.h"
 
 namespace Core {
 
@@ -10,17 +11,32 @@ namespace Core {
  * 
  * Time-stretches audio by finding similar waveform segments and overlapping them
  * Hardware-friendly time-domain method
+ *
+ * The overlap alignment is a normalised cross-correlation search (SimilaritySearch):
+ * exhaustive SIMD for the default range, coarse-to-fine with FFT correlation for
+ * larger ones, so the seek range can be raised for tonal material
  */
 class WSOLA {
 public:
+    static constexpr int DEFAULT_FRAME_SIZE = 512;  // Smaller frame for lower latency
+    static constexpr int DEFAULT_OVERLAP = 128;     // 25% overlap
+    static constexpr int DEFAULT_SEEK_RANGE = 128;  // Search range for best match (+/- samples)
+    static constexpr int MIN_FRAME_SIZE = 16;
+    static constexpr int MAX_SEEK_RANGE = 4096;
+    
     WSOLA();
     ~WSOLA();
     
     /**
-     * Prepare WSOLA processor
+     * Prepare WSOLA processor (allocates - not real-time safe)
      * sampleRate: audio sample rate
+     * frameSize: synthesis frame length (samples)
+     * overlap: samples correlated against the previous frame (clamped to frameSize / 2)
+     * seekRange: candidates searched either side of the nominal position
+     * Latency grows with frameSize + seekRange
      */
-    void prepare(double sampleRate);
+    void prepare(double sampleRate, int frameSize = DEFAULT_FRAME_SIZE,
+                 int overlap = DEFAULT_OVERLAP, int seekRange = DEFAULT_SEEK_RANGE);
     
     /**
      * Set time scale ratio
@@ -44,13 +60,12 @@ public:
      * Returns: number of output samples actually produced
      */
     int process(const float* in, int inCount, float* out, int outCapacity);
+    
+    int getFrameSize() const { return frameSize; }
+    int getOverlap() const { return overlap; }
+    int getSeekRange() const { return seekRange; }
 
 private:
-    static constexpr int FRAME_SIZE = 512;  // Smaller frame for lower latency
-    static constexpr int OVERLAP = 128;     // 25% overlap
-    static constexpr int ANALYSIS_HOP = FRAME_SIZE - OVERLAP;  // 384
-    static constexpr int SEEK_RANGE = 128;  // Search range for best match
-    
     double sampleRate;
     float timeScale;
     
@@ -74,8 +89,15 @@ private:
     // Current position in processing
     int basePos;
     
-    // Correlation function (normalized dot product)
-    static float correlation(const float* a, const float* b, int n);
+    // Frame geometry (set in prepare)
+    int frameSize;
+    int overlap;
+    int analysisHop;  // frameSize - overlap
+    int seekRange;
+    
+    // Search region peeked from the ring (2 * seekRange + overlap)
+    float* searchRegion;
+    SimilaritySearch search;
     
     void allocateBuffers();
     void deallocateBuffers();
@@ -0,0 +1,267 @@
+#include "../PluginProcessor.h"
+#include "../../Core/RealtimeSanitizer.h"
+#include "../../Core/DiagnosticsPolicy.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Entry point for the Op1CloneProcessBench target
+//   Op1CloneProcessBench [--slot <wav>]... [--mode stacked|roundrobin|orbit|all]
+//                        [--block <n>] [--rate <hz>] [--seconds <s>] [--notes <per second>]
+// Hosts Op1CloneAudioProcessor without an editor, loads slots A-E from WAV files (generated
+// tones when none are given) and plays a scripted note pattern through processBlock in each
+// playback mode. The target is built with the real-time sanitizer hooks, so allocations,
+// frees, locks and file calls made inside processBlock are counted per block
+
+namespace {
+
+struct Options {
+    std::vector<juce::File> slotFiles;
+    int mode = -1;  // -1 = all modes
+    int blockSize = 512;
+    double sampleRate = 48000.0;
+    double seconds = 10.0;
+    double notesPerSecond = 8.0;
+};
+
+struct SlotAudio {
+    juce::AudioBuffer<float> buffer;
+    double sampleRate = 44100.0;
+};
+
+struct ModeResult {
+    const char* name = "";
+    int blocks = 0;
+    int noteOns = 0;
+    double usMedian = 0.0;
+    double usP99 = 0.0;
+    double usMax = 0.0;
+    double realtimePercent = 0.0;   // Median block time over the block's duration
+    double allocsPerBlock = 0.0;
+    uint64_t maxAllocsInBlock = 0;
+    double allocsPerNoteOn = 0.0;
+    double freesPerBlock = 0.0;
+    uint64_t locks = 0;
+    uint64_t fileCalls = 0;
+};
+
+const char* modeNames[] = { "stacked", "roundrobin", "orbit" };
+
+void printUsage() {
+    printf("Usage: Op1CloneProcessBench [--slot <wav>]... [--mode stacked|roundrobin|orbit|all]\n"
+           "                            [--block <n>] [--rate <hz>] [--seconds <s>] [--notes <per second>]\n"
+           "  --slot     load the next slot (A-E) from a WAV/AIFF file; default: four generated tones\n"
+           "  --mode     playback mode to run (default all)\n"
+           "  --block    processBlock size (default 512)\n"
+           "  --rate     sample rate (default 48000)\n"
+           "  --seconds  audio rendered per mode (default 10)\n"
+           "  --notes    note-on chords per second (default 8)\n");
+}
+
+std::vector<SlotAudio> loadSlots(const Options& options) {
+    std::vector<SlotAudio> slots;
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    for (const auto& file : options.slotFiles) {
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if (reader == nullptr) {
+            fprintf(stderr, "Cannot read %s\n", file.getFullPathName().toRawUTF8());
+            continue;
+        }
+        SlotAudio slot;
+        slot.buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        reader->read(&slot.buffer, 0, static_cast<int>(reader->lengthInSamples), 0, true, true);
+        slot.sampleRate = reader->sampleRate;
+        slots.push_back(std::move(slot));
+        if (slots.size() == 5) {
+            break;
+        }
+    }
+    
+    if (slots.empty()) {
+        // Two seconds of stereo saw per slot A-D at 44.1kHz, one octave step apart
+        for (int s = 0; s < 4; ++s) {
+            SlotAudio slot;
+            int length = 88200;
+            double freq = 110.0 * (1 << s);
+            slot.buffer.setSize(2, length);
+            for (int i = 0; i < length; ++i) {
+                double phase = freq * i / slot.sampleRate;
+                float saw = static_cast<float>(phase - std::floor(phase)) * 2.0f - 1.0f;
+                slot.buffer.setSample(0, i, 0.4f * saw);
+                slot.buffer.setSample(1, i, 0.4f * saw);
+            }
+            slots.push_back(std::move(slot));
+        }
+    }
+    return slots;
+}
+
+// One MidiBuffer per block: chords of 1-3 notes at random times, each held 100-400 ms
+// Built before timing so MidiBuffer's own allocations are not billed to processBlock
+std::vector<juce::MidiBuffer> makeScript(const Options& options, int numBlocks, int& noteOns) {
+    std::vector<juce::MidiBuffer> script(static_cast<size_t>(numBlocks));
+    juce::Random random(1234);
+    const int64_t totalFrames = static_cast<int64_t>(numBlocks) * options.blockSize;
+    const double chordChancePerFrame = options.notesPerSecond / options.sampleRate;
+    noteOns = 0;
+    
+    auto addEvent = [&](int64_t frame, const juce::MidiMessage& message) {
+        if (frame < totalFrames) {
+            script[static_cast<size_t>(frame / options.blockSize)].addEvent(message, static_cast<int>(frame % options.blockSize));
+        }
+    };
+    
+    for (int64_t frame = 0; frame < totalFrames; frame += 64) {
+        if (random.nextDouble() >= chordChancePerFrame * 64.0) {
+            continue;
+        }
+        int chordSize = 1 + random.nextInt(3);
+        for (int n = 0; n < chordSize; ++n) {
+            int note = 48 + random.nextInt(25);
+            auto hold = static_cast<int64_t>((0.1 + 0.3 * random.nextDouble()) * options.sampleRate);
+            addEvent(frame, juce::MidiMessage::noteOn(1, note, 0.8f));
+            addEvent(frame + hold, juce::MidiMessage::noteOff(1, note));
+            ++noteOns;
+        }
+    }
+    return script;
+}
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+ModeResult runMode(int mode, const std::vector<SlotAudio>& slots, const Options& options) {
+    using Kind = Core::RealtimeViolationKind;
+    using Sanitizer = Core::RealtimeSanitizer;
+    
+    ModeResult result;
+    result.name = modeNames[mode];
+    
+    Op1CloneAudioProcessor processor;
+    processor.setRateAndBufferSizeDetails(options.sampleRate, options.blockSize);
+    processor.prepareToPlay(options.sampleRate, options.blockSize);  // Loads the default sample; slots replace it
+    for (size_t s = 0; s < slots.size(); ++s) {
+        juce::AudioBuffer<float> copy(slots[s].buffer);
+        processor.setSampleForSlot(static_cast<int>(s), copy, slots[s].sampleRate);
+    }
+    processor.setPlaybackMode(mode);
+    processor.setOrbitRate(2.0f);
+    
+    const int numBlocks = std::max(1, static_cast<int>(options.seconds * options.sampleRate / options.blockSize));
+    auto script = makeScript(options, numBlocks, result.noteOns);
+    juce::AudioBuffer<float> buffer(2, options.blockSize);
+    
+    // Silent warm-up so first-block setup is not billed to the first note
+    juce::MidiBuffer noMidi;
+    for (int b = 0; b < 8; ++b) {
+        buffer.clear();
+        processor.processBlock(buffer, noMidi);
+    }
+    
+    std::vector<double> blockUs;
+    blockUs.reserve(static_cast<size_t>(numBlocks));
+    Sanitizer::reset();
+    for (int b = 0; b < numBlocks; ++b) {
+        buffer.clear();
+        uint64_t allocsBefore = Sanitizer::getViolationCount(Kind::Allocation);
+        auto start = std::chrono::steady_clock::now();
+        processor.processBlock(buffer, script[static_cast<size_t>(b)]);
+        auto end = std::chrono::steady_clock::now();
+        uint64_t allocs = Sanitizer::getViolationCount(Kind::Allocation) - allocsBefore;
+        result.maxAllocsInBlock = std::max(result.maxAllocsInBlock, allocs);
+        blockUs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    
+    result.blocks = numBlocks;
+    result.usMedian = percentile(blockUs, 0.5);
+    result.usP99 = percentile(blockUs, 0.99);
+    result.usMax = *std::max_element(blockUs.begin(), blockUs.end());
+    result.realtimePercent = 100.0 * result.usMedian / (1.0e6 * options.blockSize / options.sampleRate);
+    uint64_t allocs = Sanitizer::getViolationCount(Kind::Allocation);
+    result.allocsPerBlock = static_cast<double>(allocs) / numBlocks;
+    result.allocsPerNoteOn = result.noteOns > 0 ? static_cast<double>(allocs) / result.noteOns : 0.0;
+    result.freesPerBlock = static_cast<double>(Sanitizer::getViolationCount(Kind::Deallocation)) / numBlocks;
+    result.locks = Sanitizer::getViolationCount(Kind::MutexLock);
+    result.fileCalls = Sanitizer::getViolationCount(Kind::FileIo);
+    Sanitizer::reset();
+    return result;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(arg, "--slot") == 0 && hasValue) {
+            options.slotFiles.push_back(juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]));
+        } else if (std::strcmp(arg, "--mode") == 0 && hasValue) {
+            juce::String name(argv[++i]);
+            options.mode = -1;
+            for (int m = 0; m < 3; ++m) {
+                if (name == modeNames[m]) {
+                    options.mode = m;
+                }
+            }
+            if (options.mode < 0 && name != "all") {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--block") == 0 && hasValue) {
+            options.blockSize = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--rate") == 0 && hasValue) {
+            options.sampleRate = std::max(8000.0, std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--seconds") == 0 && hasValue) {
+            options.seconds = std::max(0.1, std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--notes") == 0 && hasValue) {
+            options.notesPerSecond = std::max(0.0, std::atof(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return std::strcmp(argv[argc - 1], "--help") == 0 ? 0 : 2;
+    }
+    
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;  // Message manager for the processor's parameter tree
+    auto slots = loadSlots(options);
+    
+    printf("processBlock benchmark: %d slots, block %d @ %.0f Hz, %.1f s per mode, %.1f chords/s, %s diagnostics\n",
+           static_cast<int>(slots.size()), options.blockSize, options.sampleRate, options.seconds, options.notesPerSecond,
+           Core::ActiveDiagnostics::name);
+#if !defined(__GLIBC__)
+    printf("(allocation counts cover operator new/delete only on this platform)\n");
+#endif
+    printf("%-11s %6s %8s %8s %8s %6s %7s %9s %8s %10s %9s %6s %6s\n",
+           "mode", "blocks", "med us", "p99 us", "max us", "rt%", "noteOns",
+           "alloc/blk", "max/blk", "alloc/note", "free/blk", "locks", "files");
+    for (int mode = 0; mode < 3; ++mode) {
+        if (options.mode >= 0 && options.mode != mode) {
+            continue;
+        }
+        ModeResult r = runMode(mode, slots, options);
+        printf("%-11s %6d %8.1f %8.1f %8.1f %6.1f %7d %9.2f %8llu %10.2f %9.2f %6llu %6llu\n",
+               r.name, r.blocks, r.usMedian, r.usP99, r.usMax, r.realtimePercent, r.noteOns,
+               r.allocsPerBlock, static_cast<unsigned long long>(r.maxAllocsInBlock), r.allocsPerNoteOn,
+               r.freesPerBlock, static_cast<unsigned long long>(r.locks), static_cast<unsigned long long>(r.fileCalls));
+    }
+    return 0;
+}
@@ -165,6 +165,18 @@ void EditorLayoutManager::layoutComponents() {
                                       90,
                                       20);
     
+    // CPU load label (overlay in bottom left of screen)
+    editor->cpuLoadLabel.setBounds(screenComponentBounds.getX() + 10,
+                                   screenComponentBounds.getBottom() - 20,
+                                   220,
+                                   16);
+    
+    // Stage profile label (overlay above the CPU load label, grows upwards)
+    editor->stageProfileLabel.setBounds(screenComponentBounds.getX() + 10,
+                                        screenComponentBounds.getY() + 30,
+                                        240,
+                                        screenComponentBounds.getHeight() - 50);
+    
     // Under screen: Load sample button (directly below the screen)
     // Load sample button is hidden (functionality moved to menu encoder center button)
     // editor->loadSampleButton.setBounds(screenArea.removeFromTop(40).reduced(10));
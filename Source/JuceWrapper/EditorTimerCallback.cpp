@@ -1,6 +1,7 @@
 #include "EditorTimerCallback.h"
 #include "PluginEditor.h"
 #include <juce_core/juce_core.h>
+#include <algorithm>
 
 EditorTimerCallback::EditorTimerCallback(Op1CloneAudioProcessorEditor* editor)
     : editor(editor)
@@ -76,6 +77,42 @@ void EditorTimerCallback::handleTimerCallback() {
     }
     */
     
+    // Update CPU load meter; deadline misses since the last tick turn it red
+    Core::CallbackLoadStats load = editor->audioProcessor.getCallbackLoadStats();
+    Core::LoadOverrunEvent overruns[Core::CallbackLoadMeter::OVERRUN_EVENTS];
+    int newOverruns = editor->audioProcessor.readCallbackOverruns(overruns, Core::CallbackLoadMeter::OVERRUN_EVENTS);
+    for (int i = 0; i < newOverruns; ++i) {
+        DBG("Audio callback overrun: block " << static_cast<juce::int64>(overruns[i].blockIndex)
+            << ", " << overruns[i].numSamples << " samples, load " << juce::String(overruns[i].load * 100.0f, 0) << "%");
+    }
+    juce::String loadText = "CPU " + juce::String(juce::roundToInt(load.lastLoad * 100.0f))
+                          + "%  p50 " + juce::String(juce::roundToInt(load.p50 * 100.0f))
+                          + "%  p99 " + juce::String(juce::roundToInt(load.p99 * 100.0f))
+                          + "%  max " + juce::String(juce::roundToInt(load.maxLoad * 100.0f)) + "%";
+    if (load.overruns > 0) {
+        loadText += "  xruns " + juce::String(static_cast<juce::int64>(load.overruns));
+    }
+    
+    // Quality governor: log its decisions and show the level while it is degraded
+    Core::QualityChangeEvent qualityChanges[Core::QualityGovernor::CHANGE_EVENTS];
+    int newQualityChanges = editor->audioProcessor.readQualityChanges(qualityChanges, Core::QualityGovernor::CHANGE_EVENTS);
+    for (int i = 0; i < newQualityChanges; ++i) {
+        DBG("Quality " << Core::QualityGovernor::getLevelName(qualityChanges[i].from) << " -> "
+            << Core::QualityGovernor::getLevelName(qualityChanges[i].to) << " at block "
+            << static_cast<juce::int64>(qualityChanges[i].blockIndex) << ", smoothed load "
+            << juce::String(qualityChanges[i].smoothedLoad * 100.0f, 0) << "%");
+    }
+    Core::QualityLevel quality = editor->audioProcessor.getQualityLevel();
+    if (quality != Core::QualityLevel::Full) {
+        loadText += "  Q " + juce::String(Core::QualityGovernor::getLevelName(quality));
+    }
+    editor->cpuLoadLabel.setText(loadText, juce::dontSendNotification);
+    editor->cpuLoadLabel.setColour(juce::Label::textColourId,
+        newOverruns > 0 ? juce::Colours::red : juce::Colours::white.withAlpha(0.6f));
+    
+    // Update per-stage render profile (debug builds)
+    updateStageProfile();
+    
     // Update active slots display (which slots are currently playing)
     std::array<bool, 5> activeSlots = editor->audioProcessor.getActiveSlots();
     editor->screenComponent.setActiveSlots(activeSlots);
@@ -122,3 +159,41 @@ void EditorTimerCallback::handleTimerCallback() {
     }
 }
 
+void EditorTimerCallback::updateStageProfile() {
+    if (!Core::StageProfiler::isEnabled()) {
+        return;
+    }
+    
+    // Refresh twice a second so the averages are readable
+    double nowMs = juce::Time::getMillisecondCounterHiRes();
+    double elapsedMs = nowMs - lastStageRefreshMs;
+    if (lastStageRefreshMs > 0.0 && elapsedMs < 500.0) {
+        return;
+    }
+    
+    Core::StageTotals totals[Core::StageProfiler::NUM_STAGES];
+    Core::StageProfiler::snapshot(totals);
+    
+    // One row per stage that ran since the last refresh: share of real time and time per call
+    const double ticksPerMs = Core::CallbackLoadMeter::getTicksPerSecond() / 1000.0;
+    juce::String text;
+    if (lastStageRefreshMs > 0.0 && ticksPerMs > 0.0) {
+        for (int i = 0; i < Core::StageProfiler::NUM_STAGES; ++i) {
+            auto stage = static_cast<Core::ProfileStage>(i);
+            uint64_t calls = totals[i].calls - lastStageTotals[i].calls;
+            if (calls == 0) {
+                continue;
+            }
+            double stageMs = static_cast<double>(totals[i].ticks - lastStageTotals[i].ticks) / ticksPerMs;
+            juce::String name = juce::String::repeatedString("  ", Core::StageProfiler::getDepth(stage))
+                              + Core::StageProfiler::getName(stage);
+            text += name.paddedRight(' ', 16)
+                  + juce::String(stageMs / elapsedMs * 100.0, 2).paddedLeft(' ', 6) + "% "
+                  + juce::String(stageMs * 1000.0 / static_cast<double>(calls), 1).paddedLeft(' ', 7) + "us\n";
+        }
+    }
+    editor->stageProfileLabel.setText(text.trimEnd(), juce::dontSendNotification);
+    
+    std::copy(totals, totals + Core::StageProfiler::NUM_STAGES, lastStageTotals);
+    lastStageRefreshMs = nowMs;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../Core/StageProfiler.h"
+
 class Op1CloneAudioProcessorEditor;
 
 // Manager class to handle timer-based fade-out logic
@@ -13,6 +15,12 @@ public:
     
 private:
     Op1CloneAudioProcessorEditor* editor;
+    
+    // Per-stage profile overlay: totals at the last refresh, averaged over the interval since
+    Core::StageTotals lastStageTotals[Core::StageProfiler::NUM_STAGES];
+    double lastStageRefreshMs = 0.0;
+    
+    void updateStageProfile();
 };
 
 
@@ -1,9 +1,9 @@
 #include "JuceEngineAdapter.h"
+#include "../Core/StageProfiler.h"
 #include <algorithm>
-#include <fstream>
-#include <chrono>
 #include <array>
 #include <cmath>
+#include <thread>
 
 JuceEngineAdapter::JuceEngineAdapter()
     : sourceSampleRate(44100.0)
@@ -15,18 +15,17 @@ JuceEngineAdapter::JuceEngineAdapter()
     , orbitRateHz(1.0f)
     , orbitShape(0)
 {
+    // Default: leave one core for the host audio thread and one for the UI/host, max 3 workers
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    renderWorkerCount = std::max(0, std::min(cores - 2, 3));
+    
     // Initialize all slots as inactive
     for (int i = 0; i < 5; ++i) {
         activeSlots[i].store(false, std::memory_order_relaxed);
     }
     
-    // Initialize orbit engines and buffers
-    for (int i = 0; i < 4; ++i) {
-        orbitEngines[i] = std::make_unique<Core::SamplerEngine>();
-        orbitSlotNotes[i] = -1;  // Not playing
-        orbitChannelPointers[i].resize(2);  // Stereo
-        orbitTempBuffers[i].resize(2048 * 2);  // Allocate temp buffer (L+R interleaved, max 2048 samples)
-    }
+    // No orbit notes sounding
+    orbitNoteSlots.fill(0);
 }
 
 JuceEngineAdapter::~JuceEngineAdapter() {
@@ -69,40 +68,34 @@ void JuceEngineAdapter::preprocessSampleData(std::vector<float>& data) {
 
 void JuceEngineAdapter::prepare(double sampleRate, int blockSize, int numChannels) {
     currentSampleRate = sampleRate;
+    
+    // Restart render workers (audio is stopped during prepare)
+    renderPool.start(renderWorkerCount);
+    
     engine.prepare(sampleRate, blockSize, numChannels);
+    engine.setRenderPool(&renderPool);
     
-    // Prepare orbit engines
-    for (int i = 0; i < 4; ++i) {
-        orbitEngines[i] = std::make_unique<Core::SamplerEngine>();
-        orbitEngines[i]->prepare(sampleRate, blockSize, numChannels);
-        // Setup channel pointers for orbit engines (point to temp buffers)
-        orbitChannelPointers[i].resize(numChannels);
-        orbitTempBuffers[i].resize(blockSize * numChannels);  // Allocate temp buffer for L+R
-        orbitChannelPointers[i][0] = orbitTempBuffers[i].data();  // Left channel
-        if (numChannels > 1) {
-            orbitChannelPointers[i][1] = orbitTempBuffers[i].data() + blockSize;  // Right channel
-        }
-        orbitSlotNotes[i] = -1;  // Not playing
+    for (auto& granular : granularEngines) {
+        granular.prepare(sampleRate, blockSize);
+        granular.setLatencyCompensation(engine.getLatencySamples());  // Stretcher latency follows the rate
+    }
+    
+    // Orbit weight ramps (one gain per sample per slot A-D, filled each block)
+    for (auto& ramp : orbitWeightRamps) {
+        ramp.assign(static_cast<size_t>(blockSize), 0.0f);
     }
+    orbitNoteSlots.fill(0);
     
     // Reset orbit blender
     orbitBlender.reset();
     
     // Pre-allocate channel pointer array (max 8 channels should be enough)
     channelPointers.resize(std::max(numChannels, 8));
-    midiEventBuffer.reserve(128); // Pre-allocate space for MIDI events
+    midiEventBuffer.reserve(MAX_BLOCK_MIDI_EVENTS); // Pre-allocate space for MIDI events
+    processedEventBuffer.reserve(MAX_BLOCK_MIDI_EVENTS * slotSamples.size());
 }
 
 void JuceEngineAdapter::setSample(juce::AudioBuffer<float>& buffer, double sourceSampleRate) {
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1,H3\",\"location\":\"JuceEngineAdapter.cpp:20\",\"message\":\"setSample entry\",\"data\":{\"numSamples\":" << buffer.getNumSamples() << ",\"sourceSampleRate\":" << sourceSampleRate << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     this->sourceSampleRate = sourceSampleRate;
     // Extract sample data from JUCE buffer
     // Extract both left and right channels if stereo, otherwise use left channel only
@@ -114,15 +107,6 @@ void JuceEngineAdapter::setSample(juce::AudioBuffer<float>& buffer, double sourc
     std::vector<float> tempLeftData(static_cast<size_t>(numSamples));
     std::vector<float> tempRightData;  // Only allocate if stereo
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H3\",\"location\":\"JuceEngineAdapter.cpp:38\",\"message\":\"temp buffer created\",\"data\":{\"numSamples\":" << numSamples << ",\"numChannels\":" << numChannels << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     if (numChannels > 0 && numSamples > 0) {
         // Extract left channel (channel 0)
         const float* leftChannelData = buffer.getReadPointer(0);
@@ -143,14 +127,6 @@ void JuceEngineAdapter::setSample(juce::AudioBuffer<float>& buffer, double sourc
             }
         }
         
-        // #region agent log
-        {
-            std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-            if (log.is_open()) {
-                log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H3\",\"location\":\"JuceEngineAdapter.cpp:57\",\"message\":\"after copy to temp\",\"data\":{\"isStereo\":" << (numChannels >= 2 ? 1 : 0) << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-            }
-        }
-        // #endregion
     } else {
         // Empty buffer - fill with zeros
         std::fill(tempLeftData.begin(), tempLeftData.end(), 0.0f);
@@ -169,60 +145,15 @@ void JuceEngineAdapter::setSample(juce::AudioBuffer<float>& buffer, double sourc
     
     // Validate sample data before setting
     if (newSampleData->mono.empty() || newSampleData->length <= 0) {
-        // #region agent log
-        {
-            std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-            if (log.is_open()) {
-                log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1,H3\",\"location\":\"JuceEngineAdapter.cpp:87\",\"message\":\"Invalid SampleData - not setting\",\"data\":{\"empty\":" << (newSampleData->mono.empty() ? 1 : 0) << ",\"length\":" << newSampleData->length << ",\"size\":" << newSampleData->mono.size() << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-            }
-        }
-        // #endregion
         return; // Don't set invalid sample
     }
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1,H3\",\"location\":\"JuceEngineAdapter.cpp:97\",\"message\":\"SampleData created and validated - atomically swapping\",\"data\":{\"length\":" << numSamples << ",\"size\":" << newSampleData->mono.size() << ",\"sampleRate\":" << sourceSampleRate << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
-    // Atomically swap in new sample data (lock-free, thread-safe)
-    // Uses atomic_store_explicit on plain shared_ptr (standard-safe)
+    // Atomically swap in new sample data (lock-free for the audio thread)
     engine.setSampleData(newSampleData);
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1\",\"location\":\"JuceEngineAdapter.cpp:92\",\"message\":\"after engine.setSampleData\",\"data\":{},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     // Update adapter's vectors for visualization (copy from SampleData)
     this->sampleData = newSampleData->mono;
     this->rightChannelData = newSampleData->right;
-    
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H3\",\"location\":\"JuceEngineAdapter.cpp:108\",\"message\":\"adapter vector updated\",\"data\":{\"newSize\":" << this->sampleData.size() << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1\",\"location\":\"JuceEngineAdapter.cpp:87\",\"message\":\"after engine.setSample\",\"data\":{},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
 }
 
 void JuceEngineAdapter::setSampleForSlot(int slotIndex, juce::AudioBuffer<float>& buffer, double sourceSampleRate) {
@@ -258,78 +189,150 @@ void JuceEngineAdapter::setSampleForSlot(int slotIndex, juce::AudioBuffer<float>
     
     slotSamples[slotIndex].sourceSampleRate = sourceSampleRate;
     slotSamples[slotIndex].hasSample = !slotSamples[slotIndex].leftChannel.empty();
+    
+    // Notes share this copy, so triggering a slot never allocates on the audio thread
+    Core::SampleDataPtr slotSampleData;
+    if (slotSamples[slotIndex].hasSample) {
+        auto newSlotSampleData = std::make_shared<Core::SampleData>();
+        newSlotSampleData->mono = slotSamples[slotIndex].leftChannel;
+        newSlotSampleData->right = slotSamples[slotIndex].rightChannel;
+        newSlotSampleData->length = static_cast<int>(slotSamples[slotIndex].leftChannel.size());
+        newSlotSampleData->sourceSampleRate = sourceSampleRate;
+        slotSampleData = std::move(newSlotSampleData);
+    }
+    slotSamples[slotIndex].sampleData.publish(std::move(slotSampleData));
 }
 
 void JuceEngineAdapter::setSlotRepitch(int slotIndex, float semitones) {
     if (slotIndex >= 0 && slotIndex < 5) {
-        slotParameters[slotIndex].repitchSemitones = semitones;
+        uiSlotParameters.slots[slotIndex].repitchSemitones = semitones;
+        publishedSlotParameters.write(uiSlotParameters);
     }
 }
 
 void JuceEngineAdapter::setSlotStartPoint(int slotIndex, int sampleIndex) {
     if (slotIndex >= 0 && slotIndex < 5) {
-        slotParameters[slotIndex].startPoint = sampleIndex;
+        uiSlotParameters.slots[slotIndex].startPoint = sampleIndex;
+        publishedSlotParameters.write(uiSlotParameters);
     }
 }
 
 void JuceEngineAdapter::setSlotEndPoint(int slotIndex, int sampleIndex) {
     if (slotIndex >= 0 && slotIndex < 5) {
-        slotParameters[slotIndex].endPoint = sampleIndex;
+        uiSlotParameters.slots[slotIndex].endPoint = sampleIndex;
+        publishedSlotParameters.write(uiSlotParameters);
     }
 }
 
 void JuceEngineAdapter::setSlotSampleGain(int slotIndex, float gain) {
     if (slotIndex >= 0 && slotIndex < 5) {
-        slotParameters[slotIndex].sampleGain = gain;
+        uiSlotParameters.slots[slotIndex].sampleGain = gain;
+        publishedSlotParameters.write(uiSlotParameters);
     }
 }
 
 void JuceEngineAdapter::setSlotADSR(int slotIndex, float attackMs, float decayMs, float sustain, float releaseMs) {
     if (slotIndex >= 0 && slotIndex < 5) {
-        slotParameters[slotIndex].attackMs = attackMs;
-        slotParameters[slotIndex].decayMs = decayMs;
-        slotParameters[slotIndex].sustain = sustain;
-        slotParameters[slotIndex].releaseMs = releaseMs;
+        Core::SlotParameterBlock& params = uiSlotParameters.slots[slotIndex];
+        params.attackMs = attackMs;
+        params.decayMs = decayMs;
+        params.sustain = sustain;
+        params.releaseMs = releaseMs;
+        // Publish all four together - the audio thread never sees a half-updated ADSR
+        publishedSlotParameters.write(uiSlotParameters);
     }
 }
 
 void JuceEngineAdapter::setSlotLoopEnabled(int slotIndex, bool enabled) {
     if (slotIndex >= 0 && slotIndex < 5) {
-        slotParameters[slotIndex].loopEnabled = enabled;
+        uiSlotParameters.slots[slotIndex].loopEnabled = enabled;
+        publishedSlotParameters.write(uiSlotParameters);
     }
 }
 
 void JuceEngineAdapter::setSlotLoopPoints(int slotIndex, int startPoint, int endPoint) {
     if (slotIndex >= 0 && slotIndex < 5) {
-        slotParameters[slotIndex].loopStartPoint = startPoint;
-        slotParameters[slotIndex].loopEndPoint = endPoint;
+        uiSlotParameters.slots[slotIndex].loopStartPoint = startPoint;
+        uiSlotParameters.slots[slotIndex].loopEndPoint = endPoint;
+        publishedSlotParameters.write(uiSlotParameters);
+    }
+}
+
+void JuceEngineAdapter::setSlotGranularEnabled(int slotIndex, bool enabled) {
+    if (slotIndex >= 0 && slotIndex < 5) {
+        uiSlotParameters.slots[slotIndex].granularEnabled = enabled;
+        publishedSlotParameters.write(uiSlotParameters);
+    }
+}
+
+void JuceEngineAdapter::setSlotGranularParameters(int slotIndex, float density, float grainSizeMs, float position,
+                                                  float positionJitter, float pitchSpread, int windowShape) {
+    if (slotIndex >= 0 && slotIndex < 5) {
+        Core::SlotParameterBlock& params = uiSlotParameters.slots[slotIndex];
+        params.grainDensity = std::max(0.0f, density);
+        params.grainSizeMs = std::max(1.0f, grainSizeMs);
+        params.grainPosition = std::max(0.0f, std::min(1.0f, position));
+        params.grainPositionJitter = std::max(0.0f, std::min(1.0f, positionJitter));
+        params.grainPitchSpread = std::max(0.0f, pitchSpread);
+        params.grainWindow = std::max(0, std::min(windowShape, static_cast<int>(Core::GranularEngine::WindowShape::NumShapes) - 1));
+        publishedSlotParameters.write(uiSlotParameters);
+    }
+}
+
+int JuceEngineAdapter::getSlotActiveGrainCount(int slotIndex) const {
+    if (slotIndex >= 0 && slotIndex < 5) {
+        return granularEngines[static_cast<size_t>(slotIndex)].getActiveGrainCount();
+    }
+    return 0;
+}
+
+Core::GranularEngine::Parameters JuceEngineAdapter::makeGranularParameters(const Core::SlotParameterBlock& params) {
+    Core::GranularEngine::Parameters granular;
+    granular.density = params.grainDensity;
+    granular.grainSizeMs = params.grainSizeMs;
+    granular.position = params.grainPosition;
+    granular.positionJitter = params.grainPositionJitter;
+    granular.pitchSpread = params.grainPitchSpread;
+    granular.window = static_cast<Core::GranularEngine::WindowShape>(params.grainWindow);
+    granular.repitchSemitones = params.repitchSemitones;
+    granular.startPoint = params.startPoint;
+    granular.endPoint = params.endPoint;
+    granular.sampleGain = params.sampleGain;
+    return granular;
+}
+
+void JuceEngineAdapter::renderGranularSlots(int numChannels, int numSamples) {
+    for (auto& granular : granularEngines) {
+        if (granular.isActive()) {
+            granular.process(channelPointers.data(), numChannels, numSamples);
+        }
     }
 }
 
 float JuceEngineAdapter::getSlotRepitch(int slotIndex) const {
     if (slotIndex >= 0 && slotIndex < 5) {
-        return slotParameters[slotIndex].repitchSemitones;
+        return uiSlotParameters.slots[slotIndex].repitchSemitones;
     }
     return 0.0f;
 }
 
 int JuceEngineAdapter::getSlotStartPoint(int slotIndex) const {
     if (slotIndex >= 0 && slotIndex < 5) {
-        return slotParameters[slotIndex].startPoint;
+        return uiSlotParameters.slots[slotIndex].startPoint;
     }
     return 0;
 }
 
 int JuceEngineAdapter::getSlotEndPoint(int slotIndex) const {
     if (slotIndex >= 0 && slotIndex < 5) {
-        return slotParameters[slotIndex].endPoint;
+        return uiSlotParameters.slots[slotIndex].endPoint;
     }
     return 0;
 }
 
 float JuceEngineAdapter::getSlotSampleGain(int slotIndex) const {
     if (slotIndex >= 0 && slotIndex < 5) {
-        return slotParameters[slotIndex].sampleGain;
+        return uiSlotParameters.slots[slotIndex].sampleGain;
     }
     return 1.0f;
 }
@@ -352,26 +355,35 @@ void JuceEngineAdapter::processBlock(juce::AudioBuffer<float>& buffer, juce::Mid
     // Convert MIDI messages and handle stacked/round robin playback
     convertMidiBuffer(midiMessages, numSamples);
     
-        // Process MIDI events with stacked/round robin support
-        // For stacked mode: trigger all loaded slots
-        // For round robin: cycle through loaded slots
-        std::vector<Core::MidiEvent> processedEvents;
-        
-        // Get list of loaded slots
-        std::vector<int> loadedSlots;
-        for (int i = 0; i < 5; ++i) {
-            if (slotSamples[i].hasSample && !slotSamples[i].leftChannel.empty()) {
-                loadedSlots.push_back(i);
-            }
+    // Acquire this block's slot parameters (one coherent snapshot for every NoteOn below)
+    const Core::SlotParameterSet& blockSlotParameters = publishedSlotParameters.read();
+    
+    // Process MIDI events with stacked/round robin support
+    // For stacked mode: trigger all loaded slots
+    // For round robin: cycle through loaded slots
+    processedEventBuffer.clear();
+    
+    // Get list of loaded slots from the published samples (one load per slot per block)
+    numLoadedSlots = 0;
+    for (int i = 0; i < 5; ++i) {
+        blockSlotSamples[i] = slotSamples[i].sampleData.load();
+        if (blockSlotSamples[i] && blockSlotSamples[i]->length > 0) {
+            loadedSlots[static_cast<size_t>(numLoadedSlots++)] = i;
         }
+    }
     
     // If no slots loaded, fall back to default sample
-    if (loadedSlots.empty()) {
+    if (numLoadedSlots == 0) {
         // Use default engine sample
         engine.handleMidi(midiEventBuffer.data(), static_cast<int>(midiEventBuffer.size()));
     } else if (playbackMode == 2) {
         // Orbit mode: blend between slots A-D
         processOrbitMode(buffer, numChannels, numSamples);
+        // Grain clouds started before switching to orbit still ring out
+        for (int ch = 0; ch < numChannels; ++ch) {
+            channelPointers[ch] = buffer.getWritePointer(ch);
+        }
+        renderGranularSlots(numChannels, numSamples);
         return;  // Orbit mode handles its own processing
     } else if (playbackMode == 0) {
         // Stacked mode: trigger all loaded slots (even if just one)
@@ -383,16 +395,14 @@ void JuceEngineAdapter::processBlock(juce::AudioBuffer<float>& buffer, juce::Mid
                 // Use different MIDI notes for each slot to ensure separate voices
                 int baseNote = event.note;
                 int slotOffset = 0;
-                for (int slotIndex : loadedSlots) {
+                for (int n = 0; n < numLoadedSlots; ++n) {
+                    const int slotIndex = loadedSlots[static_cast<size_t>(n)];
+                    
                     // Get this slot's parameters
-                    const SlotParameters& params = slotParameters[slotIndex];
+                    const Core::SlotParameterBlock& params = blockSlotParameters.slots[slotIndex];
                     
-                    // Create SampleData for this slot
-                    auto slotSampleData = std::make_shared<Core::SampleData>();
-                    slotSampleData->mono = slotSamples[slotIndex].leftChannel;
-                    slotSampleData->right = slotSamples[slotIndex].rightChannel;
-                    slotSampleData->length = static_cast<int>(slotSamples[slotIndex].leftChannel.size());
-                    slotSampleData->sourceSampleRate = slotSamples[slotIndex].sourceSampleRate;
+                    // This slot's shared SampleData (non-null: loaded slots only)
+                    const Core::SampleDataPtr& slotSampleData = blockSlotSamples[slotIndex];
                     
                     // Mark this slot as active
                     activeSlots[slotIndex].store(true, std::memory_order_relaxed);
@@ -402,84 +412,97 @@ void JuceEngineAdapter::processBlock(juce::AudioBuffer<float>& buffer, juce::Mid
                     // This allows each slot to have independent parameters
                     // Use note + slotOffset to create unique notes (wrapped to stay in valid range)
                     int uniqueNote = (baseNote + slotOffset) % 128;  // Wrap to valid MIDI range
-                    engine.triggerNoteOnWithSample(uniqueNote, event.velocity, slotSampleData,
-                                                   params.repitchSemitones, params.startPoint, params.endPoint, params.sampleGain,
-                                                   params.attackMs, params.decayMs, params.sustain, params.releaseMs,
-                                                   params.loopEnabled, params.loopStartPoint, params.loopEndPoint);
+                    if (params.granularEnabled) {
+                        granularEngines[static_cast<size_t>(slotIndex)].noteOn(uniqueNote, event.velocity, slotSampleData,
+                                                                               makeGranularParameters(params), event.sampleOffset);
+                    } else {
+                        engine.triggerNoteOnWithSample(uniqueNote, event.velocity, slotSampleData,
+                                                       params.repitchSemitones, params.startPoint, params.endPoint, params.sampleGain,
+                                                       params.attackMs, params.decayMs, params.sustain, params.releaseMs,
+                                                       params.loopEnabled, params.loopStartPoint, params.loopEndPoint,
+                                                       getSlotStealPriority(slotIndex));
+                    }
                     slotOffset++;
                 }
             } else if (event.type == Core::MidiEvent::NoteOff) {
                 // NoteOff: clear active slots for all loaded slots that were playing this note
                 // In stacked mode, all slots play together, so clear all when note is released
-                for (int slotIndex : loadedSlots) {
-                    activeSlots[slotIndex].store(false, std::memory_order_relaxed);
+                for (int n = 0; n < numLoadedSlots; ++n) {
+                    activeSlots[loadedSlots[static_cast<size_t>(n)]].store(false, std::memory_order_relaxed);
                 }
                 
                 // NoteOff: send to all voices that might be playing this note (from any slot)
                 // Since we used different note numbers for each slot, we need to send NoteOff for all of them
                 int baseNote = event.note;
-                for (size_t i = 0; i < loadedSlots.size(); ++i) {
+                for (int n = 0; n < numLoadedSlots; ++n) {
                     Core::MidiEvent noteOffEvent = event;
-                    noteOffEvent.note = (baseNote + static_cast<int>(i)) % 128;
-                    processedEvents.push_back(noteOffEvent);
+                    noteOffEvent.note = (baseNote + n) % 128;
+                    processedEventBuffer.push_back(noteOffEvent);  // Within the capacity reserved in prepare
+                    granularEngines[static_cast<size_t>(loadedSlots[static_cast<size_t>(n)])].noteOff(noteOffEvent.note);
                 }
             } else {
                 // Other events - process normally
-                processedEvents.push_back(event);
+                processedEventBuffer.push_back(event);
             }
         }
         
         // Process NoteOff and other events
-        if (!processedEvents.empty()) {
-            engine.handleMidi(processedEvents.data(), static_cast<int>(processedEvents.size()));
+        if (!processedEventBuffer.empty()) {
+            engine.handleMidi(processedEventBuffer.data(), static_cast<int>(processedEventBuffer.size()));
         }
     } else {
         // Round robin mode: cycle through loaded slots
         for (const auto& event : midiEventBuffer) {
             if (event.type == Core::MidiEvent::NoteOn) {
                 // Round robin mode: cycle through loaded slots
-                int slotIndex = loadedSlots[roundRobinIndex % loadedSlots.size()];
-                roundRobinIndex = (roundRobinIndex + 1) % loadedSlots.size();
+                int slotIndex = loadedSlots[static_cast<size_t>(roundRobinIndex % numLoadedSlots)];
+                roundRobinIndex = (roundRobinIndex + 1) % numLoadedSlots;
                 
                 // Get this slot's parameters
-                const SlotParameters& params = slotParameters[slotIndex];
+                const Core::SlotParameterBlock& params = blockSlotParameters.slots[slotIndex];
                 
-                // Create SampleData for this slot
-                auto slotSampleData = std::make_shared<Core::SampleData>();
-                slotSampleData->mono = slotSamples[slotIndex].leftChannel;
-                slotSampleData->right = slotSamples[slotIndex].rightChannel;
-                slotSampleData->length = static_cast<int>(slotSamples[slotIndex].leftChannel.size());
-                slotSampleData->sourceSampleRate = slotSamples[slotIndex].sourceSampleRate;
+                // This slot's shared SampleData (non-null: loaded slots only)
+                const Core::SampleDataPtr& slotSampleData = blockSlotSamples[slotIndex];
                 
                 // Mark this slot as active
                 activeSlots[slotIndex].store(true, std::memory_order_relaxed);
                 
                 // Trigger note with this slot's sample data and parameters
-                engine.triggerNoteOnWithSample(event.note, event.velocity, slotSampleData,
-                                               params.repitchSemitones, params.startPoint, params.endPoint, params.sampleGain,
-                                               params.attackMs, params.decayMs, params.sustain, params.releaseMs,
-                                               params.loopEnabled, params.loopStartPoint, params.loopEndPoint);
+                if (params.granularEnabled) {
+                    granularEngines[static_cast<size_t>(slotIndex)].noteOn(event.note, event.velocity, slotSampleData,
+                                                                           makeGranularParameters(params), event.sampleOffset);
+                } else {
+                    engine.triggerNoteOnWithSample(event.note, event.velocity, slotSampleData,
+                                                   params.repitchSemitones, params.startPoint, params.endPoint, params.sampleGain,
+                                                   params.attackMs, params.decayMs, params.sustain, params.releaseMs,
+                                                   params.loopEnabled, params.loopStartPoint, params.loopEndPoint,
+                                                   getSlotStealPriority(slotIndex));
+                }
             } else if (event.type == Core::MidiEvent::NoteOff) {
                 // NoteOff: clear active slot for the slot that was playing
                 // In round robin mode, only one slot plays at a time
-                int slotIndex = loadedSlots[(roundRobinIndex - 1 + loadedSlots.size()) % loadedSlots.size()];
+                int slotIndex = loadedSlots[static_cast<size_t>((roundRobinIndex - 1 + numLoadedSlots) % numLoadedSlots)];
                 activeSlots[slotIndex].store(false, std::memory_order_relaxed);
                 
-                // NoteOff events pass through unchanged
-                processedEvents.push_back(event);
+                // NoteOff events pass through unchanged (and end any grain stream on this note)
+                processedEventBuffer.push_back(event);
+                for (auto& granular : granularEngines) {
+                    granular.noteOff(event.note);
+                }
             } else {
                 // Other events pass through unchanged
-                processedEvents.push_back(event);
+                processedEventBuffer.push_back(event);
             }
         }
         
         // Process NoteOff and other events
-        if (!processedEvents.empty()) {
-            engine.handleMidi(processedEvents.data(), static_cast<int>(processedEvents.size()));
+        if (!processedEventBuffer.empty()) {
+            engine.handleMidi(processedEventBuffer.data(), static_cast<int>(processedEventBuffer.size()));
         }
     }
     
     engine.process(channelPointers.data(), numChannels, numSamples);
+    renderGranularSlots(numChannels, numSamples);
     
     // Clear MIDI event buffer for next block
     midiEventBuffer.clear();
@@ -575,6 +598,23 @@ int JuceEngineAdapter::getActiveVoiceCount() const {
     return engine.getActiveVoicesCount();
 }
 
+Core::VoiceStealStats JuceEngineAdapter::getVoiceStealStats() const {
+    Core::VoiceStealStats stats;
+    stats.steals = static_cast<uint32_t>(engine.getTotalVoicesStolen());
+    stats.tailHandoffs = static_cast<uint32_t>(engine.getTailHandoffs());
+    stats.tailMisses = static_cast<uint32_t>(engine.getTailMisses());
+    stats.droppedNotes = static_cast<uint32_t>(engine.getDroppedNotes());
+    return stats;
+}
+
+void JuceEngineAdapter::setStealPolicy(Core::VoiceStealer::Policy policy) {
+    engine.setStealPolicy(policy);
+}
+
+void JuceEngineAdapter::setRenderWorkerCount(int numWorkers) {
+    renderWorkerCount = std::max(0, std::min(numWorkers, Core::RenderWorkerPool::MAX_WORKERS));
+}
+
 void JuceEngineAdapter::getDebugInfo(int& actualInN, int& outN, int& primeRemaining, int& nonZeroCount) const {
     engine.getDebugInfo(actualInN, outN, primeRemaining, nonZeroCount);
 }
@@ -621,6 +661,11 @@ void JuceEngineAdapter::setLoopPoints(int startPoint, int endPoint) {
 
 void JuceEngineAdapter::setWarpEnabled(bool enabled) {
     engine.setWarpEnabled(enabled);
+    
+    // Granular slots hold their notes back by the same amount so all slots stay aligned
+    for (auto& granular : granularEngines) {
+        granular.setLatencyCompensation(engine.getLatencySamples());
+    }
 }
 
 void JuceEngineAdapter::setTimeRatio(double ratio) {
@@ -678,125 +723,99 @@ float JuceEngineAdapter::getOrbitPhase() const {
 }
 
 void JuceEngineAdapter::processOrbitMode(juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) {
-    // Update orbit blender (use sample-based timing for audio thread safety)
-    float dt = static_cast<float>(numSamples) / static_cast<float>(currentSampleRate);
-    currentOrbitWeights = orbitBlender.update(dt);
-    
-    // Get loaded slots A-D
-    std::vector<int> loadedSlots;
-    for (int i = 0; i < 4; ++i) {  // Only slots A-D
-        if (slotSamples[i].hasSample && !slotSamples[i].leftChannel.empty()) {
-            loadedSlots.push_back(i);
+    // Orbit mode runs on the main engine: every NoteOn starts one voice per loaded slot A-D,
+    // tagged with the slot as its blend group, and the voice mix applies per-sample weight
+    // ramps from the orbit blender - one voice manager, one master bus
+    OP1_PROFILE_SCOPE(orbitScope, Orbit);
+    OP1_PROFILE_SCOPE(notesScope, OrbitNotes);
+    uint8_t loadedMask = 0;
+    for (int i = 0; i < 4; ++i) {  // Only slots A-D (published samples, loaded by processBlock)
+        if (blockSlotSamples[i] && blockSlotSamples[i]->length > 0) {
+            loadedMask |= static_cast<uint8_t>(1 << i);
         }
     }
     
-    if (loadedSlots.size() < 2) {
-        // Degenerate case: < 2 slots loaded, just play the single slot (or nothing)
-        if (loadedSlots.size() == 1) {
-            int slotIndex = loadedSlots[0];
-            const SlotParameters& params = slotParameters[slotIndex];
-            
-            auto slotSampleData = std::make_shared<Core::SampleData>();
-            slotSampleData->mono = slotSamples[slotIndex].leftChannel;
-            slotSampleData->right = slotSamples[slotIndex].rightChannel;
-            slotSampleData->length = static_cast<int>(slotSamples[slotIndex].leftChannel.size());
-            slotSampleData->sourceSampleRate = slotSamples[slotIndex].sourceSampleRate;
-            
-            // Process MIDI events
-            for (const auto& event : midiEventBuffer) {
-                if (event.type == Core::MidiEvent::NoteOn) {
-                    engine.triggerNoteOnWithSample(event.note, event.velocity, slotSampleData,
-                                                   params.repitchSemitones, params.startPoint, params.endPoint, params.sampleGain,
-                                                   params.attackMs, params.decayMs, params.sustain, params.releaseMs,
-                                                   params.loopEnabled, params.loopStartPoint, params.loopEndPoint);
-                }
-            }
-            engine.process(channelPointers.data(), numChannels, numSamples);
-            
-            // Clear temp buffers
-            for (int ch = 0; ch < numChannels; ++ch) {
-                if (channelPointers[ch] != nullptr) {
-                    std::fill(buffer.getWritePointer(ch), buffer.getWritePointer(ch) + numSamples, 0.0f);
-                }
-            }
-            // Output is already in buffer via channelPointers
-            return;
-        } else {
-            // No slots loaded - silence
-            buffer.clear();
-            return;
-        }
+    if (loadedMask == 0) {
+        // No slots A-D loaded - silence
+        buffer.clear();
+        return;
     }
     
-    // Process MIDI events for each slot
+    // Weights are only distributed over loaded slots
+    orbitBlender.setActiveSlotsMask(loadedMask);
+    
+    const Core::SlotParameterSet& blockSlotParameters = publishedSlotParameters.current();
     for (const auto& event : midiEventBuffer) {
         if (event.type == Core::MidiEvent::NoteOn) {
-            // Trigger all slots A-D (only loaded ones will actually play)
             for (int slotIdx = 0; slotIdx < 4; ++slotIdx) {
-                if (slotSamples[slotIdx].hasSample && !slotSamples[slotIdx].leftChannel.empty()) {
-                    const SlotParameters& params = slotParameters[slotIdx];
-                    
-                    auto slotSampleData = std::make_shared<Core::SampleData>();
-                    slotSampleData->mono = slotSamples[slotIdx].leftChannel;
-                    slotSampleData->right = slotSamples[slotIdx].rightChannel;
-                    slotSampleData->length = static_cast<int>(slotSamples[slotIdx].leftChannel.size());
-                    slotSampleData->sourceSampleRate = slotSamples[slotIdx].sourceSampleRate;
-                    
-                    // In orbit mode, use the actual MIDI note so different keys play different pitches
-                    // All slots A-D still trigger simultaneously (for blending), but with the correct pitch
-                    // Store which slots are playing which note for NoteOff handling
-                    orbitSlotNotes[slotIdx] = event.note;  // Store note for this slot
-                    
-                    // In orbit mode, force loop enabled so samples play continuously while note is held
-                    // This allows smooth blending as weights change
-                    bool forceLoop = true;
-                    int loopStart = (params.loopStartPoint > 0) ? params.loopStartPoint : params.startPoint;
-                    int loopEnd = (params.loopEndPoint > 0) ? params.loopEndPoint : params.endPoint;
-                    if (loopEnd <= loopStart) loopEnd = params.endPoint;  // Fallback to end point
-                    
-                    // Use the actual MIDI note for pitch, but all slots still play simultaneously
-                    orbitEngines[slotIdx]->triggerNoteOnWithSample(event.note, event.velocity, slotSampleData,
-                                                                  params.repitchSemitones, params.startPoint, params.endPoint, params.sampleGain,
-                                                                  params.attackMs, params.decayMs, params.sustain, params.releaseMs,
-                                                                  forceLoop, loopStart, loopEnd);
+                if ((loadedMask & (1 << slotIdx)) == 0) {
+                    continue;
+                }
+                const Core::SlotParameterBlock& params = blockSlotParameters.slots[slotIdx];
+                
+                const Core::SampleDataPtr& slotSampleData = blockSlotSamples[slotIdx];
+                
+                // In orbit mode, force loop enabled so samples play continuously while note is held
+                // This allows smooth blending as weights change
+                bool forceLoop = true;
+                int loopStart = (params.loopStartPoint > 0) ? params.loopStartPoint : params.startPoint;
+                int loopEnd = (params.loopEndPoint > 0) ? params.loopEndPoint : params.endPoint;
+                if (loopEnd <= loopStart) loopEnd = params.endPoint;  // Fallback to end point
+                
+                // Use the actual MIDI note for pitch; all slots play simultaneously, one voice each
+                bool started = engine.triggerNoteOnWithSample(event.note, event.velocity, slotSampleData,
+                                                              params.repitchSemitones, params.startPoint, params.endPoint, params.sampleGain,
+                                                              params.attackMs, params.decayMs, params.sustain, params.releaseMs,
+                                                              forceLoop, loopStart, loopEnd,
+                                                              getSlotStealPriority(slotIdx), slotIdx);
+                if (started) {
+                    orbitNoteSlots[event.note & 0x7F] |= static_cast<uint8_t>(1 << slotIdx);
                 }
             }
         } else if (event.type == Core::MidiEvent::NoteOff) {
-            // Send NoteOff to all orbit engines that are playing this note
-            // In orbit mode, multiple slots might be playing the same note simultaneously
+            // One NoteOff per slot voice started for this note (each releases one voice)
+            Core::MidiEvent noteOffs[4];
+            int numNoteOffs = 0;
+            uint8_t& slots = orbitNoteSlots[event.note & 0x7F];
             for (int slotIdx = 0; slotIdx < 4; ++slotIdx) {
-                if (orbitSlotNotes[slotIdx] == event.note) {
-                    // Use the actual MIDI note (same as NoteOn)
-                    Core::MidiEvent noteOffEvent = event;
-                    orbitEngines[slotIdx]->handleMidi(&noteOffEvent, 1);
-                    orbitSlotNotes[slotIdx] = -1;  // Mark slot as not playing
+                if (slots & (1 << slotIdx)) {
+                    noteOffs[numNoteOffs++] = event;
                 }
             }
+            slots = 0;
+            if (numNoteOffs > 0) {
+                engine.handleMidi(noteOffs, numNoteOffs);
+            }
         }
     }
     
-    // Clear output buffer
-    buffer.clear();
-    
-    // Process each slot into temp buffers and blend with orbit weights
-    for (int slotIdx = 0; slotIdx < 4; ++slotIdx) {
-        if (slotSamples[slotIdx].hasSample && !slotSamples[slotIdx].leftChannel.empty() && currentOrbitWeights[slotIdx] > 0.0001f) {
-            // Clear temp buffer for this slot
-            std::fill(orbitTempBuffers[slotIdx].begin(), orbitTempBuffers[slotIdx].end(), 0.0f);
-            
-            // Process this slot's engine into temp buffer
-            orbitEngines[slotIdx]->process(orbitChannelPointers[slotIdx].data(), numChannels, numSamples);
-            
-            // Blend into output buffer with orbit weight
-            float weight = currentOrbitWeights[slotIdx];
-            for (int ch = 0; ch < numChannels; ++ch) {
-                float* outputPtr = buffer.getWritePointer(ch);
-                float* tempPtr = orbitTempBuffers[slotIdx].data() + (ch * numSamples);
-                for (int i = 0; i < numSamples; ++i) {
-                    outputPtr[i] += tempPtr[i] * weight;
-                }
-            }
+    // Render in chunks that fit the preallocated weight ramps (hosts may exceed the prepared block size)
+    OP1_PROFILE_END(notesScope);
+    int rampCapacity = static_cast<int>(orbitWeightRamps[0].size());
+    for (int offset = 0; offset < numSamples; ) {
+        int chunk = (rampCapacity > 0) ? std::min(rampCapacity, numSamples - offset) : (numSamples - offset);
+        float dt = static_cast<float>(chunk) / static_cast<float>(currentSampleRate);
+        OP1_PROFILE_SCOPE(chunkScope, OrbitWeights);
+        
+        float* ramps[4];
+        const float* weights[4];
+        for (int i = 0; i < 4; ++i) {
+            ramps[i] = orbitWeightRamps[i].data();
+            weights[i] = ramps[i];
+        }
+        if (rampCapacity > 0) {
+            currentOrbitWeights = orbitBlender.renderWeightRamps(dt, chunk, ramps);
+            engine.setBlendWeights(weights);
+        } else {
+            currentOrbitWeights = orbitBlender.update(dt);
         }
+        
+        for (int ch = 0; ch < numChannels; ++ch) {
+            channelPointers[ch] = buffer.getWritePointer(ch) + offset;
+        }
+        OP1_PROFILE_NEXT(chunkScope, OrbitEngine);
+        engine.process(channelPointers.data(), numChannels, chunk);
+        offset += chunk;
     }
 }
 
@@ -822,6 +841,9 @@ void JuceEngineAdapter::convertMidiBuffer(juce::MidiBuffer& midiMessages, int nu
             continue;
         }
         
+        if (midiEventBuffer.size() == midiEventBuffer.capacity()) {
+            break;  // Keep within the capacity reserved in prepare (no audio-thread allocation)
+        }
         midiEventBuffer.push_back(event);
     }
 }
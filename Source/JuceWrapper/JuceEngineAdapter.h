@@ -2,8 +2,13 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "../Core/SamplerEngine.h"
+#include "../Core/RenderWorkerPool.h"
+#include "../Core/GranularEngine.h"
 #include "../Core/MidiEvent.h"
 #include "../Core/DSP/OrbitBlender.h"
+#include "../Core/SlotParameterBlock.h"
+#include "../Core/TripleBuffer.h"
+#include "../Core/PublishedSample.h"
 #include <vector>
 #include <array>
 #include <atomic>
@@ -72,6 +77,27 @@ public:
     // Get active voice count (for UI updates)
     int getActiveVoiceCount() const;
     
+    // Get voice stealing counters (thread-safe)
+    Core::VoiceStealStats getVoiceStealStats() const;
+    
+    // Set voice stealing policy
+    void setStealPolicy(Core::VoiceStealer::Policy policy);
+    
+    // Number of voice render worker threads (0 = render on the audio thread only)
+    // Takes effect at the next prepare()
+    void setRenderWorkerCount(int numWorkers);
+    int getRenderWorkerCount() const { return renderWorkerCount; }
+    
+    // Publish engine instrumentation to shared memory for Op1CloneTelemetry (POSIX only)
+    // Empty name = "/op1clone-<pid>-<n>". Call while audio is stopped; false if unavailable
+    bool enableTelemetry(const std::string& name = std::string()) { return engine.enableTelemetry(name); }
+    void disableTelemetry() { engine.disableTelemetry(); }
+    
+    // CPU-adaptive quality governor (see Core::QualityGovernor; thread-safe)
+    void setQualityGovernorEnabled(bool enabled) { engine.setQualityGovernorEnabled(enabled); }
+    Core::QualityLevel getQualityLevel() const { return engine.getQualityLevel(); }
+    int readQualityChanges(Core::QualityChangeEvent* out, int maxCount) { return engine.readQualityChanges(out, maxCount); }
+    
     // Get playhead position (for UI display)
     double getPlayheadPosition() const;
     
@@ -102,8 +128,12 @@ public:
     void setLoopPoints(int startPoint, int endPoint);
     
     // Enable/disable time-warp processing
+    // Warp mode is latency compensated - report getLatencySamples() to the host after changing it
     void setWarpEnabled(bool enabled);
     
+    // Constant plugin latency (stretcher latency while warp is on, otherwise 0)
+    int getLatencySamples() const { return engine.getLatencySamples(); }
+    
     // Set time ratio (1.0 = constant duration, != 1.0 = time stretching)
     void setTimeRatio(double ratio);
     
@@ -127,6 +157,13 @@ public:
     void setSlotLoopEnabled(int slotIndex, bool enabled);
     void setSlotLoopPoints(int slotIndex, int startPoint, int endPoint);
     
+    // Granular playback for a specific slot (0-4 for A-E); applies to notes started afterwards
+    // Stacked and round robin modes only - orbit mode always blends sampler voices
+    void setSlotGranularEnabled(int slotIndex, bool enabled);
+    void setSlotGranularParameters(int slotIndex, float density, float grainSizeMs, float position,
+                                   float positionJitter, float pitchSpread, int windowShape);
+    int getSlotActiveGrainCount(int slotIndex) const;
+    
     // Get parameters for a specific slot (0-4 for A-E)
     float getSlotRepitch(int slotIndex) const;
     int getSlotStartPoint(int slotIndex) const;
@@ -142,11 +179,17 @@ public:
     float getOrbitPhase() const;  // Get current orbit phase (0.0-1.0) for dot animation
     
 private:
+    // Voice render workers (used by the engine's voice manager)
+    Core::RenderWorkerPool renderPool;
+    int renderWorkerCount;
+    
     Core::SamplerEngine engine;
     
     // Pre-allocated buffers for conversion (no allocation in audio thread)
     std::vector<float*> channelPointers;
     std::vector<Core::MidiEvent> midiEventBuffer;
+    std::vector<Core::MidiEvent> processedEventBuffer;  // Stacked note-offs fan out to one event per loaded slot
+    static constexpr int MAX_BLOCK_MIDI_EVENTS = 256;   // Note events kept per block; the rest are dropped
     
     // Sample data storage (owned by adapter) - per slot
     struct SlotSampleData {
@@ -154,40 +197,34 @@ private:
         std::vector<float> rightChannel;
         double sourceSampleRate;
         bool hasSample;
+        Core::PublishedSample sampleData;  // Built once per load and shared by every note of the slot
         
         SlotSampleData() : sourceSampleRate(44100.0), hasSample(false) {}
     };
     std::array<SlotSampleData, 5> slotSamples;  // 5 slots A-E
     
+    // Audio thread only: each slot's published sample, loaded once per block. A slot counts as
+    // loaded when its pointer is set - leftChannel/hasSample belong to the UI thread
+    std::array<Core::SampleDataPtr, 5> blockSlotSamples;
+    std::array<int, 5> loadedSlots {};
+    int numLoadedSlots = 0;
+    
     // Parameter storage per slot
-    struct SlotParameters {
-        float repitchSemitones;
-        int startPoint;
-        int endPoint;
-        float sampleGain;
-        float attackMs;
-        float decayMs;
-        float sustain;
-        float releaseMs;
-        bool loopEnabled;
-        int loopStartPoint;
-        int loopEndPoint;
-        
-        SlotParameters()
-            : repitchSemitones(0.0f)
-            , startPoint(0)
-            , endPoint(0)
-            , sampleGain(1.0f)
-            , attackMs(800.0f)
-            , decayMs(0.0f)
-            , sustain(1.0f)
-            , releaseMs(1000.0f)
-            , loopEnabled(false)
-            , loopStartPoint(0)
-            , loopEndPoint(0)
-        {}
-    };
-    std::array<SlotParameters, 5> slotParameters;  // 5 slots A-E
+    // UI thread edits uiSlotParameters and publishes a full copy; the audio thread
+    // reads one coherent snapshot per block (no locks, no tearing, no string copies)
+    Core::SlotParameterSet uiSlotParameters;  // UI thread only
+    Core::TripleBuffer<Core::SlotParameterSet> publishedSlotParameters;
+    
+    // Granular playback per slot (grain pools are fixed-size; prepared with the engine)
+    std::array<Core::GranularEngine, 5> granularEngines;
+    
+    static Core::GranularEngine::Parameters makeGranularParameters(const Core::SlotParameterBlock& params);
+    
+    // Add sounding grain clouds into channelPointers after the engine has rendered
+    void renderGranularSlots(int numChannels, int numSamples);
+    
+    // Steal priority per slot: slot A highest, slot E lowest (LowestPrioritySlot policy)
+    static int getSlotStealPriority(int slotIndex) { return 4 - slotIndex; }
     
     // Track which slots are currently active (playing) - updated in processBlock
     mutable std::array<std::atomic<bool>, 5> activeSlots;  // Thread-safe tracking of active slots
@@ -211,13 +248,11 @@ private:
     float orbitRateHz;  // Track orbit rate (Hz)
     int orbitShape;  // Track orbit shape (0-3)
     
-    // Orbit mode: separate engines for each slot (A-D only)
-    std::array<std::unique_ptr<Core::SamplerEngine>, 4> orbitEngines;
-    std::array<std::vector<float*>, 4> orbitChannelPointers;  // Per-slot channel pointers
-    std::array<std::vector<float>, 4> orbitTempBuffers;  // Per-slot temp buffers (L and R interleaved)
+    // Orbit mode: per-sample blend weights for slots A-D (allocated in prepare)
+    std::array<std::vector<float>, 4> orbitWeightRamps;
     
-    // Orbit mode: track which note each slot is playing
-    std::array<int, 4> orbitSlotNotes;  // MIDI note for each slot (A-D), -1 if not playing
+    // Orbit mode: slots (bitmask A-D) that started a voice for each MIDI note
+    std::array<uint8_t, 128> orbitNoteSlots;
     
     // Helper: convert JUCE MIDI buffer to Core MidiEvent array
     void convertMidiBuffer(juce::MidiBuffer& midiMessages, int numSamples);
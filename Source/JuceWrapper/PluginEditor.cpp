@@ -78,6 +78,25 @@ Op1CloneAudioProcessorEditor::Op1CloneAudioProcessorEditor(Op1CloneAudioProcesso
     bpmDisplayLabel.setVisible(true);  // Always visible
     addAndMakeVisible(&bpmDisplayLabel);
     
+    // Setup CPU load label (overlay in bottom left of screen, updated by the timer)
+    cpuLoadLabel.setText("", juce::dontSendNotification);
+    cpuLoadLabel.setJustificationType(juce::Justification::centredLeft);
+    cpuLoadLabel.setColour(juce::Label::textColourId, juce::Colours::white.withAlpha(0.6f));
+    cpuLoadLabel.setFont(10.0f);
+    cpuLoadLabel.setAlwaysOnTop(true);
+    cpuLoadLabel.setInterceptsMouseClicks(false, false);
+    addAndMakeVisible(&cpuLoadLabel);
+    
+    // Setup stage profile label (per-stage timings above the load meter, debug builds only)
+    stageProfileLabel.setText("", juce::dontSendNotification);
+    stageProfileLabel.setJustificationType(juce::Justification::bottomLeft);
+    stageProfileLabel.setColour(juce::Label::textColourId, juce::Colours::white.withAlpha(0.6f));
+    stageProfileLabel.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 9.0f, juce::Font::plain));
+    stageProfileLabel.setAlwaysOnTop(true);
+    stageProfileLabel.setInterceptsMouseClicks(false, false);
+    stageProfileLabel.setVisible(Core::StageProfiler::isEnabled());
+    addChildComponent(&stageProfileLabel);
+    
     // Initialize fade-out tracking
     lastEncoderChangeTime = 0;
     parameterDisplayAlpha = 0.0f;
@@ -47,6 +47,8 @@ private:
     juce::Label adsrLabel;  // "ADSR" text overlay in top right
     juce::Label parameterDisplayLabel;  // Parameter value display (e.g., "A 1s") in top left
     juce::Label bpmDisplayLabel;  // BPM display (e.g., "BPM: 120") in top right
+    juce::Label cpuLoadLabel;  // Callback load meter (e.g., "CPU 12% p99 31%") in bottom left
+    juce::Label stageProfileLabel;  // Per-stage render profile (debug builds) above the load meter
     
     // Parameter display component (label + progress bar)
     class ParameterDisplay : public juce::Component {
@@ -4,8 +4,6 @@
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <cmath>
-#include <fstream>
-#include <chrono>
 
 // For now, we'll generate a simple test tone as the default sample
 // In a real implementation, you'd load a WAV file from BinaryData
@@ -41,6 +39,10 @@ Op1CloneAudioProcessor::Op1CloneAudioProcessor()
         })
     , midiFifo(32)
 {
+#if OP1_TELEMETRY
+    // Engine instrumentation for external monitors (Op1CloneTelemetry), editor open or not
+    adapter.enableTelemetry();
+#endif
 }
 
 Op1CloneAudioProcessor::~Op1CloneAudioProcessor() {
@@ -86,6 +88,8 @@ void Op1CloneAudioProcessor::changeProgramName(int index, const juce::String& ne
 
 void Op1CloneAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     adapter.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    setLatencySamples(adapter.getLatencySamples());
+    callbackLoad.prepare(sampleRate);
     
     // Load default sample on first prepare
     static bool sampleLoaded = false;
@@ -96,6 +100,11 @@ void Op1CloneAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
 }
 
 void Op1CloneAudioProcessor::releaseResources() {
+    // OP1_RT_SANITIZER builds: report what the audio thread allocated, locked or wrote
+    if (Core::RealtimeSanitizer::isEnabled()) {
+        Core::RealtimeSanitizer::printViolations();
+        Core::RealtimeSanitizer::reset();
+    }
 }
 
 bool Op1CloneAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
@@ -107,7 +116,9 @@ bool Op1CloneAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts)
 }
 
 void Op1CloneAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    OP1_REALTIME_SCOPE(realtimeScope);
     juce::ScopedNoDenormals noDenormals;
+    const uint64_t blockStart = callbackLoad.beginBlock();
     
     // Drain MIDI input FIFO (from MIDI controller) - lock-free
     midiInputHandler.drainToMidiBuffer(midiMessages, buffer.getNumSamples());
@@ -139,14 +150,25 @@ void Op1CloneAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     debugLastOutN.store(outN, std::memory_order_relaxed);
     debugLastPrimeRemaining.store(primeRemaining, std::memory_order_relaxed);
     debugLastNonZeroOutCount.store(nonZeroCount, std::memory_order_relaxed);
+    
+    callbackLoad.endBlock(blockStart, buffer.getNumSamples());
 }
 
+// OP1_HEADLESS builds (Op1CloneProcessBench) link without the editor sources
 bool Op1CloneAudioProcessor::hasEditor() const {
+#if OP1_HEADLESS
+    return false;
+#else
     return true;
+#endif
 }
 
 juce::AudioProcessorEditor* Op1CloneAudioProcessor::createEditor() {
+#if OP1_HEADLESS
+    return nullptr;
+#else
     return new Op1CloneAudioProcessorEditor(*this);
+#endif
 }
 
 void Op1CloneAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -228,15 +250,6 @@ float Op1CloneAudioProcessor::getSampleGain() const {
 }
 
 bool Op1CloneAudioProcessor::loadSampleFromFile(const juce::File& file) {
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1\",\"location\":\"PluginProcessor.cpp:213\",\"message\":\"loadSampleFromFile entry\",\"data\":{\"fileExists\":" << (file.existsAsFile() ? 1 : 0) << ",\"fileName\":\"" << file.getFileName().toStdString() << "\"},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     if (!file.existsAsFile()) {
         return false;
     }
@@ -247,15 +260,6 @@ bool Op1CloneAudioProcessor::loadSampleFromFile(const juce::File& file) {
     
     std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1\",\"location\":\"PluginProcessor.cpp:223\",\"message\":\"reader created\",\"data\":{\"readerNull\":" << (reader == nullptr ? 1 : 0) << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     if (reader == nullptr) {
         return false;
     }
@@ -264,55 +268,19 @@ bool Op1CloneAudioProcessor::loadSampleFromFile(const juce::File& file) {
     juce::AudioBuffer<float> sampleBuffer(static_cast<int>(reader->numChannels), 
                                           static_cast<int>(reader->lengthInSamples));
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1\",\"location\":\"PluginProcessor.cpp:230\",\"message\":\"buffer created\",\"data\":{\"numChannels\":" << static_cast<int>(reader->numChannels) << ",\"numSamples\":" << static_cast<int>(reader->lengthInSamples) << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     // Read the file into the buffer
     bool readSuccess = reader->read(&sampleBuffer, 0, static_cast<int>(reader->lengthInSamples), 0, true, true);
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1\",\"location\":\"PluginProcessor.cpp:232\",\"message\":\"file read\",\"data\":{\"readSuccess\":" << (readSuccess ? 1 : 0) << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     if (!readSuccess) {
         return false;
     }
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1\",\"location\":\"PluginProcessor.cpp:237\",\"message\":\"calling adapter.setSample\",\"data\":{\"sampleRate\":" << reader->sampleRate << "},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     // Pass to adapter (will extract mono from first channel)
     adapter.setSample(sampleBuffer, reader->sampleRate);
     
     // Also update slot 0 to keep it in sync with the default sample
     adapter.setSampleForSlot(0, sampleBuffer, reader->sampleRate);
     
-    // #region agent log
-    {
-        std::ofstream log("/Users/troycarson/Documents/JUCE Projects/OP1-Clone/.cursor/debug.log", std::ios::app);
-        if (log.is_open()) {
-            log << "{\"sessionId\":\"debug-session\",\"runId\":\"run1\",\"hypothesisId\":\"H1\",\"location\":\"PluginProcessor.cpp:240\",\"message\":\"loadSampleFromFile exit\",\"data\":{},\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() << "}\n";
-        }
-    }
-    // #endregion
-    
     return true;
 }
 
@@ -344,6 +312,14 @@ int Op1CloneAudioProcessor::getActiveVoiceCount() const {
     return adapter.getActiveVoiceCount();
 }
 
+Core::VoiceStealStats Op1CloneAudioProcessor::getVoiceStealStats() const {
+    return adapter.getVoiceStealStats();
+}
+
+void Op1CloneAudioProcessor::setStealPolicy(Core::VoiceStealer::Policy policy) {
+    adapter.setStealPolicy(policy);
+}
+
 void Op1CloneAudioProcessor::setLPFilterCutoff(float cutoffHz) {
     adapter.setLPFilterCutoff(cutoffHz);
 }
@@ -452,6 +428,8 @@ void Op1CloneAudioProcessor::setLoopPoints(int startPoint, int endPoint) {
 
 void Op1CloneAudioProcessor::setWarpEnabled(bool enabled) {
     adapter.setWarpEnabled(enabled);
+    // Warped voices are delay compensated by the host rather than primed per note
+    setLatencySamples(adapter.getLatencySamples());
 }
 
 void Op1CloneAudioProcessor::setTimeRatio(double ratio) {
@@ -5,6 +5,8 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "JuceEngineAdapter.h"
 #include "MidiInputHandler.h"
+#include "../Core/CallbackLoadMeter.h"
+#include "../Core/RealtimeSanitizer.h"
 #include <vector>
 #include <array>
 #include <atomic>
@@ -91,6 +93,20 @@ public:
     // Get active voice count (for UI updates)
     int getActiveVoiceCount() const;
     
+    // Whole-callback CPU load (fraction of the block's real-time budget) and deadline misses
+    Core::CallbackLoadStats getCallbackLoadStats() const { return callbackLoad.getStats(); }
+    int readCallbackOverruns(Core::LoadOverrunEvent* out, int maxCount) { return callbackLoad.readOverruns(out, maxCount); }
+    void resetCallbackLoadStats() { callbackLoad.requestReset(); }
+    
+    // Quality level the engine's governor has stepped to under load, and its decisions
+    Core::QualityLevel getQualityLevel() const { return adapter.getQualityLevel(); }
+    int readQualityChanges(Core::QualityChangeEvent* out, int maxCount) { return adapter.readQualityChanges(out, maxCount); }
+    void setQualityGovernorEnabled(bool enabled) { adapter.setQualityGovernorEnabled(enabled); }
+    
+    // Voice stealing counters and policy (pass-through to adapter)
+    Core::VoiceStealStats getVoiceStealStats() const;
+    void setStealPolicy(Core::VoiceStealer::Policy policy);
+    
     // Set LP filter parameters
     void setLPFilterCutoff(float cutoffHz);
     void setLPFilterResonance(float resonance);
@@ -168,6 +184,9 @@ private:
     JuceEngineAdapter adapter;
     juce::AudioProcessorValueTreeState parameters;
     
+    // Times every processBlock against numSamples / sampleRate
+    Core::CallbackLoadMeter callbackLoad;
+    
     // MIDI input handler for standalone app (lock-free FIFO)
     MidiInputHandler midiInputHandler;
     
@@ -0,0 +1,23 @@
+#!/bin/bash
+# Benchmark processBlock under each render-loop diagnostics policy (Core/DiagnosticsPolicy.h)
+# Builds Op1CloneProcessBench once per policy in its own release build directory and runs it
+# with the given arguments:
+#   ./bench_diagnostics.sh --slot a.wav --slot b.wav --block 256
+
+set -e
+
+JOBS=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)
+
+for POLICY in Release Diagnostics Paranoid; do
+    BUILD_DIR="build-diagnostics-$(echo "$POLICY" | tr '[:upper:]' '[:lower:]')"
+    echo "=== $POLICY ($BUILD_DIR) ==="
+    cmake -S . -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DOP1_DIAGNOSTICS="$POLICY" > /dev/null
+    cmake --build "$BUILD_DIR" --config Release --target Op1CloneProcessBench -j"$JOBS" > /dev/null
+    BENCH=$(find "$BUILD_DIR" -type f -name Op1CloneProcessBench -perm -u+x | head -n 1)
+    if [ -z "$BENCH" ]; then
+        echo "❌ ERROR: Op1CloneProcessBench not found in $BUILD_DIR"
+        exit 1
+    fi
+    "$BENCH" "$@"
+    echo ""
+done
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+# Compare two Op1CloneCoreBench JSON runs and flag regressions
+# Usage: ./compare_core_bench.py baseline.json candidate.json [--threshold 10] [--metric nsPerSample]
+# Exits 1 if any case got slower by more than the threshold (percent), 0 otherwise
+
+import argparse
+import json
+import math
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        run = json.load(f)
+    if run.get("suite") != "Op1CloneCoreBench":
+        sys.exit(f"{path}: not an Op1CloneCoreBench report")
+    cases = {}
+    for r in run.get("results", []):
+        cases[(r["name"], r["blockSize"], r["sampleRate"])] = r
+    return run, cases
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two Op1CloneCoreBench JSON runs")
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="percent slowdown that counts as a regression (default 10)")
+    parser.add_argument("--metric", default="nsPerSample",
+                        help="result field to compare, lower is better (default nsPerSample)")
+    parser.add_argument("--all", action="store_true", help="list every case, not just changes")
+    args = parser.parse_args()
+
+    base_run, base = load(args.baseline)
+    cand_run, cand = load(args.candidate)
+
+    # Numbers from different build types or compilers are not comparable case by case
+    for field in ("build", "compiler"):
+        if base_run.get(field) != cand_run.get(field):
+            print(f"warning: {field} differs: {base_run.get(field)} vs {cand_run.get(field)}")
+
+    regressions = []
+    improvements = []
+    per_class = {}
+    print(f"{'class':<18} {'block':>6} {'rate':>7} {'base':>10} {'cand':>10} {'change':>8}")
+    for key in sorted(base.keys() & cand.keys()):
+        before = base[key].get(args.metric)
+        after = cand[key].get(args.metric)
+        if not before or after is None:
+            continue
+        change = (after / before - 1.0) * 100.0
+        per_class.setdefault(key[0], []).append(after / before)
+        mark = ""
+        if change > args.threshold:
+            regressions.append(key)
+            mark = "  REGRESSION"
+        elif change < -args.threshold:
+            improvements.append(key)
+            mark = "  faster"
+        if mark or args.all:
+            print(f"{key[0]:<18} {key[1]:>6} {key[2]:>7.0f} {before:>10.3f} {after:>10.3f} {change:>+7.1f}%{mark}")
+
+    # Geometric mean per class smooths out single noisy cases
+    print("\nPer class (geometric mean of candidate / baseline):")
+    for name in sorted(per_class):
+        ratios = per_class[name]
+        mean = math.exp(sum(math.log(r) for r in ratios) / len(ratios))
+        print(f"  {name:<18} {(mean - 1.0) * 100.0:>+7.1f}%  ({len(ratios)} cases)")
+
+    missing = sorted(base.keys() - cand.keys())
+    added = sorted(cand.keys() - base.keys())
+    if missing:
+        print(f"\n{len(missing)} case(s) only in baseline, e.g. {missing[0]}")
+    if added:
+        print(f"\n{len(added)} case(s) only in candidate, e.g. {added[0]}")
+
+    print(f"\n{len(regressions)} regression(s), {len(improvements)} improvement(s) "
+          f"beyond {args.threshold:g}% on {args.metric}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())